@@ -0,0 +1,260 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "Core/Context.h"
+#include "Core/Timer.h"
+#include "Rendering/Renderer.h"
+#include "RHI/RHI_SwapChain.h"
+#include "RHI/RHI_CommandList.h"
+#include "RHI/Null/Null_Utility.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include "World/Components/Light.h"
+//======================================
+
+#if !defined(API_GRAPHICS_NULL)
+#error "The benchmark reads the null backend's command stream, generate the project files with the null graphics API"
+#endif
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace _Benchmark
+{
+    double percentile(const vector<double>& sorted, const double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+
+        const size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[min(index, sorted.size() - 1)];
+    }
+}
+
+Benchmark::~Benchmark()
+{
+    if (!m_engine)
+        return;
+
+    // The engine saves its settings on shutdown, so don't leave the benchmark's behind
+    m_context->GetSubsystem<Timer>()->SetTargetFps(m_fps_target_previous);
+    m_renderer->SetResolution(m_width_previous, m_height_previous);
+}
+
+bool Benchmark::Initialize(const Settings& settings)
+{
+    m_settings = settings;
+
+    // The null swap chain doesn't present anywhere, so it needs no window
+    WindowData window_data;
+    window_data.width   = static_cast<float>(m_settings.width);
+    window_data.height  = static_cast<float>(m_settings.height);
+
+    m_engine    = make_unique<Engine>(window_data);
+    m_context   = m_engine->GetContext();
+    m_renderer  = m_context->GetSubsystem<Renderer>();
+    m_world     = m_context->GetSubsystem<World>();
+
+    if (!m_renderer->IsInitialized())
+    {
+        printf("The renderer failed to initialize, see the log for details.\n");
+        return false;
+    }
+
+    // Remember what the settings file had
+    Timer* timer            = m_context->GetSubsystem<Timer>();
+    m_fps_target_previous   = timer->GetTargetFps();
+    m_width_previous        = static_cast<uint32_t>(m_renderer->GetResolution().x);
+    m_height_previous       = static_cast<uint32_t>(m_renderer->GetResolution().y);
+
+    // A target which is never reached, so the timer never sleeps inside a measured frame
+    timer->SetTargetFps(1000000.0);
+    m_renderer->SetResolution(m_settings.width, m_settings.height);
+
+    return true;
+}
+
+void Benchmark::GenerateScene()
+{
+    mt19937 generator(m_settings.seed);
+    uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+    // Lay the renderables out on a grid in front of the default camera, with varying geometry and scale
+    const Geometry_Type geometries[]    = { Geometry_Default_Cube, Geometry_Default_Sphere, Geometry_Default_Cylinder, Geometry_Default_Cone };
+    const uint32_t side                 = static_cast<uint32_t>(ceil(sqrt(static_cast<double>(m_settings.renderables))));
+    const float spacing                 = 2.5f;
+    const float extent                  = static_cast<float>(side) * spacing;
+
+    for (uint32_t i = 0; i < m_settings.renderables; i++)
+    {
+        const float x = static_cast<float>(i % side) * spacing - extent * 0.5f;
+        const float z = static_cast<float>(i / side) * spacing + 2.0f;
+        const float y = distribution(generator) * 2.0f;
+
+        shared_ptr<Entity> entity = m_world->EntityCreate();
+        entity->SetName("Renderable_" + to_string(i));
+        entity->GetTransform()->SetPositionLocal(Vector3(x, y, z));
+        entity->GetTransform()->SetScaleLocal(Vector3(0.5f + distribution(generator)));
+
+        Renderable* renderable = entity->AddComponent<Renderable>();
+        renderable->GeometrySet(geometries[i % (sizeof(geometries) / sizeof(geometries[0]))]);
+        renderable->UseDefaultMaterial();
+    }
+
+    // Scatter point lights over the same area, the world already has a directional light
+    for (uint32_t i = 0; i < m_settings.lights; i++)
+    {
+        const float x = distribution(generator) * extent - extent * 0.5f;
+        const float z = distribution(generator) * extent + 2.0f;
+
+        shared_ptr<Entity> entity = m_world->EntityCreate();
+        entity->SetName("Light_" + to_string(i));
+        entity->GetTransform()->SetPositionLocal(Vector3(x, 3.0f, z));
+
+        Light* light = entity->AddComponent<Light>();
+        light->SetLightType(LightType_Point);
+        light->SetColor(distribution(generator), distribution(generator), distribution(generator), 1.0f);
+        light->SetRange(spacing * 4.0f);
+    }
+
+    printf("Generated %u renderables and %u point lights\n", m_settings.renderables, m_settings.lights);
+}
+
+bool Benchmark::Run()
+{
+    for (uint32_t i = 0; i < m_settings.frames_warm_up; i++)
+    {
+        if (!Tick(false))
+            return false;
+    }
+
+    m_frame_times_ms.reserve(m_settings.frames);
+    for (uint32_t i = 0; i < m_settings.frames; i++)
+    {
+        if (!Tick(true))
+            return false;
+    }
+
+    return true;
+}
+
+bool Benchmark::Tick(const bool measure)
+{
+    RHI_SwapChain* swap_chain   = m_renderer->GetSwapChain();
+    RHI_CommandList* cmd_list   = swap_chain->GetCmdList();
+
+    // Same sequence as the editor, minus the UI
+    const auto time_start = chrono::high_resolution_clock::now();
+    cmd_list->Begin();
+    m_engine->Tick();
+    const bool presented = m_renderer->Present();
+    const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - time_start;
+
+    if (!presented)
+    {
+        printf("Failed to present, see the log for details.\n");
+        return false;
+    }
+
+    if (!measure)
+        return true;
+
+    m_frame_times_ms.emplace_back(duration.count());
+
+    // The command stream of this frame stays intact until the command list begins again
+    const null_utility::command_stream* stream = null_utility::get_command_stream(cmd_list->GetResource_CommandBuffer());
+    m_draw_calls += stream->count(null_utility::command_draw) + stream->count(null_utility::command_draw_indexed);
+
+    for (const null_utility::pass_timing& pass : stream->get_passes())
+    {
+        const string name = pass.name ? pass.name : "Unnamed";
+
+        auto it = m_passes.find(name);
+        if (it == m_passes.end())
+        {
+            it = m_passes.emplace(name, PassStatistics()).first;
+            m_pass_order.emplace_back(name);
+        }
+
+        it->second.cpu_ms   += pass.cpu_ms;
+        it->second.commands += pass.command_count;
+        it->second.count++;
+    }
+
+    return true;
+}
+
+void Benchmark::Report() const
+{
+    if (m_frame_times_ms.empty())
+    {
+        printf("No frames were measured\n");
+        return;
+    }
+
+    vector<double> sorted = m_frame_times_ms;
+    sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (const double time : sorted)
+    {
+        sum += time;
+    }
+
+    const double frames = static_cast<double>(sorted.size());
+    const double mean   = sum / frames;
+
+    printf("\nFrames: %u (after %u warm-up frames), resolution: %ux%u\n", static_cast<uint32_t>(sorted.size()), m_settings.frames_warm_up, m_settings.width, m_settings.height);
+    printf("CPU frame time (ms): mean %.3f, min %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n",
+        mean,
+        sorted.front(),
+        _Benchmark::percentile(sorted, 0.50),
+        _Benchmark::percentile(sorted, 0.95),
+        _Benchmark::percentile(sorted, 0.99),
+        sorted.back()
+    );
+    printf("Draw calls per frame: %.1f\n", static_cast<double>(m_draw_calls) / frames);
+
+    // Per pass averages, in the order in which the passes were first recorded
+    printf("\n%-32s %12s %12s %12s\n", "Pass", "CPU ms", "Commands", "Per frame");
+    for (const string& name : m_pass_order)
+    {
+        const PassStatistics& pass = m_passes.at(name);
+        printf("%-32s %12.3f %12.1f %12.1f\n",
+            name.c_str(),
+            pass.cpu_ms / frames,
+            static_cast<double>(pass.commands) / frames,
+            static_cast<double>(pass.count) / frames
+        );
+    }
+}
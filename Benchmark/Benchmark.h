@@ -0,0 +1,92 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include <vector>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "Core/Engine.h"
+//==============================
+
+//= FORWARD DECLARATIONS =
+namespace Spartan
+{
+    class Context;
+    class Renderer;
+    class World;
+}
+//========================
+
+// Renders a generated scene through the null RHI backend and reports how much CPU time
+// each frame, and each pass within it, takes. No window or GPU is involved, so it can run
+// on build machines.
+class Benchmark
+{
+public:
+    struct Settings
+    {
+        uint32_t width          = 1920;
+        uint32_t height         = 1080;
+        uint32_t renderables    = 1000;
+        uint32_t lights         = 16;
+        uint32_t frames_warm_up = 60;   // lets shader compilation and pipeline creation settle
+        uint32_t frames         = 500;
+        uint32_t seed           = 1;
+    };
+
+    Benchmark() = default;
+    ~Benchmark();
+
+    bool Initialize(const Settings& settings);
+    void GenerateScene();
+    bool Run();
+    void Report() const;
+
+private:
+    bool Tick(bool measure);
+
+    struct PassStatistics
+    {
+        double cpu_ms       = 0.0;
+        uint64_t commands   = 0;
+        uint32_t count      = 0;
+    };
+
+    Settings m_settings;
+    std::vector<double> m_frame_times_ms;
+    std::vector<std::string> m_pass_order;
+    std::unordered_map<std::string, PassStatistics> m_passes;
+    uint64_t m_draw_calls = 0;
+
+    // Engine
+    std::unique_ptr<Spartan::Engine> m_engine;
+    Spartan::Context* m_context     = nullptr;
+    Spartan::Renderer* m_renderer   = nullptr;
+    Spartan::World* m_world         = nullptr;
+
+    // Values which the engine persists to the settings file, restored before it shuts down
+    double m_fps_target_previous    = 0.0;
+    uint32_t m_width_previous       = 0;
+    uint32_t m_height_previous      = 0;
+};
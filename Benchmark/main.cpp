@@ -0,0 +1,78 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =======
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Benchmark.h"
+//==================
+
+namespace _Benchmark
+{
+    bool parse_argument(const char* argument, const char* name, uint32_t& value)
+    {
+        const size_t length = strlen(name);
+        if (strncmp(argument, name, length) != 0 || argument[length] != '=')
+            return false;
+
+        value = static_cast<uint32_t>(strtoul(argument + length + 1, nullptr, 10));
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Benchmark::Settings settings;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+
+        bool parsed = false;
+        parsed |= _Benchmark::parse_argument(argument, "--width",        settings.width);
+        parsed |= _Benchmark::parse_argument(argument, "--height",       settings.height);
+        parsed |= _Benchmark::parse_argument(argument, "--renderables",  settings.renderables);
+        parsed |= _Benchmark::parse_argument(argument, "--lights",       settings.lights);
+        parsed |= _Benchmark::parse_argument(argument, "--warm_up",      settings.frames_warm_up);
+        parsed |= _Benchmark::parse_argument(argument, "--frames",       settings.frames);
+        parsed |= _Benchmark::parse_argument(argument, "--seed",         settings.seed);
+
+        if (!parsed)
+        {
+            printf("Unknown argument: %s\n", argument);
+            printf("Usage: Benchmark [--width=N] [--height=N] [--renderables=N] [--lights=N] [--warm_up=N] [--frames=N] [--seed=N]\n");
+            return 1;
+        }
+    }
+
+    Benchmark benchmark;
+    if (!benchmark.Initialize(settings))
+        return 1;
+
+    benchmark.GenerateScene();
+
+    if (!benchmark.Run())
+        return 1;
+
+    benchmark.Report();
+    return 0;
+}
@@ -0,0 +1,23 @@
+@echo off
+cd /D "%~dp0"
+
+rem Generates a null graphics, software audio solution, builds the benchmark and runs it.
+rem Needs no IDE, window or GPU, so it can run on build machines. Arguments are passed to the
+rem benchmark, e.g. Benchmark_Null.bat --renderables=5000 --frames=1000
+
+call "Scripts\generate_project_files.bat" vs2019 null software
+if errorlevel 1 exit /b 1
+
+set VSWHERE="%ProgramFiles(x86)%\Microsoft Visual Studio\Installer\vswhere.exe"
+for /f "usebackq tokens=*" %%i in (`%VSWHERE% -latest -requires Microsoft.Component.MSBuild -find MSBuild\**\Bin\MSBuild.exe`) do set MSBUILD="%%i"
+if not defined MSBUILD (
+    echo MSBuild was not found
+    exit /b 1
+)
+
+%MSBUILD% Spartan.sln /m /t:Benchmark /p:Configuration=Release /p:Platform=x64
+if errorlevel 1 exit /b 1
+
+cd "Binaries\Release"
+Benchmark_null.exe %*
+exit /b %errorlevel%
@@ -91,6 +91,8 @@ cbuffer BufferUber : register(b2)
 
     float g_mat_id;
     float3 g_padding2;
+
+    uint4 g_mat_textures[2];
 };
 
 // High frequency - Updates per object
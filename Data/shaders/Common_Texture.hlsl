@@ -20,6 +20,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 // Material
+#if BINDLESS
+// Texture table, indexed with the material's texture indices (see BufferUber)
+Texture2D tex_bindless[]                : register (t0, space1);
+#define tex_material_albedo             tex_bindless[g_mat_textures[0].x]
+#define tex_material_roughness          tex_bindless[g_mat_textures[0].y]
+#define tex_material_metallic           tex_bindless[g_mat_textures[0].z]
+#define tex_material_normal             tex_bindless[g_mat_textures[0].w]
+#define tex_material_height             tex_bindless[g_mat_textures[1].x]
+#define tex_material_occlusion          tex_bindless[g_mat_textures[1].y]
+#define tex_material_emission           tex_bindless[g_mat_textures[1].z]
+#define tex_material_mask               tex_bindless[g_mat_textures[1].w]
+#else
 Texture2D tex_material_albedo           : register (t0);
 Texture2D tex_material_roughness        : register (t1);
 Texture2D tex_material_metallic         : register (t2);
@@ -28,6 +40,7 @@ Texture2D tex_material_height           : register (t4);
 Texture2D tex_material_occlusion        : register (t5);
 Texture2D tex_material_emission         : register (t6);
 Texture2D tex_material_mask             : register (t7);
+#endif
 
 // G-buffer
 Texture2D tex_albedo                    : register(t8);
@@ -47,6 +47,18 @@ Widget_Console::Widget_Console(Editor* editor) : Widget(editor)
 
 void Widget_Console::Tick()
 {
+    // Take over what the engine logged since the last tick
+    {
+        lock_guard<mutex> lock(m_logs_pending_mutex);
+        m_logs_pending.swap(m_logs_incoming);
+    }
+
+    for (const LogPackage& package : m_logs_incoming)
+    {
+        LogPackageProcess(package);
+    }
+    m_logs_incoming.clear();
+
 	// Clear Button
 	if (ImGui::Button("Clear"))	{ Clear();} ImGui::SameLine();
 
@@ -90,14 +102,7 @@ void Widget_Console::Tick()
         max_log_width = Math::Helper::Max(max_log_width, ImGui::GetWindowContentRegionWidth());
         ImGui::PushItemWidth(max_log_width);
 
-        // Wait for reading to finish
-        while (m_is_reading)
-        {
-            this_thread::sleep_for(std::chrono::milliseconds(16));
-        }
-
         uint32_t index = 0;
-        m_is_reading = true;
         for (LogPackage& log : m_logs)
         {
             if (m_log_filter.PassFilter(log.text.c_str()))
@@ -126,7 +131,6 @@ void Widget_Console::Tick()
                 }
             }
         }
-        m_is_reading = false;
 
         ImGui::PopItemWidth();
 
@@ -163,9 +167,13 @@ void Widget_Console::Tick()
 
 void Widget_Console::AddLogPackage(const LogPackage& package)
 {
-    // Wait for reading to finish
-    while (m_is_reading) {}
+    // Called from the engine's log thread, so only queue it, the widget picks it up when it ticks
+    lock_guard<mutex> lock(m_logs_pending_mutex);
+    m_logs_pending.push_back(package);
+}
 
+void Widget_Console::LogPackageProcess(const LogPackage& package)
+{
     // Save to deque
 	m_logs.push_back(package);
 	if (static_cast<uint32_t>(m_logs.size()) > m_log_max_count)
@@ -26,7 +26,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <memory>
 #include <functional>
 #include <deque>
-#include <atomic>
+#include <mutex>
+#include <vector>
 #include "Logging/ILogger.h"
 //==========================
 
@@ -36,7 +37,7 @@ struct LogPackage
 	unsigned int error_level = 0;
 };
 
-// Implementation of Spartan::ILogger so the engine can log into the editor
+// Implementation of Spartan::ILogger so the engine can log into the editor (the callback runs on the engine's log thread)
 class EngineLogger : public Spartan::ILogger
 {
 public:
@@ -67,6 +68,8 @@ public:
 	void Clear();
 
 private:
+    void LogPackageProcess(const LogPackage& package);
+
     bool m_scroll_to_bottom         = false;
     uint32_t m_log_max_count        = 1000;
     float m_log_type_max_width[3]   = { 0, 0, 0 };
@@ -78,9 +81,11 @@ private:
         Spartan::Math::Vector4(0.7f, 0.75f, 0.0f, 1.0f),	// Warning
         Spartan::Math::Vector4(0.7f, 0.3f, 0.3f, 1.0f)	    // Error
     };
-    std::atomic<bool> m_is_reading = false;
     std::shared_ptr<EngineLogger> m_logger;
     std::deque<LogPackage> m_logs;
+    std::mutex m_logs_pending_mutex;
+    std::vector<LogPackage> m_logs_pending;     // filled by the engine's log thread
+    std::vector<LogPackage> m_logs_incoming;    // swapped with the above, so the lock isn't held while processing
     ImGuiTextFilter m_log_filter;
     LogPackage m_log_selected;
 };
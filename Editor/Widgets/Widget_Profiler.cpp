@@ -51,36 +51,55 @@ void Widget_Profiler::Tick()
 	ImGui::SameLine();
 	ImGui::RadioButton("GPU", &item_type, 1);
 	ImGui::SameLine();
+	ImGui::RadioButton("Hitches", &item_type, 2);
+	ImGui::SameLine();
 	float interval = m_profiler->GetUpdateInterval();
-	ImGui::DragFloat("Update interval (The smaller the interval the higher the performance impact)", &interval, 0.001f, 0.0f, 0.5f);
+	ImGui::DragFloat("GPU update interval (The smaller the interval the higher the performance impact)", &interval, 0.001f, 0.0f, 0.5f);
 	m_profiler->SetUpdateInterval(interval);
+	static int capture_frames = 120;
+	ImGui::InputInt("Frames", &capture_frames);
+	capture_frames = Helper::Max(capture_frames, 1);
+	ImGui::SameLine();
+	if (ImGui::Button(m_profiler->IsCapturing() ? "Capturing..." : "Capture") && !m_profiler->IsCapturing())
+	{
+		m_profiler->CaptureStart("profiler_capture.json", static_cast<uint32_t>(capture_frames));
+	}
 	ImGui::Separator();
-    const bool show_cpu = (item_type == 0);
 
-	if (show_cpu)
+	if (item_type == 0)
 	{
 		ShowCPU();
 	}
-	else
+	else if (item_type == 1)
 	{
 		ShowGPU();
 	}
+	else
+	{
+		ShowHitches();
+	}
 }
 
 void Widget_Profiler::ShowCPU()
 {
 	// Get stuff
-	const auto& time_blocks		= m_profiler->GetTimeBlocks();
-	const auto time_block_count = static_cast<unsigned int>(time_blocks.size());
-	const auto time_cpu			= m_profiler->GetTimeCpuLast();	
+	const auto& timeline		= m_profiler->GetTimeline();
+	const auto timeline_ms		= m_profiler->GetTimelineDuration();
+	const auto time_cpu			= m_profiler->GetTimeCpuLast();
 
-	// Time blocks	
-	for (unsigned int i = 0; i < time_block_count; i++)
+	// Threads
+	for (const TimelineThread& thread : timeline)
 	{
-        if (time_blocks[i].GetType() != TimeBlock_Cpu)
+        if (thread.scopes.empty())
             continue;
 
-        ShowTimeBlock(time_blocks[i], time_cpu);
+        ImGui::Text("%s", thread.name.c_str());
+        if (thread.dropped != 0)
+        {
+            ImGui::SameLine(); ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "(%d events dropped)", thread.dropped);
+        }
+
+        ShowTimeline(thread.scopes, timeline_ms);
 	}
 
 	ImGui::Separator();
@@ -136,6 +155,109 @@ void Widget_Profiler::ShowTimeBlock(const TimeBlock& time_block, float total_tim
     ImGui::Text("%s - %.2f ms", name, duration);
 }
 
+void Widget_Profiler::ShowHitches() const
+{
+	// Percentiles
+	const FrameHistory& history = m_profiler->GetFrameHistory();
+	ImGui::Text("Last %d frames\t\tp50\t\tp90\t\tp99\t\tp99.9", history.GetCount());
+	const char* names[FrameTime_Count] = { "Frame:", "CPU:", "GPU:" };
+	for (uint32_t type = 0; type < FrameTime_Count; type++)
+	{
+		const FrameTime_Type frame_time_type = static_cast<FrameTime_Type>(type);
+		ImGui::Text("%s\t\t\t\t%.2f\t\t%.2f\t\t%.2f\t\t%.2f",
+			names[type],
+			history.GetPercentile(frame_time_type, 50.0f),
+			history.GetPercentile(frame_time_type, 90.0f),
+			history.GetPercentile(frame_time_type, 99.0f),
+			history.GetPercentile(frame_time_type, 99.9f)
+		);
+	}
+	ImGui::Separator();
+
+	// Options
+	float multiplier = m_profiler->GetHitchMultiplier();
+	ImGui::DragFloat("Hitch threshold (multiple of the median frame time)", &multiplier, 0.05f, 1.1f, 10.0f);
+	m_profiler->SetHitchMultiplier(multiplier);
+	if (ImGui::Button("Export")) { m_profiler->HitchesExport("profiler_hitches.json"); }
+	ImGui::SameLine();
+	if (ImGui::Button("Clear")) { m_profiler->HitchesClear(); }
+	ImGui::Separator();
+
+	// Snapshots (newest first)
+	const auto& hitches = m_profiler->GetHitches();
+	for (auto it = hitches.rbegin(); it != hitches.rend(); it++)
+	{
+		const HitchSnapshot& hitch = *it;
+
+		ImGui::PushID(static_cast<int>(hitch.frame));
+		if (ImGui::TreeNode("hitch", "Frame %d - %.2f ms (median %.2f ms, CPU %.2f ms)", static_cast<uint32_t>(hitch.frame), hitch.time_frame_ms, hitch.time_median_ms, hitch.time_cpu_ms))
+		{
+			for (const TimelineThread& thread : hitch.timeline)
+			{
+				if (thread.scopes.empty())
+					continue;
+
+				ImGui::Text("%s", thread.name.c_str());
+				ShowTimeline(thread.scopes, hitch.time_frame_ms);
+			}
+
+			if (!hitch.gpu.empty())
+			{
+				ImGui::Text("GPU - %.2f ms", hitch.time_gpu_ms);
+				ShowTimeline(hitch.gpu, hitch.time_frame_ms);
+			}
+
+			ImGui::TreePop();
+		}
+		ImGui::PopID();
+	}
+}
+
+void Widget_Profiler::ShowTimeline(const vector<TimelineScope>& scopes, float timeline_ms) const
+{
+    if (timeline_ms <= 0.0f)
+        return;
+
+    // Each nesting level is a row and each scope is placed where it falls within the frame
+    uint32_t depth_max = 0;
+    for (const TimelineScope& scope : scopes)
+    {
+        depth_max = Helper::Max(depth_max, scope.depth);
+    }
+
+    const float width       = ImGui::GetWindowContentRegionWidth();
+    const float row_height  = ImGui::GetTextLineHeightWithSpacing();
+    const auto& color       = ImGui::GetStyle().Colors[ImGuiCol_FrameBgActive];
+    const ImVec2 pos_screen = ImGui::GetCursorScreenPos();
+    ImDrawList* draw_list   = ImGui::GetWindowDrawList();
+
+    for (const TimelineScope& scope : scopes)
+    {
+        const float x_start = Helper::Saturate(scope.start_ms / timeline_ms) * width;
+        const float x_end   = Helper::Saturate((scope.start_ms + scope.duration_ms) / timeline_ms) * width;
+        const ImVec2 rect_min(pos_screen.x + x_start, pos_screen.y + scope.depth * row_height);
+        const ImVec2 rect_max(pos_screen.x + Helper::Max(x_end, x_start + 1.0f), rect_min.y + row_height - 1.0f);
+
+        // Rectangle
+        draw_list->AddRectFilled(rect_min, rect_max, IM_COL32(color.x * 255, color.y * 255, color.z * 255, 255));
+        draw_list->AddRect(rect_min, rect_max, IM_COL32(0, 0, 0, 255));
+
+        // Text (only if it fits)
+        if (ImGui::CalcTextSize(scope.name).x < rect_max.x - rect_min.x)
+        {
+            draw_list->AddText(rect_min, IM_COL32(255, 255, 255, 255), scope.name);
+        }
+
+        // Tooltip
+        if (ImGui::IsMouseHoveringRect(rect_min, rect_max))
+        {
+            ImGui::SetTooltip("%s - %.2f ms", scope.name, scope.duration_ms);
+        }
+    }
+
+    ImGui::Dummy(ImVec2(width, (depth_max + 1) * row_height));
+}
+
 void Widget_Profiler::ShowPlot(vector<float>& data, Metric& metric, float time_value, bool is_stuttering) const
 {
 	if (time_value >= 0.0f)
@@ -68,6 +68,8 @@ private:
 	void ShowCPU();
 	void ShowGPU();
     void ShowTimeBlock(const Spartan::TimeBlock& time_block, float total_time) const;
+    void ShowHitches() const;
+    void ShowTimeline(const std::vector<Spartan::TimelineScope>& scopes, float timeline_ms) const;
 	void ShowPlot(std::vector<float>& data, Metric& metric, float time_value, bool is_stuttering) const;
 
 	std::vector<float> m_plot_times_cpu;
@@ -567,7 +567,8 @@ void Widget_Properties::ShowCollider(Collider* collider) const
 			"Cylinder",
 			"Capsule",
 			"Cone",
-			"Mesh"
+			"Mesh",
+			"Static Mesh"
 		};
 		const char* shape_char_ptr		= type[static_cast<int>(collider->GetShapeType())].c_str();
 		bool optimize					= collider->GetOptimize();
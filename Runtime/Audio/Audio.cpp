@@ -21,21 +21,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =============================
 #include "Audio.h"
-#include <fmod.hpp>
-#include <fmod_errors.h>
-#include <sstream>
-#include "../Core/Engine.h"
-#include "../Core/EventSystem.h"
-#include "../Core/Settings.h"
-#include "../Core/Context.h"
-#include "../Profiling/Profiler.h"
+#include <algorithm>
 #include "../World/Components/Transform.h"
+#include "../World/Components/AudioSource.h"
 //========================================
 
-//= NAMESPACES ======
+//= NAMESPACES =====
 using namespace std;
-using namespace FMOD;
-//===================
+//==================
 
 namespace Spartan
 {
@@ -44,148 +37,106 @@ namespace Spartan
 
     }
 
-	Audio::~Audio()
+    void Audio::SetListenerTransform(Transform* transform)
 	{
-		// Unsubscribe from events
-		UNSUBSCRIBE_FROM_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; });
+		m_listener = transform;
+	}
 
-		if (!m_system_fmod)
+	void Audio::AddVoice(AudioSource* source)
+	{
+		const auto it = find_if(m_voices.begin(), m_voices.end(), [source](const AudioVoice& voice) { return voice.source == source; });
+		if (it != m_voices.end())
 			return;
 
-		// Close FMOD
-		m_result_fmod = m_system_fmod->close();
-		if (m_result_fmod != FMOD_OK)
-		{
-			LogErrorFmod(m_result_fmod);
-			return;
-		}
+		AudioVoice voice;
+		voice.source = source;
 
-		// Release FMOD
-		m_result_fmod = m_system_fmod->release();
-		if (m_result_fmod != FMOD_OK)
+		// Start right away if a channel is free, otherwise the next update decides
+		if (m_voice_count_real < m_max_voices_real && source->PlayReal())
 		{
-			LogErrorFmod(m_result_fmod);
+			voice.real = true;
+			m_voice_count_real++;
 		}
-	}
 
-    bool Audio::Initialize()
-    {
-        // Create FMOD instance
-        m_result_fmod = System_Create(&m_system_fmod);
-        if (m_result_fmod != FMOD_OK)
-        {
-            LogErrorFmod(m_result_fmod);
-            return false;
-        }
-
-        // Check FMOD version
-        uint32_t version;
-        m_result_fmod = m_system_fmod->getVersion(&version);
-        if (m_result_fmod != FMOD_OK)
-        {
-            LogErrorFmod(m_result_fmod);
-            return false;
-        }
-
-        if (version < FMOD_VERSION)
-        {
-            LogErrorFmod(m_result_fmod);
-            return false;
-        }
-
-        // Make sure there is a sound card devices on the machine
-        auto driver_count = 0;
-        m_result_fmod = m_system_fmod->getNumDrivers(&driver_count);
-        if (m_result_fmod != FMOD_OK)
-        {
-            LogErrorFmod(m_result_fmod);
-            return false;
-        }
-
-        // Initialize FMOD
-        m_result_fmod = m_system_fmod->init(m_max_channels, FMOD_INIT_NORMAL, nullptr);
-        if (m_result_fmod != FMOD_OK)
-        {
-            LogErrorFmod(m_result_fmod);
-            return false;
-        }
-
-        // Set 3D settings
-        m_result_fmod = m_system_fmod->set3DSettings(1.0, m_distance_entity, 0.0f);
-        if (m_result_fmod != FMOD_OK)
-        {
-            LogErrorFmod(m_result_fmod);
-            return false;
-        }
-
-        m_initialized = true;
-
-        // Get version
-        stringstream ss;
-        ss << hex << version;
-        const auto major = ss.str().erase(1, 4);
-        const auto minor = ss.str().erase(0, 1).erase(2, 2);
-        const auto rev = ss.str().erase(0, 3);
-        m_context->GetSubsystem<Settings>()->RegisterThirdPartyLib("FMOD", major + "." + minor + "." + rev, "https://www.fmod.com/download");
-
-        // Get dependencies
-        m_profiler = m_context->GetSubsystem<Profiler>();
-
-        // Subscribe to events
-        SUBSCRIBE_TO_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; });
-   
-        return true;
-    }
+		m_voices.emplace_back(voice);
+	}
 
-	void Audio::Tick(float delta_time)
+	void Audio::RemoveVoice(AudioSource* source)
 	{
-		// Don't play audio if the engine is not in game mode
-		if (!m_context->m_engine->EngineMode_IsSet(Engine_Game))
+		const auto it = find_if(m_voices.begin(), m_voices.end(), [source](const AudioVoice& voice) { return voice.source == source; });
+		if (it == m_voices.end())
 			return;
 
-		if (!m_initialized)
-			return;
+		m_voice_count_real -= it->real ? 1 : 0;
+		*it = m_voices.back();
+		m_voices.pop_back();
+	}
 
-        SCOPED_TIME_BLOCK(m_profiler);
+	void Audio::UpdateVoices(const float delta_time)
+	{
+		const Math::Vector3 listener_position = m_listener ? m_listener->GetPosition() : Math::Vector3::Zero;
 
-		// Update FMOD
-		m_result_fmod = m_system_fmod->update();
-		if (m_result_fmod != FMOD_OK)
+		// Advance and score
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_voices.size());)
 		{
-			LogErrorFmod(m_result_fmod);
-			return;
+			AudioVoice& voice	= m_voices[i];
+			voice.age			+= delta_time;
+
+			// Real voices end when their channel does, virtual ones when their logical playback does
+			const bool playing = voice.real ? voice.source->IsPlayingReal() : voice.source->Advance(delta_time);
+			if (!playing)
+			{
+				m_voice_count_real -= voice.real ? 1 : 0;
+				voice = m_voices.back();
+				m_voices.pop_back();
+				continue;
+			}
+
+			// Priority (0 is the most important) comes first, then how loud the voice is. Newer voices and the
+			// ones which are already real are slightly preferred, so that voices of similar loudness don't swap every frame.
+			voice.audibility		= voice.source->GetAudibility(listener_position, m_listener != nullptr);
+			const float preference	= (voice.real ? 1.1f : 1.0f) / (1.0f + voice.age * 0.01f);
+			voice.score				= static_cast<float>(255 - voice.source->GetPriority()) + Math::Helper::Min(voice.audibility * preference, 0.999f);
+
+			i++;
+		}
+
+		// Keep the highest scoring (audible) voices at the front
+		const uint32_t real_count = Math::Helper::Min(m_max_voices_real, static_cast<uint32_t>(m_voices.size()));
+		if (real_count < m_voices.size())
+		{
+			nth_element(m_voices.begin(), m_voices.begin() + real_count, m_voices.end(), [](const AudioVoice& a, const AudioVoice& b) { return a.score > b.score; });
 		}
 
-		if (m_listener)
+		// Release channels first, so that they can be given to the voices which become real
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_voices.size()); i++)
 		{
-			auto position = m_listener->GetPosition();
-			auto velocity = Math::Vector3::Zero;
-			auto forward = m_listener->GetForward();
-			auto up = m_listener->GetUp();
-
-			// Set 3D attributes
-			m_result_fmod = m_system_fmod->set3DListenerAttributes(
-				0, 
-				reinterpret_cast<FMOD_VECTOR*>(&position), 
-				reinterpret_cast<FMOD_VECTOR*>(&velocity), 
-				reinterpret_cast<FMOD_VECTOR*>(&forward), 
-				reinterpret_cast<FMOD_VECTOR*>(&up)
-			);
-			if (m_result_fmod != FMOD_OK)
+			AudioVoice& voice = m_voices[i];
+			if (voice.real && (i >= real_count || voice.audibility <= 0.0f))
 			{
-				LogErrorFmod(m_result_fmod);
-				return;
+				voice.source->PlayVirtual();
+				voice.real = false;
+				m_voice_count_real--;
 			}
 		}
-	}
 
-    void Audio::SetListenerTransform(Transform* transform)
-	{
-		m_listener = transform;
-	}
+		// Acquire channels and update the real voices in one pass
+		for (uint32_t i = 0; i < real_count; i++)
+		{
+			AudioVoice& voice = m_voices[i];
+			if (voice.audibility <= 0.0f)
+				continue;
 
-	void Audio::LogErrorFmod(int error) const
-	{
-		LOG_ERROR("%s", FMOD_ErrorString(static_cast<FMOD_RESULT>(error)));
+			if (!voice.real)
+			{
+				if (!voice.source->PlayReal())
+					continue;
+
+				voice.real = true;
+				m_voice_count_real++;
+			}
+
+			voice.source->UpdateReal();
+		}
 	}
 }
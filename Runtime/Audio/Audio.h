@@ -22,21 +22,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ==================
+#include <vector>
+#include <functional>
 #include "../Core/ISubsystem.h"
 //=============================
 
-//= FORWARD DECLARATIONS =
-namespace FMOD
-{
-	class System;
-}
-//========================
-
 namespace Spartan
 {
 	class Transform;
 	class Profiler;
+	class AudioSource;
 
+	// The backend is chosen at build time (API_AUDIO_FMOD or API_AUDIO_SOFTWARE), see Audio/FMOD and Audio/Software
 	class Audio : public ISubsystem
 	{
 	public:
@@ -48,18 +45,49 @@ namespace Spartan
         void Tick(float delta_time) override;
         //===================================
 
-		auto GetSystemFMOD() const { return m_system_fmod; }
+		// The backend's device, FMOD::System or AudioMixer
+		void* GetDevice() const { return m_device; }
 		void SetListenerTransform(Transform* transform);
 
+		// Every playing source is a voice, only the most audible ones get a real channel, the rest play virtually
+		void AddVoice(AudioSource* source);
+		void RemoveVoice(AudioSource* source);
+		void SetMaxVoicesReal(const uint32_t count)	{ m_max_voices_real = count < m_max_channels ? count : m_max_channels; }
+		uint32_t GetMaxVoicesReal()			const	{ return m_max_voices_real; }
+		uint32_t GetVoiceCount()			const	{ return static_cast<uint32_t>(m_voices.size()); }
+		uint32_t GetVoiceCountReal()		const	{ return m_voice_count_real; }
+
+		// Offline rendering (software backend only), mixes the next frames as interleaved stereo
+		bool Render(float* frames, uint32_t frame_count);
+		// Receives every block which is mixed while ticking (software backend only), e.g. to feed a device or capture the output
+		void SetOutputCallback(const std::function<void(const float*, uint32_t)>& callback) { m_output_callback = callback; }
+		uint32_t GetSampleRate() const { return m_sample_rate; }
+
 	private:
-		void LogErrorFmod(int error) const;
+		struct AudioVoice
+		{
+			AudioSource* source	= nullptr;
+			float score			= 0.0f;
+			float audibility	= 0.0f;
+			float age			= 0.0f;
+			bool real			= false;
+		};
+
+		void UpdateVoices(float delta_time);
+		void UpdateListener();
 
-		uint32_t m_result_fmod		= 0;
 		uint32_t m_max_channels		= 32;
+		uint32_t m_sample_rate		= 48000;
 		float m_distance_entity		= 1.0f;
 		bool m_initialized			= false;
 		Transform* m_listener		= nullptr;
+		uint32_t m_max_voices_real	= 32;
+		uint32_t m_voice_count_real	= 0;
+		std::vector<AudioVoice> m_voices;
+		std::function<void(const float*, uint32_t)> m_output_callback;
+		std::vector<float> m_output;
+		float m_output_frames_pending = 0.0f;
 		Profiler* m_profiler		= nullptr;
-		FMOD::System* m_system_fmod = nullptr;
+		void* m_device				= nullptr;
 	};
 }
@@ -26,18 +26,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Math/Vector3.h"
 //================================
 
-//= FWD DECLARATIONS =
-namespace FMOD
-{
-	class System;
-	class Sound;
-	class Channel;
-}
-//====================
-
 namespace Spartan
 {
 	class Transform;
+	class Audio;
 
 	enum PlayMode
 	{
@@ -62,7 +54,8 @@ namespace Spartan
         bool SaveToFile(const std::string& file_path) override;
         //=======================================================
 
-		bool Play();
+		// Plays from the given position (in seconds)
+		bool Play(float position = 0.0f);
 		bool Pause();
 		bool Stop();
 
@@ -95,25 +88,31 @@ namespace Spartan
 		bool Update();
 
 		bool IsPlaying();
+		bool IsLooping() const { return m_loop; }
+
+		// Playback position and length, in seconds
+		float GetPosition();
+		float GetLength();
+
+		float GetMinDistance() const { return m_minDistance; }
+		float GetMaxDistance() const { return m_maxDistance; }
 
 	private:
 		//= CREATION ===================================
 		bool CreateSound(const std::string& file_path);
 		bool CreateStream(const std::string& file_path);
 		//==============================================
-		int GetSoundMode() const;
-		void LogErrorFmod(int error) const;
+		void ReleaseSound();
 		bool IsChannelValid() const;
 
 		Transform* m_transform;
-		FMOD::System* m_systemFMOD;
-		FMOD::Sound* m_soundFMOD;
-		FMOD::Channel* m_channelFMOD;	
+		Audio* m_audio;
+		void* m_sound;		// FMOD::Sound or AudioSample, depending on the backend
+		void* m_channel;	// FMOD::Channel or AudioMixerVoice, depending on the backend
 		PlayMode m_playMode;
-		int m_modeLoop;
+		bool m_loop;
 		float m_minDistance;
 		float m_maxDistance;
-		int m_modeRolloff;
-		int m_result;
+		Rolloff m_rolloff;
 	};
 }
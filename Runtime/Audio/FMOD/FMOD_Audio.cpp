@@ -0,0 +1,195 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================================
+#include "../Audio.h"
+#include <fmod.hpp>
+#include <fmod_errors.h>
+#include <sstream>
+#include "../../Core/Engine.h"
+#include "../../Core/EventSystem.h"
+#include "../../Core/Settings.h"
+#include "../../Core/Context.h"
+#include "../../Profiling/Profiler.h"
+#include "../../World/Components/Transform.h"
+//===========================================
+
+//= NAMESPACES ======
+using namespace std;
+using namespace FMOD;
+//===================
+
+namespace Spartan
+{
+	static void log_error_fmod(const FMOD_RESULT result)
+	{
+		LOG_ERROR("%s", FMOD_ErrorString(result));
+	}
+
+	Audio::~Audio()
+	{
+		// Unsubscribe from events
+		UNSUBSCRIBE_FROM_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; m_voices.clear(); m_voice_count_real = 0; });
+
+		System* system_fmod = static_cast<System*>(m_device);
+		if (!system_fmod)
+			return;
+
+		// Close FMOD
+		FMOD_RESULT result = system_fmod->close();
+		if (result != FMOD_OK)
+		{
+			log_error_fmod(result);
+			return;
+		}
+
+		// Release FMOD
+		result = system_fmod->release();
+		if (result != FMOD_OK)
+		{
+			log_error_fmod(result);
+		}
+	}
+
+    bool Audio::Initialize()
+    {
+        // Create FMOD instance
+        System* system_fmod = nullptr;
+        FMOD_RESULT result = System_Create(&system_fmod);
+        if (result != FMOD_OK)
+        {
+            log_error_fmod(result);
+            return false;
+        }
+        m_device = system_fmod;
+
+        // Check FMOD version
+        uint32_t version;
+        result = system_fmod->getVersion(&version);
+        if (result != FMOD_OK)
+        {
+            log_error_fmod(result);
+            return false;
+        }
+
+        if (version < FMOD_VERSION)
+        {
+            log_error_fmod(result);
+            return false;
+        }
+
+        // Make sure there is a sound card devices on the machine
+        auto driver_count = 0;
+        result = system_fmod->getNumDrivers(&driver_count);
+        if (result != FMOD_OK)
+        {
+            log_error_fmod(result);
+            return false;
+        }
+
+        // Initialize FMOD
+        result = system_fmod->init(m_max_channels, FMOD_INIT_NORMAL, nullptr);
+        if (result != FMOD_OK)
+        {
+            log_error_fmod(result);
+            return false;
+        }
+
+        // Set 3D settings
+        result = system_fmod->set3DSettings(1.0, m_distance_entity, 0.0f);
+        if (result != FMOD_OK)
+        {
+            log_error_fmod(result);
+            return false;
+        }
+
+        m_initialized = true;
+
+        // Get version
+        stringstream ss;
+        ss << hex << version;
+        const auto major = ss.str().erase(1, 4);
+        const auto minor = ss.str().erase(0, 1).erase(2, 2);
+        const auto rev = ss.str().erase(0, 3);
+        m_context->GetSubsystem<Settings>()->RegisterThirdPartyLib("FMOD", major + "." + minor + "." + rev, "https://www.fmod.com/download");
+
+        // Get dependencies
+        m_profiler = m_context->GetSubsystem<Profiler>();
+
+        // Subscribe to events
+        SUBSCRIBE_TO_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; m_voices.clear(); m_voice_count_real = 0; });
+   
+        return true;
+    }
+
+	void Audio::Tick(float delta_time)
+	{
+		// Don't play audio if the engine is not in game mode
+		if (!m_context->m_engine->EngineMode_IsSet(Engine_Game))
+			return;
+
+		if (!m_initialized)
+			return;
+
+        SCOPED_TIME_BLOCK(m_profiler);
+
+		// Update FMOD
+		const FMOD_RESULT result = static_cast<System*>(m_device)->update();
+		if (result != FMOD_OK)
+		{
+			log_error_fmod(result);
+			return;
+		}
+
+		UpdateListener();
+		UpdateVoices(delta_time);
+	}
+
+	void Audio::UpdateListener()
+	{
+		if (!m_listener)
+			return;
+
+		auto position = m_listener->GetPosition();
+		auto velocity = Math::Vector3::Zero;
+		auto forward = m_listener->GetForward();
+		auto up = m_listener->GetUp();
+
+		// Set 3D attributes
+		const FMOD_RESULT result = static_cast<System*>(m_device)->set3DListenerAttributes(
+			0, 
+			reinterpret_cast<FMOD_VECTOR*>(&position), 
+			reinterpret_cast<FMOD_VECTOR*>(&velocity), 
+			reinterpret_cast<FMOD_VECTOR*>(&forward), 
+			reinterpret_cast<FMOD_VECTOR*>(&up)
+		);
+		if (result != FMOD_OK)
+		{
+			log_error_fmod(result);
+		}
+	}
+
+	bool Audio::Render(float* frames, uint32_t frame_count)
+	{
+		LOG_ERROR("Offline rendering requires the software audio backend");
+		return false;
+	}
+}
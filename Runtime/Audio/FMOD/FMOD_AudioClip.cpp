@@ -0,0 +1,294 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================================
+#include "../AudioClip.h"
+#include <fmod.hpp>
+#include <fmod_errors.h>
+#include "../Audio.h"
+#include "../../World/Components/Transform.h"
+//============================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+using namespace FMOD;
+//=============================
+
+namespace Spartan
+{
+	static bool handle_result(const FMOD_RESULT result)
+	{
+		if (result == FMOD_OK)
+			return true;
+
+		LOG_ERROR("%s", FMOD_ErrorString(result));
+		return false;
+	}
+
+	static FMOD_MODE get_sound_mode(const bool loop, const Rolloff rolloff)
+	{
+		return FMOD_3D | (loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF) | (rolloff == Custom ? FMOD_3D_CUSTOMROLLOFF : FMOD_3D_LINEARROLLOFF);
+	}
+
+    bool AudioClip::Play(const float position /*= 0.0f*/)
+	{
+		// Check if the sound is playing
+		if (IsChannelValid())
+		{
+			auto is_playing = false;
+			if (!handle_result(static_cast<Channel*>(m_channel)->isPlaying(&is_playing)))
+				return false;
+	
+			// If it's already playing, don't bother
+			if (is_playing)
+				return true;
+		}
+
+		// Start the sound paused, so that it can be positioned before it's heard
+		Channel* channel = nullptr;
+		if (!handle_result(static_cast<System*>(m_audio->GetDevice())->playSound(static_cast<Sound*>(m_sound), nullptr, true, &channel)))
+			return false;
+		m_channel = channel;
+
+		if (position > 0.0f)
+		{
+			handle_result(channel->setPosition(static_cast<uint32_t>(position * 1000.0f), FMOD_TIMEUNIT_MS));
+		}
+
+		return handle_result(channel->setPaused(false));
+	}
+
+	bool AudioClip::Pause()
+	{
+		if (!IsChannelValid())
+			return true;
+
+		// Get sound paused state
+		auto is_paused = false;
+		if (!handle_result(static_cast<Channel*>(m_channel)->getPaused(&is_paused)))
+			return false;
+
+		// If it's already paused, don't bother
+		if (!is_paused)
+			return true;
+
+		// Pause the sound
+		return handle_result(static_cast<Channel*>(m_channel)->setPaused(true));
+	}
+
+	bool AudioClip::Stop()
+	{
+		if (!IsChannelValid())
+			return true;
+
+		// If it's already stopped, don't bother
+		if (!IsPlaying())
+			return true;
+
+		// Stop the sound
+		const FMOD_RESULT result = static_cast<Channel*>(m_channel)->stop();
+		m_channel = nullptr;
+
+		return handle_result(result);
+	}
+
+	bool AudioClip::SetLoop(const bool loop)
+	{
+		m_loop = loop;
+
+		if (!m_sound)
+			return false;
+
+		// Infinite loops
+		if (loop)
+		{
+			static_cast<Sound*>(m_sound)->setLoopCount(-1);
+		}
+
+		// Set the channel with the new mode
+		return handle_result(static_cast<Sound*>(m_sound)->setMode(get_sound_mode(m_loop, m_rolloff)));
+	}
+
+	bool AudioClip::SetVolume(float volume)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		return handle_result(static_cast<Channel*>(m_channel)->setVolume(volume));
+	}
+
+	bool AudioClip::SetMute(const bool mute)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		return handle_result(static_cast<Channel*>(m_channel)->setMute(mute));
+	}
+
+	bool AudioClip::SetPriority(const int priority)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		return handle_result(static_cast<Channel*>(m_channel)->setPriority(priority));
+	}
+
+	bool AudioClip::SetPitch(const float pitch)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		return handle_result(static_cast<Channel*>(m_channel)->setPitch(pitch));
+	}
+
+	bool AudioClip::SetPan(const float pan)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		return handle_result(static_cast<Channel*>(m_channel)->setPan(pan));
+	}
+
+	bool AudioClip::SetRolloff(const vector<Vector3>& curve_points)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		SetRolloff(Custom);
+
+		// Convert Vector3 to FMOD_VECTOR
+		vector<FMOD_VECTOR> fmod_curve;
+		for (const auto& point : curve_points)
+		{
+			fmod_curve.push_back(FMOD_VECTOR{ point.x, point.y, point.z });
+		}
+
+		return handle_result(static_cast<Channel*>(m_channel)->set3DCustomRolloff(&fmod_curve.front(), static_cast<int>(fmod_curve.size())));
+	}
+
+	bool AudioClip::SetRolloff(const Rolloff rolloff)
+	{
+		m_rolloff = rolloff;
+		return true;
+	}
+
+	bool AudioClip::Update()
+	{
+		if (!IsChannelValid() || !m_transform)
+			return true;
+
+		const auto pos = m_transform->GetPosition();
+
+		FMOD_VECTOR f_mod_pos = { pos.x, pos.y, pos.z };
+		FMOD_VECTOR f_mod_vel = { 0, 0, 0 };
+
+		// Set 3D attributes
+		if (!handle_result(static_cast<Channel*>(m_channel)->set3DAttributes(&f_mod_pos, &f_mod_vel)))
+		{
+			m_channel = nullptr;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool AudioClip::IsPlaying()
+	{
+		if (!IsChannelValid())
+			return false;
+
+		auto is_playing = false;
+		if (!handle_result(static_cast<Channel*>(m_channel)->isPlaying(&is_playing)))
+			return false;
+
+		return is_playing;
+	}
+
+	float AudioClip::GetPosition()
+	{
+		if (!IsChannelValid())
+			return 0.0f;
+
+		uint32_t position = 0;
+		if (!handle_result(static_cast<Channel*>(m_channel)->getPosition(&position, FMOD_TIMEUNIT_MS)))
+			return 0.0f;
+
+		return static_cast<float>(position) / 1000.0f;
+	}
+
+	float AudioClip::GetLength()
+	{
+		if (!m_sound)
+			return 0.0f;
+
+		uint32_t length = 0;
+		if (!handle_result(static_cast<Sound*>(m_sound)->getLength(&length, FMOD_TIMEUNIT_MS)))
+			return 0.0f;
+
+		return static_cast<float>(length) / 1000.0f;
+	}
+
+	//= CREATION ================================================
+	bool AudioClip::CreateSound(const string& file_path)
+	{
+		// Create sound
+		Sound* sound = nullptr;
+		if (!handle_result(static_cast<System*>(m_audio->GetDevice())->createSound(file_path.c_str(), get_sound_mode(m_loop, m_rolloff), nullptr, &sound)))
+			return false;
+		m_sound = sound;
+
+		// Set 3D min max distance
+		return handle_result(sound->set3DMinMaxDistance(m_minDistance, m_maxDistance));
+	}
+
+	bool AudioClip::CreateStream(const string& file_path)
+	{
+		// Create sound
+		Sound* sound = nullptr;
+		if (!handle_result(static_cast<System*>(m_audio->GetDevice())->createStream(file_path.c_str(), get_sound_mode(m_loop, m_rolloff), nullptr, &sound)))
+			return false;
+		m_sound = sound;
+
+		// Set 3D min max distance
+		return handle_result(sound->set3DMinMaxDistance(m_minDistance, m_maxDistance));
+	}
+
+	void AudioClip::ReleaseSound()
+	{
+		if (!m_sound)
+			return;
+
+		handle_result(static_cast<Sound*>(m_sound)->release());
+		m_sound = nullptr;
+	}
+
+	bool AudioClip::IsChannelValid() const
+	{
+		if (!m_channel)
+			return false;
+
+		// Do a query and see if it fails or not
+		bool value;
+		return static_cast<Channel*>(m_channel)->isPlaying(&value) == FMOD_OK;
+	}
+	//===========================================================
+}
@@ -0,0 +1,180 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============
+#include "AudioDecoder.h"
+#include <cstring>
+#include "../../Logging/Log.h"
+//==========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	static const uint16_t WAVE_FORMAT_PCM			= 0x0001;
+	static const uint16_t WAVE_FORMAT_IEEE_FLOAT	= 0x0003;
+	static const uint16_t WAVE_FORMAT_EXTENSIBLE	= 0xFFFE;
+
+	template<typename T>
+	static bool read_value(ifstream& file, T* value)
+	{
+		file.read(reinterpret_cast<char*>(value), sizeof(T));
+		return file.good();
+	}
+
+	bool AudioDecoder::Open(const string& file_path)
+	{
+		m_file.open(file_path, ios::in | ios::binary);
+		if (!m_file.is_open())
+		{
+			LOG_ERROR("Failed to open \"%s\"", file_path.c_str());
+			return false;
+		}
+
+		char riff[4]	= {};
+		char wave[4]	= {};
+		uint32_t size	= 0;
+		m_file.read(riff, 4);
+		read_value(m_file, &size);
+		m_file.read(wave, 4);
+		if (!m_file.good() || memcmp(riff, "RIFF", 4) != 0 || memcmp(wave, "WAVE", 4) != 0)
+		{
+			LOG_ERROR("\"%s\" is not a WAVE file, only WAVE files are supported", file_path.c_str());
+			return false;
+		}
+
+		// Walk the chunks, the format and the data can be in any order
+		bool has_format		= false;
+		bool has_data		= false;
+		uint32_t data_size	= 0;
+		while (m_file.good())
+		{
+			char id[4]				= {};
+			uint32_t chunk_size		= 0;
+			m_file.read(id, 4);
+			if (!read_value(m_file, &chunk_size))
+				break;
+
+			const streampos chunk_start = m_file.tellg();
+
+			if (memcmp(id, "fmt ", 4) == 0)
+			{
+				uint16_t channel_count	= 0;
+				uint32_t byte_rate		= 0;
+				uint16_t block_align	= 0;
+				read_value(m_file, &m_format);
+				read_value(m_file, &channel_count);
+				read_value(m_file, &m_sample_rate);
+				read_value(m_file, &byte_rate);
+				read_value(m_file, &block_align);
+				read_value(m_file, &m_bits_per_sample);
+
+				// The actual format of an extensible file is the first two bytes of its sub format
+				if (m_format == WAVE_FORMAT_EXTENSIBLE && chunk_size >= 26)
+				{
+					m_file.seekg(chunk_start + streamoff(24));
+					read_value(m_file, &m_format);
+				}
+
+				m_channel_count	= channel_count;
+				m_frame_size	= block_align;
+				has_format		= true;
+			}
+			else if (memcmp(id, "data", 4) == 0)
+			{
+				m_data_offset	= static_cast<uint64_t>(chunk_start);
+				data_size		= chunk_size;
+				has_data		= true;
+			}
+
+			// Chunks are padded to an even size
+			m_file.seekg(chunk_start + streamoff(chunk_size + (chunk_size & 1)));
+		}
+
+		const bool format_integer	= m_format == WAVE_FORMAT_PCM && (m_bits_per_sample == 8 || m_bits_per_sample == 16 || m_bits_per_sample == 24 || m_bits_per_sample == 32);
+		const bool format_float		= m_format == WAVE_FORMAT_IEEE_FLOAT && m_bits_per_sample == 32;
+		if (!has_format || !has_data || m_channel_count == 0 || (!format_integer && !format_float))
+		{
+			LOG_ERROR("\"%s\" uses an unsupported WAVE format", file_path.c_str());
+			return false;
+		}
+
+		// Frames are read and converted as tightly packed samples, a header which says otherwise can't be trusted
+		if (m_frame_size != m_channel_count * (m_bits_per_sample / 8))
+		{
+			LOG_ERROR("\"%s\" has a block align of %d, %d channels of %d bits need %d", file_path.c_str(), m_frame_size, m_channel_count, m_bits_per_sample, m_channel_count * (m_bits_per_sample / 8));
+			return false;
+		}
+
+		m_frame_count = data_size / m_frame_size;
+
+		m_file.clear();
+		return Seek(0);
+	}
+
+	uint32_t AudioDecoder::Read(float* frames, uint32_t frame_count)
+	{
+		frame_count = static_cast<uint32_t>(min<uint64_t>(frame_count, m_frame_count - m_frame_position));
+		if (frame_count == 0)
+			return 0;
+
+		m_buffer.resize(static_cast<size_t>(frame_count) * m_frame_size);
+		m_file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+		frame_count = static_cast<uint32_t>(m_file.gcount() / m_frame_size);
+		m_frame_position += frame_count;
+
+		const uint32_t sample_count		= frame_count * m_channel_count;
+		const uint32_t bytes_per_sample	= m_bits_per_sample / 8;
+		const uint8_t* data				= m_buffer.data();
+		for (uint32_t i = 0; i < sample_count; i++, data += bytes_per_sample)
+		{
+			if (m_format == WAVE_FORMAT_IEEE_FLOAT)
+			{
+				memcpy(&frames[i], data, sizeof(float));
+				continue;
+			}
+
+			switch (m_bits_per_sample)
+			{
+				case 8:  frames[i] = (static_cast<float>(data[0]) - 128.0f) / 128.0f; break; // unsigned
+				case 16: frames[i] = static_cast<float>(static_cast<int16_t>(data[0] | (data[1] << 8))) / 32768.0f; break;
+				case 24: frames[i] = static_cast<float>(static_cast<int32_t>((data[0] << 8) | (data[1] << 16) | (data[2] << 24)) >> 8) / 8388608.0f; break;
+				default: frames[i] = static_cast<float>(static_cast<int32_t>(data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24))) / 2147483648.0f; break;
+			}
+		}
+
+		return frame_count;
+	}
+
+	bool AudioDecoder::Seek(const uint64_t frame)
+	{
+		if (frame > m_frame_count)
+			return false;
+
+		m_file.clear();
+		m_file.seekg(static_cast<streamoff>(m_data_offset + frame * m_frame_size));
+		m_frame_position = frame;
+
+		return m_file.good();
+	}
+}
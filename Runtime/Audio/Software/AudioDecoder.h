@@ -0,0 +1,63 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <string>
+#include <vector>
+#include <fstream>
+#include "../../Core/EngineDefs.h"
+//=========================
+
+namespace Spartan
+{
+	// Decodes RIFF/WAVE files holding integer (8, 16, 24, 32 bit) or float (32 bit) PCM, into interleaved float frames
+	class SPARTAN_CLASS AudioDecoder
+	{
+	public:
+		AudioDecoder() = default;
+		~AudioDecoder() = default;
+
+		bool Open(const std::string& file_path);
+
+		// Reads up to frame_count frames from the current position, returns the number of frames read
+		uint32_t Read(float* frames, uint32_t frame_count);
+		bool Seek(uint64_t frame);
+
+		uint32_t GetChannelCount()	const { return m_channel_count; }
+		uint32_t GetSampleRate()	const { return m_sample_rate; }
+		uint64_t GetFrameCount()	const { return m_frame_count; }
+		uint64_t GetFramePosition()	const { return m_frame_position; }
+
+	private:
+		std::ifstream m_file;
+		std::vector<uint8_t> m_buffer;
+		uint16_t m_format			= 0;
+		uint16_t m_bits_per_sample	= 0;
+		uint32_t m_channel_count	= 0;
+		uint32_t m_sample_rate		= 0;
+		uint32_t m_frame_size		= 0;
+		uint64_t m_data_offset		= 0;
+		uint64_t m_frame_count		= 0;
+		uint64_t m_frame_position	= 0;
+	};
+}
@@ -0,0 +1,296 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================
+#include "AudioMixer.h"
+#include <cstring>
+#include <algorithm>
+#include "../../Math/Simd.h"
+#include "../../Logging/Log.h"
+//==============================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+	// Frames decoded at a time when loading a whole sample
+	static const uint32_t DECODE_BLOCK_SIZE = 4096;
+
+	// Volume at a distance, either from the custom curve or linear between the min and max distance
+	static float get_attenuation(const AudioMixerVoice& voice, const float distance)
+	{
+		if (!voice.rolloff.empty())
+		{
+			if (distance <= voice.rolloff.front().x)
+				return voice.rolloff.front().y;
+
+			for (size_t i = 1; i < voice.rolloff.size(); i++)
+			{
+				const Vector3& a = voice.rolloff[i - 1];
+				const Vector3& b = voice.rolloff[i];
+				if (distance <= b.x)
+					return b.x > a.x ? Helper::Lerp(a.y, b.y, (distance - a.x) / (b.x - a.x)) : b.y;
+			}
+
+			return voice.rolloff.back().y;
+		}
+
+		if (distance <= voice.distance_min)
+			return 1.0f;
+
+		if (distance >= voice.distance_max)
+			return 0.0f;
+
+		return (voice.distance_max - distance) / (voice.distance_max - voice.distance_min);
+	}
+
+	// Mono is played on both sides, anything with more channels than stereo plays its first two
+	static void to_stereo(const float* frames, const uint32_t channel_count, const uint32_t frame_count, float* frames_stereo)
+	{
+		for (uint32_t i = 0; i < frame_count; i++)
+		{
+			frames_stereo[i * 2 + 0] = frames[i * channel_count];
+			frames_stereo[i * 2 + 1] = frames[i * channel_count + (channel_count > 1 ? 1 : 0)];
+		}
+	}
+
+	// out += in * (gain_left, gain_right), over interleaved stereo
+	static void mix_add(float* out, const float* in, const uint32_t sample_count, const float gain_left, const float gain_right)
+	{
+		uint32_t i = 0;
+
+		#if defined(SPARTAN_SIMD_SSE)
+		const __m128 gain = _mm_setr_ps(gain_left, gain_right, gain_left, gain_right);
+		for (; i + 4 <= sample_count; i += 4)
+		{
+			_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), gain)));
+		}
+		#endif
+
+		for (; i < sample_count; i += 2)
+		{
+			out[i + 0] += in[i + 0] * gain_left;
+			out[i + 1] += in[i + 1] * gain_right;
+		}
+	}
+
+	bool AudioSample::Load(const string& file_path, const bool stream)
+	{
+		AudioDecoder decoder;
+		if (!decoder.Open(file_path))
+			return false;
+
+		this->file_path	= file_path;
+		this->stream	= stream;
+		channel_count	= decoder.GetChannelCount();
+		sample_rate		= decoder.GetSampleRate();
+		frame_count		= decoder.GetFrameCount();
+
+		if (stream)
+			return true;
+
+		frames.resize(static_cast<size_t>(frame_count) * channel_count);
+		uint64_t frame = 0;
+		while (frame < frame_count)
+		{
+			const uint32_t read = decoder.Read(&frames[static_cast<size_t>(frame) * channel_count], DECODE_BLOCK_SIZE);
+			if (read == 0)
+				break;
+
+			frame += read;
+		}
+
+		// A truncated file plays what it has
+		frame_count = frame;
+		frames.resize(static_cast<size_t>(frame_count) * channel_count);
+
+		return true;
+	}
+
+	AudioMixer::AudioMixer(const uint32_t sample_rate)
+	{
+		m_sample_rate = sample_rate;
+	}
+
+	AudioMixerVoice* AudioMixer::Play(const AudioSample* sample, const float position)
+	{
+		if (!sample || sample->frame_count == 0)
+			return nullptr;
+
+		auto voice		= make_unique<AudioMixerVoice>();
+		voice->sample	= sample;
+		voice->position	= Helper::Min(static_cast<double>(position) * sample->sample_rate, static_cast<double>(sample->frame_count - 1));
+
+		// Every voice of a streamed sample reads the file on its own
+		if (sample->stream)
+		{
+			voice->decoder = make_unique<AudioDecoder>();
+			if (!voice->decoder->Open(sample->file_path))
+				return nullptr;
+		}
+
+		lock_guard<mutex> lock(m_mutex);
+		m_voices.emplace_back(move(voice));
+		return m_voices.back().get();
+	}
+
+	void AudioMixer::Stop(AudioMixerVoice* voice)
+	{
+		lock_guard<mutex> lock(m_mutex);
+
+		const auto it = find_if(m_voices.begin(), m_voices.end(), [voice](const unique_ptr<AudioMixerVoice>& v) { return v.get() == voice; });
+		if (it == m_voices.end())
+			return;
+
+		*it = move(m_voices.back());
+		m_voices.pop_back();
+	}
+
+	void AudioMixer::SetListener(const Vector3& position, const Vector3& right)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_listener_position	= position;
+		m_listener_right	= right;
+	}
+
+	void AudioMixer::Render(float* frames, const uint32_t frame_count)
+	{
+		lock_guard<mutex> lock(m_mutex);
+
+		memset(frames, 0, static_cast<size_t>(frame_count) * 2 * sizeof(float));
+
+		for (const auto& voice : m_voices)
+		{
+			if (voice->playing && !voice->paused)
+			{
+				MixVoice(*voice, frames, frame_count);
+			}
+		}
+	}
+
+	void AudioMixer::MixVoice(AudioMixerVoice& voice, float* frames, const uint32_t frame_count)
+	{
+		const AudioSample& sample = *voice.sample;
+
+		// Gains are constant over the block
+		float attenuation	= 1.0f;
+		float pan			= voice.pan;
+		if (voice.spatial)
+		{
+			const Vector3 to_voice	= voice.position_world - m_listener_position;
+			const float distance	= to_voice.Length();
+			attenuation				= get_attenuation(voice, distance);
+
+			if (distance > Helper::M_EPSILON)
+			{
+				pan = Helper::Clamp(pan + (to_voice / distance).Dot(m_listener_right), -1.0f, 1.0f);
+			}
+		}
+		const float gain		= voice.mute ? 0.0f : voice.volume * attenuation;
+		const float gain_left	= gain * Helper::Min(1.0f, 1.0f - pan);
+		const float gain_right	= gain * Helper::Min(1.0f, 1.0f + pan);
+		const double step		= static_cast<double>(voice.pitch) * sample.sample_rate / m_sample_rate;
+
+		// Silent voices only advance
+		if (gain > 0.0f)
+		{
+			// Read the sample frames the block spans, plus one to interpolate towards
+			const uint64_t first		= static_cast<uint64_t>(voice.position);
+			const double offset			= voice.position - static_cast<double>(first);
+			const uint32_t source_count	= static_cast<uint32_t>(offset + step * (frame_count - 1)) + 2;
+			m_frames_source.resize(static_cast<size_t>(source_count) * 2);
+			ReadSample(voice, first, source_count, m_frames_source.data());
+
+			// Resample (linear)
+			m_frames_voice.resize(static_cast<size_t>(frame_count) * 2);
+			double position = offset;
+			for (uint32_t i = 0; i < frame_count; i++, position += step)
+			{
+				const uint32_t index	= static_cast<uint32_t>(position);
+				const float fraction	= static_cast<float>(position - index);
+				const float* a			= &m_frames_source[index * 2];
+				m_frames_voice[i * 2 + 0] = a[0] + (a[2] - a[0]) * fraction;
+				m_frames_voice[i * 2 + 1] = a[1] + (a[3] - a[1]) * fraction;
+			}
+
+			mix_add(frames, m_frames_voice.data(), frame_count * 2, gain_left, gain_right);
+		}
+
+		// Advance
+		voice.position += step * frame_count;
+		if (voice.position >= static_cast<double>(sample.frame_count))
+		{
+			if (voice.loop)
+			{
+				voice.position = fmod(voice.position, static_cast<double>(sample.frame_count));
+			}
+			else
+			{
+				voice.playing = false;
+			}
+		}
+	}
+
+	void AudioMixer::ReadSample(AudioMixerVoice& voice, const uint64_t frame_first, const uint32_t frame_count, float* frames_stereo)
+	{
+		const AudioSample& sample = *voice.sample;
+
+		for (uint32_t i = 0; i < frame_count;)
+		{
+			// Past the end, looping voices wrap and the rest is silence
+			uint64_t frame = frame_first + i;
+			if (frame >= sample.frame_count)
+			{
+				if (!voice.loop)
+				{
+					memset(frames_stereo + i * 2, 0, static_cast<size_t>(frame_count - i) * 2 * sizeof(float));
+					return;
+				}
+
+				frame %= sample.frame_count;
+			}
+
+			const uint32_t run = static_cast<uint32_t>(Helper::Min<uint64_t>(frame_count - i, sample.frame_count - frame));
+			if (!sample.stream)
+			{
+				to_stereo(&sample.frames[static_cast<size_t>(frame) * sample.channel_count], sample.channel_count, run, frames_stereo + i * 2);
+			}
+			else
+			{
+				// Blocks are read in order, so this only seeks when looping or when a block starts on the previous block's last frame
+				if (voice.decoder->GetFramePosition() != frame)
+				{
+					voice.decoder->Seek(frame);
+				}
+
+				m_frames_decoded.resize(static_cast<size_t>(run) * sample.channel_count);
+				const uint32_t read = voice.decoder->Read(m_frames_decoded.data(), run);
+				to_stereo(m_frames_decoded.data(), sample.channel_count, read, frames_stereo + i * 2);
+				memset(frames_stereo + (i + read) * 2, 0, static_cast<size_t>(run - read) * 2 * sizeof(float));
+			}
+
+			i += run;
+		}
+	}
+}
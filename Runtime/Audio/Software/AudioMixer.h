@@ -0,0 +1,99 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <memory>
+#include <vector>
+#include <mutex>
+#include "AudioDecoder.h"
+#include "../../Math/Vector3.h"
+//=============================
+
+namespace Spartan
+{
+	// Clip data shared by the voices that play it. Memory clips are decoded up front, streamed clips are decoded by every voice as it plays.
+	struct AudioSample
+	{
+		bool Load(const std::string& file_path, bool stream);
+
+		std::string file_path;
+		std::vector<float> frames; // interleaved, empty when streamed
+		uint32_t channel_count	= 0;
+		uint32_t sample_rate	= 0;
+		uint64_t frame_count	= 0;
+		bool stream				= false;
+	};
+
+	struct AudioMixerVoice
+	{
+		const AudioSample* sample = nullptr;
+		std::unique_ptr<AudioDecoder> decoder; // streamed samples only
+		double position			= 0.0; // in sample frames
+		float volume			= 1.0f;
+		float pitch				= 1.0f;
+		float pan				= 0.0f;
+		bool mute				= false;
+		bool loop				= false;
+		bool paused				= false;
+		bool playing			= true;
+
+		// 3D
+		bool spatial					= false;
+		Math::Vector3 position_world	= Math::Vector3::Zero;
+		float distance_min				= 1.0f;
+		float distance_max				= 10000.0f;
+		std::vector<Math::Vector3> rolloff; // custom (distance, volume) curve, linear between the min and max distance when empty
+	};
+
+	// Mixes voices into interleaved stereo, with distance attenuation and panning relative to the listener.
+	// Voices stay allocated (and their pointers valid) until they are stopped, even after they finish playing.
+	class SPARTAN_CLASS AudioMixer
+	{
+	public:
+		AudioMixer(uint32_t sample_rate);
+		~AudioMixer() = default;
+
+		AudioMixerVoice* Play(const AudioSample* sample, float position);
+		void Stop(AudioMixerVoice* voice);
+		void SetListener(const Math::Vector3& position, const Math::Vector3& right);
+
+		// Mixes the next frame_count frames of every playing voice
+		void Render(float* frames, uint32_t frame_count);
+
+		uint32_t GetSampleRate()	const { return m_sample_rate; }
+		uint32_t GetVoiceCount()	const { return static_cast<uint32_t>(m_voices.size()); }
+
+	private:
+		void MixVoice(AudioMixerVoice& voice, float* frames, uint32_t frame_count);
+		void ReadSample(AudioMixerVoice& voice, uint64_t frame, uint32_t frame_count, float* frames_stereo);
+
+		uint32_t m_sample_rate				= 0;
+		Math::Vector3 m_listener_position	= Math::Vector3::Zero;
+		Math::Vector3 m_listener_right		= Math::Vector3::Right;
+		std::vector<std::unique_ptr<AudioMixerVoice>> m_voices;
+		std::vector<float> m_frames_source;
+		std::vector<float> m_frames_voice;
+		std::vector<float> m_frames_decoded;
+		std::mutex m_mutex;
+	};
+}
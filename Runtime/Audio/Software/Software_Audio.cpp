@@ -0,0 +1,108 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================================
+#include "../Audio.h"
+#include "AudioMixer.h"
+#include "../../Core/Engine.h"
+#include "../../Core/EventSystem.h"
+#include "../../Core/Context.h"
+#include "../../Profiling/Profiler.h"
+#include "../../World/Components/Transform.h"
+//===========================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	Audio::~Audio()
+	{
+		// Unsubscribe from events
+		UNSUBSCRIBE_FROM_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; m_voices.clear(); m_voice_count_real = 0; });
+
+		delete static_cast<AudioMixer*>(m_device);
+		m_device = nullptr;
+	}
+
+    bool Audio::Initialize()
+    {
+        // No device, the mixer renders on request (offline) or as the engine ticks
+        m_device		= new AudioMixer(m_sample_rate);
+        m_initialized	= true;
+
+        // Get dependencies
+        m_profiler = m_context->GetSubsystem<Profiler>();
+
+        // Subscribe to events
+        SUBSCRIBE_TO_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; m_voices.clear(); m_voice_count_real = 0; });
+
+        return true;
+    }
+
+	void Audio::Tick(float delta_time)
+	{
+		// Don't play audio if the engine is not in game mode
+		if (!m_context->m_engine->EngineMode_IsSet(Engine_Game))
+			return;
+
+		if (!m_initialized)
+			return;
+
+        SCOPED_TIME_BLOCK(m_profiler);
+
+		UpdateListener();
+		UpdateVoices(delta_time);
+
+		// Mix the frames this tick covers
+		m_output_frames_pending		+= delta_time * m_sample_rate;
+		const uint32_t frame_count	= static_cast<uint32_t>(m_output_frames_pending);
+		m_output_frames_pending		-= frame_count;
+		if (frame_count == 0)
+			return;
+
+		m_output.resize(static_cast<size_t>(frame_count) * 2);
+		static_cast<AudioMixer*>(m_device)->Render(m_output.data(), frame_count);
+
+		if (m_output_callback)
+		{
+			m_output_callback(m_output.data(), frame_count);
+		}
+	}
+
+	void Audio::UpdateListener()
+	{
+		if (!m_listener)
+			return;
+
+		static_cast<AudioMixer*>(m_device)->SetListener(m_listener->GetPosition(), m_listener->GetRight());
+	}
+
+	bool Audio::Render(float* frames, const uint32_t frame_count)
+	{
+		if (!m_device || !frames)
+			return false;
+
+		static_cast<AudioMixer*>(m_device)->Render(frames, frame_count);
+		return true;
+	}
+}
@@ -0,0 +1,233 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================================
+#include "../AudioClip.h"
+#include "../Audio.h"
+#include "AudioMixer.h"
+#include "../../World/Components/Transform.h"
+//============================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+    bool AudioClip::Play(const float position /*= 0.0f*/)
+	{
+		AudioMixer* mixer = static_cast<AudioMixer*>(m_audio->GetDevice());
+
+		// If it's already playing, don't bother
+		if (IsPlaying())
+			return true;
+
+		// A finished voice stays allocated until it's stopped
+		if (m_channel)
+		{
+			mixer->Stop(static_cast<AudioMixerVoice*>(m_channel));
+			m_channel = nullptr;
+		}
+
+		AudioMixerVoice* voice = mixer->Play(static_cast<AudioSample*>(m_sound), position);
+		if (!voice)
+			return false;
+
+		voice->loop			= m_loop;
+		voice->distance_min	= m_minDistance;
+		voice->distance_max	= m_maxDistance;
+		m_channel			= voice;
+
+		return true;
+	}
+
+	bool AudioClip::Pause()
+	{
+		if (!IsChannelValid())
+			return true;
+
+		static_cast<AudioMixerVoice*>(m_channel)->paused = true;
+		return true;
+	}
+
+	bool AudioClip::Stop()
+	{
+		if (!IsChannelValid())
+			return true;
+
+		static_cast<AudioMixer*>(m_audio->GetDevice())->Stop(static_cast<AudioMixerVoice*>(m_channel));
+		m_channel = nullptr;
+
+		return true;
+	}
+
+	bool AudioClip::SetLoop(const bool loop)
+	{
+		m_loop = loop;
+
+		if (!m_sound)
+			return false;
+
+		if (IsChannelValid())
+		{
+			static_cast<AudioMixerVoice*>(m_channel)->loop = loop;
+		}
+
+		return true;
+	}
+
+	bool AudioClip::SetVolume(const float volume)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		static_cast<AudioMixerVoice*>(m_channel)->volume = volume;
+		return true;
+	}
+
+	bool AudioClip::SetMute(const bool mute)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		static_cast<AudioMixerVoice*>(m_channel)->mute = mute;
+		return true;
+	}
+
+	bool AudioClip::SetPriority(const int priority)
+	{
+		// Every voice the mixer has is mixed, Audio already chose them by priority
+		return IsChannelValid();
+	}
+
+	bool AudioClip::SetPitch(const float pitch)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		static_cast<AudioMixerVoice*>(m_channel)->pitch = pitch;
+		return true;
+	}
+
+	bool AudioClip::SetPan(const float pan)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		static_cast<AudioMixerVoice*>(m_channel)->pan = pan;
+		return true;
+	}
+
+	bool AudioClip::SetRolloff(const vector<Vector3>& curve_points)
+	{
+		if (!IsChannelValid())
+			return false;
+
+		SetRolloff(Custom);
+		static_cast<AudioMixerVoice*>(m_channel)->rolloff = curve_points;
+
+		return true;
+	}
+
+	bool AudioClip::SetRolloff(const Rolloff rolloff)
+	{
+		m_rolloff = rolloff;
+		return true;
+	}
+
+	bool AudioClip::Update()
+	{
+		if (!IsChannelValid() || !m_transform)
+			return true;
+
+		AudioMixerVoice* voice	= static_cast<AudioMixerVoice*>(m_channel);
+		voice->spatial			= true;
+		voice->position_world	= m_transform->GetPosition();
+
+		return true;
+	}
+
+	bool AudioClip::IsPlaying()
+	{
+		return IsChannelValid() && static_cast<AudioMixerVoice*>(m_channel)->playing;
+	}
+
+	float AudioClip::GetPosition()
+	{
+		if (!IsChannelValid())
+			return 0.0f;
+
+		const AudioMixerVoice* voice = static_cast<AudioMixerVoice*>(m_channel);
+		return static_cast<float>(voice->position / voice->sample->sample_rate);
+	}
+
+	float AudioClip::GetLength()
+	{
+		const AudioSample* sample = static_cast<AudioSample*>(m_sound);
+		if (!sample || sample->sample_rate == 0)
+			return 0.0f;
+
+		return static_cast<float>(static_cast<double>(sample->frame_count) / sample->sample_rate);
+	}
+
+	//= CREATION ================================================
+	bool AudioClip::CreateSound(const string& file_path)
+	{
+		auto sample = new AudioSample();
+		if (!sample->Load(file_path, false))
+		{
+			delete sample;
+			return false;
+		}
+
+		m_sound = sample;
+		return true;
+	}
+
+	bool AudioClip::CreateStream(const string& file_path)
+	{
+		auto sample = new AudioSample();
+		if (!sample->Load(file_path, true))
+		{
+			delete sample;
+			return false;
+		}
+
+		m_sound = sample;
+		return true;
+	}
+
+	void AudioClip::ReleaseSound()
+	{
+		// Voices point to the sample
+		Stop();
+
+		delete static_cast<AudioSample*>(m_sound);
+		m_sound = nullptr;
+	}
+
+	bool AudioClip::IsChannelValid() const
+	{
+		return m_channel != nullptr;
+	}
+	//===========================================================
+}
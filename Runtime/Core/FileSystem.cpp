@@ -555,6 +555,11 @@ namespace Spartan
         return GetExtensionFromFilePath(path) == EXTENSION_AUDIO;
     }
 
+    bool FileSystem::IsEngineAnimationFile(const string& path)
+    {
+        return GetExtensionFromFilePath(path) == EXTENSION_ANIMATION;
+    }
+
     bool FileSystem::IsEngineShaderFile(const string& path)
 	{
 		return GetExtensionFromFilePath(path) == EXTENSION_SHADER;
@@ -570,6 +575,7 @@ namespace Spartan
                 IsEngineSceneFile(path)    ||
                 IsEngineTextureFile(path)  ||
                 IsEngineAudioFile(path)    ||
+                IsEngineAnimationFile(path) ||
                 IsEngineShaderFile(path);
     }
 
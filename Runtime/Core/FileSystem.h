@@ -79,6 +79,7 @@ namespace Spartan
 		static bool IsEngineSceneFile(const std::string& path);
 		static bool IsEngineTextureFile(const std::string& path);
         static bool IsEngineAudioFile(const std::string& path);
+        static bool IsEngineAnimationFile(const std::string& path);
 		static bool IsEngineShaderFile(const std::string& path);
         static bool IsEngineFile(const std::string& path);
 
@@ -101,6 +102,7 @@ namespace Spartan
     static const char* EXTENSION_TEXTURE   = ".texture";
     static const char* EXTENSION_MESH      = ".mesh";
     static const char* EXTENSION_AUDIO     = ".audio";
+    static const char* EXTENSION_ANIMATION = ".animation";
 
     static const std::vector<std::string> supported_formats_image
     {
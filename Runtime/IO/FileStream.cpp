@@ -21,8 +21,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =================
 #include "FileStream.h"
+#include <algorithm>
 #include "../Logging/Log.h"
 #include "../RHI/RHI_Vertex.h"
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
 //============================
 
 //= NAMESPACES =====
@@ -31,10 +41,59 @@ using namespace std;
 
 namespace Spartan
 {
+	namespace
+	{
+		constexpr uint64_t buffer_size_write	= 256 * 1024;
+		constexpr uint64_t buffer_size_read		= 1024 * 1024;
+		constexpr uint32_t checksum_magic		= 0x4B435053; // "SPCK"
+		constexpr uint64_t checksum_footer_size	= sizeof(uint64_t) + sizeof(uint32_t);
+		constexpr uint64_t checksum_basis		= 0xCBF29CE484222325;
+
+		// FNV-1a over 64-bit words (bytes for the tail), pieces must be multiples of 8 bytes except for the last one
+		inline uint64_t checksum_update(uint64_t hash, const std::byte* data, const uint64_t size)
+		{
+			constexpr uint64_t prime = 0x100000001B3;
+
+			uint64_t i = 0;
+			for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+			{
+				uint64_t word;
+				memcpy(&word, data + i, sizeof(uint64_t));
+				hash = (hash ^ word) * prime;
+			}
+
+			for (; i < size; i++)
+			{
+				hash = (hash ^ static_cast<uint64_t>(data[i])) * prime;
+			}
+
+			return hash;
+		}
+
+		// Hashes the first size bytes of a stream
+		inline uint64_t checksum_compute(ifstream& stream, uint64_t size)
+		{
+			uint64_t hash = checksum_basis;
+			vector<std::byte> chunk(static_cast<size_t>(min(size, buffer_size_read)));
+
+			stream.seekg(0, ios::beg);
+			while (size > 0)
+			{
+				const uint64_t count = min(size, static_cast<uint64_t>(chunk.size()));
+				stream.read(reinterpret_cast<char*>(chunk.data()), count);
+				hash = checksum_update(hash, chunk.data(), count);
+				size -= count;
+			}
+
+			return hash;
+		}
+	}
+
 	FileStream::FileStream(const string& path, uint32_t flags)
 	{
 		m_is_open	= false;
 		m_flags		= flags;
+		m_path		= path;
 
 		int ios_flags	= ios::binary;
 		ios_flags		|= (flags & FileStream_Read)	? ios::in	: 0;
@@ -49,6 +108,16 @@ namespace Spartan
 				LOG_ERROR("Failed to open \"%s\" for writing", path.c_str());
 				return;
 			}
+
+			if (m_flags & FileStream_Append)
+			{
+				out.seekp(0, ios::end);
+				m_data_offset = static_cast<uint64_t>(out.tellp());
+			}
+
+			m_buffer.resize(buffer_size_write);
+			m_data		= m_buffer.data();
+			m_data_size	= m_buffer.size();
 		}
 		else if (m_flags & FileStream_Read)
 		{
@@ -58,6 +127,31 @@ namespace Spartan
 				LOG_ERROR("Failed to open \"%s\" for reading", path.c_str());
 				return;
 			}
+
+			in.seekg(0, ios::end);
+			m_file_size = static_cast<uint64_t>(in.tellg());
+			in.seekg(0, ios::beg);
+
+			// Map first, so that the checksum is computed over the view instead of being read through the stream
+			const bool mapped = (m_flags & FileStream_Map) && Map(path);
+
+			if ((m_flags & FileStream_Checksum) && !VerifyChecksum())
+			{
+				Unmap();
+				return;
+			}
+
+			if (mapped)
+			{
+				m_data		= m_map_data;
+				m_data_size	= m_file_size;
+			}
+			else
+			{
+				m_buffer.resize(static_cast<size_t>(min(m_file_size, buffer_size_read)));
+				m_data		= m_buffer.data();
+				m_data_size	= 0;
+			}
 		}
 
 		m_is_open = true;
@@ -70,24 +164,340 @@ namespace Spartan
 
 	void FileStream::Close()
 	{
+		if (!m_is_open)
+			return;
+
 		if (m_flags & FileStream_Write)
 		{
+			Flush();
 			out.flush();
 			out.close();
+
+			if (m_flags & FileStream_Checksum)
+			{
+				AppendChecksum();
+			}
 		}
 		else if (m_flags & FileStream_Read)
 		{
 			in.clear();
 			in.close();
+			Unmap();
+		}
+
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+		m_data		= nullptr;
+		m_data_size	= 0;
+		m_cursor	= 0;
+		m_is_open	= false;
+	}
+
+	uint64_t FileStream::GetPosition()
+	{
+		return m_data_offset + m_cursor;
+	}
+
+	void FileStream::Seek(const uint64_t position)
+	{
+		if (m_flags & FileStream_Write)
+		{
+			Flush();
+			out.seekp(static_cast<streamoff>(position), ios::beg);
+			m_data_offset = position;
+		}
+		else if (m_flags & FileStream_Read)
+		{
+			// Move within the window if possible, otherwise the next read refills it
+			if (m_map_data)
+			{
+				m_cursor = min(position, m_data_size);
+			}
+			else if (position >= m_data_offset && position <= m_data_offset + m_data_size)
+			{
+				m_cursor = position - m_data_offset;
+			}
+			else
+			{
+				m_data_offset	= position;
+				m_data_size		= 0;
+				m_cursor		= 0;
+			}
+		}
+	}
+
+	void FileStream::Skip(uint32_t n)
+	{
+		// Set the seek cursor to offset n from the current position
+		if (m_flags & FileStream_Write)
+		{
+			Flush();
+			out.seekp(n, ios::cur);
+			m_data_offset += n;
+		}
+		else if (m_flags & FileStream_Read)
+		{
+			Seek(GetPosition() + n);
+		}
+	}
+
+	void FileStream::Align(const uint32_t alignment)
+	{
+		if (alignment == 0)
+			return;
+
+		const uint32_t padding = static_cast<uint32_t>((alignment - GetPosition() % alignment) % alignment);
+
+		if (m_flags & FileStream_Write)
+		{
+			static const std::byte zeros[256] = {};
+			for (uint32_t written = 0; written < padding; written += sizeof(zeros))
+			{
+				WriteBytes(zeros, min(padding - written, static_cast<uint32_t>(sizeof(zeros))));
+			}
+		}
+		else if (m_flags & FileStream_Read)
+		{
+			Skip(padding);
+		}
+	}
+
+	void FileStream::WriteBytesSlow(const void* data, const uint64_t size)
+	{
+		if (!m_is_open || !(m_flags & FileStream_Write))
+			return;
+
+		Flush();
+
+		// Large blocks go straight to the file
+		if (size >= m_data_size)
+		{
+			out.write(static_cast<const char*>(data), size);
+			m_data_offset += size;
+			return;
 		}
+
+		memcpy(m_data, data, size);
+		m_cursor = size;
+	}
+
+	void FileStream::ReadBytesSlow(void* data, uint64_t size)
+	{
+		auto destination = static_cast<std::byte*>(data);
+
+		// Drain what's left in the window
+		const uint64_t available = m_data_size > m_cursor ? m_data_size - m_cursor : 0;
+		if (available != 0)
+		{
+			memcpy(destination, m_data + m_cursor, available);
+			destination	+= available;
+			size		-= available;
+			m_cursor	+= available;
+		}
+
+		// Refill it (a map already holds the whole file)
+		if (m_is_open && !m_map_data && (m_flags & FileStream_Read))
+		{
+			const uint64_t position		= m_data_offset + m_cursor;
+			const uint64_t remaining	= position < m_file_size ? m_file_size - position : 0;
+			in.clear();
+			in.seekg(static_cast<streamoff>(position), ios::beg);
+
+			if (size >= m_buffer.size())
+			{
+				// Large blocks go straight to the destination
+				const uint64_t count = min(size, remaining);
+				in.read(reinterpret_cast<char*>(destination), count);
+				destination		+= count;
+				size			-= count;
+				m_data_offset	= position + count;
+				m_data_size		= 0;
+				m_cursor		= 0;
+			}
+			else
+			{
+				m_data_offset	= position;
+				m_data_size		= min(static_cast<uint64_t>(m_buffer.size()), remaining);
+				in.read(reinterpret_cast<char*>(m_data), m_data_size);
+
+				const uint64_t count = min(size, m_data_size);
+				memcpy(destination, m_data, count);
+				destination	+= count;
+				size		-= count;
+				m_cursor	= count;
+			}
+		}
+
+		// Past the end of the file
+		if (size != 0)
+		{
+			memset(destination, 0, size);
+
+			if (!m_read_overflow)
+			{
+				LOG_ERROR("Attempted to read past the end of \"%s\"", m_path.c_str());
+				m_read_overflow = true;
+			}
+		}
+	}
+
+	void FileStream::Flush()
+	{
+		if (!(m_flags & FileStream_Write) || m_cursor == 0)
+			return;
+
+		out.write(reinterpret_cast<const char*>(m_data), m_cursor);
+		m_data_offset	+= m_cursor;
+		m_cursor		= 0;
+	}
+
+	bool FileStream::Map(const string& path)
+	{
+		if (m_file_size == 0)
+			return false;
+
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_map_file		= file;
+		m_map_mapping	= mapping;
+#else
+		const int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		// The whole file is mapped, including a checksum footer (if any)
+		in.seekg(0, ios::end);
+		const auto size = static_cast<uint64_t>(in.tellg());
+		in.seekg(0, ios::beg);
+
+		void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (view == MAP_FAILED)
+			return false;
+
+		m_map_size = size;
+#endif
+
+		m_map_data = static_cast<std::byte*>(view);
+		return true;
+	}
+
+	void FileStream::Unmap()
+	{
+		if (!m_map_data)
+			return;
+
+#if defined(_WIN32)
+		UnmapViewOfFile(m_map_data);
+		CloseHandle(static_cast<HANDLE>(m_map_mapping));
+		CloseHandle(static_cast<HANDLE>(m_map_file));
+#else
+		munmap(m_map_data, m_map_size);
+#endif
+
+		m_map_data		= nullptr;
+		m_map_file		= nullptr;
+		m_map_mapping	= nullptr;
+		m_map_size		= 0;
+	}
+
+	bool FileStream::VerifyChecksum()
+	{
+		// Files without a footer are accepted as they are
+		if (m_file_size < checksum_footer_size)
+			return true;
+
+		uint64_t checksum				= 0;
+		uint32_t magic					= 0;
+		const uint64_t footer_offset	= m_file_size - checksum_footer_size;
+		if (m_map_data)
+		{
+			memcpy(&checksum, m_map_data + footer_offset, sizeof(checksum));
+			memcpy(&magic, m_map_data + footer_offset + sizeof(checksum), sizeof(magic));
+		}
+		else
+		{
+			in.seekg(static_cast<streamoff>(footer_offset), ios::beg);
+			in.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
+			in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+			in.clear();
+			in.seekg(0, ios::beg);
+		}
+
+		if (magic != checksum_magic)
+			return true;
+
+		m_file_size = footer_offset;
+		uint64_t checksum_computed = 0;
+		if (m_map_data)
+		{
+			checksum_computed = checksum_update(checksum_basis, m_map_data, m_file_size);
+		}
+		else
+		{
+			checksum_computed = checksum_compute(in, m_file_size);
+			in.clear();
+			in.seekg(0, ios::beg);
+		}
+
+		if (checksum != checksum_computed)
+		{
+			LOG_ERROR("\"%s\" is corrupted, checksum mismatch", m_path.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	void FileStream::AppendChecksum()
+	{
+		uint64_t checksum = 0;
+		{
+			ifstream file(m_path, ios::binary | ios::in);
+			if (file.fail())
+			{
+				LOG_ERROR("Failed to open \"%s\" to compute it's checksum", m_path.c_str());
+				return;
+			}
+
+			file.seekg(0, ios::end);
+			checksum = checksum_compute(file, static_cast<uint64_t>(file.tellg()));
+		}
+
+		ofstream file(m_path, ios::binary | ios::out | ios::app);
+		file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+		file.write(reinterpret_cast<const char*>(&checksum_magic), sizeof(checksum_magic));
 	}
 
 	void FileStream::Write(const string& value)
 	{
+		if (m_string_table)
+		{
+			Write(m_string_table->Add(value));
+			return;
+		}
+
 		const auto length = static_cast<uint32_t>(value.length());
 		Write(length);
-
-		out.write(const_cast<char*>(value.c_str()), length);
+		WriteBytes(value.data(), length);
 	}
 
 	void FileStream::Write(const vector<string>& value)
@@ -105,50 +515,52 @@ namespace Spartan
 	{
 		const auto length = static_cast<uint32_t>(value.size());
 		Write(length);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(RHI_Vertex_PosTexNorTan) * length);
+		WriteSpan(value.data(), length);
 	}
 
 	void FileStream::Write(const vector<uint32_t>& value)
 	{
 		const auto length = static_cast<uint32_t>(value.size());
 		Write(length);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(uint32_t) * length);
+		WriteSpan(value.data(), length);
 	}
 
 	void FileStream::Write(const vector<unsigned char>& value)
 	{
 		const auto size = static_cast<uint32_t>(value.size());
 		Write(size);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned char) * size);
+		WriteSpan(value.data(), size);
 	}
 
 	void FileStream::Write(const vector<std::byte>& value)
 	{
 		const auto size = static_cast<uint32_t>(value.size());
 		Write(size);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(std::byte) * size);
+		WriteSpan(value.data(), size);
 	}
 
-	void FileStream::Skip(uint32_t n)
+	void FileStream::Read(string* value)
 	{
-		// Set the seek cursor to offset n from the current position
-		if (m_flags & FileStream_Write)
+		if (m_string_table)
 		{
-			out.seekp(n, ios::cur);
-		}
-		else if (m_flags & FileStream_Read)
-		{
-			in.ignore(n, ios::cur);
+			const auto index = ReadAs<uint32_t>();
+			if (index < m_string_table->strings.size())
+			{
+				*value = m_string_table->strings[index];
+			}
+			else
+			{
+				LOG_ERROR("Invalid string table index %u", index);
+				value->clear();
+			}
+			return;
 		}
-	}
 
-	void FileStream::Read(string* value)
-	{
 		uint32_t length = 0;
 		Read(&length);
 
 		value->resize(length);
-		in.read(const_cast<char*>(value->c_str()), length);
+		ReadBytes(value->data(), length);
 	}
 
 	void FileStream::Read(vector<string>* vec)
@@ -183,7 +595,7 @@ namespace Spartan
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(RHI_Vertex_PosTexNorTan) * length);
+		ReadSpan(vec->data(), length);
 	}
 
 	void FileStream::Read(vector<uint32_t>* vec)
@@ -199,7 +611,7 @@ namespace Spartan
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(uint32_t) * length);
+		ReadSpan(vec->data(), length);
 	}
 
 	void FileStream::Read(vector<unsigned char>* vec)
@@ -215,7 +627,7 @@ namespace Spartan
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned char) * length);
+		ReadSpan(vec->data(), length);
 	}
 
 	void FileStream::Read(vector<std::byte>* vec)
@@ -231,6 +643,6 @@ namespace Spartan
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(std::byte) * length);
+		ReadSpan(vec->data(), length);
 	}
 }
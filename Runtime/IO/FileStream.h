@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================
 #include <vector>
 #include <fstream>
+#include <cstring>
+#include <unordered_map>
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
@@ -40,17 +42,50 @@ namespace Spartan
 		FileStream_Read		= 1 << 0,
 		FileStream_Write	= 1 << 1,
 		FileStream_Append	= 1 << 2,
+		FileStream_Map		= 1 << 3, // Read through a memory map of the whole file (falls back to buffered reads)
+		FileStream_Checksum	= 1 << 4, // Write a checksummed footer on close, verify it (if present) on open
+	};
+
+	// Deduplicated strings, a stream with a table attached writes/reads strings as indices into it
+	struct SPARTAN_CLASS FileStream_StringTable
+	{
+		uint32_t Add(const std::string& value)
+		{
+			const auto it = indices.find(value);
+			if (it != indices.end())
+				return it->second;
+
+			const auto index = static_cast<uint32_t>(strings.size());
+			strings.emplace_back(value);
+			indices[value] = index;
+			return index;
+		}
+
+		std::vector<std::string> strings;
+		std::unordered_map<std::string, uint32_t> indices;
 	};
 
 	class SPARTAN_CLASS FileStream
 	{
 	public:
+		// Types which can be copied as raw bytes (math types qualify, even though they declare copy constructors)
+		template <typename T>
+		static constexpr bool is_plain_data() { return std::is_standard_layout<T>::value && std::is_trivially_destructible<T>::value && !std::is_pointer<T>::value; }
+
 		FileStream(const std::string& path, uint32_t flags);
 		~FileStream();
 
-		auto IsOpen() const { return m_is_open; }
+		auto IsOpen() const		{ return m_is_open; }
+		auto IsMapped() const	{ return m_map_data != nullptr; }
 		void Close();
 
+		// Absolute position of the read/write cursor
+		uint64_t GetPosition();
+		void Seek(uint64_t position);
+
+		// Strings are written as table indices while a table is set (null to write them inline)
+		void SetStringTable(FileStream_StringTable* string_table) { m_string_table = string_table; }
+
 		//= WRITING ==================================================
 		template <class T, class = typename std::enable_if<
 			std::is_same<T, bool>::value				||
@@ -76,7 +111,15 @@ namespace Spartan
 		>::type>
 		void Write(T value)
 		{
-			out.write(reinterpret_cast<char*>(&value), sizeof(value));
+			WriteBytes(&value, sizeof(value));
+		}
+
+		// Writes an array of POD elements as is
+		template <typename T>
+		void WriteSpan(const T* data, const uint64_t count)
+		{
+			static_assert(is_plain_data<T>(), "WriteSpan requires a plain data type");
+			WriteBytes(data, sizeof(T) * count);
 		}
 
 		void Write(const std::string& value);
@@ -86,6 +129,9 @@ namespace Spartan
 		void Write(const std::vector<unsigned char>& value);
 		void Write(const std::vector<std::byte>& value);
 		void Skip(uint32_t n);
+
+		// Pads (when writing) or skips (when reading) up to the next multiple of alignment
+		void Align(uint32_t alignment);
 		//===========================================================
 		
 		//= READING ===========================================
@@ -114,7 +160,30 @@ namespace Spartan
 		>::type>
 		void Read(T* value)
 		{
-			in.read(reinterpret_cast<char*>(value), sizeof(T));
+			ReadBytes(value, sizeof(T));
+		}
+
+		// Reads an array of POD elements into caller memory
+		template <typename T>
+		void ReadSpan(T* data, const uint64_t count)
+		{
+			static_assert(is_plain_data<T>(), "ReadSpan requires a plain data type");
+			ReadBytes(data, sizeof(T) * count);
+		}
+
+		// Returns the elements in place and advances past them, only possible for a mapped and suitably aligned region (returns null otherwise)
+		template <typename T>
+		const T* ViewSpan(const uint64_t count)
+		{
+			static_assert(is_plain_data<T>(), "ViewSpan requires a plain data type");
+
+			const uint64_t size = sizeof(T) * count;
+			if (!m_map_data || m_cursor + size > m_data_size || reinterpret_cast<uintptr_t>(m_data + m_cursor) % alignof(T) != 0)
+				return nullptr;
+
+			const T* view = reinterpret_cast<const T*>(m_data + m_cursor);
+			m_cursor += size;
+			return view;
 		}
 		void Read(std::string* value);
 		void Read(std::vector<std::string>* vec);
@@ -152,9 +221,59 @@ namespace Spartan
 		//=====================================================
 
 	private:
+		// Scalars land in the buffer (or come from the map) with a single copy, only full buffers reach the file
+		void WriteBytes(const void* data, const uint64_t size)
+		{
+			if (m_cursor + size <= m_data_size)
+			{
+				memcpy(m_data + m_cursor, data, size);
+				m_cursor += size;
+				return;
+			}
+
+			WriteBytesSlow(data, size);
+		}
+
+		void ReadBytes(void* data, const uint64_t size)
+		{
+			if (m_cursor + size <= m_data_size)
+			{
+				memcpy(data, m_data + m_cursor, size);
+				m_cursor += size;
+				return;
+			}
+
+			ReadBytesSlow(data, size);
+		}
+
+		void WriteBytesSlow(const void* data, uint64_t size);
+		void ReadBytesSlow(void* data, uint64_t size);
+		void Flush();
+		bool Map(const std::string& path);
+		void Unmap();
+		bool VerifyChecksum();
+		void AppendChecksum();
+
 		std::ofstream out;
 		std::ifstream in;
+		std::string m_path;
 		uint32_t m_flags;
 		bool m_is_open;
+		bool m_read_overflow = false;
+		FileStream_StringTable* m_string_table = nullptr;
+
+		// The window of the file which is currently in memory (the buffer or the whole map)
+		std::vector<std::byte> m_buffer;
+		std::byte* m_data		= nullptr;
+		uint64_t m_data_size	= 0; // valid bytes (reading) or capacity (writing)
+		uint64_t m_data_offset	= 0; // file offset of the first byte
+		uint64_t m_cursor		= 0;
+		uint64_t m_file_size	= 0; // readable bytes, excludes the checksum footer
+
+		// Memory map
+		std::byte* m_map_data	= nullptr;
+		void* m_map_file		= nullptr;
+		void* m_map_mapping		= nullptr;
+		uint64_t m_map_size		= 0;
 	};
 }
@@ -28,6 +28,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
+	// Log() is called from the log's writer thread, not from the thread which logged the message,
+	// so implementations must be thread-safe and hand the messages over to whoever displays them.
 	class SPARTAN_CLASS ILogger
 	{
 	public:
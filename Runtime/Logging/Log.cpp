@@ -24,8 +24,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ILogger.h"
 #include <fstream>
 #include <cstdarg>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <condition_variable>
 #include "../World/Entity.h"
-#include "../Core/EventSystem.h"
 #include "../Core/FileSystem.h"
 //==============================
 
@@ -36,36 +41,394 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-	weak_ptr<ILogger> Log::m_logger;
-	ofstream Log::m_fout;
-	mutex Log::m_mutex_log;
-    vector<LogCmd> Log::m_log_buffer;
-	string Log::m_log_file_name	    = "log.txt";
-	bool Log::m_log_to_file		    = true; // start logging to file (unless changed by the user, e.g. Renderer initialization was successful, so logging can happen on screen)
-	bool Log::m_first_log		    = true;
-   
-	// Everything resolves to this
-	void Log::Write(const char* text, const Log_Type type)
-	{
+    namespace
+    {
+        // A fixed size record, so the queue never allocates. Messages which don't fit continue in the records which follow.
+        struct LogRecord
+        {
+            atomic<uint64_t> sequence   = 0;
+            double time_ms              = 0.0;
+            uint32_t thread_index       = 0;
+            Log_Type type               = Log_Info;
+            uint32_t length             = 0; // of the whole message, set in the first record
+            uint32_t record_count       = 1; // records the message spans, set in the first record
+            char text[480]              = {};
+        };
+
+        // Bounded multiple producer/single consumer queue (each slot carries a sequence number, so producers
+        // only contend on the enqueue position) which is drained by a background thread that batches the writes.
+        class LogBackend
+        {
+        public:
+            LogBackend()
+            {
+                for (uint64_t i = 0; i < m_capacity; i++)
+                {
+                    m_records[i].sequence.store(i, memory_order_relaxed);
+                }
+
+                m_start  = chrono::steady_clock::now();
+                m_thread = thread(&LogBackend::ThreadLoop, this);
+            }
+
+            ~LogBackend()
+            {
+                {
+                    lock_guard<mutex> lock(m_mutex_wake);
+                    m_stopping = true;
+                }
+                m_condition_var.notify_one();
+                m_thread.join();
+            }
+
+            bool Push(const char* text, size_t length, const Log_Type type)
+            {
+                static atomic<uint32_t> thread_count = 0;
+                thread_local const uint32_t thread_index = thread_count.fetch_add(1, memory_order_relaxed);
+
+                // Long messages span consecutive records (the terminator included), anything beyond the limit is cut
+                const size_t record_text_size   = sizeof(LogRecord::text);
+                length                          = min(length, m_records_per_message_max * record_text_size - 1);
+                const uint64_t record_count     = length / record_text_size + 1;
+
+                // Claim the slots, they are released in order, so if the last one is free, they all are
+                uint64_t position = m_enqueue_position.load(memory_order_relaxed);
+                while (true)
+                {
+                    const uint64_t position_last    = position + record_count - 1;
+                    const uint64_t sequence         = m_records[position_last & (m_capacity - 1)].sequence.load(memory_order_acquire);
+                    const int64_t difference        = static_cast<int64_t>(sequence) - static_cast<int64_t>(position_last);
+
+                    if (difference == 0)
+                    {
+                        if (m_enqueue_position.compare_exchange_weak(position, position + record_count, memory_order_relaxed))
+                            break;
+                    }
+                    else if (difference < 0) // full
+                    {
+                        m_dropped.fetch_add(1, memory_order_relaxed);
+                        return false;
+                    }
+                    else
+                    {
+                        position = m_enqueue_position.load(memory_order_relaxed);
+                    }
+                }
+
+                // Fill them
+                for (uint64_t i = 0; i < record_count; i++)
+                {
+                    const size_t offset = i * record_text_size;
+                    const size_t size   = min(record_text_size, length - offset);
+                    memcpy(m_records[(position + i) & (m_capacity - 1)].text, text + offset, size);
+                }
+
+                LogRecord& record   = m_records[position & (m_capacity - 1)];
+                if (record_count == 1)
+                {
+                    record.text[length] = '\0';
+                }
+                record.time_ms      = chrono::duration<double, milli>(chrono::steady_clock::now() - m_start).count();
+                record.thread_index = thread_index;
+                record.type         = type;
+                record.length       = static_cast<uint32_t>(length);
+                record.record_count = static_cast<uint32_t>(record_count);
+
+                // Publish them, the first one last, since that's the one the writer waits on
+                for (uint64_t i = record_count - 1; i > 0; i--)
+                {
+                    m_records[(position + i) & (m_capacity - 1)].sequence.store(position + i + 1, memory_order_release);
+                }
+                record.sequence.store(position + 1, memory_order_release);
+
+                // Errors are written out as soon as possible, everything else waits for the next batch
+                if (type == Log_Error)
+                {
+                    m_condition_var.notify_one();
+                }
+
+                return true;
+            }
+
+            void Flush()
+            {
+                if (this_thread::get_id() == m_thread.get_id())
+                    return;
+
+                const uint64_t position = m_enqueue_position.load(memory_order_acquire);
+                while (m_written.load(memory_order_acquire) < position)
+                {
+                    m_condition_var.notify_one();
+                    this_thread::yield();
+                }
+            }
+
+            void SetLogger(const weak_ptr<ILogger>& logger)
+            {
+                lock_guard<mutex> lock(m_mutex_logger);
+                m_logger = logger;
+            }
+
+            uint32_t GetDroppedCount() const { return m_dropped.load(memory_order_relaxed); }
+            atomic<uint32_t> m_suppressed = 0;
+
+        private:
+            void ThreadLoop()
+            {
+                while (true)
+                {
+                    const bool stopping = m_stopping.load();
+
+                    if (Drain() == 0)
+                    {
+                        if (stopping)
+                            break;
+
+                        unique_lock<mutex> lock(m_mutex_wake);
+                        m_condition_var.wait_for(lock, chrono::milliseconds(10));
+                    }
+                }
+
+                if (m_fout.is_open())
+                {
+                    m_fout.close();
+                }
+            }
+
+            uint32_t Drain()
+            {
+                lock_guard<mutex> lock(m_mutex_logger);
+                const bool log_to_file = m_logger.expired() || Log::m_log_to_file;
+
+                // Report drops
+                const uint32_t dropped = m_dropped.load(memory_order_relaxed);
+                if (dropped != m_dropped_reported)
+                {
+                    char text[128];
+                    snprintf(text, sizeof(text), "Log: %d messages were dropped because the log queue was full", dropped - m_dropped_reported);
+                    Write(text, Log_Warning, 0.0, 0, log_to_file);
+                    m_dropped_reported = dropped;
+                }
+
+                uint32_t count = 0;
+                while (true)
+                {
+                    LogRecord& record = m_records[m_dequeue_position & (m_capacity - 1)];
+                    if (record.sequence.load(memory_order_acquire) != m_dequeue_position + 1)
+                        break;
+
+                    // Join messages which span several records
+                    const char* text = record.text;
+                    if (record.record_count > 1)
+                    {
+                        const size_t record_text_size = sizeof(LogRecord::text);
+                        for (uint32_t i = 0; i < record.record_count; i++)
+                        {
+                            const size_t offset = i * record_text_size;
+                            const size_t size   = min(record_text_size, record.length - offset);
+                            memcpy(m_text_joined + offset, m_records[(m_dequeue_position + i) & (m_capacity - 1)].text, size);
+                        }
+                        m_text_joined[record.length] = '\0';
+                        text = m_text_joined;
+                    }
+
+                    Write(text, record.type, record.time_ms, record.thread_index, log_to_file);
+
+                    // Release the slots
+                    const uint32_t record_count = record.record_count;
+                    for (uint32_t i = 0; i < record_count; i++)
+                    {
+                        m_records[(m_dequeue_position + i) & (m_capacity - 1)].sequence.store(m_dequeue_position + i + m_capacity, memory_order_release);
+                    }
+                    m_dequeue_position += record_count;
+                    count++;
+                }
+
+                if (count != 0)
+                {
+                    if (log_to_file && m_fout.is_open())
+                    {
+                        m_fout << m_batch;
+                        m_fout.flush();
+                    }
+
+                    m_batch.clear();
+                    m_written.store(m_dequeue_position, memory_order_release);
+                }
+
+                return count;
+            }
+
+            void Write(const char* text, const Log_Type type, const double time_ms, const uint32_t thread_index, const bool log_to_file)
+            {
+                if (log_to_file)
+                {
+                    // Delete the previous log file (if it exists)
+                    if (!m_fout.is_open())
+                    {
+                        m_fout.open(m_log_file_name, ofstream::out | ofstream::trunc);
+                    }
+
+                    char prefix[64];
+                    const char* type_name = (type == Log_Info) ? "Info:" : (type == Log_Warning) ? "Warning:" : "Error:";
+                    snprintf(prefix, sizeof(prefix), "[%10.3f][%2d] %s ", time_ms / 1000.0, thread_index, type_name);
+                    m_batch += prefix;
+                    m_batch += text;
+                    m_batch += '\n';
+
+                    // Keep it, so the logger can show it once it's set
+                    m_log_buffer.emplace_back(text, type);
+                    if (m_log_buffer.size() > m_log_buffer_capacity)
+                    {
+                        m_log_buffer.pop_front();
+                    }
+                }
+                else
+                {
+                    shared_ptr<ILogger> logger = m_logger.lock();
+
+                    // Log everything from memory to the logger implementation
+                    for (const auto& log : m_log_buffer)
+                    {
+                        logger->Log(log.first, log.second);
+                    }
+                    m_log_buffer.clear();
+
+                    logger->Log(string(text), type);
+                }
+            }
+
+            // Queue
+            static const uint64_t m_capacity                    = 1024; // must be a power of two
+            static const uint64_t m_records_per_message_max     = 8;
+            LogRecord m_records[m_capacity];
+            char m_text_joined[m_records_per_message_max * sizeof(LogRecord::text)];
+            atomic<uint64_t> m_enqueue_position = 0;
+            uint64_t m_dequeue_position         = 0;
+            atomic<uint64_t> m_written          = 0;
+            atomic<uint32_t> m_dropped          = 0;
+            uint32_t m_dropped_reported         = 0;
+
+            // Writer
+            thread m_thread;
+            mutex m_mutex_wake;
+            condition_variable m_condition_var;
+            atomic<bool> m_stopping = false;
+            chrono::steady_clock::time_point m_start;
+            ofstream m_fout;
+            string m_batch;
+            const string m_log_file_name = "log.txt";
+
+            // Logger, and what was logged before it was set
+            mutex m_mutex_logger;
+            weak_ptr<ILogger> m_logger;
+            deque<pair<string, Log_Type>> m_log_buffer;
+            const size_t m_log_buffer_capacity = 1000;
+        };
+
+        // The backend can be used by other statics while they are destroyed, so its lifetime is tracked
+        atomic<bool> backend_alive = false;
+
+        LogBackend* get_backend()
+        {
+            struct Holder
+            {
+                Holder()    { backend_alive = true; }
+                ~Holder()   { backend_alive = false; }
+                LogBackend backend;
+            };
+
+            static Holder holder;
+            return backend_alive ? &holder.backend : nullptr;
+        }
+    }
+
+	atomic<bool> Log::m_log_to_file		    = true; // start logging to file (unless changed by the user, e.g. Renderer initialization was successful, so logging can happen on screen)
+    uint32_t Log::m_site_rate_limit         = 100;
+
+    void Log::SetLogger(const weak_ptr<ILogger>& logger)
+    {
+        if (LogBackend* backend = get_backend())
+        {
+            backend->SetLogger(logger);
+        }
+    }
+
+    void Log::WriteF(LogSite& site, const Log_Type type, const char* function, const char* text, ...)
+    {
         if (!text)
+            return;
+
+        // Rate limit per call site
+        const int64_t second    = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t window          = site.window.load(memory_order_relaxed);
+        if (window != second && site.window.compare_exchange_strong(window, second, memory_order_relaxed))
         {
-            LOG_ERROR_INVALID_PARAMETER();
+            site.count.store(0, memory_order_relaxed);
+        }
+
+        if (site.count.fetch_add(1, memory_order_relaxed) >= m_site_rate_limit)
+        {
+            site.suppressed.fetch_add(1, memory_order_relaxed);
+            if (LogBackend* backend = get_backend())
+            {
+                backend->m_suppressed.fetch_add(1, memory_order_relaxed);
+            }
             return;
         }
 
-        lock_guard<mutex> guard(m_mutex_log);
+        // Format
+        char buffer[2048];
+        int length = snprintf(buffer, sizeof(buffer), "%s: ", function);
+        va_list args;
+        va_start(args, text);
+        length += max(vsnprintf(buffer + length, sizeof(buffer) - length, text, args), 0);
+        va_end(args);
+
+        const uint32_t suppressed = site.suppressed.exchange(0, memory_order_relaxed);
+        if (suppressed != 0 && length < static_cast<int>(sizeof(buffer)))
+        {
+            length += snprintf(buffer + length, sizeof(buffer) - length, " (%d similar messages were suppressed)", suppressed);
+        }
+
+        if (LogBackend* backend = get_backend())
+        {
+            backend->Push(buffer, min(static_cast<size_t>(length), sizeof(buffer) - 1), type);
+        }
+    }
+
+    void Log::Flush()
+    {
+        if (LogBackend* backend = get_backend())
+        {
+            backend->Flush();
+        }
+    }
+
+    uint32_t Log::GetDroppedCount()
+    {
+        LogBackend* backend = get_backend();
+        return backend ? backend->GetDroppedCount() : 0;
+    }
 
-        const auto log_to_file = m_logger.expired() || m_log_to_file;
+    uint32_t Log::GetSuppressedCount()
+    {
+        LogBackend* backend = get_backend();
+        return backend ? backend->m_suppressed.load(memory_order_relaxed) : 0;
+    }
 
-        if (log_to_file)
+	// Everything resolves to this
+	void Log::Write(const char* text, const Log_Type type)
+	{
+        if (!text)
         {
-            m_log_buffer.emplace_back(text, type);
-            LogToFile(text, type);
+            LOG_ERROR_INVALID_PARAMETER();
+            return;
         }
-        else
+
+        if (LogBackend* backend = get_backend())
         {
-            FlushBuffer();
-            LogString(text, type);
+            backend->Push(text, strlen(text), type);
         }
 	}
 
@@ -74,7 +437,7 @@ namespace Spartan
 		char buffer[1024];
 		va_list args;
 		va_start(args, text);
-		auto w = vsnprintf(buffer, sizeof(buffer), text, args);
+		vsnprintf(buffer, sizeof(buffer), text, args);
 		va_end(args);
 
 		Write(buffer, Log_Info);
@@ -85,7 +448,7 @@ namespace Spartan
 		char buffer[1024];
 		va_list args;
 		va_start(args, text);
-		auto w = vsnprintf(buffer, sizeof(buffer), text, args);
+		vsnprintf(buffer, sizeof(buffer), text, args);
 		va_end(args);
 
 		Write(buffer, Log_Warning);
@@ -96,7 +459,7 @@ namespace Spartan
 		char buffer[1024];
 		va_list args;
 		va_start(args, text);
-		auto w = vsnprintf(buffer, sizeof(buffer), text, args);
+		vsnprintf(buffer, sizeof(buffer), text, args);
 		va_end(args);
 
 		Write(buffer, Log_Error);
@@ -112,7 +475,7 @@ namespace Spartan
         char buffer[2048];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
+        vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
         va_end(args);
 
         Write(buffer, Log_Info);
@@ -123,7 +486,7 @@ namespace Spartan
         char buffer[2048];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
+        vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
         va_end(args);
 
         Write(buffer, Log_Warning);
@@ -134,7 +497,7 @@ namespace Spartan
         char buffer[2048];
         va_list args;
         va_start(args, text);
-        auto w = vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
+        vsnprintf(buffer, sizeof(buffer), text.c_str(), args);
         va_end(args);
 
         Write(buffer, Log_Error);
@@ -174,59 +537,4 @@ namespace Spartan
 	{
 		Write(value.ToString(), type);
 	}
-
-    void Log::FlushBuffer()
-    {
-        if (m_logger.expired() || m_log_buffer.empty())
-            return;
-
-         // Log everything from memory to the logger implementation
-        for (const auto& log : m_log_buffer)
-        {
-            LogString(log.text.c_str(), log.type);
-        }
-        m_log_buffer.clear();
-    }
-
-    void Log::LogString(const char* text, const Log_Type type)
-	{
-        if (!text)
-        {
-            LOG_ERROR_INVALID_PARAMETER();
-            return;
-        }
-
-		m_logger.lock()->Log(string(text), type);
-	}
-
-	void Log::LogToFile(const char* text, const Log_Type type)
-    {
-        if (!text)
-        {
-            LOG_ERROR_INVALID_PARAMETER();
-            return;
-        }
-
-		const string prefix		= (type == Log_Info) ? "Info:" : (type == Log_Warning) ? "Warning:" : "Error:";
-		const auto final_text	= prefix + " " + text;
-
-		// Delete the previous log file (if it exists)
-		if (m_first_log)
-		{
-			FileSystem::Delete(m_log_file_name);
-			m_first_log = false;
-		}
-
-		// Open/Create a log file to write the error message to
-		m_fout.open(m_log_file_name, ofstream::out | ofstream::app);
-
-		if (m_fout.is_open())
-		{
-			// Write out the error message
-			m_fout << final_text << endl;
-
-			// Close the file
-			m_fout.close();
-		}
-	}
 }
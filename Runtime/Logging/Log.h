@@ -26,14 +26,33 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <memory>
 #include <mutex>
 #include <vector>
+#include <atomic>
 #include "../Core/EngineDefs.h"
 //=============================
 
+// Log calls below this level are compiled out (0: info, 1: warning, 2: error, 3: nothing)
+#ifndef SPARTAN_LOG_LEVEL_MIN
+    #define SPARTAN_LOG_LEVEL_MIN 0
+#endif
+
 namespace Spartan
 {
-    #define LOG_INFO(text, ...)	    { Spartan::Log::WriteFInfo(std::string(__FUNCTION__)    + ": " + std::string(text), __VA_ARGS__); }
-    #define LOG_WARNING(text, ...)	{ Spartan::Log::WriteFWarning(std::string(__FUNCTION__) + ": " + std::string(text), __VA_ARGS__); }
-    #define LOG_ERROR(text, ...)	{ Spartan::Log::WriteFError(std::string(__FUNCTION__)   + ": " + std::string(text), __VA_ARGS__); }
+    // Every call site owns a static Spartan::LogSite, which is what rate limiting is tracked against
+    #if SPARTAN_LOG_LEVEL_MIN <= 0
+    #define LOG_INFO(text, ...)	    { static Spartan::LogSite log_site; Spartan::Log::WriteF(log_site, Spartan::Log_Info,    __FUNCTION__, Spartan::Log::ToText(text), __VA_ARGS__); }
+    #else
+    #define LOG_INFO(text, ...)	    {}
+    #endif
+    #if SPARTAN_LOG_LEVEL_MIN <= 1
+    #define LOG_WARNING(text, ...)	{ static Spartan::LogSite log_site; Spartan::Log::WriteF(log_site, Spartan::Log_Warning, __FUNCTION__, Spartan::Log::ToText(text), __VA_ARGS__); }
+    #else
+    #define LOG_WARNING(text, ...)	{}
+    #endif
+    #if SPARTAN_LOG_LEVEL_MIN <= 2
+    #define LOG_ERROR(text, ...)	{ static Spartan::LogSite log_site; Spartan::Log::WriteF(log_site, Spartan::Log_Error,   __FUNCTION__, Spartan::Log::ToText(text), __VA_ARGS__); }
+    #else
+    #define LOG_ERROR(text, ...)	{}
+    #endif
 
 	// Standard errors
 	#define LOG_ERROR_GENERIC_FAILURE()		LOG_ERROR("Failed.")
@@ -61,16 +80,11 @@ namespace Spartan
 		Log_Error
 	};
 
-    struct LogCmd
+    struct LogSite
     {
-        LogCmd(const std::string& text, const Log_Type type)
-        {
-            this->text = text;
-            this->type = type;
-        }
-
-        std::string text;
-        Log_Type type;
+        std::atomic<int64_t> window     = 0; // second in which count started
+        std::atomic<uint32_t> count     = 0;
+        std::atomic<uint32_t> suppressed = 0;
     };
 
 	class SPARTAN_CLASS Log
@@ -80,7 +94,19 @@ namespace Spartan
         Log() = default;
 
 		// Set a logger to be used (if not set, logging will done in a text file.
-		static void SetLogger(const std::weak_ptr<ILogger>& logger) { m_logger = logger; }
+		static void SetLogger(const std::weak_ptr<ILogger>& logger);
+
+        // Formats on the calling thread and queues the text, the file and the logger are written to by a background thread
+        static void WriteF(LogSite& site, Log_Type type, const char* function, const char* text, ...);
+        static const char* ToText(const char* text)         { return text; }
+        static const char* ToText(const std::string& text)  { return text.c_str(); }
+
+        // Blocks until everything that has been logged so far has been written out
+        static void Flush();
+        // Messages lost because the queue was full
+        static uint32_t GetDroppedCount();
+        // Messages skipped because their call site exceeded m_site_rate_limit messages per second
+        static uint32_t GetSuppressedCount();
 
 		// Alpha
 		static void Write(const char* text, const Log_Type type);
@@ -123,18 +149,7 @@ namespace Spartan
 		static void Write(const std::weak_ptr<Entity>& entity, Log_Type type);
 		static void Write(const std::shared_ptr<Entity>& entity, Log_Type type);
 
-		static bool m_log_to_file;     
-
-	private:
-        static void FlushBuffer();
-		static void LogString(const char* text, Log_Type type);
-		static void LogToFile(const char* text, Log_Type type);
-
-        static std::mutex m_mutex_log;
-		static std::weak_ptr<ILogger> m_logger;
-		static std::ofstream m_fout;	
-		static std::string m_log_file_name;
-		static bool m_first_log;
-        static std::vector<LogCmd> m_log_buffer;
+		static std::atomic<bool> m_log_to_file;
+        static uint32_t m_site_rate_limit;
 	};
 }
@@ -110,8 +110,23 @@ namespace Spartan::Math
 		}
 	}
 
+	Vector3 BoundingBox::GetClosestPoint(const Vector3& point) const
+	{
+		return Vector3
+		(
+			Helper::Clamp(point.x, m_min.x, m_max.x),
+			Helper::Clamp(point.y, m_min.y, m_max.y),
+			Helper::Clamp(point.z, m_min.z, m_max.z)
+		);
+	}
+
 	BoundingBox BoundingBox::Transform(const Matrix& transform) const
 	{
+#if defined(SPARTAN_SIMD_SSE)
+        BoundingBox result;
+        Transform(this, &transform, &result, 1);
+        return result;
+#else
         const Vector3 center_new = transform * GetCenter();
         const Vector3 extent_old = GetExtents();
         const Vector3 extend_new = Vector3
@@ -122,15 +137,44 @@ namespace Spartan::Math
 		);
 
 		return BoundingBox(center_new - extend_new, center_new + extend_new);
+#endif
 	}
 
+    void BoundingBox::Transform(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* out, const uint32_t count)
+    {
+#if defined(SPARTAN_SIMD_SSE)
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            __m128 r0, r1, r2, r3;
+            Simd::matrix_rows(transforms[i].Data(), r0, r1, r2, r3);
+
+            const __m128 min        = Simd::load_float3(&boxes[i].m_min.x);
+            const __m128 max        = Simd::load_float3(&boxes[i].m_max.x);
+            const __m128 center     = _mm_mul_ps(_mm_add_ps(max, min), half);
+            const __m128 extents    = _mm_mul_ps(_mm_sub_ps(max, min), half);
+
+            __m128 min_new, max_new;
+            Simd::transform_aabb(center, extents, r0, r1, r2, r3, min_new, max_new);
+            Simd::store_float3(min_new, &out[i].m_min.x);
+            Simd::store_float3(max_new, &out[i].m_max.x);
+        }
+#else
+        for (uint32_t i = 0; i < count; i++)
+        {
+            out[i] = boxes[i].Transform(transforms[i]);
+        }
+#endif
+    }
+
     void BoundingBox::Merge(const BoundingBox& box)
     {
         m_min.x = Helper::Min(m_min.x, box.m_min.x);
         m_min.y = Helper::Min(m_min.y, box.m_min.y);
         m_min.z = Helper::Min(m_min.z, box.m_min.z);
         m_max.x = Helper::Max(m_max.x, box.m_max.x);
-        m_max.y = Helper::Max(m_max.x, box.m_max.x);
-        m_max.z = Helper::Max(m_max.x, box.m_max.x);
+        m_max.y = Helper::Max(m_max.y, box.m_max.y);
+        m_max.z = Helper::Max(m_max.z, box.m_max.z);
     }
 }
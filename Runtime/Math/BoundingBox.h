@@ -70,9 +70,15 @@ namespace Spartan
 			// Test if a bounding box is inside
 			Intersection IsInside (const BoundingBox& box) const;
 
+			// Returns the closest point inside the box
+			Vector3 GetClosestPoint(const Vector3& point) const;
+
 			// Returns a transformed bounding box
 			BoundingBox Transform(const Matrix& transform) const;
 
+            // Transforms a batch, out[i] = boxes[i].Transform(transforms[i]) (out can alias boxes)
+            static void Transform(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* out, uint32_t count);
+
 			// Merge with another bounding box
 			void Merge(const BoundingBox& box);
 
@@ -0,0 +1,575 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================
+#include "DynamicAabbTree.h"
+#include "Ray.h"
+#include "Frustum.h"
+#include "../Logging/Log.h"
+//===========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan::Math
+{
+    namespace
+    {
+        inline BoundingBox merge(const BoundingBox& a, const BoundingBox& b)
+        {
+            BoundingBox merged = a;
+            merged.Merge(b);
+            return merged;
+        }
+
+        inline float surface_area(const BoundingBox& box)
+        {
+            const Vector3 size = box.GetSize();
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        inline BoundingBox fatten(const BoundingBox& box, const float margin)
+        {
+            // Scale the margin with the box so that large objects don't re-insert on every move
+            const Vector3 extents   = box.GetExtents();
+            const float m           = Helper::Max(margin, Helper::Max3(extents.x, extents.y, extents.z) * 0.1f);
+            const Vector3 offset    = Vector3(m, m, m);
+            return BoundingBox(box.GetMin() - offset, box.GetMax() + offset);
+        }
+    }
+
+    DynamicAabbTree::DynamicAabbTree(const float margin /*= 0.1f*/)
+    {
+        m_margin = margin;
+    }
+
+    int32_t DynamicAabbTree::Insert(const BoundingBox& box, void* user_data)
+    {
+        const int32_t proxy = AllocateNode();
+        m_nodes[proxy].box          = fatten(box, m_margin);
+        m_nodes[proxy].user_data    = user_data;
+        m_nodes[proxy].height       = 0;
+
+        InsertLeaf(proxy);
+        m_proxy_count++;
+
+        return proxy;
+    }
+
+    void DynamicAabbTree::Remove(const int32_t proxy)
+    {
+        if (proxy < 0 || proxy >= static_cast<int32_t>(m_nodes.size()) || !m_nodes[proxy].IsLeaf() || m_nodes[proxy].height != 0)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return;
+        }
+
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        m_proxy_count--;
+    }
+
+    bool DynamicAabbTree::Update(const int32_t proxy, const BoundingBox& box)
+    {
+        if (proxy < 0 || proxy >= static_cast<int32_t>(m_nodes.size()) || !m_nodes[proxy].IsLeaf() || m_nodes[proxy].height != 0)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        // Still enclosed by the fat box and the fat box isn't much larger than it needs to be
+        const BoundingBox& box_fat = m_nodes[proxy].box;
+        if (box_fat.IsInside(box) == Inside && surface_area(box_fat) <= 4.0f * surface_area(fatten(box, m_margin)))
+            return false;
+
+        RemoveLeaf(proxy);
+        m_nodes[proxy].box = fatten(box, m_margin);
+        InsertLeaf(proxy);
+
+        return true;
+    }
+
+    void DynamicAabbTree::Clear()
+    {
+        m_nodes.clear();
+        m_root          = node_null;
+        m_free_list     = node_null;
+        m_proxy_count   = 0;
+    }
+
+    void DynamicAabbTree::QueryBox(const BoundingBox& box, const function<bool(int32_t)>& callback) const
+    {
+        if (m_root == node_null)
+            return;
+
+        vector<int32_t> stack;
+        stack.reserve(64);
+        stack.emplace_back(m_root);
+
+        while (!stack.empty())
+        {
+            const int32_t index = stack.back();
+            stack.pop_back();
+
+            const Node& node = m_nodes[index];
+            if (box.IsInside(node.box) == Outside)
+                continue;
+
+            if (node.IsLeaf())
+            {
+                if (!callback(index))
+                    return;
+            }
+            else
+            {
+                stack.emplace_back(node.child_left);
+                stack.emplace_back(node.child_right);
+            }
+        }
+    }
+
+    void DynamicAabbTree::QuerySphere(const Vector3& center, const float radius, const function<bool(int32_t)>& callback) const
+    {
+        if (m_root == node_null)
+            return;
+
+        vector<int32_t> stack;
+        stack.reserve(64);
+        stack.emplace_back(m_root);
+
+        while (!stack.empty())
+        {
+            const int32_t index = stack.back();
+            stack.pop_back();
+
+            const Node& node = m_nodes[index];
+            if (Vector3::DistanceSquared(center, node.box.GetClosestPoint(center)) > radius * radius)
+                continue;
+
+            if (node.IsLeaf())
+            {
+                if (!callback(index))
+                    return;
+            }
+            else
+            {
+                stack.emplace_back(node.child_left);
+                stack.emplace_back(node.child_right);
+            }
+        }
+    }
+
+    void DynamicAabbTree::QueryFrustum(const Frustum& frustum, const function<bool(int32_t)>& callback) const
+    {
+        if (m_root == node_null)
+            return;
+
+        // The second member is set once a node is fully inside, its descendants then skip the plane tests
+        vector<pair<int32_t, bool>> stack;
+        stack.reserve(64);
+        stack.emplace_back(m_root, false);
+
+        while (!stack.empty())
+        {
+            const auto [index, inside_parent] = stack.back();
+            stack.pop_back();
+
+            const Node& node    = m_nodes[index];
+            bool inside         = inside_parent;
+            if (!inside)
+            {
+                const Intersection intersection = frustum.IsInside(node.box);
+                if (intersection == Outside)
+                    continue;
+
+                inside = intersection == Inside;
+            }
+
+            if (node.IsLeaf())
+            {
+                if (!callback(index))
+                    return;
+            }
+            else
+            {
+                stack.emplace_back(node.child_left, inside);
+                stack.emplace_back(node.child_right, inside);
+            }
+        }
+    }
+
+    void DynamicAabbTree::QueryRay(const Ray& ray, float max_distance, const function<float(int32_t, float)>& callback) const
+    {
+        if (m_root == node_null)
+            return;
+
+        struct Entry
+        {
+            int32_t index;
+            float distance;
+        };
+
+        const auto is_hit = [&max_distance](const float distance) { return distance != INFINITY && distance <= max_distance; };
+
+        const float distance_root = ray.HitDistance(m_nodes[m_root].box);
+        if (!is_hit(distance_root))
+            return;
+
+        vector<Entry> stack;
+        stack.reserve(64);
+        stack.push_back({ m_root, distance_root });
+
+        while (!stack.empty())
+        {
+            const Entry entry = stack.back();
+            stack.pop_back();
+
+            // The maximum distance might have shrunk since this entry was pushed
+            if (!is_hit(entry.distance))
+                continue;
+
+            const Node& node = m_nodes[entry.index];
+            if (node.IsLeaf())
+            {
+                max_distance = callback(entry.index, max_distance);
+                if (max_distance <= 0.0f)
+                    return;
+
+                continue;
+            }
+
+            const float distance_left   = ray.HitDistance(m_nodes[node.child_left].box);
+            const float distance_right  = ray.HitDistance(m_nodes[node.child_right].box);
+            const bool hit_left         = is_hit(distance_left);
+            const bool hit_right        = is_hit(distance_right);
+
+            // Push the far child first so that the near one gets visited first
+            if (hit_left && hit_right)
+            {
+                if (distance_left < distance_right)
+                {
+                    stack.push_back({ node.child_right, distance_right });
+                    stack.push_back({ node.child_left,  distance_left });
+                }
+                else
+                {
+                    stack.push_back({ node.child_left,  distance_left });
+                    stack.push_back({ node.child_right, distance_right });
+                }
+            }
+            else if (hit_left)
+            {
+                stack.push_back({ node.child_left, distance_left });
+            }
+            else if (hit_right)
+            {
+                stack.push_back({ node.child_right, distance_right });
+            }
+        }
+    }
+
+    int32_t DynamicAabbTree::AllocateNode()
+    {
+        int32_t index = node_null;
+
+        if (m_free_list == node_null)
+        {
+            index = static_cast<int32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        else
+        {
+            index       = m_free_list;
+            m_free_list = m_nodes[index].parent;
+        }
+
+        m_nodes[index]          = Node();
+        m_nodes[index].height   = 0;
+
+        return index;
+    }
+
+    void DynamicAabbTree::FreeNode(const int32_t node)
+    {
+        m_nodes[node].parent    = m_free_list;
+        m_nodes[node].height    = -1;
+        m_nodes[node].user_data = nullptr;
+        m_free_list             = node;
+    }
+
+    void DynamicAabbTree::InsertLeaf(const int32_t leaf)
+    {
+        if (m_root == node_null)
+        {
+            m_root                  = leaf;
+            m_nodes[leaf].parent    = node_null;
+            return;
+        }
+
+        // Find the best sibling by descending towards the child with the lowest surface area cost
+        const BoundingBox box_leaf = m_nodes[leaf].box;
+        int32_t index = m_root;
+        while (!m_nodes[index].IsLeaf())
+        {
+            const Node& node = m_nodes[index];
+
+            const float area            = surface_area(node.box);
+            const float area_combined   = surface_area(merge(node.box, box_leaf));
+
+            // Cost of creating a new parent for this node and the new leaf
+            const float cost = 2.0f * area_combined;
+
+            // Minimum cost of pushing the leaf further down the tree
+            const float cost_inheritance = 2.0f * (area_combined - area);
+
+            const auto cost_descend = [&](const int32_t child)
+            {
+                const Node& node_child = m_nodes[child];
+                float cost_child = surface_area(merge(box_leaf, node_child.box));
+                if (!node_child.IsLeaf())
+                {
+                    cost_child -= surface_area(node_child.box);
+                }
+
+                return cost_child + cost_inheritance;
+            };
+
+            const float cost_left   = cost_descend(node.child_left);
+            const float cost_right  = cost_descend(node.child_right);
+
+            if (cost < cost_left && cost < cost_right)
+                break;
+
+            index = cost_left < cost_right ? node.child_left : node.child_right;
+        }
+        const int32_t sibling = index;
+
+        // Create a new parent
+        const int32_t parent_old    = m_nodes[sibling].parent;
+        const int32_t parent_new    = AllocateNode();
+        Node& node_parent           = m_nodes[parent_new];
+        node_parent.parent          = parent_old;
+        node_parent.box             = merge(box_leaf, m_nodes[sibling].box);
+        node_parent.height          = m_nodes[sibling].height + 1;
+        node_parent.child_left      = sibling;
+        node_parent.child_right     = leaf;
+        m_nodes[sibling].parent     = parent_new;
+        m_nodes[leaf].parent        = parent_new;
+
+        if (parent_old != node_null)
+        {
+            if (m_nodes[parent_old].child_left == sibling)
+            {
+                m_nodes[parent_old].child_left = parent_new;
+            }
+            else
+            {
+                m_nodes[parent_old].child_right = parent_new;
+            }
+        }
+        else
+        {
+            m_root = parent_new;
+        }
+
+        Refit(m_nodes[leaf].parent);
+    }
+
+    void DynamicAabbTree::RemoveLeaf(const int32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = node_null;
+            return;
+        }
+
+        const int32_t parent        = m_nodes[leaf].parent;
+        const int32_t grandparent   = m_nodes[parent].parent;
+        const int32_t sibling       = m_nodes[parent].child_left == leaf ? m_nodes[parent].child_right : m_nodes[parent].child_left;
+
+        // Replace the parent with the sibling
+        if (grandparent != node_null)
+        {
+            if (m_nodes[grandparent].child_left == parent)
+            {
+                m_nodes[grandparent].child_left = sibling;
+            }
+            else
+            {
+                m_nodes[grandparent].child_right = sibling;
+            }
+
+            m_nodes[sibling].parent = grandparent;
+            FreeNode(parent);
+            Refit(grandparent);
+        }
+        else
+        {
+            m_root                  = sibling;
+            m_nodes[sibling].parent = node_null;
+            FreeNode(parent);
+        }
+    }
+
+    void DynamicAabbTree::Refit(int32_t index)
+    {
+        // Walk up the tree fixing heights and boxes
+        while (index != node_null)
+        {
+            index = Balance(index);
+
+            Node& node              = m_nodes[index];
+            const Node& left        = m_nodes[node.child_left];
+            const Node& right       = m_nodes[node.child_right];
+            node.height             = 1 + Helper::Max(left.height, right.height);
+            node.box                = merge(left.box, right.box);
+
+            index = node.parent;
+        }
+    }
+
+    // Performs a left or right rotation if the node is imbalanced, returns the new subtree root
+    int32_t DynamicAabbTree::Balance(const int32_t index_a)
+    {
+        Node& a = m_nodes[index_a];
+        if (a.IsLeaf() || a.height < 2)
+            return index_a;
+
+        const int32_t index_b   = a.child_left;
+        const int32_t index_c   = a.child_right;
+        Node& b                 = m_nodes[index_b];
+        Node& c                 = m_nodes[index_c];
+        const int32_t balance   = c.height - b.height;
+
+        // Rotate C up
+        if (balance > 1)
+        {
+            const int32_t index_f   = c.child_left;
+            const int32_t index_g   = c.child_right;
+            Node& f                 = m_nodes[index_f];
+            Node& g                 = m_nodes[index_g];
+
+            // Swap A and C
+            c.child_left    = index_a;
+            c.parent        = a.parent;
+            a.parent        = index_c;
+
+            // A's old parent should point to C
+            if (c.parent != node_null)
+            {
+                if (m_nodes[c.parent].child_left == index_a)
+                {
+                    m_nodes[c.parent].child_left = index_c;
+                }
+                else
+                {
+                    m_nodes[c.parent].child_right = index_c;
+                }
+            }
+            else
+            {
+                m_root = index_c;
+            }
+
+            // Rotate
+            if (f.height > g.height)
+            {
+                c.child_right   = index_f;
+                a.child_right   = index_g;
+                g.parent        = index_a;
+                a.box           = merge(b.box, g.box);
+                c.box           = merge(a.box, f.box);
+                a.height        = 1 + Helper::Max(b.height, g.height);
+                c.height        = 1 + Helper::Max(a.height, f.height);
+            }
+            else
+            {
+                c.child_right   = index_g;
+                a.child_right   = index_f;
+                f.parent        = index_a;
+                a.box           = merge(b.box, f.box);
+                c.box           = merge(a.box, g.box);
+                a.height        = 1 + Helper::Max(b.height, f.height);
+                c.height        = 1 + Helper::Max(a.height, g.height);
+            }
+
+            return index_c;
+        }
+
+        // Rotate B up
+        if (balance < -1)
+        {
+            const int32_t index_d   = b.child_left;
+            const int32_t index_e   = b.child_right;
+            Node& d                 = m_nodes[index_d];
+            Node& e                 = m_nodes[index_e];
+
+            // Swap A and B
+            b.child_left    = index_a;
+            b.parent        = a.parent;
+            a.parent        = index_b;
+
+            // A's old parent should point to B
+            if (b.parent != node_null)
+            {
+                if (m_nodes[b.parent].child_left == index_a)
+                {
+                    m_nodes[b.parent].child_left = index_b;
+                }
+                else
+                {
+                    m_nodes[b.parent].child_right = index_b;
+                }
+            }
+            else
+            {
+                m_root = index_b;
+            }
+
+            // Rotate
+            if (d.height > e.height)
+            {
+                b.child_right   = index_d;
+                a.child_left    = index_e;
+                e.parent        = index_a;
+                a.box           = merge(c.box, e.box);
+                b.box           = merge(a.box, d.box);
+                a.height        = 1 + Helper::Max(c.height, e.height);
+                b.height        = 1 + Helper::Max(a.height, d.height);
+            }
+            else
+            {
+                b.child_right   = index_e;
+                a.child_left    = index_d;
+                d.parent        = index_a;
+                a.box           = merge(c.box, d.box);
+                b.box           = merge(a.box, e.box);
+                a.height        = 1 + Helper::Max(c.height, d.height);
+                b.height        = 1 + Helper::Max(a.height, e.height);
+            }
+
+            return index_b;
+        }
+
+        return index_a;
+    }
+}
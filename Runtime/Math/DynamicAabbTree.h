@@ -0,0 +1,97 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===============
+#include <vector>
+#include <functional>
+#include "BoundingBox.h"
+//==========================
+
+namespace Spartan::Math
+{
+    class Ray;
+    class Frustum;
+
+    // A dynamic bounding volume hierarchy of axis aligned bounding boxes.
+    // Leaves store a fattened box so that small movements don't require a re-insertion,
+    // and the tree is kept balanced with rotations as leaves are inserted and removed.
+    class SPARTAN_CLASS DynamicAabbTree
+    {
+    public:
+        DynamicAabbTree(float margin = 0.1f);
+        ~DynamicAabbTree() = default;
+
+        // Inserts a box, returns a proxy which identifies it
+        int32_t Insert(const BoundingBox& box, void* user_data);
+
+        // Removes a proxy
+        void Remove(int32_t proxy);
+
+        // Updates the box of a proxy, returns true if the proxy had to be re-inserted
+        bool Update(int32_t proxy, const BoundingBox& box);
+
+        // Removes all proxies
+        void Clear();
+
+        // Queries, the callbacks return false to stop the query
+        void QueryBox(const BoundingBox& box, const std::function<bool(int32_t)>& callback) const;
+        void QuerySphere(const Vector3& center, float radius, const std::function<bool(int32_t)>& callback) const;
+        void QueryFrustum(const Frustum& frustum, const std::function<bool(int32_t)>& callback) const;
+
+        // Visits proxies nearest first, the callback returns the new maximum distance (return 0 to stop, max_distance to continue)
+        void QueryRay(const Ray& ray, float max_distance, const std::function<float(int32_t, float)>& callback) const;
+
+        void* GetUserData(const int32_t proxy)                  const { return m_nodes[proxy].user_data; }
+        const BoundingBox& GetFatBox(const int32_t proxy)       const { return m_nodes[proxy].box; }
+        uint32_t GetProxyCount()                                const { return m_proxy_count; }
+        uint32_t GetHeight()                                    const { return m_root == node_null ? 0 : m_nodes[m_root].height; }
+
+    private:
+        static constexpr int32_t node_null = -1;
+
+        struct Node
+        {
+            bool IsLeaf() const { return child_left == node_null; }
+
+            BoundingBox box;
+            void* user_data     = nullptr;
+            int32_t parent      = node_null; // next free node when unused
+            int32_t child_left  = node_null;
+            int32_t child_right = node_null;
+            int32_t height      = -1; // 0 for leaves, -1 when unused
+        };
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        int32_t Balance(int32_t node);
+        void Refit(int32_t node);
+
+        std::vector<Node> m_nodes;
+        int32_t m_root          = node_null;
+        int32_t m_free_list     = node_null;
+        uint32_t m_proxy_count  = 0;
+        float m_margin          = 0.1f;
+    };
+}
@@ -110,6 +110,11 @@ namespace Spartan::Math
         return false;
     }
 
+    Intersection Frustum::IsInside(const BoundingBox& box) const
+    {
+        return CheckCube(box.GetCenter(), box.GetExtents());
+    }
+
 	Intersection Frustum::CheckCube(const Vector3& center, const Vector3& extent) const
 	{
         Intersection result = Inside;
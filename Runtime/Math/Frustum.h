@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Math/Plane.h"
 #include "Matrix.h"
 #include "Vector3.h"
+#include "BoundingBox.h"
 //========================
 
 namespace Spartan::Math
@@ -38,6 +39,9 @@ namespace Spartan::Math
 
         bool IsVisible(const Vector3& center, const Vector3& extent, bool ignore_near_plane = false) const;
 
+        // Test if a bounding box is inside
+        Intersection IsInside(const BoundingBox& box) const;
+
 	private:
         Intersection CheckCube(const Vector3& center, const Vector3& extent) const;
         Intersection CheckSphere(const Vector3& center, float radius) const;
@@ -37,6 +37,37 @@ namespace Spartan::Math
 		0, 0, 0, 1
 	);
 
+    void Matrix::Multiply(const Matrix* lhs, const Matrix* rhs, Matrix* out, const uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+#if defined(SPARTAN_SIMD_AVX)
+            Simd::matrix_multiply_avx(lhs[i].Data(), rhs[i].Data(), out[i].Data());
+#else
+            out[i] = lhs[i] * rhs[i];
+#endif
+        }
+    }
+
+    void Matrix::TransformPoints(const Matrix& transform, const Vector3* points, Vector3* out, const uint32_t count)
+    {
+#if defined(SPARTAN_SIMD_SSE)
+        // Transpose once, for the whole batch
+        __m128 r0, r1, r2, r3;
+        Simd::matrix_rows(transform.Data(), r0, r1, r2, r3);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            Simd::store_float3(Simd::transform_point(Simd::load_float3(&points[i].x), r0, r1, r2, r3), &out[i].x);
+        }
+#else
+        for (uint32_t i = 0; i < count; i++)
+        {
+            out[i] = transform * points[i];
+        }
+#endif
+    }
+
 	string Matrix::ToString() const
 	{
 		char tempBuffer[200];
@@ -25,11 +25,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Quaternion.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include "Simd.h"
 //=====================
 
 namespace Spartan::Math
 {
-	class SPARTAN_CLASS Matrix
+	class SPARTAN_CLASS alignas(16) Matrix
 	{
 	public:
 		Matrix()
@@ -286,6 +287,11 @@ namespace Spartan::Math
         [[nodiscard]] Matrix Inverted() const { return Invert(*this); }
 		static inline Matrix Invert(const Matrix& matrix)
 		{
+#if defined(SPARTAN_SIMD_SSE)
+            Matrix result;
+            Simd::matrix_invert(matrix.Data(), result.Data());
+            return result;
+#else
 			float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
 			float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
 			float v2 = matrix.m20 * matrix.m33 - matrix.m23 *matrix.m30;
@@ -339,6 +345,7 @@ namespace Spartan::Math
 				i10, i11, i12, i13,
 				i20, i21, i22, i23,
 				i30, i31, i32, i33);
+#endif
 		}
 		//================================================================================================
 
@@ -360,6 +367,11 @@ namespace Spartan::Math
 		//= MULTIPLICATION ================================================================================================================
 		Matrix operator*(const Matrix& rhs) const
 		{
+#if defined(SPARTAN_SIMD_SSE)
+            Matrix result;
+            Simd::matrix_multiply(Data(), rhs.Data(), result.Data());
+            return result;
+#else
 			return Matrix(
 				m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30,
 				m00 * rhs.m01 + m01 * rhs.m11 + m02 * rhs.m21 + m03 * rhs.m31,
@@ -378,6 +390,7 @@ namespace Spartan::Math
 				m30 * rhs.m02 + m31 * rhs.m12 + m32 * rhs.m22 + m33 * rhs.m32,
 				m30 * rhs.m03 + m31 * rhs.m13 + m32 * rhs.m23 + m33 * rhs.m33
 			);
+#endif
 		}
 
 		void operator*=(const Matrix& rhs) { (*this) = (*this) * rhs; }
@@ -404,6 +417,11 @@ namespace Spartan::Math
                 (rhs.x * m03) + (rhs.y * m13) + (rhs.z * m23) + (rhs.w * m33)
             );
         }
+
+        // Batches - out[i] = lhs[i] * rhs[i] (out can alias lhs or rhs)
+        static void Multiply(const Matrix* lhs, const Matrix* rhs, Matrix* out, uint32_t count);
+        // Batches - out[i] = points[i] * transform (out can alias points)
+        static void TransformPoints(const Matrix& transform, const Vector3* points, Vector3* out, uint32_t count);
 		//=================================================================================================================================
 
 		//= COMPARISON =====================================================
@@ -440,6 +458,7 @@ namespace Spartan::Math
 		//==================================================================
 
         [[nodiscard]] const float* Data() const { return &m00; }
+        [[nodiscard]] float* Data()             { return &m00; }
         [[nodiscard]] std::string ToString() const;
 
 		// Column-major memory representation 
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =======
 #include "Vector3.h"
+#include "Simd.h"
 //==================
 
 namespace Spartan::Math
@@ -185,6 +186,23 @@ namespace Spartan::Math
 			return start.Inverse() * end;
 		}
 
+		// Returns the normalized linear interpolation between two quaternions, along the shortest path
+		static inline Quaternion Lerp(const Quaternion& a, const Quaternion& b, const float t)
+		{
+			const float sign = (a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w) < 0.0f ? -1.0f : 1.0f;
+
+			Quaternion result
+			(
+				a.x + (b.x * sign - a.x) * t,
+				a.y + (b.y * sign - a.y) * t,
+				a.z + (b.z * sign - a.z) * t,
+				a.w + (b.w * sign - a.w) * t
+			);
+			result.Normalize();
+
+			return result;
+		}
+
 		auto Conjugate() const	    { return Quaternion(-x, -y, -z, w); }
 		float LengthSquared() const	{ return (x * x) + (y * y) + (z * z) + (w * w); }
 
@@ -232,6 +250,11 @@ namespace Spartan::Math
 
         static inline Quaternion Multiply(const Quaternion& Qa, const Quaternion& Qb)
         {
+#if defined(SPARTAN_SIMD_SSE)
+            Quaternion result;
+            Simd::quaternion_multiply(&Qa.x, &Qb.x, &result.x);
+            return result;
+#else
             const float x = Qa.x;
             const float y = Qa.y;
             const float z = Qa.z;
@@ -251,6 +274,7 @@ namespace Spartan::Math
                 ((z * num) + (num2 * w)) + num10,
                 (w * num) - num9
             );
+#endif
         }
 
 		Quaternion operator*(const Quaternion& rhs) const
@@ -21,13 +21,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==============================
 #include "Ray.h"
-#include <algorithm>
 #include "RayHit.h"
+#include "BoundingBox.h"
 #include "../Core/Context.h"
 #include "../World/World.h"
-#include "../World/Entity.h"
-#include "../World/Components/Environment.h"
-#include "../World/Components/Renderable.h"
 //=========================================
 
 //= NAMESPACES =====
@@ -43,43 +40,13 @@ namespace Spartan::Math
         const Vector3 start_to_end    = (end - start);
         m_length                = start_to_end.Length();
 		m_direction             = start_to_end.Normalized();
+		m_direction_inverse		= Vector3(1.0f / m_direction.x, 1.0f / m_direction.y, 1.0f / m_direction.z);
 	}
 
-	vector<RayHit> Ray::Trace(Context* context) const
+	vector<RayHit> Ray::Trace(Context* context, const float max_distance /*= INFINITY*/) const
 	{
-		// Find all the entities that the ray hits
 		vector<RayHit> hits;
-		const auto& entities = context->GetSubsystem<World>()->EntityGetAll();
-		for (const auto& entity : entities)
-		{
-			// Make sure there entity has a renderable
-			if (!entity->HasComponent<Renderable>())
-				continue;
-
-			// Get object oriented bounding box
-			const auto& aabb = entity->GetComponent<Renderable>()->GetAabb();
-
-			// Compute hit distance
-			auto distance = HitDistance(aabb);
-
-			// Don't store hit data if there was no hit
-			if (distance == INFINITY)
-				continue;
-
-			hits.emplace_back(
-                entity,                             // Entity
-                m_start + distance * m_direction,   // Position
-                distance,                           // Distance
-                distance == 0.0f                    // Inside
-            );
-		}
-
-		// Sort by distance (ascending)
-		sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b)
-		{
-			return a.m_distance < b.m_distance;
-		});
-
+		context->GetSubsystem<World>()->RayCast(*this, hits, max_distance);
 		return hits;
 	}
 
@@ -93,86 +60,38 @@ namespace Spartan::Math
 		if (box.IsInside(m_start))
 			return 0.0f;
 
-		auto dist = INFINITY;
-
-		// Check for intersecting in the X-direction
-		if (m_start.x < box.GetMin().x && m_direction.x > 0.0f)
+		// Slab test, narrow the [entry, exit] interval one axis at a time
+		auto distance_entry	= -INFINITY;
+		auto distance_exit	= INFINITY;
+		const auto slab = [&distance_entry, &distance_exit](const float start, const float direction, const float direction_inverse, const float min, const float max)
 		{
-            const auto x = (box.GetMin().x - m_start.x) / m_direction.x;
-			if (x < dist)
-			{
-				const auto point = m_start + x * m_direction;
-				if (point.y >= box.GetMin().y && point.y <= box.GetMax().y && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
-			}
-		}
-		if (m_start.x > box.GetMax().x && m_direction.x < 0.0f)
-		{
-			const auto x = (box.GetMax().x - m_start.x) / m_direction.x;
-			if (x < dist)
-			{
-				const auto point = m_start + x * m_direction;
-				if (point.y >= box.GetMin().y && point.y <= box.GetMax().y && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
-			}
-		}
+			// Parallel to the slab, either always in it or never
+			if (direction == 0.0f)
+				return start >= min && start <= max;
 
-		// Check for intersecting in the Y-direction
-		if (m_start.y < box.GetMin().y && m_direction.y > 0.0f)
-		{
-			const auto x = (box.GetMin().y - m_start.y) / m_direction.y;
-			if (x < dist)
-			{
-				const auto point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
-			}
-		}
-		if (m_start.y > box.GetMax().y && m_direction.y < 0.0f)
-		{
-			const auto x = (box.GetMax().y - m_start.y) / m_direction.y;
-			if (x < dist)
+			auto t_near	= (min - start) * direction_inverse;
+			auto t_far	= (max - start) * direction_inverse;
+			if (t_near > t_far)
 			{
-				const auto point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
+				swap(t_near, t_far);
 			}
-		}
 
-		// Check for intersecting in the Z-direction
-		if (m_start.z < box.GetMin().z && m_direction.z > 0.0f)
-		{
-			const auto x = (box.GetMin().z - m_start.z) / m_direction.z;
-			if (x < dist)
-			{
-				const auto point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.y >= box.GetMin().y && point.y <= box.GetMax().y)
-				{
-					dist = x;
-				}
-			}
-		}
-		if (m_start.z > box.GetMax().z && m_direction.z < 0.0f)
-		{
-			const auto x = (box.GetMax().z - m_start.z) / m_direction.z;
-			if (x < dist)
-			{
-				const auto point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.y >= box.GetMin().y && point.y <= box.GetMax().y)
-				{
-					dist = x;
-				}
-			}
-		}
+			distance_entry	= Helper::Max(distance_entry, t_near);
+			distance_exit	= Helper::Min(distance_exit, t_far);
+
+			return distance_entry <= distance_exit;
+		};
+
+		const Vector3& min = box.GetMin();
+		const Vector3& max = box.GetMax();
+		if (!slab(m_start.x, m_direction.x, m_direction_inverse.x, min.x, max.x)) return INFINITY;
+		if (!slab(m_start.y, m_direction.y, m_direction_inverse.y, min.y, max.y)) return INFINITY;
+		if (!slab(m_start.z, m_direction.z, m_direction_inverse.z, min.z, max.z)) return INFINITY;
+
+		// The box is behind the ray
+		if (distance_exit < 0.0f)
+			return INFINITY;
 
-		return dist;
+		return distance_entry;
 	}
 }
@@ -43,8 +43,8 @@ namespace Spartan
 			Ray(const Vector3& start, const Vector3& end);
 			~Ray() = default;
 
-			// Traces a ray against all entities in the world, returns all hits in a vector.
-			std::vector<RayHit> Trace(Context* context) const;
+			// Traces a ray against all renderable entities in the world, returns all hits sorted by distance.
+			std::vector<RayHit> Trace(Context* context, float max_distance = INFINITY) const;
 
 			// Returns hit distance to a bounding box, or infinity if there is no hit.
 			float HitDistance(const BoundingBox& box) const;
@@ -58,6 +58,7 @@ namespace Spartan
 			Vector3 m_start;
 			Vector3 m_end;
 			Vector3 m_direction;
+			Vector3 m_direction_inverse;
             float m_length = 0.0f;
 		};
 	}
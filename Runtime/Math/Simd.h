@@ -0,0 +1,193 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+// SSE2 is part of x64, so it's used whenever the target is x86, AVX is used (for batches) when the compiler targets it.
+// Define SPARTAN_SIMD_DISABLE to force the scalar fallback.
+#if !defined(SPARTAN_SIMD_DISABLE) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define SPARTAN_SIMD_SSE
+    #if defined(__AVX__)
+        #define SPARTAN_SIMD_AVX
+    #endif
+#endif
+
+#if defined(SPARTAN_SIMD_AVX)
+    #include <immintrin.h>
+#elif defined(SPARTAN_SIMD_SSE)
+    #include <emmintrin.h>
+#endif
+
+#if defined(SPARTAN_SIMD_SSE)
+namespace Spartan::Math::Simd
+{
+    #define SPARTAN_SHUFFLE_MASK(x, y, z, w)    ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+    #define SPARTAN_SWIZZLE(v, x, y, z, w)      _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), SPARTAN_SHUFFLE_MASK(x, y, z, w)))
+    #define SPARTAN_SHUFFLE(a, b, x, y, z, w)   _mm_shuffle_ps(a, b, SPARTAN_SHUFFLE_MASK(x, y, z, w))
+
+    // All matrices are 16 floats, stored as the Matrix class stores them (column after column)
+
+    inline void matrix_multiply(const float* lhs, const float* rhs, float* out)
+    {
+        const __m128 l0 = _mm_load_ps(lhs + 0);
+        const __m128 l1 = _mm_load_ps(lhs + 4);
+        const __m128 l2 = _mm_load_ps(lhs + 8);
+        const __m128 l3 = _mm_load_ps(lhs + 12);
+
+        for (int i = 0; i < 16; i += 4)
+        {
+            const __m128 r = _mm_load_ps(rhs + i);
+            __m128 result  = _mm_mul_ps(l0, SPARTAN_SWIZZLE(r, 0, 0, 0, 0));
+            result         = _mm_add_ps(result, _mm_mul_ps(l1, SPARTAN_SWIZZLE(r, 1, 1, 1, 1)));
+            result         = _mm_add_ps(result, _mm_mul_ps(l2, SPARTAN_SWIZZLE(r, 2, 2, 2, 2)));
+            result         = _mm_add_ps(result, _mm_mul_ps(l3, SPARTAN_SWIZZLE(r, 3, 3, 3, 3)));
+            _mm_store_ps(out + i, result);
+        }
+    }
+
+    #if defined(SPARTAN_SIMD_AVX)
+    // Two output columns per iteration
+    inline void matrix_multiply_avx(const float* lhs, const float* rhs, float* out)
+    {
+        const __m256 l0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 0));
+        const __m256 l1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 4));
+        const __m256 l2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 8));
+        const __m256 l3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 12));
+
+        for (int i = 0; i < 16; i += 8)
+        {
+            const __m256 r = _mm256_loadu_ps(rhs + i); // matrices are only 16 byte aligned
+            __m256 result  = _mm256_mul_ps(l0, _mm256_permute_ps(r, 0x00));
+            result         = _mm256_add_ps(result, _mm256_mul_ps(l1, _mm256_permute_ps(r, 0x55)));
+            result         = _mm256_add_ps(result, _mm256_mul_ps(l2, _mm256_permute_ps(r, 0xAA)));
+            result         = _mm256_add_ps(result, _mm256_mul_ps(l3, _mm256_permute_ps(r, 0xFF)));
+            _mm256_storeu_ps(out + i, result);
+        }
+    }
+    #endif
+
+    // 2x2 block helpers for the inverse, a block is stored as (m00, m01, m10, m11)
+    inline __m128 mat2_mul(const __m128 a, const __m128 b)      { return _mm_add_ps(_mm_mul_ps(a, SPARTAN_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(SPARTAN_SWIZZLE(a, 1, 0, 3, 2), SPARTAN_SWIZZLE(b, 2, 1, 2, 1))); }
+    inline __m128 mat2_adj_mul(const __m128 a, const __m128 b)  { return _mm_sub_ps(_mm_mul_ps(SPARTAN_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(SPARTAN_SWIZZLE(a, 1, 1, 2, 2), SPARTAN_SWIZZLE(b, 2, 3, 0, 1))); }
+    inline __m128 mat2_mul_adj(const __m128 a, const __m128 b)  { return _mm_sub_ps(_mm_mul_ps(a, SPARTAN_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(SPARTAN_SWIZZLE(a, 1, 0, 3, 2), SPARTAN_SWIZZLE(b, 2, 1, 2, 1))); }
+
+    // Block wise inverse. The inverse of the transpose is the transpose of the inverse,
+    // so this works on the columns the same way it would on rows.
+    inline void matrix_invert(const float* matrix, float* out)
+    {
+        const __m128 c0 = _mm_load_ps(matrix + 0);
+        const __m128 c1 = _mm_load_ps(matrix + 4);
+        const __m128 c2 = _mm_load_ps(matrix + 8);
+        const __m128 c3 = _mm_load_ps(matrix + 12);
+
+        // Sub matrices
+        const __m128 a = _mm_movelh_ps(c0, c1);
+        const __m128 b = _mm_movehl_ps(c1, c0);
+        const __m128 c = _mm_movelh_ps(c2, c3);
+        const __m128 d = _mm_movehl_ps(c3, c2);
+
+        // Determinants of the sub matrices, as (|a| |b| |c| |d|)
+        const __m128 det_sub = _mm_sub_ps(
+            _mm_mul_ps(SPARTAN_SHUFFLE(c0, c2, 0, 2, 0, 2), SPARTAN_SHUFFLE(c1, c3, 1, 3, 1, 3)),
+            _mm_mul_ps(SPARTAN_SHUFFLE(c0, c2, 1, 3, 1, 3), SPARTAN_SHUFFLE(c1, c3, 0, 2, 0, 2))
+        );
+        const __m128 det_a = SPARTAN_SWIZZLE(det_sub, 0, 0, 0, 0);
+        const __m128 det_b = SPARTAN_SWIZZLE(det_sub, 1, 1, 1, 1);
+        const __m128 det_c = SPARTAN_SWIZZLE(det_sub, 2, 2, 2, 2);
+        const __m128 det_d = SPARTAN_SWIZZLE(det_sub, 3, 3, 3, 3);
+
+        const __m128 d_c = mat2_adj_mul(d, c);
+        const __m128 a_b = mat2_adj_mul(a, b);
+        __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_mul(b, d_c));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_mul(c, a_b));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2_mul_adj(d, a_b));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_mul_adj(a, d_c));
+
+        // |m| = |a| * |d| + |b| * |c| - trace((a#b)(d#c))
+        __m128 trace = _mm_mul_ps(a_b, SPARTAN_SWIZZLE(d_c, 0, 2, 1, 3));
+        trace        = _mm_add_ps(trace, SPARTAN_SWIZZLE(trace, 2, 3, 0, 1));
+        trace        = _mm_add_ps(trace, SPARTAN_SWIZZLE(trace, 1, 0, 3, 2));
+        const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+
+        const __m128 det_reciprocal = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+        x = _mm_mul_ps(x, det_reciprocal);
+        y = _mm_mul_ps(y, det_reciprocal);
+        z = _mm_mul_ps(z, det_reciprocal);
+        w = _mm_mul_ps(w, det_reciprocal);
+
+        // Apply the adjugate and store
+        _mm_store_ps(out + 0,  SPARTAN_SHUFFLE(x, y, 3, 1, 3, 1));
+        _mm_store_ps(out + 4,  SPARTAN_SHUFFLE(x, y, 2, 0, 2, 0));
+        _mm_store_ps(out + 8,  SPARTAN_SHUFFLE(z, w, 3, 1, 3, 1));
+        _mm_store_ps(out + 12, SPARTAN_SHUFFLE(z, w, 2, 0, 2, 0));
+    }
+
+    // Returns the matrix rows, which is what a point is multiplied against
+    inline void matrix_rows(const float* matrix, __m128& r0, __m128& r1, __m128& r2, __m128& r3)
+    {
+        r0 = _mm_load_ps(matrix + 0);
+        r1 = _mm_load_ps(matrix + 4);
+        r2 = _mm_load_ps(matrix + 8);
+        r3 = _mm_load_ps(matrix + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    }
+
+    // Point (w = 1) times matrix, followed by the perspective divide
+    inline __m128 transform_point(const __m128 point, const __m128 r0, const __m128 r1, const __m128 r2, const __m128 r3)
+    {
+        __m128 result = _mm_add_ps(_mm_mul_ps(SPARTAN_SWIZZLE(point, 0, 0, 0, 0), r0), r3);
+        result        = _mm_add_ps(result, _mm_mul_ps(SPARTAN_SWIZZLE(point, 1, 1, 1, 1), r1));
+        result        = _mm_add_ps(result, _mm_mul_ps(SPARTAN_SWIZZLE(point, 2, 2, 2, 2), r2));
+
+        return _mm_div_ps(result, SPARTAN_SWIZZLE(result, 3, 3, 3, 3));
+    }
+
+    // Transforms an aabb given as center and extents, the extents are projected on the absolute rows
+    inline void transform_aabb(const __m128 center, const __m128 extents, const __m128 r0, const __m128 r1, const __m128 r2, const __m128 r3, __m128& min, __m128& max)
+    {
+        const __m128 abs_mask       = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 center_new     = transform_point(center, r0, r1, r2, r3);
+        __m128 extents_new          = _mm_mul_ps(SPARTAN_SWIZZLE(extents, 0, 0, 0, 0), _mm_and_ps(r0, abs_mask));
+        extents_new                 = _mm_add_ps(extents_new, _mm_mul_ps(SPARTAN_SWIZZLE(extents, 1, 1, 1, 1), _mm_and_ps(r1, abs_mask)));
+        extents_new                 = _mm_add_ps(extents_new, _mm_mul_ps(SPARTAN_SWIZZLE(extents, 2, 2, 2, 2), _mm_and_ps(r2, abs_mask)));
+
+        min = _mm_sub_ps(center_new, extents_new);
+        max = _mm_add_ps(center_new, extents_new);
+    }
+
+    inline __m128 load_float3(const float* v)            { return _mm_setr_ps(v[0], v[1], v[2], 0.0f); }
+    inline void store_float3(const __m128 v, float* out) { alignas(16) float result[4]; _mm_store_ps(result, v); out[0] = result[0]; out[1] = result[1]; out[2] = result[2]; }
+
+    // Hamilton product, quaternions are (x, y, z, w)
+    inline void quaternion_multiply(const float* lhs, const float* rhs, float* out)
+    {
+        const __m128 a = _mm_loadu_ps(lhs);
+        const __m128 b = _mm_loadu_ps(rhs);
+
+        __m128 result = _mm_mul_ps(SPARTAN_SWIZZLE(a, 3, 3, 3, 3), b);
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(SPARTAN_SWIZZLE(a, 0, 0, 0, 0), SPARTAN_SWIZZLE(b, 3, 2, 1, 0)), _mm_setr_ps( 1.0f, -1.0f,  1.0f, -1.0f)));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(SPARTAN_SWIZZLE(a, 1, 1, 1, 1), SPARTAN_SWIZZLE(b, 2, 3, 0, 1)), _mm_setr_ps( 1.0f,  1.0f, -1.0f, -1.0f)));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(SPARTAN_SWIZZLE(a, 2, 2, 2, 2), SPARTAN_SWIZZLE(b, 1, 0, 3, 2)), _mm_setr_ps(-1.0f,  1.0f,  1.0f, -1.0f)));
+
+        _mm_storeu_ps(out, result);
+    }
+}
+#endif
@@ -126,6 +126,9 @@ namespace Spartan::Math
         // Returns the squared distance between to vectors
         static inline float DistanceSquared(const Vector3& a, const Vector3& b)    { return (b - a).LengthSquared(); }
 
+        // Returns the linear interpolation between two vectors
+        static inline Vector3 Lerp(const Vector3& a, const Vector3& b, const float t) { return a + (b - a) * t; }
+
         // Floor
 		void Floor()
 		{
@@ -20,20 +20,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 //= INCLUDES ===================================================================
+#include <algorithm>
 #include "Physics.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsTaskScheduler.h"
+#include "PhysicsStaticMesh.h"
 #include "BulletPhysicsHelper.h"
 #include "../Core/Engine.h"
 #include "../Core/Context.h"
 #include "../Core/Settings.h"
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
+#include "../Threading/Threading.h"
+#include "../World/Components/Transform.h"
 #pragma warning(push, 0) // Hide warnings belonging to Bullet
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
-#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
-#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletSoftBody/btSoftBody.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
@@ -47,18 +53,67 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+    // Bullet has no multithreaded soft body world, builds which opt out of soft bodies (premake --no_soft_bodies)
+    // use btDiscreteDynamicsWorldMt instead, so that islands are solved in parallel too.
+#if defined(SPARTAN_PHYSICS_SOFT_BODIES)
     static const bool m_soft_body_support = true;
+#else
+    static const bool m_soft_body_support = false;
+#endif
+    static const int m_dispatcher_grain_size = 40; // overlapping pairs per task
+    static const uint32_t m_query_grain_size = 16; // below this many queries a batch runs in the calling thread
+    static const uint32_t m_transform_grain_size = 64; // below this many subtrees the write-back isn't worth splitting
+
+    // Bullet libraries which were built without BT_THREADSAFE keep the thread index in a plain static, so every
+    // thread reports the main thread's index. Asking from a worker tells the two builds apart without touching
+    // any of Bullet's mutexes (which assert in such builds).
+    static bool bullet_is_thread_safe(Threading* threading)
+    {
+        // Without workers nothing runs in parallel, so it doesn't matter
+        if (threading->GetThreadCount() == 0)
+            return true;
+
+        btGetCurrentThreadIndex(); // the calling thread takes index 0, if it doesn't have one already
+
+        atomic<bool> done           = false;
+        atomic<unsigned int> index  = 0;
+        threading->AddTask([&done, &index]()
+        {
+            index   = btGetCurrentThreadIndex();
+            done    = true;
+        });
+
+        while (!done)
+        {
+            this_thread::yield();
+        }
+
+        return index != 0;
+    }
 
 	Physics::Physics(Context* context) : ISubsystem(context)
 	{
+        // Bullet's parallel loops run on the engine's threads, this has to be set (from the main thread) before any "Mt" class is used
+        m_threading         = m_context->GetSubsystem<Threading>();
+        m_task_scheduler    = new PhysicsTaskScheduler(m_threading);
+        btSetTaskScheduler(m_task_scheduler);
+
+        // The runtime is compiled with BT_THREADSAFE=1, if the linked libraries weren't, Bullet's loops must not leave the calling thread
+        m_bullet_thread_safe = bullet_is_thread_safe(m_threading);
+        if (!m_bullet_thread_safe)
+        {
+            LOG_ERROR("The Bullet libraries were built without BT_THREADSAFE=1, rebuild them with it. Physics will run on a single thread.");
+            m_task_scheduler->setNumThreads(1);
+        }
+
         m_broadphase        = new btDbvtBroadphase();
-        m_constraint_solver = new btSequentialImpulseConstraintSolver();
+        m_constraint_solver = new btSequentialImpulseConstraintSolverMt(); // batches the constraints of large islands and solves them in parallel
 
         if (m_soft_body_support)
         {
             // Create
             m_collision_configuration  = new btSoftBodyRigidBodyCollisionConfiguration();
-            m_collision_dispatcher     = new btCollisionDispatcher(m_collision_configuration);
+            m_collision_dispatcher     = new btCollisionDispatcherMt(m_collision_configuration, m_dispatcher_grain_size);
             m_world                    = new btSoftRigidDynamicsWorld(m_collision_dispatcher, m_broadphase, m_constraint_solver, m_collision_configuration);
 
             // Setup         
@@ -78,8 +133,9 @@ namespace Spartan
         {
             // Create
             m_collision_configuration   = new btDefaultCollisionConfiguration();
-            m_collision_dispatcher      = new btCollisionDispatcher(m_collision_configuration);
-            m_world                     = new btDiscreteDynamicsWorld(m_collision_dispatcher, m_broadphase, m_constraint_solver, m_collision_configuration);
+            m_collision_dispatcher      = new btCollisionDispatcherMt(m_collision_configuration, m_dispatcher_grain_size);
+            m_constraint_solver_pool    = new btConstraintSolverPoolMt(m_task_scheduler->getNumThreads()); // islands are solved in parallel, one solver per thread
+            m_world                     = new btDiscreteDynamicsWorldMt(m_collision_dispatcher, m_broadphase, m_constraint_solver_pool, m_constraint_solver, m_collision_configuration);
         }
 
         // Setup
@@ -91,13 +147,22 @@ namespace Spartan
 
 	Physics::~Physics()
 	{
+        SetSimulationThreaded(false);
+
         safe_delete(m_world);
+        safe_delete(m_constraint_solver_pool);
         safe_delete(m_constraint_solver);
         safe_delete(m_collision_dispatcher);
         safe_delete(m_collision_configuration);
         safe_delete(m_broadphase);
         safe_delete(m_world_info);
         safe_delete(m_debug_draw);
+
+        if (btGetTaskScheduler() == m_task_scheduler)
+        {
+            btSetTaskScheduler(btGetSequentialTaskScheduler());
+        }
+        safe_delete(m_task_scheduler);
 	}
 
 	bool Physics::Initialize()
@@ -128,6 +193,40 @@ namespace Spartan
 	{
 		if (!m_world)
 			return;
+
+        m_frame_delta_time      = delta_time_sec;
+        m_simulation_enabled    = m_context->m_engine->EngineMode_IsSet(Engine_Physics) && m_context->m_engine->EngineMode_IsSet(Engine_Game);
+
+        // The simulation runs on its own thread, pick up the latest published step and see how far past it we are.
+        // Debug drawing is skipped as the world can't be read from this thread while it's being simulated.
+        if (m_threaded)
+        {
+            bool is_new_step = false;
+            {
+                lock_guard<mutex> lock(m_states_mutex);
+                if (m_states_published_version != m_states_front_version)
+                {
+                    m_states_front.swap(m_states_published);
+                    m_states_front_time     = m_states_published_time;
+                    m_states_front_version  = m_states_published_version;
+                    is_new_step             = true;
+                }
+            }
+
+            if (is_new_step)
+            {
+                m_states_front_index.clear();
+                for (uint32_t i = 0; i < static_cast<uint32_t>(m_states_front.size()); i++)
+                {
+                    m_states_front_index[m_states_front[i].id] = i;
+                }
+            }
+
+            const float time_since_step = chrono::duration<float>(chrono::steady_clock::now() - m_states_front_time).count();
+            m_interpolation_alpha       = Helper::Saturate(time_since_step * m_internal_fps);
+
+            return;
+        }
 		
 		// Debug draw
 		if (m_renderer->GetOptions() & Render_Debug_Physics)
@@ -136,7 +235,7 @@ namespace Spartan
 		}
 
 		// Don't simulate physics if they are turned off or the we are in editor mode
-		if (!m_context->m_engine->EngineMode_IsSet(Engine_Physics) || !m_context->m_engine->EngineMode_IsSet(Engine_Game))
+		if (!m_simulation_enabled)
 			return;
 
         SCOPED_TIME_BLOCK(m_profiler);
@@ -155,64 +254,479 @@ namespace Spartan
 		}
 
 		// Step the physics world. 
-		m_simulating = true;
-        m_world->stepSimulation(delta_time_sec, max_substeps, internal_time_step);
-		m_simulating = false;
+        {
+            lock_guard<mutex> lock(m_world_mutex);
+		    m_simulating = true;
+            m_world->stepSimulation(delta_time_sec, max_substeps, internal_time_step);
+		    m_simulating = false;
+        }
+
+        FlushTransforms();
 	}
 
-    void Physics::AddBody(btRigidBody* body) const
+    void Physics::AddBody(btRigidBody* body)
     {
         if (!m_world)
             return;
 
-        m_world->addRigidBody(body);
+        // Identifies the body's published state
+        body->setUserIndex(++m_body_id);
+
+        Enqueue([this, body]() { m_world->addRigidBody(body); });
     }
 
-    void Physics::RemoveBody(btRigidBody*& body) const
+    void Physics::RemoveBody(btRigidBody*& body)
     {
         if (!m_world)
             return;
 
-        m_world->removeRigidBody(body);
-        delete body->getMotionState();
-        safe_delete(body);
+        btRigidBody* body_removed = body;
+        body = nullptr;
+
+        Enqueue([this, body_removed]()
+        {
+            m_world->removeRigidBody(body_removed);
+            m_states_simulated.erase(body_removed->getUserIndex());
+            delete body_removed->getMotionState();
+            delete body_removed;
+        });
     }
 
-    void Physics::AddConstraint(btTypedConstraint* constraint, bool collision_with_linked_body /*= true*/) const
+    void Physics::AddConstraint(btTypedConstraint* constraint, bool collision_with_linked_body /*= true*/)
     {
         if (!m_world)
             return;
 
-        m_world->addConstraint(constraint, !collision_with_linked_body);
+        Enqueue([this, constraint, collision_with_linked_body]() { m_world->addConstraint(constraint, !collision_with_linked_body); });
     }
 
-    void Physics::RemoveConstraint(btTypedConstraint*& constraint) const
+    void Physics::RemoveConstraint(btTypedConstraint*& constraint)
     {
         if (!m_world)
             return;
 
-        m_world->removeConstraint(constraint);
-        safe_delete(constraint);
+        btTypedConstraint* constraint_removed = constraint;
+        constraint = nullptr;
+
+        Enqueue([this, constraint_removed]()
+        {
+            m_world->removeConstraint(constraint_removed);
+            delete constraint_removed;
+        });
     }
 
-    void Physics::AddBody(btSoftBody* body) const
+    void Physics::AddBody(btSoftBody* body)
     {
-        if (!m_world)
+        if (!m_world || !IsSoftBodySupported())
             return;
 
         if (btSoftRigidDynamicsWorld* world = static_cast<btSoftRigidDynamicsWorld*>(m_world))
         {
-            world->addSoftBody(body);
+            Enqueue([world, body]() { world->addSoftBody(body); });
         }
     }
 
-    void Physics::RemoveBody(btSoftBody*& body) const
+    void Physics::RemoveBody(btSoftBody*& body)
     {
+        if (!IsSoftBodySupported())
+            return;
+
         if (btSoftRigidDynamicsWorld* world = static_cast<btSoftRigidDynamicsWorld*>(m_world))
         {
-            world->removeSoftBody(body);
-            safe_delete(body);
+            btSoftBody* body_removed = body;
+            body = nullptr;
+
+            Enqueue([world, body_removed]()
+            {
+                world->removeSoftBody(body_removed);
+                delete body_removed;
+            });
+        }
+    }
+
+    void Physics::RemoveShape(btCollisionShape*& shape)
+    {
+        btCollisionShape* shape_removed = shape;
+        shape = nullptr;
+
+        // Queued after the removal of the bodies which use it
+        Enqueue([shape_removed]() { delete shape_removed; });
+    }
+
+    // Runs the queries of a batch in parallel. Bullet's broadphase only has a ray traversal stack per thread when its libraries
+    // were built with BT_THREADSAFE (see IsBulletThreadSafe()), otherwise rays and sweeps share one so a batch runs in a single thread.
+    template <typename Function>
+    static void execute_queries(Threading* threading, const bool parallel, const uint32_t count, Function&& function)
+    {
+        if (parallel && count >= m_query_grain_size)
+        {
+            threading->AddTaskLoop([&function](uint32_t start, uint32_t end)
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    function(i);
+                }
+            }, count);
+            return;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            function(i);
+        }
+    }
+
+    void Physics::Submit(const shared_ptr<PhysicsQueryBatch>& batch)
+    {
+        if (!batch)
+            return;
+
+        batch->done = false;
+
+        if (!m_threaded)
+        {
+            lock_guard<mutex> lock(m_world_mutex);
+            ExecuteQueryBatch(*batch);
+            return;
+        }
+
+        {
+            lock_guard<mutex> lock(m_query_batches_mutex);
+            m_query_batches.emplace_back(batch);
         }
+        m_thread_condition.notify_one();
+    }
+
+    void Physics::ExecuteQueryBatches()
+    {
+        {
+            lock_guard<mutex> lock(m_query_batches_mutex);
+            m_query_batches_executing.swap(m_query_batches);
+        }
+
+        for (shared_ptr<PhysicsQueryBatch>& batch : m_query_batches_executing)
+        {
+            ExecuteQueryBatch(*batch);
+        }
+
+        m_query_batches_executing.clear();
+    }
+
+    void Physics::ExecuteQueryBatch(PhysicsQueryBatch& batch)
+    {
+        const uint32_t ray_count        = static_cast<uint32_t>(batch.rays.size());
+        const uint32_t sweep_count      = static_cast<uint32_t>(batch.sweeps.size());
+        const uint32_t overlap_count    = static_cast<uint32_t>(batch.overlaps.size());
+        const uint32_t max_bodies       = batch.overlap_max_bodies;
+
+        batch.ray_hits.assign(ray_count, PhysicsHit());
+        batch.sweep_hits.assign(sweep_count, PhysicsHit());
+        batch.overlap_bodies.assign(static_cast<size_t>(overlap_count) * max_bodies, nullptr);
+        batch.overlap_counts.assign(overlap_count, 0);
+
+        if (m_world)
+        {
+            execute_queries(m_threading, m_bullet_thread_safe, ray_count, [this, &batch](const uint32_t i)
+            {
+                PhysicsQuery::RayCast(m_world, batch.rays[i], batch.ray_hits[i]);
+            });
+
+            execute_queries(m_threading, m_bullet_thread_safe, sweep_count, [this, &batch](const uint32_t i)
+            {
+                PhysicsQuery::Sweep(m_world, batch.sweeps[i], batch.sweep_hits[i]);
+            });
+
+            execute_queries(m_threading, m_bullet_thread_safe, overlap_count, [this, &batch, max_bodies](const uint32_t i)
+            {
+                batch.overlap_counts[i] = PhysicsQuery::Overlap(m_world, batch.overlaps[i], &batch.overlap_bodies[i * max_bodies], max_bodies);
+            });
+        }
+
+        batch.done.store(true, memory_order_release);
+    }
+
+    btBvhTriangleMeshShape* Physics::AcquireStaticMesh(const vector<uint32_t>& indices, const vector<RHI_Vertex_PosTexNorTan>& vertices, const string& cache_file_path_base)
+    {
+        const uint64_t key = PhysicsStaticMesh::ComputeKey(indices, vertices);
+
+        auto it = m_static_meshes.find(key);
+        if (it == m_static_meshes.end())
+        {
+            auto mesh = make_unique<PhysicsStaticMesh>(indices, vertices);
+            if (!mesh->Create(cache_file_path_base.empty() ? "" : cache_file_path_base + "_" + to_string(key) + ".bvh"))
+                return nullptr;
+
+            it = m_static_meshes.emplace(key, move(mesh)).first;
+        }
+
+        it->second->AddRef();
+        return it->second->GetShape();
+    }
+
+    void Physics::ReleaseStaticMesh(btBvhTriangleMeshShape*& shape)
+    {
+        if (!shape)
+            return;
+
+        for (auto it = m_static_meshes.begin(); it != m_static_meshes.end(); it++)
+        {
+            if (it->second->GetShape() != shape)
+                continue;
+
+            if (it->second->Release())
+            {
+                // Queued after the removal of the bodies which use it
+                PhysicsStaticMesh* mesh = it->second.release();
+                m_static_meshes.erase(it);
+                Enqueue([mesh]() { delete mesh; });
+            }
+            break;
+        }
+
+        shape = nullptr;
+    }
+
+    void Physics::QueueTransform(Transform* transform, const Vector3& position, const Quaternion& rotation)
+    {
+        // A body can be moved more than once per frame, the last write wins
+        const auto it = m_transform_write_index.find(transform);
+        if (it != m_transform_write_index.end())
+        {
+            m_transform_writes[it->second].position = position;
+            m_transform_writes[it->second].rotation = rotation;
+            return;
+        }
+
+        m_transform_write_index[transform] = static_cast<uint32_t>(m_transform_writes.size());
+        m_transform_writes.push_back({ transform, position, rotation, 0 });
+    }
+
+    void Physics::FlushTransforms()
+    {
+        if (m_transform_writes.empty())
+            return;
+
+        // Writes under another moved transform have to wait for their parent's world matrix, the rest are
+        // independent subtrees, each of which gets updated (children included) exactly once.
+        uint32_t root_count = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_transform_writes.size()); i++)
+        {
+            TransformWrite& write = m_transform_writes[i];
+
+            uint32_t depth = 0;
+            bool is_nested = false;
+            for (Transform* parent = write.transform->GetParent(); parent; parent = parent->GetParent())
+            {
+                depth++;
+                is_nested = is_nested || m_transform_write_index.count(parent) != 0;
+            }
+
+            if (is_nested)
+            {
+                write.depth = depth;
+                m_transform_writes_nested.emplace_back(write);
+            }
+            else
+            {
+                m_transform_writes[root_count++] = write;
+            }
+        }
+
+        const auto write_range = [this](uint32_t start, uint32_t end)
+        {
+            for (uint32_t i = start; i < end; i++)
+            {
+                m_transform_writes[i].transform->SetPositionAndRotation(m_transform_writes[i].position, m_transform_writes[i].rotation);
+            }
+        };
+
+        if (root_count >= m_transform_grain_size)
+        {
+            m_threading->AddTaskLoop(write_range, root_count);
+        }
+        else
+        {
+            write_range(0, root_count);
+        }
+
+        // Rare (bodies parented to bodies), parents first
+        sort(m_transform_writes_nested.begin(), m_transform_writes_nested.end(), [](const TransformWrite& a, const TransformWrite& b) { return a.depth < b.depth; });
+        for (const TransformWrite& write : m_transform_writes_nested)
+        {
+            write.transform->SetPositionAndRotation(write.position, write.rotation);
+        }
+
+        m_transform_writes.clear();
+        m_transform_writes_nested.clear();
+        m_transform_write_index.clear();
+    }
+
+    void Physics::SetSimulationThreaded(const bool threaded)
+    {
+        if (threaded == m_threaded)
+            return;
+
+        if (threaded)
+        {
+            m_states_simulated.clear();
+            m_thread_stop   = false;
+            m_threaded      = true;
+            m_thread        = thread(&Physics::ThreadLoop, this);
+        }
+        else
+        {
+            {
+                lock_guard<mutex> lock(m_query_batches_mutex);
+                m_thread_stop = true;
+            }
+            m_thread_condition.notify_one();
+            m_thread.join();
+            m_threaded = false;
+
+            // Anything that was queued after the last step
+            ExecuteCommands();
+            ExecuteQueryBatches();
+
+            m_states_front.clear();
+            m_states_front_index.clear();
+            m_interpolation_alpha = 1.0f;
+        }
+    }
+
+    void Physics::Enqueue(function<void()>&& command)
+    {
+        if (!m_threaded)
+        {
+            command();
+            return;
+        }
+
+        lock_guard<mutex> lock(m_commands_mutex);
+        m_commands.emplace_back(move(command));
+    }
+
+    bool Physics::GetBodyState(const int body_id, PhysicsBodyState& state) const
+    {
+        const auto it = m_states_front_index.find(body_id);
+        if (it == m_states_front_index.end())
+            return false;
+
+        state = m_states_front[it->second];
+        return true;
+    }
+
+    void Physics::ThreadLoop()
+    {
+        const auto step_duration    = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(1.0 / m_internal_fps));
+        const float step_sec        = 1.0f / m_internal_fps;
+        const int steps_max         = Helper::Max(m_max_sub_steps, 1);
+        auto step_time              = chrono::steady_clock::now();
+
+        // Publish the current state, so bodies can be queried before the first step
+        {
+            lock_guard<mutex> lock(m_world_mutex);
+            ExecuteCommands();
+            PublishStates(step_time, false);
+        }
+
+        while (!m_thread_stop)
+        {
+            unique_lock<mutex> lock(m_world_mutex);
+
+            const bool executed_commands    = ExecuteCommands();
+            const auto now                  = chrono::steady_clock::now();
+
+            if (m_simulation_enabled)
+            {
+                // Catch up in fixed steps, time beyond the maximum number of steps is dropped instead of spiraling
+                int steps = 0;
+                while (step_time + step_duration <= now && steps < steps_max)
+                {
+                    m_simulating = true;
+                    m_world->stepSimulation(step_sec, 0); // no sub-steps, a single step of exactly this duration
+                    m_simulating = false;
+
+                    step_time += step_duration;
+                    steps++;
+
+                    PublishStates(step_time, true);
+                }
+
+                if (step_time + step_duration <= now)
+                {
+                    step_time = now;
+                }
+            }
+            else
+            {
+                step_time = now;
+
+                // Commands (e.g. the editor moving a body) still need to be visible
+                if (executed_commands)
+                {
+                    PublishStates(step_time, false);
+                }
+            }
+
+            // Queries see the world in between steps
+            ExecuteQueryBatches();
+            lock.unlock();
+
+            // Sleep until the next step, submitted query batches wake the thread so they don't have to wait for it
+            unique_lock<mutex> lock_batches(m_query_batches_mutex);
+            m_thread_condition.wait_until(lock_batches, step_time + step_duration, [this]() { return m_thread_stop || !m_query_batches.empty(); });
+        }
+    }
+
+    bool Physics::ExecuteCommands()
+    {
+        {
+            lock_guard<mutex> lock(m_commands_mutex);
+            m_commands_executing.swap(m_commands);
+        }
+
+        for (function<void()>& command : m_commands_executing)
+        {
+            command();
+        }
+
+        const bool executed = !m_commands_executing.empty();
+        m_commands_executing.clear();
+        return executed;
+    }
+
+    void Physics::PublishStates(const chrono::steady_clock::time_point step_time, const bool stepped)
+    {
+        m_states_back.clear();
+
+        const btCollisionObjectArray& objects = m_world->getCollisionObjectArray();
+        for (int i = 0; i < objects.size(); i++)
+        {
+            const btRigidBody* body = btRigidBody::upcast(objects[i]);
+            if (!body || body->getUserIndex() <= 0)
+                continue;
+
+            const btTransform& transform    = body->getWorldTransform();
+            const Vector3 position          = ToVector3(transform.getOrigin());
+            const Quaternion rotation       = ToQuaternion(transform.getRotation());
+
+            // Without a step in between there is nothing to interpolate (e.g. a body was just added or moved)
+            PhysicsBodyState& state = m_states_simulated[body->getUserIndex()];
+            const bool interpolate  = stepped && state.id != 0;
+            state.id                = body->getUserIndex();
+            state.active            = body->isActive();
+            state.position_previous = interpolate ? state.position : position;
+            state.rotation_previous = interpolate ? state.rotation : rotation;
+            state.position          = position;
+            state.rotation          = rotation;
+
+            m_states_back.emplace_back(state);
+        }
+
+        lock_guard<mutex> lock(m_states_mutex);
+        m_states_back.swap(m_states_published);
+        m_states_published_time = step_time;
+        m_states_published_version++;
     }
 
     Vector3 Physics::GetGravity() const
@@ -21,31 +21,62 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ==================
+//= INCLUDES =====================
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include <memory>
 #include "../Core/ISubsystem.h"
+#include "../RHI/RHI_Vertex.h"
+#include "PhysicsQuery.h"
 #include "../Math/Vector3.h"
-//=============================
+#include "../Math/Quaternion.h"
+//================================
 
 //= FORWARD DECLARATIONS =================
 class btBroadphaseInterface;
 class btCollisionDispatcher;
 class btSequentialImpulseConstraintSolver;
+class btConstraintSolverPoolMt;
 class btDefaultCollisionConfiguration;
 class btCollisionObject;
 class btDiscreteDynamicsWorld;
 class btRigidBody;
 class btSoftBody;
 class btTypedConstraint;
+class btCollisionShape;
+class btBvhTriangleMeshShape;
 struct btSoftBodyWorldInfo;
 //========================================
 
 namespace Spartan
 {
 	class Renderer;
+	class Threading;
+	class Transform;
 	class PhysicsDebugDraw;
+	class PhysicsTaskScheduler;
+	class PhysicsStaticMesh;
+	class RigidBody;
 	class Profiler;
 	namespace Math { class Vector3; }	
 
+	// The simulated transform of a rigid body (center of mass), along with the one of the step before so that it can be interpolated
+	struct PhysicsBodyState
+	{
+		int id                              = 0;
+		bool active                         = false;
+		Math::Vector3 position_previous     = Math::Vector3::Zero;
+		Math::Vector3 position              = Math::Vector3::Zero;
+		Math::Quaternion rotation_previous  = Math::Quaternion::Identity;
+		Math::Quaternion rotation           = Math::Quaternion::Identity;
+	};
+
 	class Physics : public ISubsystem
 	{
 	public:
@@ -58,35 +89,74 @@ namespace Spartan
 		//===================================
 
         // Rigid body
-        void AddBody(btRigidBody* body) const;
-        void RemoveBody(btRigidBody*& body) const;
+        void AddBody(btRigidBody* body);
+        void RemoveBody(btRigidBody*& body);
 
         // Soft body
-        void AddBody(btSoftBody* body) const;
-        void RemoveBody(btSoftBody*& body) const;
+        void AddBody(btSoftBody* body);
+        void RemoveBody(btSoftBody*& body);
 
         // Constraint
-        void AddConstraint(btTypedConstraint* constraint, bool collision_with_linked_body = true) const;
-        void RemoveConstraint(btTypedConstraint*& constraint) const;
+        void AddConstraint(btTypedConstraint* constraint, bool collision_with_linked_body = true);
+        void RemoveConstraint(btTypedConstraint*& constraint);
+
+        // Scene queries, the queries of a batch run in parallel. While the simulation is threaded, the physics thread executes
+        // submitted batches between two steps and the caller polls IsDone() instead of waiting for a step to finish,
+        // otherwise they execute immediately.
+        void Submit(const std::shared_ptr<PhysicsQueryBatch>& batch);
+
+        // Shape, deleted once no body can be using it
+        void RemoveShape(btCollisionShape*& shape);
+
+        // Static triangle mesh, shared by everyone who acquires the same geometry. The BVH is cached
+        // in "<cache_file_path_base>_<content hash>.bvh", an empty base keeps it in memory only.
+        btBvhTriangleMeshShape* AcquireStaticMesh(const std::vector<uint32_t>& indices, const std::vector<RHI_Vertex_PosTexNorTan>& vertices, const std::string& cache_file_path_base);
+        void ReleaseStaticMesh(btBvhTriangleMeshShape*& shape);
+
+        // Bodies moved by a step, written back to their transforms in one pass once the step is done
+        void QueueTransform(Transform* transform, const Math::Vector3& position, const Math::Quaternion& rotation);
+
+        // Threaded simulation, steps at a fixed rate on a dedicated thread. Anything which modifies the simulation has to go
+        // through Enqueue() (it executes immediately when the simulation isn't threaded), commands are applied between steps.
+        void SetSimulationThreaded(bool threaded);
+        bool IsSimulationThreaded() const { return m_threaded; }
+        void Enqueue(std::function<void()>&& command);
+
+        // The latest published state of a body and how far (0 to 1) the game thread is between it and the next step
+        bool GetBodyState(int body_id, PhysicsBodyState& state) const;
+        float GetInterpolationAlpha()   const { return m_interpolation_alpha; }
+        float GetFrameDeltaTime()       const { return m_frame_delta_time; }
 
         // Properties
 		Math::Vector3 GetGravity()  const;
         auto& GetSoftWorldInfo()    const { return *m_world_info; }
+        bool IsSoftBodySupported()  const { return m_world_info != nullptr; }
+        bool IsBulletThreadSafe()   const { return m_bullet_thread_safe; }
         auto GetPhysicsDebugDraw()  const { return m_debug_draw; }
 		bool IsSimulating()         const { return m_simulating; }
 
 	private:
+        void ThreadLoop();
+        bool ExecuteCommands();
+        void ExecuteQueryBatches();
+        void ExecuteQueryBatch(PhysicsQueryBatch& batch);
+        void PublishStates(std::chrono::steady_clock::time_point step_time, bool stepped);
+        void FlushTransforms();
+
         btBroadphaseInterface* m_broadphase                         = nullptr;
         btCollisionDispatcher* m_collision_dispatcher               = nullptr;
         btSequentialImpulseConstraintSolver* m_constraint_solver    = nullptr;
+        btConstraintSolverPoolMt* m_constraint_solver_pool          = nullptr;
         btDefaultCollisionConfiguration* m_collision_configuration  = nullptr;
         btDiscreteDynamicsWorld* m_world                            = nullptr;
         btSoftBodyWorldInfo* m_world_info                           = nullptr;
         PhysicsDebugDraw* m_debug_draw                              = nullptr;
+        PhysicsTaskScheduler* m_task_scheduler                      = nullptr;
 
         // Misc
-        Renderer* m_renderer = nullptr;
-        Profiler* m_profiler = nullptr;
+        Renderer* m_renderer    = nullptr;
+        Profiler* m_profiler    = nullptr;
+        Threading* m_threading  = nullptr;
 
 		//= PROPERTIES =================================================
         int m_max_sub_steps         = 1;
@@ -95,5 +165,55 @@ namespace Spartan
         Math::Vector3 m_gravity     = Math::Vector3(0.0f, -9.81f, 0.0f);
         bool m_simulating           = false;
 		//==============================================================
+
+        // Whether the linked Bullet libraries were built with BT_THREADSAFE, checked on startup
+        bool m_bullet_thread_safe = false;
+
+        // Held while the world is being modified by a step or read by queries
+        std::mutex m_world_mutex;
+
+        // Static meshes, by content hash
+        std::unordered_map<uint64_t, std::unique_ptr<PhysicsStaticMesh>> m_static_meshes;
+
+        // Transform write-back
+        struct TransformWrite
+        {
+            Transform* transform;
+            Math::Vector3 position;
+            Math::Quaternion rotation;
+            uint32_t depth;
+        };
+        std::vector<TransformWrite> m_transform_writes;
+        std::vector<TransformWrite> m_transform_writes_nested;
+        std::unordered_map<Transform*, uint32_t> m_transform_write_index;
+
+        // Threaded simulation
+        std::thread m_thread;
+        std::atomic<bool> m_threaded                = false;
+        std::atomic<bool> m_thread_stop             = false;
+        std::atomic<bool> m_simulation_enabled      = false; // physics and game mode, snapshotted by the game thread every tick
+        std::vector<std::function<void()>> m_commands;
+        std::vector<std::function<void()>> m_commands_executing;
+        std::mutex m_commands_mutex;
+        std::vector<std::shared_ptr<PhysicsQueryBatch>> m_query_batches;
+        std::vector<std::shared_ptr<PhysicsQueryBatch>> m_query_batches_executing;
+        std::mutex m_query_batches_mutex;
+        std::condition_variable m_thread_condition; // wakes the physics thread before its next step, to stop or execute query batches
+        int m_body_id                               = 0;
+        float m_frame_delta_time                    = 0.0f;
+        float m_interpolation_alpha                 = 1.0f;
+
+        // Body states, the physics thread fills the back buffer and swaps it with the published one,
+        // the game thread swaps the published one with the front buffer when a newer step is available.
+        std::unordered_map<int, PhysicsBodyState> m_states_simulated; // physics thread only
+        std::vector<PhysicsBodyState> m_states_back;
+        std::vector<PhysicsBodyState> m_states_published;
+        std::vector<PhysicsBodyState> m_states_front;
+        std::unordered_map<int, uint32_t> m_states_front_index;
+        std::chrono::steady_clock::time_point m_states_published_time;
+        std::chrono::steady_clock::time_point m_states_front_time;
+        uint64_t m_states_published_version         = 0;
+        uint64_t m_states_front_version             = 0;
+        std::mutex m_states_mutex;
 	};
 }
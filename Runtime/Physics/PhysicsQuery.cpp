@@ -0,0 +1,231 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================================================
+#include <memory>
+#include "PhysicsQuery.h"
+#include "BulletPhysicsHelper.h"
+#pragma warning(push, 0) // Hide warnings belonging to Bullet
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btConcaveShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpa2.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#pragma warning(pop)
+//=====================================================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+    static unique_ptr<btConvexShape> create_shape(const PhysicsQueryShape type, const Vector3& size)
+    {
+        switch (type)
+        {
+            case PhysicsQueryShape_Box:     return make_unique<btBoxShape>(ToBtVector3(size));
+            case PhysicsQueryShape_Capsule: return make_unique<btCapsuleShape>(size.x, size.y * 2.0f);
+            default:                        return make_unique<btSphereShape>(size.x);
+        }
+    }
+
+    static RigidBody* get_rigid_body(const btCollisionObject* object)
+    {
+        return btRigidBody::upcast(object) ? static_cast<RigidBody*>(object->getUserPointer()) : nullptr;
+    }
+
+    // Shapes are treated as overlapping when they are closer than their collision margins (spheres and capsules are all margin)
+    static bool overlap_convex(const btConvexShape* shape_a, const btTransform& transform_a, const btConvexShape* shape_b, const btTransform& transform_b)
+    {
+        btVector3 guess = transform_b.getOrigin() - transform_a.getOrigin();
+        if (guess.fuzzyZero())
+        {
+            guess = btVector3(1.0f, 0.0f, 0.0f);
+        }
+
+        btGjkEpaSolver2::sResults results;
+        if (!btGjkEpaSolver2::Distance(shape_a, transform_a, shape_b, transform_b, guess, results))
+            return true; // the cores intersect
+
+        return results.distance <= shape_a->getMargin() + shape_b->getMargin();
+    }
+
+    class TriangleOverlapCallback : public btTriangleCallback
+    {
+    public:
+        TriangleOverlapCallback(const btConvexShape* shape, const btTransform& shape_transform, const btTransform& mesh_transform)
+            : m_shape(shape), m_shape_transform(shape_transform), m_mesh_transform(mesh_transform) {}
+
+        void processTriangle(btVector3* triangle, int, int) override
+        {
+            if (m_overlap)
+                return;
+
+            btTriangleShape triangle_shape(triangle[0], triangle[1], triangle[2]);
+            triangle_shape.setMargin(0.0f);
+            m_overlap = overlap_convex(m_shape, m_shape_transform, &triangle_shape, m_mesh_transform);
+        }
+
+        bool m_overlap = false;
+
+    private:
+        const btConvexShape* m_shape;
+        const btTransform& m_shape_transform;
+        const btTransform& m_mesh_transform;
+    };
+
+    static bool overlap_shape(const btConvexShape* query_shape, const btTransform& query_transform, const btCollisionShape* shape, const btTransform& transform)
+    {
+        if (shape->isConvex())
+            return overlap_convex(query_shape, query_transform, static_cast<const btConvexShape*>(shape), transform);
+
+        if (shape->isCompound())
+        {
+            const auto compound = static_cast<const btCompoundShape*>(shape);
+            for (int i = 0; i < compound->getNumChildShapes(); i++)
+            {
+                if (overlap_shape(query_shape, query_transform, compound->getChildShape(i), transform * compound->getChildTransform(i)))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // Triangle meshes, planes, heightfields, only the triangles within the query's bounds (in mesh space) are tested
+        if (shape->isConcave())
+        {
+            btVector3 aabb_min, aabb_max;
+            query_shape->getAabb(transform.inverse() * query_transform, aabb_min, aabb_max);
+
+            TriangleOverlapCallback callback(query_shape, query_transform, transform);
+            static_cast<const btConcaveShape*>(shape)->processAllTriangles(&callback, aabb_min, aabb_max);
+            return callback.m_overlap;
+        }
+
+        return false;
+    }
+
+    class BroadphaseOverlapCallback : public btBroadphaseAabbCallback
+    {
+    public:
+        BroadphaseOverlapCallback(const PhysicsOverlap& overlap, const btConvexShape* shape, const btTransform& transform, RigidBody** bodies, const uint32_t max_bodies)
+            : m_overlap(overlap), m_shape(shape), m_transform(transform), m_bodies(bodies), m_max_bodies(max_bodies) {}
+
+        bool process(const btBroadphaseProxy* proxy) override
+        {
+            if (m_count == m_max_bodies || (proxy->m_collisionFilterGroup & m_overlap.mask) == 0)
+                return false;
+
+            const auto object   = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+            RigidBody* body     = get_rigid_body(object);
+            if (!body)
+                return true;
+
+            if (overlap_shape(m_shape, m_transform, object->getCollisionShape(), object->getWorldTransform()))
+            {
+                m_bodies[m_count++] = body;
+            }
+
+            return true;
+        }
+
+        uint32_t m_count = 0;
+
+    private:
+        const PhysicsOverlap& m_overlap;
+        const btConvexShape* m_shape;
+        const btTransform& m_transform;
+        RigidBody** m_bodies;
+        uint32_t m_max_bodies;
+    };
+
+    void PhysicsQuery::RayCast(const btCollisionWorld* world, const PhysicsRay& ray, PhysicsHit& hit)
+    {
+        const btVector3 from    = ToBtVector3(ray.from);
+        const btVector3 to      = ToBtVector3(ray.to);
+
+        btCollisionWorld::ClosestRayResultCallback callback(from, to);
+        callback.m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
+        callback.m_collisionFilterMask  = static_cast<int>(ray.mask);
+        world->rayTest(from, to, callback);
+
+        hit.hit = callback.hasHit();
+        if (!hit.hit)
+        {
+            hit = PhysicsHit();
+            return;
+        }
+
+        hit.body        = get_rigid_body(callback.m_collisionObject);
+        hit.position    = ToVector3(callback.m_hitPointWorld);
+        hit.normal      = ToVector3(callback.m_hitNormalWorld);
+        hit.fraction    = callback.m_closestHitFraction;
+    }
+
+    void PhysicsQuery::Sweep(const btCollisionWorld* world, const PhysicsSweep& sweep, PhysicsHit& hit)
+    {
+        const unique_ptr<btConvexShape> shape = create_shape(sweep.shape, sweep.size);
+        const btTransform from(ToBtQuaternion(sweep.rotation), ToBtVector3(sweep.from));
+        const btTransform to(ToBtQuaternion(sweep.rotation), ToBtVector3(sweep.to));
+
+        btCollisionWorld::ClosestConvexResultCallback callback(from.getOrigin(), to.getOrigin());
+        callback.m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
+        callback.m_collisionFilterMask  = static_cast<int>(sweep.mask);
+        world->convexSweepTest(shape.get(), from, to, callback);
+
+        hit.hit = callback.hasHit();
+        if (!hit.hit)
+        {
+            hit = PhysicsHit();
+            return;
+        }
+
+        hit.body        = get_rigid_body(callback.m_hitCollisionObject);
+        hit.position    = ToVector3(callback.m_hitPointWorld);
+        hit.normal      = ToVector3(callback.m_hitNormalWorld);
+        hit.fraction    = callback.m_closestHitFraction;
+    }
+
+    uint32_t PhysicsQuery::Overlap(const btCollisionWorld* world, const PhysicsOverlap& overlap, RigidBody** bodies, const uint32_t max_bodies)
+    {
+        if (max_bodies == 0)
+            return 0;
+
+        const unique_ptr<btConvexShape> shape = create_shape(overlap.shape, overlap.size);
+        const btTransform transform(ToBtQuaternion(overlap.rotation), ToBtVector3(overlap.position));
+
+        btVector3 aabb_min, aabb_max;
+        shape->getAabb(transform, aabb_min, aabb_max);
+
+        // The broadphase is only read (its traversal stack is local to the call)
+        BroadphaseOverlapCallback callback(overlap, shape.get(), transform, bodies, max_bodies);
+        const_cast<btBroadphaseInterface*>(world->getBroadphase())->aabbTest(aabb_min, aabb_max, callback);
+
+        return callback.m_count;
+    }
+}
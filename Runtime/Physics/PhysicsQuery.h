@@ -0,0 +1,125 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include "../Math/Vector3.h"
+#include "../Math/Quaternion.h"
+//================================
+
+class btCollisionWorld;
+
+namespace Spartan
+{
+    class RigidBody;
+
+    // Matched against the collision group of each body (same values as Bullet's default filter groups)
+    enum PhysicsFilter : uint32_t
+    {
+        PhysicsFilter_Dynamic   = 1 << 0,
+        PhysicsFilter_Static    = 1 << 1,
+        PhysicsFilter_Kinematic = 1 << 2,
+        PhysicsFilter_All       = 0xFFFFFFFF
+    };
+
+    enum PhysicsQueryShape
+    {
+        PhysicsQueryShape_Sphere,   // size.x is the radius
+        PhysicsQueryShape_Box,      // size is the half extents
+        PhysicsQueryShape_Capsule   // size.x is the radius, size.y the half height of the cylinder (along Y)
+    };
+
+    struct PhysicsRay
+    {
+        Math::Vector3 from  = Math::Vector3::Zero;
+        Math::Vector3 to    = Math::Vector3::Zero;
+        uint32_t mask       = PhysicsFilter_All;
+    };
+
+    struct PhysicsSweep
+    {
+        PhysicsQueryShape shape     = PhysicsQueryShape_Sphere;
+        Math::Vector3 size          = Math::Vector3::One;
+        Math::Quaternion rotation   = Math::Quaternion::Identity;
+        Math::Vector3 from          = Math::Vector3::Zero;
+        Math::Vector3 to            = Math::Vector3::Zero;
+        uint32_t mask               = PhysicsFilter_All;
+    };
+
+    struct PhysicsOverlap
+    {
+        PhysicsQueryShape shape     = PhysicsQueryShape_Sphere;
+        Math::Vector3 size          = Math::Vector3::One;
+        Math::Quaternion rotation   = Math::Quaternion::Identity;
+        Math::Vector3 position      = Math::Vector3::Zero;
+        uint32_t mask               = PhysicsFilter_All;
+    };
+
+    // The closest hit of a ray or sweep
+    struct PhysicsHit
+    {
+        bool hit                = false;
+        RigidBody* body         = nullptr; // null for objects which aren't rigid bodies (e.g. soft bodies)
+        Math::Vector3 position  = Math::Vector3::Zero;
+        Math::Vector3 normal    = Math::Vector3::Zero;
+        float fraction          = 1.0f; // along from -> to
+    };
+
+    // Queries which execute as a whole, one result per query. Overlaps write up to overlap_max_bodies bodies per query,
+    // to overlap_bodies[i * overlap_max_bodies], and their count to overlap_counts[i].
+    // Once submitted, a batch belongs to the physics until IsDone() returns true.
+    struct PhysicsQueryBatch
+    {
+        bool IsDone() const { return done.load(std::memory_order_acquire); }
+
+        void Clear()
+        {
+            rays.clear();
+            sweeps.clear();
+            overlaps.clear();
+        }
+
+        std::vector<PhysicsRay> rays;
+        std::vector<PhysicsSweep> sweeps;
+        std::vector<PhysicsOverlap> overlaps;
+        uint32_t overlap_max_bodies = 16;
+
+        // Results
+        std::vector<PhysicsHit> ray_hits;
+        std::vector<PhysicsHit> sweep_hits;
+        std::vector<RigidBody*> overlap_bodies;
+        std::vector<uint32_t> overlap_counts;
+        std::atomic<bool> done = false;
+    };
+
+    // Read-only queries against a collision world, a single query only touches its own memory
+    // (and Bullet's thread-safe allocators), so many of them can run in parallel while the world isn't being modified.
+    namespace PhysicsQuery
+    {
+        void RayCast(const btCollisionWorld* world, const PhysicsRay& ray, PhysicsHit& hit);
+        void Sweep(const btCollisionWorld* world, const PhysicsSweep& sweep, PhysicsHit& hit);
+        uint32_t Overlap(const btCollisionWorld* world, const PhysicsOverlap& overlap, RigidBody** bodies, uint32_t max_bodies);
+    }
+}
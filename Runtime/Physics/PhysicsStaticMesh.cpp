@@ -0,0 +1,203 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =======================================================
+#include "PhysicsStaticMesh.h"
+#include "../Core/FileSystem.h"
+#include "../IO/FileStream.h"
+#include "../Logging/Log.h"
+#include "../Utilities/Hash.h"
+#pragma warning(push, 0) // Hide warnings belonging to Bullet
+#include <LinearMath/btScalar.h>
+#include <LinearMath/btAlignedAllocator.h>
+#include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#pragma warning(pop)
+//==================================================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // Bump to invalidate every saved BVH
+    static const uint32_t bvh_cache_version = 2;
+
+    // Bullet reads the BVH nodes in place, so the buffer needs the alignment of its SIMD types
+    static const uint32_t bvh_alignment = 16;
+
+    PhysicsStaticMesh::PhysicsStaticMesh(const vector<uint32_t>& indices, const vector<RHI_Vertex_PosTexNorTan>& vertices)
+    {
+        // Only the positions are kept, they are what Bullet reads when testing against the triangles
+        m_indices = indices;
+        m_positions.reserve(vertices.size() * 3);
+        for (const RHI_Vertex_PosTexNorTan& vertex : vertices)
+        {
+            m_positions.emplace_back(vertex.pos[0]);
+            m_positions.emplace_back(vertex.pos[1]);
+            m_positions.emplace_back(vertex.pos[2]);
+        }
+    }
+
+    PhysicsStaticMesh::~PhysicsStaticMesh()
+    {
+        delete m_shape;
+
+        // A loaded BVH was constructed inside the buffer, it doesn't own its memory
+        if (m_bvh_buffer)
+        {
+            m_bvh->~btOptimizedBvh();
+            btAlignedFree(m_bvh_buffer);
+        }
+
+        delete m_mesh_interface;
+    }
+
+    bool PhysicsStaticMesh::Create(const string& cache_file_path)
+    {
+        if (m_indices.empty() || m_indices.size() % 3 != 0 || m_positions.empty())
+        {
+            LOG_ERROR("Invalid geometry, a static mesh requires a list of triangles");
+            return false;
+        }
+
+        const uint32_t vertex_count = static_cast<uint32_t>(m_positions.size() / 3);
+        for (const uint32_t index : m_indices)
+        {
+            if (index >= vertex_count)
+            {
+                LOG_ERROR("Invalid geometry, index %d is out of range", index);
+                return false;
+            }
+        }
+
+        m_mesh_interface = new btTriangleIndexVertexArray(
+            static_cast<int>(m_indices.size() / 3),         // triangle count
+            reinterpret_cast<int*>(m_indices.data()),       // indices
+            static_cast<int>(sizeof(uint32_t) * 3),         // triangle stride
+            static_cast<int>(vertex_count),                 // vertex count
+            m_positions.data(),                             // positions
+            static_cast<int>(sizeof(float) * 3)             // vertex stride
+        );
+
+        if (!cache_file_path.empty() && LoadBvh(cache_file_path))
+            return true;
+
+        m_shape = new btBvhTriangleMeshShape(m_mesh_interface, true); // quantized AABBs, a fraction of the memory
+
+        if (!cache_file_path.empty())
+        {
+            SaveBvh(cache_file_path);
+        }
+
+        return true;
+    }
+
+    uint64_t PhysicsStaticMesh::ComputeKey(const vector<uint32_t>& indices, const vector<RHI_Vertex_PosTexNorTan>& vertices)
+    {
+        const uint32_t header[] =
+        {
+            static_cast<uint32_t>(btGetVersion()),
+            bvh_cache_version,
+            static_cast<uint32_t>(vertices.size()),
+            static_cast<uint32_t>(indices.size())
+        };
+
+        uint64_t hash = Utility::Hash::fnv1a(header, sizeof(header));
+        hash          = Utility::Hash::fnv1a(indices.data(), indices.size() * sizeof(uint32_t), hash);
+
+        for (const RHI_Vertex_PosTexNorTan& vertex : vertices)
+        {
+            hash = Utility::Hash::fnv1a(vertex.pos, sizeof(vertex.pos), hash);
+        }
+
+        return hash;
+    }
+
+    bool PhysicsStaticMesh::LoadBvh(const string& cache_file_path)
+    {
+        if (!FileSystem::Exists(cache_file_path))
+            return false;
+
+        auto file = make_unique<FileStream>(cache_file_path, FileStream_Read | FileStream_Checksum);
+        if (!file->IsOpen())
+            return false;
+
+        if (file->ReadAs<uint32_t>() != bvh_cache_version)
+            return false;
+
+        // A different mesh which ended up with the same key
+        const uint32_t vertex_count = file->ReadAs<uint32_t>();
+        const uint32_t index_count  = file->ReadAs<uint32_t>();
+        if (vertex_count != static_cast<uint32_t>(m_positions.size() / 3) || index_count != static_cast<uint32_t>(m_indices.size()))
+        {
+            LOG_WARNING("Discarding BVH \"%s\", it was built from different geometry", FileSystem::GetFileNameFromFilePath(cache_file_path).c_str());
+            return false;
+        }
+
+        const uint32_t size = file->ReadAs<uint32_t>();
+        if (size == 0)
+            return false;
+
+        m_bvh_buffer = btAlignedAlloc(size, bvh_alignment);
+        file->ReadSpan(static_cast<byte*>(m_bvh_buffer), size);
+
+        m_bvh = btOptimizedBvh::deSerializeInPlace(m_bvh_buffer, size, false);
+        if (!m_bvh)
+        {
+            LOG_WARNING("Discarding invalid BVH \"%s\"", FileSystem::GetFileNameFromFilePath(cache_file_path).c_str());
+            btAlignedFree(m_bvh_buffer);
+            m_bvh_buffer = nullptr;
+            return false;
+        }
+
+        // Built from the same triangles (the file is keyed by them and the counts match), so it can be used as is
+        m_shape = new btBvhTriangleMeshShape(m_mesh_interface, true, false);
+        m_shape->setOptimizedBvh(m_bvh);
+
+        return true;
+    }
+
+    void PhysicsStaticMesh::SaveBvh(const string& cache_file_path) const
+    {
+        const btOptimizedBvh* bvh = m_shape->getOptimizedBvh();
+        if (!bvh)
+            return;
+
+        const uint32_t size = bvh->calculateSerializeBufferSize();
+        void* buffer        = btAlignedAlloc(size, bvh_alignment);
+        if (bvh->serializeInPlace(buffer, size, false))
+        {
+            auto file = make_unique<FileStream>(cache_file_path, FileStream_Write | FileStream_Checksum);
+            if (file->IsOpen())
+            {
+                file->Write(bvh_cache_version);
+                file->Write(static_cast<uint32_t>(m_positions.size() / 3));
+                file->Write(static_cast<uint32_t>(m_indices.size()));
+                file->Write(size);
+                file->WriteSpan(static_cast<const byte*>(buffer), size);
+            }
+        }
+        btAlignedFree(buffer);
+    }
+}
@@ -0,0 +1,69 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <string>
+#include <vector>
+#include "../RHI/RHI_Vertex.h"
+//=================================
+
+//= FORWARD DECLARATIONS ====
+class btTriangleIndexVertexArray;
+class btBvhTriangleMeshShape;
+class btOptimizedBvh;
+//===========================
+
+namespace Spartan
+{
+    // A static triangle mesh with an exact BVH (quantized AABBs), meant to be shared by every collider which uses the same
+    // geometry (each one wraps it in a btScaledBvhTriangleMeshShape). Building the BVH of level geometry is slow, so it's
+    // saved to a file and loaded in place on the next run, the file name is keyed by the content of the mesh.
+    class PhysicsStaticMesh
+    {
+    public:
+        PhysicsStaticMesh(const std::vector<uint32_t>& indices, const std::vector<RHI_Vertex_PosTexNorTan>& vertices);
+        ~PhysicsStaticMesh();
+
+        // Loads the BVH from the cache file (if any and valid) or builds it and saves it there. An empty path skips the cache.
+        bool Create(const std::string& cache_file_path);
+
+        // Hashes what the BVH depends on, positions and indices (stable across runs, it names the cache file)
+        static uint64_t ComputeKey(const std::vector<uint32_t>& indices, const std::vector<RHI_Vertex_PosTexNorTan>& vertices);
+
+        btBvhTriangleMeshShape* GetShape()  const { return m_shape; }
+        void AddRef()                             { m_ref_count++; }
+        bool Release()                            { return --m_ref_count == 0; }
+
+    private:
+        bool LoadBvh(const std::string& cache_file_path);
+        void SaveBvh(const std::string& cache_file_path) const;
+
+        std::vector<uint32_t> m_indices;
+        std::vector<float> m_positions;
+        btTriangleIndexVertexArray* m_mesh_interface    = nullptr;
+        btBvhTriangleMeshShape* m_shape                 = nullptr;
+        btOptimizedBvh* m_bvh                           = nullptr; // lives in m_bvh_buffer when it was loaded
+        void* m_bvh_buffer                              = nullptr;
+        uint32_t m_ref_count                            = 0;
+    };
+}
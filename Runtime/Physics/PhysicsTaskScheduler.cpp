@@ -0,0 +1,137 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "PhysicsTaskScheduler.h"
+#include "../Threading/Threading.h"
+#include "../Math/MathHelper.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // Set while a thread executes a chunk, Bullet nests loops (e.g. batched solving inside an island) and
+    // a nested loop can't wait for the pool which it's part of, so it runs in the calling thread instead.
+    static thread_local bool is_in_parallel_loop = false;
+
+    // Splits a loop into chunks and executes them in parallel, the last chunk runs in the calling thread
+    template <typename Function>
+    static void execute_chunks(Threading* threading, const uint32_t chunk_count, Function&& function)
+    {
+        atomic<uint32_t> chunks_done = 0;
+        for (uint32_t i = 0; i < chunk_count - 1; i++)
+        {
+            threading->AddTask([&function, &chunks_done, i]
+            {
+                is_in_parallel_loop = true;
+                function(i);
+                is_in_parallel_loop = false;
+                chunks_done++;
+            });
+        }
+
+        is_in_parallel_loop = true;
+        function(chunk_count - 1);
+        is_in_parallel_loop = false;
+
+        // Wait till the threads are done
+        while (chunks_done != chunk_count - 1)
+        {
+            this_thread::yield();
+        }
+    }
+
+    PhysicsTaskScheduler::PhysicsTaskScheduler(Threading* threading) : btITaskScheduler("Spartan")
+    {
+        m_threading = threading;
+        setNumThreads(getMaxNumThreads());
+    }
+
+    int PhysicsTaskScheduler::getMaxNumThreads() const
+    {
+        // Plus one for the thread which steps the simulation
+        const uint32_t thread_count = m_threading ? m_threading->GetThreadCount() + 1 : 1;
+        return static_cast<int>(Math::Helper::Min(thread_count, BT_MAX_THREAD_COUNT));
+    }
+
+    void PhysicsTaskScheduler::setNumThreads(int thread_count)
+    {
+        m_thread_count = static_cast<uint32_t>(Math::Helper::Clamp(thread_count, 1, getMaxNumThreads()));
+    }
+
+    void PhysicsTaskScheduler::parallelFor(int begin, int end, int grain_size, const btIParallelForBody& body)
+    {
+        const uint32_t chunk_count = GetChunkCount(begin, end, grain_size);
+        if (chunk_count <= 1)
+        {
+            body.forLoop(begin, end);
+            return;
+        }
+
+        const int range = end - begin;
+        execute_chunks(m_threading, chunk_count, [&](const uint32_t chunk)
+        {
+            const int chunk_begin   = begin + static_cast<int>((static_cast<int64_t>(range) * chunk) / chunk_count);
+            const int chunk_end     = begin + static_cast<int>((static_cast<int64_t>(range) * (chunk + 1)) / chunk_count);
+            body.forLoop(chunk_begin, chunk_end);
+        });
+    }
+
+    btScalar PhysicsTaskScheduler::parallelSum(int begin, int end, int grain_size, const btIParallelSumBody& body)
+    {
+        const uint32_t chunk_count = GetChunkCount(begin, end, grain_size);
+        if (chunk_count <= 1)
+            return body.sumLoop(begin, end);
+
+        // Partial sums are added up in chunk order, floating point addition isn't associative
+        btScalar sums[BT_MAX_THREAD_COUNT];
+        const int range = end - begin;
+        execute_chunks(m_threading, chunk_count, [&](const uint32_t chunk)
+        {
+            const int chunk_begin   = begin + static_cast<int>((static_cast<int64_t>(range) * chunk) / chunk_count);
+            const int chunk_end     = begin + static_cast<int>((static_cast<int64_t>(range) * (chunk + 1)) / chunk_count);
+            sums[chunk]             = body.sumLoop(chunk_begin, chunk_end);
+        });
+
+        btScalar sum = 0;
+        for (uint32_t i = 0; i < chunk_count; i++)
+        {
+            sum += sums[i];
+        }
+
+        return sum;
+    }
+
+    uint32_t PhysicsTaskScheduler::GetChunkCount(int begin, int end, int grain_size) const
+    {
+        if (end <= begin || is_in_parallel_loop || !m_threading)
+            return 1;
+
+        // Depends only on the range and the thread count, never on how busy the threads are
+        const int64_t range         = static_cast<int64_t>(end) - begin;
+        const int64_t grain         = grain_size > 0 ? grain_size : 1;
+        const int64_t chunk_count   = (range + grain - 1) / grain;
+        return static_cast<uint32_t>(Math::Helper::Min<int64_t>(chunk_count, m_thread_count));
+    }
+}
@@ -0,0 +1,106 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "FrameHistory.h"
+#include <algorithm>
+#include <cmath>
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    FrameHistory::FrameHistory(const uint32_t capacity /*= 1024*/)
+    {
+        m_capacity = capacity;
+        m_frames.resize(capacity);
+
+        for (vector<float>& sorted : m_sorted)
+        {
+            sorted.reserve(capacity);
+        }
+    }
+
+    void FrameHistory::Add(const FrameTimes& frame_times)
+    {
+        // Evict the oldest frame
+        if (m_count == m_capacity)
+        {
+            const FrameTimes& oldest = m_frames[m_head];
+
+            for (uint32_t type = 0; type < FrameTime_Count; type++)
+            {
+                if (oldest.time[type] < 0.0f)
+                    continue;
+
+                vector<float>& sorted = m_sorted[type];
+                auto it = lower_bound(sorted.begin(), sorted.end(), oldest.time[type]);
+                if (it != sorted.end())
+                {
+                    sorted.erase(it);
+                }
+            }
+
+            m_count--;
+        }
+
+        // Insert the new frame
+        for (uint32_t type = 0; type < FrameTime_Count; type++)
+        {
+            if (frame_times.time[type] < 0.0f)
+                continue;
+
+            vector<float>& sorted = m_sorted[type];
+            sorted.insert(upper_bound(sorted.begin(), sorted.end(), frame_times.time[type]), frame_times.time[type]);
+        }
+
+        m_frames[m_head]    = frame_times;
+        m_head              = (m_head + 1) % m_capacity;
+        m_count++;
+    }
+
+    void FrameHistory::Clear()
+    {
+        m_head  = 0;
+        m_count = 0;
+
+        for (vector<float>& sorted : m_sorted)
+        {
+            sorted.clear();
+        }
+    }
+
+    float FrameHistory::GetPercentile(const FrameTime_Type type, const float percentile) const
+    {
+        const vector<float>& sorted = m_sorted[type];
+        if (sorted.empty())
+            return 0.0f;
+
+        // Nearest rank
+        const float rank    = ceil(percentile / 100.0f * static_cast<float>(sorted.size()));
+        const size_t index  = static_cast<size_t>(max(rank, 1.0f)) - 1;
+
+        return sorted[min(index, sorted.size() - 1)];
+    }
+}
@@ -0,0 +1,69 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====
+#include <vector>
+//================
+
+namespace Spartan
+{
+    enum FrameTime_Type
+    {
+        FrameTime_Frame,
+        FrameTime_Cpu,
+        FrameTime_Gpu,
+        FrameTime_Count
+    };
+
+    struct FrameTimes
+    {
+        uint64_t frame  = 0;
+        float time[FrameTime_Count] = { 0.0f, 0.0f, 0.0f }; // ms, a negative time means it wasn't measured
+    };
+
+    // A fixed size ring of per-frame times. Next to the ring, every time type keeps its samples sorted,
+    // so adding a frame is a binary search plus a small move and any percentile is a lookup.
+    class FrameHistory
+    {
+    public:
+        FrameHistory(uint32_t capacity = 1024);
+
+        void Add(const FrameTimes& frame_times);
+        void Clear();
+
+        // percentile is in the [0, 100] range, returns 0 if there are no samples
+        float GetPercentile(FrameTime_Type type, float percentile) const;
+        uint32_t GetSampleCount(FrameTime_Type type)    const { return static_cast<uint32_t>(m_sorted[type].size()); }
+        uint32_t GetCapacity()                          const { return m_capacity; }
+        uint32_t GetCount()                             const { return m_count; }
+        // Index 0 is the oldest frame
+        const FrameTimes& GetFrame(uint32_t index)      const { return m_frames[(m_head + m_capacity - m_count + index) % m_capacity]; }
+
+    private:
+        uint32_t m_capacity = 0;
+        uint32_t m_head     = 0;
+        uint32_t m_count    = 0;
+        std::vector<FrameTimes> m_frames;
+        std::vector<float> m_sorted[FrameTime_Count];
+    };
+}
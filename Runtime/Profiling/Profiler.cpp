@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Resource/ResourceCache.h"
 #include "../RHI/RHI_Implementation.h"
 #include "../Core/Timer.h"
+#include "../Threading/Threading.h"
 //====================================
 
 //= NAMESPACES =====
@@ -41,11 +42,13 @@ namespace Spartan
         m_time_blocks_read.resize(m_time_block_capacity);
 		m_time_blocks_write.reserve(m_time_block_capacity);
 		m_time_blocks_write.resize(m_time_block_capacity);
+        m_timeline_start_ticks = ThreadEventBuffer::GetTicks();
 	}
 
     Profiler::~Profiler()
     {
         if (m_profile) OnFrameEnd();
+        CaptureStop();
         m_time_blocks_write.clear();
         m_time_blocks_read.clear();
         ClearRhiMetrics();
@@ -56,12 +59,16 @@ namespace Spartan
 		m_resource_manager	= m_context->GetSubsystem<ResourceCache>();
 		m_renderer			= m_context->GetSubsystem<Renderer>();
         m_timer             = m_context->GetSubsystem<Timer>();
+        m_threading         = m_context->GetSubsystem<Threading>();
 
 		return true;
 	}
 
     void Profiler::Tick(float delta_time)
     {
+        // CPU scopes are captured continuously, so the timeline is resolved every frame
+        ResolveTimeline();
+
         if (!m_renderer)
             return;
 
@@ -90,12 +97,15 @@ namespace Spartan
             }
         }
 
+        // OnFrameEnd() has resolved the gpu time blocks if there are any
+        UpdateFrameHistory(m_time_block_count_read != 0);
+
         // Compute fps
         ComputeFps(delta_time);
 
         // Check whether we should profile or not
         m_time_since_profiling_sec += delta_time;
-        if (m_time_since_profiling_sec >= m_profiling_interval_sec)
+        if (m_time_since_profiling_sec >= m_profiling_interval_sec || IsCapturing())
         {
             m_time_since_profiling_sec  = 0.0f;
             m_profile                   = true;
@@ -117,6 +127,12 @@ namespace Spartan
             }
         }
 
+        if (IsCapturing())
+        {
+            CaptureFrame();
+        }
+
+        m_time_block_count_read = 0;
         ClearRhiMetrics();
     }
 
@@ -150,20 +166,19 @@ namespace Spartan
                 time_block.Reset();
             }
 
-            m_time_block_count = 0;
+            m_time_block_count_read = m_time_block_count;
+            m_time_block_count      = 0;
         }
 
         // Detect stutters
         float frames_to_accumulate  = 5.0f;
         float delta_feedback        = 1.0f / frames_to_accumulate;
-        m_is_stuttering_cpu         = m_time_cpu_last > (m_time_cpu_avg + m_stutter_delta_ms);
         m_is_stuttering_gpu         = m_time_gpu_last > (m_time_gpu_avg + m_stutter_delta_ms);
 
-        // Compute cpu and gpu times
+        // Compute gpu and frame times (cpu times are computed by ResolveTimeline(), every frame)
         {
             frames_to_accumulate    = 20.0f;
             delta_feedback          = 1.0f / frames_to_accumulate;
-            m_time_cpu_last         = 0.0f;
             m_time_gpu_last         = 0.0f;
 
             for (const TimeBlock& time_block : m_time_blocks_read)
@@ -171,22 +186,12 @@ namespace Spartan
                 if (!time_block.IsComplete())
                     continue;
 
-                if (!time_block.GetParent() && time_block.GetType() == TimeBlock_Cpu)
-                {
-                    m_time_cpu_last += time_block.GetDuration();
-                }
-
                 if (!time_block.GetParent() && time_block.GetType() == TimeBlock_Gpu)
                 {
                     m_time_gpu_last += time_block.GetDuration();
                 }
             }
 
-            // CPU
-            m_time_cpu_avg = m_time_cpu_avg * (1.0f - delta_feedback) + m_time_cpu_last * delta_feedback;
-            m_time_cpu_min = Math::Helper::Min(m_time_cpu_min, m_time_cpu_last);
-            m_time_cpu_max = Math::Helper::Max(m_time_cpu_max, m_time_cpu_last);
-
             // GPU
             m_time_gpu_avg = m_time_gpu_avg * (1.0f - delta_feedback) + m_time_gpu_last * delta_feedback;
             m_time_gpu_min = Math::Helper::Min(m_time_gpu_min, m_time_gpu_last);
@@ -202,31 +207,41 @@ namespace Spartan
 
     void Profiler::TimeBlockStart(const char* func_name, TimeBlock_Type type, RHI_CommandList* cmd_list /*= nullptr*/)
 	{
-		if (!m_profile)
-			return;
+        // Every start is pushed on the calling thread's scope stack (even if it won't be recorded), so that
+        // TimeBlockEnd() can tell what it's ending without searching or synchronizing with other threads.
+        ThreadEventBuffer* buffer = ThreadEventBuffer::Get();
 
-        const bool can_profile_cpu = (type == TimeBlock_Cpu) && m_profile_cpu_enabled;
-        const bool can_profile_gpu = (type == TimeBlock_Gpu) && m_profile_gpu_enabled;
+        if (type == TimeBlock_Cpu)
+        {
+            buffer->Begin(func_name, m_profile_cpu_enabled ? TimeBlock_Cpu : TimeBlock_Undefined);
+            return;
+        }
 
-		if (!can_profile_cpu && !can_profile_gpu)
-			return;
+        // GPU timing requires queries, so it's only done every m_profiling_interval_sec
+        const bool can_profile_gpu = (type == TimeBlock_Gpu) && m_profile_gpu_enabled && m_profile;
+        TimeBlock* time_block      = nullptr;
 
-        // Last incomplete block of the same type, is the parent
-        TimeBlock* time_block_parent = GetLastIncompleteTimeBlock(type);
+        if (can_profile_gpu)
+        {
+            // Last incomplete block of the same type, is the parent
+            TimeBlock* time_block_parent = GetLastIncompleteTimeBlock(type);
 
-		if (TimeBlock* time_block = GetNewTimeBlock())
-		{
-			time_block->Begin(func_name, type, time_block_parent, cmd_list, m_renderer->GetRhiDevice());
-		}
+            time_block = GetNewTimeBlock();
+            if (time_block)
+            {
+                time_block->Begin(func_name, type, time_block_parent, cmd_list, m_renderer->GetRhiDevice());
+            }
+        }
+
+        buffer->Begin(func_name, time_block ? TimeBlock_Gpu : TimeBlock_Undefined);
 	}
 
 	void Profiler::TimeBlockEnd()
 	{
-        // If the capacity 
-        if (m_increase_capacity)
+        if (ThreadEventBuffer::Get()->End() != TimeBlock_Gpu)
             return;
 
-		if (TimeBlock* time_block = GetLastIncompleteTimeBlock())
+		if (TimeBlock* time_block = GetLastIncompleteTimeBlock(TimeBlock_Gpu))
 		{
 			time_block->End();
 		}
@@ -248,6 +263,285 @@ namespace Spartan
         m_time_gpu_last     = 0.0f;
     }
 
+    void Profiler::ResolveTimeline()
+    {
+        const uint64_t timeline_end_ticks   = ThreadEventBuffer::GetTicks();
+        const uint64_t timeline_start_ticks = m_timeline_start_ticks;
+        const thread::id this_thread_id     = this_thread::get_id();
+        float time_cpu                      = 0.0f;
+
+        ThreadEventBuffer::Iterate([this, timeline_start_ticks, this_thread_id, &time_cpu](ThreadEventBuffer& buffer)
+        {
+            if (buffer.GetIndex() >= static_cast<uint32_t>(m_timeline.size()))
+            {
+                m_timeline.resize(buffer.GetIndex() + 1);
+            }
+
+            TimelineThread& thread = m_timeline[buffer.GetIndex()];
+            if (thread.name.empty())
+            {
+                thread.name = m_threading ? m_threading->GetThreadName(buffer.GetThreadId()) : "";
+                if (thread.name.empty())
+                {
+                    thread.name = "thread_" + to_string(buffer.GetIndex());
+                }
+            }
+
+            m_thread_events.clear();
+            buffer.Drain(m_thread_events);
+
+            thread.scopes.clear();
+            thread.dropped = buffer.GetDroppedCount();
+            for (const ThreadEvent& event : m_thread_events)
+            {
+                TimelineScope& scope    = thread.scopes.emplace_back();
+                scope.name              = event.name;
+                scope.start_ms          = static_cast<float>(ThreadEventBuffer::TicksToMs(static_cast<int64_t>(event.start - timeline_start_ticks)));
+                scope.duration_ms       = static_cast<float>(ThreadEventBuffer::TicksToMs(static_cast<int64_t>(event.end - event.start)));
+                scope.depth             = event.depth;
+
+                // The cpu time is the time spent in the top level scopes of the thread which ticks the engine
+                if (event.depth == 0 && buffer.GetThreadId() == this_thread_id)
+                {
+                    time_cpu += scope.duration_ms;
+                }
+            }
+        });
+
+        m_timeline_frame_ticks  = timeline_start_ticks;
+        m_timeline_start_ticks  = timeline_end_ticks;
+        m_timeline_duration_ms  = static_cast<float>(ThreadEventBuffer::TicksToMs(static_cast<int64_t>(timeline_end_ticks - timeline_start_ticks)));
+
+        // Detect stutters
+        m_is_stuttering_cpu = time_cpu > (m_time_cpu_avg + m_stutter_delta_ms);
+
+        // Compute cpu times
+        const float delta_feedback  = 1.0f / 20.0f;
+        m_time_cpu_last             = time_cpu;
+        m_time_cpu_avg              = m_time_cpu_avg * (1.0f - delta_feedback) + m_time_cpu_last * delta_feedback;
+        m_time_cpu_min              = Math::Helper::Min(m_time_cpu_min, m_time_cpu_last);
+        m_time_cpu_max              = Math::Helper::Max(m_time_cpu_max, m_time_cpu_last);
+    }
+
+    bool Profiler::CaptureStart(const string& file_path, const uint32_t frame_count)
+    {
+        if (frame_count == 0)
+        {
+            LOG_ERROR("Invalid frame count");
+            return false;
+        }
+
+        CaptureStop();
+
+        if (!m_capture.Open(file_path))
+            return false;
+
+        m_capture.AddProcessName(0, "CPU");
+        m_capture.AddProcessName(1, "GPU");
+        m_capture.AddThreadName(1, 0, "Time blocks");
+
+        m_capture_file_path     = file_path;
+        m_capture_start_ticks   = m_timeline_start_ticks; // the frame which is currently being recorded is the first one
+        m_capture_frames_left   = frame_count;
+        m_capture_frame         = 0;
+        m_profile               = true;
+        m_capture_thread_named.clear();
+
+        LOG_INFO("Capturing %d frames to \"%s\"...", frame_count, file_path.c_str());
+
+        return true;
+    }
+
+    void Profiler::CaptureStop()
+    {
+        if (!m_capture.IsOpen())
+            return;
+
+        m_capture.Close();
+        m_capture_frames_left = 0;
+
+        LOG_INFO("Capture of %d frames saved to \"%s\"", m_capture_frame, m_capture_file_path.c_str());
+    }
+
+    void Profiler::CaptureFrame()
+    {
+        const double frame_us = ThreadEventBuffer::TicksToMs(static_cast<int64_t>(m_timeline_frame_ticks - m_capture_start_ticks)) * 1000.0;
+
+        // Frame marker
+        char frame_name[32];
+        snprintf(frame_name, sizeof(frame_name), "Frame %llu", static_cast<unsigned long long>(m_renderer->GetFrameNum()));
+        m_capture.AddInstant(frame_name, 0, frame_us);
+
+        // CPU - timeline
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_timeline.size()); i++)
+        {
+            const TimelineThread& thread = m_timeline[i];
+            if (thread.scopes.empty())
+                continue;
+
+            if (i >= static_cast<uint32_t>(m_capture_thread_named.size()))
+            {
+                m_capture_thread_named.resize(i + 1, false);
+            }
+
+            if (!m_capture_thread_named[i])
+            {
+                m_capture.AddThreadName(0, i, thread.name.c_str());
+                m_capture_thread_named[i] = true;
+            }
+
+            for (const TimelineScope& scope : thread.scopes)
+            {
+                m_capture.AddComplete(scope.name, "cpu", 0, i, frame_us + scope.start_ms * 1000.0, scope.duration_ms * 1000.0);
+            }
+        }
+
+        // GPU
+        {
+            GetGpuScopes(m_capture_gpu_scopes);
+
+            for (const TimelineScope& scope : m_capture_gpu_scopes)
+            {
+                m_capture.AddComplete(scope.name, "gpu", 1, 0, frame_us + scope.start_ms * 1000.0, scope.duration_ms * 1000.0);
+            }
+        }
+
+        // Counters
+        m_capture.AddCounter("Draw calls",                  0, frame_us, m_rhi_draw_calls);
+        m_capture.AddCounter("Meshes rendered",             0, frame_us, m_renderer_meshes_rendered);
+        m_capture.AddCounter("Pipeline bindings",           0, frame_us, m_rhi_bindings_pipeline);
+        m_capture.AddCounter("Descriptor set bindings",     0, frame_us, m_rhi_bindings_descriptor_set);
+        m_capture.AddCounter("Texture bindings",            0, frame_us, m_rhi_bindings_texture);
+        m_capture.AddCounter("Constant buffer bindings",    0, frame_us, m_rhi_bindings_buffer_constant);
+        m_capture.AddCounter("Vertex buffer bindings",      0, frame_us, m_rhi_bindings_buffer_vertex);
+        m_capture.AddCounter("Index buffer bindings",       0, frame_us, m_rhi_bindings_buffer_index);
+        m_capture.AddCounter("Pipeline barriers",           0, frame_us, m_rhi_pipeline_barriers);
+        m_capture.AddCounter("Pipeline creations",          0, frame_us, m_rhi_pipeline_creations);
+        m_capture.AddCounter("CPU time (ms)",               0, frame_us, m_time_cpu_last);
+        m_capture.AddCounter("GPU memory used (MB)",        1, frame_us, m_gpu_memory_used);
+        m_capture.AddCounter("Resource memory CPU (MB)",    0, frame_us, static_cast<double>(m_resource_manager->GetMemoryUsageCpu()) / 1024.0 / 1024.0);
+        m_capture.AddCounter("Resource memory GPU (MB)",    1, frame_us, static_cast<double>(m_resource_manager->GetMemoryUsageGpu()) / 1024.0 / 1024.0);
+
+        m_capture_frame++;
+        if (--m_capture_frames_left == 0)
+        {
+            CaptureStop();
+        }
+    }
+
+    void Profiler::UpdateFrameHistory(const bool gpu_resolved)
+    {
+        FrameTimes frame_times;
+        frame_times.frame                   = m_renderer->GetFrameNum();
+        frame_times.time[FrameTime_Frame]   = static_cast<float>(m_timer->GetDeltaTimeMs());
+        frame_times.time[FrameTime_Cpu]     = m_time_cpu_last;
+        frame_times.time[FrameTime_Gpu]     = gpu_resolved ? m_time_gpu_last : -1.0f;
+
+        // Compare against the median before this frame is part of it
+        const float median = m_frame_history.GetPercentile(FrameTime_Frame, 50.0f);
+        const bool is_hitch = m_frame_history.GetSampleCount(FrameTime_Frame) >= m_hitch_min_samples && frame_times.time[FrameTime_Frame] > median * m_hitch_multiplier;
+
+        m_frame_history.Add(frame_times);
+
+        if (!is_hitch)
+            return;
+
+        if (m_hitches.size() >= m_hitch_capacity)
+        {
+            m_hitches.pop_front();
+        }
+
+        HitchSnapshot& hitch    = m_hitches.emplace_back();
+        hitch.frame             = frame_times.frame;
+        hitch.time_frame_ms     = frame_times.time[FrameTime_Frame];
+        hitch.time_cpu_ms       = frame_times.time[FrameTime_Cpu];
+        hitch.time_gpu_ms       = frame_times.time[FrameTime_Gpu];
+        hitch.time_median_ms    = median;
+        hitch.timeline          = m_timeline;
+        GetGpuScopes(hitch.gpu);
+
+        LOG_WARNING("Frame %d took %.2f ms (median is %.2f ms), a snapshot has been kept", static_cast<uint32_t>(hitch.frame), hitch.time_frame_ms, median);
+    }
+
+    void Profiler::GetGpuScopes(vector<TimelineScope>& scopes) const
+    {
+        scopes.clear();
+
+        // GPU time blocks only resolve to durations, so they are laid out back to back (per tree depth) from the start of the frame
+        static const uint32_t depth_max = 32;
+        float cursor[depth_max] = {};
+
+        for (uint32_t i = 0; i < m_time_block_count_read; i++)
+        {
+            const TimeBlock& time_block = m_time_blocks_read[i];
+            if (!time_block.IsComplete() || time_block.GetType() != TimeBlock_Gpu)
+                continue;
+
+            TimelineScope& scope    = scopes.emplace_back();
+            scope.name              = time_block.GetName();
+            scope.depth             = Math::Helper::Min(time_block.GetTreeDepth(), depth_max - 1);
+            scope.start_ms          = cursor[scope.depth];
+            scope.duration_ms       = time_block.GetDuration();
+
+            cursor[scope.depth] = scope.start_ms + scope.duration_ms;
+            for (uint32_t j = scope.depth + 1; j < depth_max; j++)
+            {
+                cursor[j] = scope.start_ms;
+            }
+        }
+    }
+
+    bool Profiler::HitchesExport(const string& file_path) const
+    {
+        if (m_hitches.empty())
+        {
+            LOG_WARNING("There are no hitches to export");
+            return false;
+        }
+
+        TraceWriter writer;
+        if (!writer.Open(file_path))
+            return false;
+
+        // Every hitch is a process, so they can be compared side by side
+        for (uint32_t pid = 0; pid < static_cast<uint32_t>(m_hitches.size()); pid++)
+        {
+            const HitchSnapshot& hitch = m_hitches[pid];
+
+            char name[128];
+            sprintf_s(name, "Frame %d - %.2f ms (median %.2f ms)", static_cast<uint32_t>(hitch.frame), hitch.time_frame_ms, hitch.time_median_ms);
+            writer.AddProcessName(pid, name);
+
+            const uint32_t thread_count = static_cast<uint32_t>(hitch.timeline.size());
+            for (uint32_t tid = 0; tid < thread_count; tid++)
+            {
+                const TimelineThread& thread = hitch.timeline[tid];
+                if (thread.scopes.empty())
+                    continue;
+
+                writer.AddThreadName(pid, tid, thread.name.c_str());
+                for (const TimelineScope& scope : thread.scopes)
+                {
+                    writer.AddComplete(scope.name, "cpu", pid, tid, scope.start_ms * 1000.0, scope.duration_ms * 1000.0);
+                }
+            }
+
+            if (!hitch.gpu.empty())
+            {
+                writer.AddThreadName(pid, thread_count, "GPU");
+                for (const TimelineScope& scope : hitch.gpu)
+                {
+                    writer.AddComplete(scope.name, "gpu", pid, thread_count, scope.start_ms * 1000.0, scope.duration_ms * 1000.0);
+                }
+            }
+        }
+
+        writer.Close();
+        LOG_INFO("%d hitches exported to \"%s\"", static_cast<uint32_t>(m_hitches.size()), file_path.c_str());
+
+        return true;
+    }
+
     TimeBlock* Profiler::GetNewTimeBlock()
 	{
 		// Increase capacity if needed
@@ -345,7 +639,8 @@ namespace Spartan
             "Render target bindings:\t%d\n"
             "Pipeline bindings:\t\t\t%d\n"
             "Descriptor set bindings:\t%d\n"
-            "Pipeline barriers:\t\t\t%d";
+            "Pipeline barriers:\t\t\t%d\n"
+            "Pipeline creations:\t\t%d";
 
         static char buffer[2048];
 		sprintf_s
@@ -383,7 +678,8 @@ namespace Spartan
 			m_rhi_bindings_render_target,
             m_rhi_bindings_pipeline,
             m_rhi_bindings_descriptor_set,
-            m_rhi_pipeline_barriers
+            m_rhi_pipeline_barriers,
+            m_rhi_pipeline_creations
 		);
 
 		m_metrics = string(buffer);
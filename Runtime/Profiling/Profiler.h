@@ -24,7 +24,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <string>
 #include <vector>
+#include <deque>
 #include "TimeBlock.h"
+#include "FrameHistory.h"
+#include "ThreadEventBuffer.h"
+#include "TraceWriter.h"
 #include "../Core/EngineDefs.h"
 #include "../Core/ISubsystem.h"
 #include "../Core/Stopwatch.h"
@@ -42,6 +46,36 @@ namespace Spartan
 	class Renderer;
     class Variant;
     class Timer;
+    class Threading;
+
+    // A CPU scope, placed on the frame's timeline
+    struct TimelineScope
+    {
+        const char* name    = nullptr;
+        float start_ms      = 0.0f; // relative to the start of the frame (negative if it started in an earlier frame)
+        float duration_ms   = 0.0f;
+        uint32_t depth      = 0;
+    };
+
+    // All the CPU scopes a thread completed during a frame
+    struct TimelineThread
+    {
+        std::string name;
+        std::vector<TimelineScope> scopes;
+        uint32_t dropped = 0;
+    };
+
+    // A frame which took much longer than the median, along with everything that was profiled in it
+    struct HitchSnapshot
+    {
+        uint64_t frame          = 0;
+        float time_frame_ms     = 0.0f;
+        float time_cpu_ms       = 0.0f;
+        float time_gpu_ms       = 0.0f; // negative if the gpu wasn't profiled during that frame
+        float time_median_ms    = 0.0f;
+        std::vector<TimelineThread> timeline;
+        std::vector<TimelineScope> gpu;
+    };
 
 	class SPARTAN_CLASS Profiler : public ISubsystem
 	{
@@ -59,11 +93,26 @@ namespace Spartan
 		void TimeBlockEnd();
         void ResetMetrics();
 
+        // Capture - writes the next frame_count frames (cpu timeline, gpu time blocks and counters) as a Chrome Trace Event file
+        bool CaptureStart(const std::string& file_path, uint32_t frame_count);
+        void CaptureStop();
+        bool IsCapturing() const { return m_capture_frames_left != 0; }
+
+        // Hitches - frames longer than the hitch multiplier times the median frame time are snapshotted automatically
+        bool HitchesExport(const std::string& file_path) const;
+        void HitchesClear()                                   { m_hitches.clear(); }
+        const auto& GetHitches()                        const { return m_hitches; }
+        float GetHitchMultiplier()                      const { return m_hitch_multiplier; }
+        void SetHitchMultiplier(const float multiplier)       { m_hitch_multiplier = multiplier; }
+        const FrameHistory& GetFrameHistory()           const { return m_frame_history; }
+
         // Properties
 		void SetProfilingEnabledCpu(const bool enabled)	{ m_profile_cpu_enabled = enabled; }
 		void SetProfilingEnabledGpu(const bool enabled)	{ m_profile_gpu_enabled = enabled; }
 		const std::string& GetMetrics()                 const { return m_metrics; }
 		const auto& GetTimeBlocks()                     const { return m_time_blocks_read; }
+        const auto& GetTimeline()                       const { return m_timeline; }
+        float GetTimelineDuration()                     const { return m_timeline_duration_ms; }
 		float GetTimeCpuLast()                          const { return m_time_cpu_last; }
 		float GetTimeGpuLast()                          const { return m_time_gpu_last; }
 		float GetTimeFrameLast()                        const { return m_time_frame_last; }
@@ -90,6 +139,7 @@ namespace Spartan
         uint32_t m_rhi_bindings_descriptor_set  = 0;     
         uint32_t m_rhi_bindings_pipeline        = 0;
         uint32_t m_rhi_pipeline_barriers        = 0;
+        uint32_t m_rhi_pipeline_creations       = 0;
 
 		// Metrics - Renderer
 		uint32_t m_renderer_meshes_rendered = 0;
@@ -125,8 +175,13 @@ namespace Spartan
             m_rhi_bindings_descriptor_set   = 0;
             m_rhi_bindings_pipeline         = 0;
             m_rhi_pipeline_barriers         = 0;
+            m_rhi_pipeline_creations        = 0;
         }
 
+        void ResolveTimeline();
+        void CaptureFrame();
+        void UpdateFrameHistory(bool gpu_resolved);
+        void GetGpuScopes(std::vector<TimelineScope>& scopes) const;
 		TimeBlock* GetNewTimeBlock();
 		TimeBlock* GetLastIncompleteTimeBlock(TimeBlock_Type type = TimeBlock_Undefined);
 		void ComputeFps(float delta_time);
@@ -139,12 +194,36 @@ namespace Spartan
 		float m_profiling_interval_sec		= 0.3f;
 		float m_time_since_profiling_sec	= m_profiling_interval_sec;
 
-		// Time blocks (double buffered)
+		// Time blocks - GPU (double buffered)
 		uint32_t m_time_block_capacity	= 200;
 		uint32_t m_time_block_count		= 0;
+        uint32_t m_time_block_count_read = 0;
 		std::vector<TimeBlock> m_time_blocks_write;
         std::vector<TimeBlock> m_time_blocks_read;
 
+        // Timeline - CPU (recorded continuously, per thread)
+        std::vector<ThreadEvent> m_thread_events;
+        std::vector<TimelineThread> m_timeline;
+        uint64_t m_timeline_start_ticks = 0;
+        uint64_t m_timeline_frame_ticks = 0;
+        float m_timeline_duration_ms    = 0.0f;
+
+        // Capture
+        TraceWriter m_capture;
+        std::string m_capture_file_path;
+        std::vector<bool> m_capture_thread_named;
+        std::vector<TimelineScope> m_capture_gpu_scopes; // reused every captured frame
+        uint64_t m_capture_start_ticks  = 0;
+        uint32_t m_capture_frames_left  = 0;
+        uint32_t m_capture_frame        = 0;
+
+        // Frame history and hitches
+        FrameHistory m_frame_history;
+        std::deque<HitchSnapshot> m_hitches;
+        uint32_t m_hitch_capacity       = 16;
+        uint32_t m_hitch_min_samples    = 60;
+        float m_hitch_multiplier        = 2.0f;
+
 		// FPS
         float m_delta_time      = 0.0f;
 		float m_fps				= 0.0f;
@@ -173,6 +252,7 @@ namespace Spartan
 		ResourceCache* m_resource_manager	= nullptr;
 		Renderer* m_renderer				= nullptr;
         Timer* m_timer                      = nullptr;
+        Threading* m_threading              = nullptr;
 	};
 
     class ScopedTimeBlock
@@ -0,0 +1,78 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "ThreadEventBuffer.h"
+#include <mutex>
+#include <memory>
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace
+    {
+        // Buffers are never released, a thread which exits simply stops producing events.
+        // The mutex is only taken when a thread registers and when the profiler drains, never per event.
+        mutex registry_mutex;
+        vector<unique_ptr<ThreadEventBuffer>> registry;
+    }
+
+    void ThreadEventBuffer::Drain(vector<ThreadEvent>& events)
+    {
+        const uint64_t tail = m_tail.load(memory_order_relaxed);
+        const uint64_t head = m_head.load(memory_order_acquire);
+
+        for (uint64_t i = tail; i < head; i++)
+        {
+            events.emplace_back(m_events[i & (m_capacity - 1)]);
+        }
+
+        m_tail.store(head, memory_order_release);
+    }
+
+    ThreadEventBuffer* ThreadEventBuffer::Get()
+    {
+        thread_local ThreadEventBuffer* buffer = nullptr;
+
+        if (!buffer)
+        {
+            lock_guard<mutex> lock(registry_mutex);
+            registry.emplace_back(make_unique<ThreadEventBuffer>(static_cast<uint32_t>(registry.size()), this_thread::get_id()));
+            buffer = registry.back().get();
+        }
+
+        return buffer;
+    }
+
+    void ThreadEventBuffer::Iterate(const function<void(ThreadEventBuffer&)>& function)
+    {
+        lock_guard<mutex> lock(registry_mutex);
+
+        for (const auto& buffer : registry)
+        {
+            function(*buffer);
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <functional>
+#include "TimeBlock.h"
+//======================
+
+namespace Spartan
+{
+    // A completed scope, as recorded by the thread that executed it
+    struct ThreadEvent
+    {
+        const char* name    = nullptr;
+        uint64_t start      = 0; // ticks
+        uint64_t end        = 0; // ticks
+        uint32_t depth      = 0;
+    };
+
+    // Per-thread event buffer. Only the owning thread pushes (Begin/End) and only the
+    // profiler drains, so the ring is a single producer/single consumer queue which needs no locks.
+    class ThreadEventBuffer
+    {
+    public:
+        ThreadEventBuffer(uint32_t index, std::thread::id thread_id) : m_index(index), m_thread_id(thread_id) { m_events.resize(m_capacity); }
+
+        void Begin(const char* name, TimeBlock_Type type)
+        {
+            if (m_depth < m_stack_size)
+            {
+                Scope& scope    = m_stack[m_depth];
+                scope.name      = name;
+                scope.type      = type;
+                scope.start     = type == TimeBlock_Cpu ? GetTicks() : 0;
+            }
+
+            m_depth++;
+        }
+
+        // Returns the type the scope was started with, so the caller can end any GPU work it owns
+        TimeBlock_Type End()
+        {
+            if (m_depth == 0)
+                return TimeBlock_Undefined;
+
+            m_depth--;
+
+            if (m_depth >= m_stack_size)
+                return TimeBlock_Undefined;
+
+            const Scope& scope = m_stack[m_depth];
+            if (scope.type == TimeBlock_Cpu)
+            {
+                Push(scope.name, scope.start, GetTicks(), m_depth);
+            }
+
+            return scope.type;
+        }
+
+        // Consumer side, copies all the events which have been completed since the last call
+        void Drain(std::vector<ThreadEvent>& events);
+
+        uint32_t GetIndex()                 const { return m_index; }
+        std::thread::id GetThreadId()       const { return m_thread_id; }
+        uint32_t GetDroppedCount()          const { return m_dropped.load(std::memory_order_relaxed); }
+
+        static uint64_t GetTicks()          { return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()); }
+        static double TicksToMs(int64_t ticks) { return static_cast<double>(ticks) * 1000.0 * std::chrono::steady_clock::period::num / std::chrono::steady_clock::period::den; }
+
+        // Returns the buffer of the calling thread, registering it on first use
+        static ThreadEventBuffer* Get();
+        // Iterates over the buffers of all the threads which have ever recorded an event
+        static void Iterate(const std::function<void(ThreadEventBuffer&)>& function);
+
+    private:
+        void Push(const char* name, const uint64_t start, const uint64_t end, const uint32_t depth)
+        {
+            const uint64_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) >= m_capacity)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            ThreadEvent& event  = m_events[head & (m_capacity - 1)];
+            event.name          = name;
+            event.start         = start;
+            event.end           = end;
+            event.depth         = depth;
+
+            m_head.store(head + 1, std::memory_order_release);
+        }
+
+        struct Scope
+        {
+            const char* name    = nullptr;
+            TimeBlock_Type type = TimeBlock_Undefined;
+            uint64_t start      = 0;
+        };
+
+        // Ring (must be a power of two)
+        static const uint32_t m_capacity = 4096;
+        std::vector<ThreadEvent> m_events;
+        std::atomic<uint64_t> m_head    = 0;
+        std::atomic<uint64_t> m_tail    = 0;
+        std::atomic<uint32_t> m_dropped = 0;
+
+        // Open scopes, only touched by the owning thread
+        static const uint32_t m_stack_size = 64;
+        Scope m_stack[m_stack_size];
+        uint32_t m_depth = 0;
+
+        uint32_t m_index = 0;
+        std::thread::id m_thread_id;
+    };
+}
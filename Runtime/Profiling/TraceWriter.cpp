@@ -0,0 +1,160 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ============
+#include "TraceWriter.h"
+#include "../Logging/Log.h"
+//=======================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    bool TraceWriter::Open(const string& file_path)
+    {
+        Close();
+
+        m_file.open(file_path, ofstream::out | ofstream::trunc);
+        if (!m_file.is_open())
+        {
+            LOG_ERROR("Failed to open \"%s\" for writing", file_path.c_str());
+            return false;
+        }
+
+        m_file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        m_first_event = true;
+
+        return true;
+    }
+
+    void TraceWriter::Close()
+    {
+        if (!m_file.is_open())
+            return;
+
+        m_file << "\n]}\n";
+        m_file.close();
+    }
+
+    void TraceWriter::AddProcessName(const uint32_t pid, const char* name)
+    {
+        if (!BeginEvent())
+            return;
+
+        char head[128];
+        snprintf(head, sizeof(head), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"", pid);
+        m_file << head;
+        WriteEscaped(name);
+        m_file << "\"}}";
+    }
+
+    void TraceWriter::AddThreadName(const uint32_t pid, const uint32_t tid, const char* name)
+    {
+        if (!BeginEvent())
+            return;
+
+        char head[128];
+        snprintf(head, sizeof(head), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"", pid, tid);
+        m_file << head;
+        WriteEscaped(name);
+        m_file << "\"}}";
+    }
+
+    void TraceWriter::AddComplete(const char* name, const char* category, const uint32_t pid, const uint32_t tid, const double timestamp, const double duration)
+    {
+        if (!BeginEvent())
+            return;
+
+        m_file << "{\"name\":\"";
+        WriteEscaped(name);
+
+        char tail[256];
+        snprintf(tail, sizeof(tail), "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", category, pid, tid, timestamp, duration);
+        m_file << tail;
+    }
+
+    void TraceWriter::AddInstant(const char* name, const uint32_t pid, const double timestamp)
+    {
+        if (!BeginEvent())
+            return;
+
+        m_file << "{\"name\":\"";
+        WriteEscaped(name);
+
+        char tail[128];
+        snprintf(tail, sizeof(tail), "\",\"ph\":\"i\",\"s\":\"p\",\"pid\":%u,\"tid\":0,\"ts\":%.3f}", pid, timestamp);
+        m_file << tail;
+    }
+
+    void TraceWriter::AddCounter(const char* name, const uint32_t pid, const double timestamp, const double value)
+    {
+        if (!BeginEvent())
+            return;
+
+        m_file << "{\"name\":\"";
+        WriteEscaped(name);
+
+        char tail[128];
+        snprintf(tail, sizeof(tail), "\",\"ph\":\"C\",\"pid\":%u,\"ts\":%.3f,\"args\":{\"value\":%.3f}}", pid, timestamp, value);
+        m_file << tail;
+    }
+
+    bool TraceWriter::BeginEvent()
+    {
+        if (!m_file.is_open())
+            return false;
+
+        if (!m_first_event)
+        {
+            m_file << ",\n";
+        }
+
+        m_first_event = false;
+        return true;
+    }
+
+    void TraceWriter::WriteEscaped(const char* text)
+    {
+        // Write runs of plain characters as they are, only quotes and backslashes need a prefix and control characters are dropped
+        const char* run = text ? text : "N/A";
+        const char* c   = run;
+        for (; *c; c++)
+        {
+            const bool needs_escape = *c == '"' || *c == '\\';
+            const bool is_control   = static_cast<unsigned char>(*c) < 0x20;
+
+            if (needs_escape || is_control)
+            {
+                m_file.write(run, c - run);
+                run = is_control ? c + 1 : c;
+
+                if (needs_escape)
+                {
+                    m_file.put('\\');
+                }
+            }
+        }
+
+        m_file.write(run, c - run);
+    }
+}
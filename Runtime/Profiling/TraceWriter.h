@@ -0,0 +1,57 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====
+#include <string>
+#include <fstream>
+//================
+
+namespace Spartan
+{
+    // Streams events in the Chrome Trace Event format (chrome://tracing, Perfetto UI). Every event is
+    // written to the file as soon as it's added, so a capture of any length only costs the stream's buffer.
+    class TraceWriter
+    {
+    public:
+        TraceWriter() = default;
+        ~TraceWriter() { Close(); }
+
+        bool Open(const std::string& file_path);
+        void Close();
+        bool IsOpen() const { return m_file.is_open(); }
+
+        // Timestamps and durations are in microseconds
+        void AddProcessName(uint32_t pid, const char* name);
+        void AddThreadName(uint32_t pid, uint32_t tid, const char* name);
+        void AddComplete(const char* name, const char* category, uint32_t pid, uint32_t tid, double timestamp, double duration);
+        void AddInstant(const char* name, uint32_t pid, double timestamp);
+        void AddCounter(const char* name, uint32_t pid, double timestamp, double value);
+
+    private:
+        bool BeginEvent();
+        void WriteEscaped(const char* text);
+
+        std::ofstream m_file;
+        bool m_first_event = true;
+    };
+}
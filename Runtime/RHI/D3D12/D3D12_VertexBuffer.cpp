@@ -42,7 +42,7 @@ namespace Spartan
 		return true;
 	}
 
-	void* RHI_VertexBuffer::Map()
+	void* RHI_VertexBuffer::Map(const bool discard /*= true*/)
 	{
         return nullptr;
 	}
@@ -0,0 +1,98 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "../RHI_Implementation.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void RHI_ConstantBuffer::_destroy()
+    {
+        m_mapped = nullptr;
+        null_utility::buffer::destroy(m_buffer);
+    }
+
+    RHI_ConstantBuffer::RHI_ConstantBuffer(const std::shared_ptr<RHI_Device>& rhi_device, const string& name, bool is_dynamic /*= false*/)
+    {
+        m_rhi_device    = rhi_device;
+        m_name          = name;
+        m_is_dynamic    = is_dynamic;
+    }
+
+	bool RHI_ConstantBuffer::_create()
+	{
+		if (!m_rhi_device || !m_rhi_device->GetContextRhi()->device)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+        // Destroy previous buffer
+        _destroy();
+
+        // Create buffer
+        m_size_gpu  = m_offset_count * m_stride;
+        m_buffer    = null_utility::buffer::create(m_size_gpu);
+        if (!m_buffer)
+        {
+            LOG_ERROR("Failed to allocate buffer");
+            return false;
+        }
+
+		return true;
+	}
+
+	void* RHI_ConstantBuffer::Map()
+    {
+        if (!m_buffer)
+        {
+            LOG_ERROR("Invalid buffer");
+            return nullptr;
+        }
+
+        m_mapped = m_buffer;
+        return m_mapped;
+	}
+
+	bool RHI_ConstantBuffer::Unmap(const uint64_t offset /*= 0*/, const uint64_t size /*= 0*/)
+	{
+        if (!m_buffer)
+        {
+            LOG_ERROR("Invalid buffer");
+            return false;
+        }
+
+        if (!m_persistent_mapping)
+        {
+            m_mapped = nullptr;
+        }
+
+		return true;
+	}
+}
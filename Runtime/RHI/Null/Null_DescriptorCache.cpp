@@ -0,0 +1,57 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "../RHI_Implementation.h"
+#include "../RHI_DescriptorCache.h"
+#include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//=====================================
+
+namespace Spartan
+{
+    RHI_DescriptorCache::~RHI_DescriptorCache()
+    = default;
+
+    void RHI_DescriptorCache::SetDescriptorSetCapacity(uint32_t descriptor_set_capacity)
+    {
+        if (!m_rhi_device || !m_rhi_device->GetContextRhi())
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return;
+        }
+
+        // Destroy layouts (and descriptor sets)
+        m_descriptor_set_layouts.clear();
+        m_descriptor_layout_current = nullptr;
+
+        // Re-allocate everything with the new size
+        CreateDescriptorPool(descriptor_set_capacity);
+    }
+
+    bool RHI_DescriptorCache::CreateDescriptorPool(uint32_t descriptor_set_capacity)
+    {
+        // There is no pool, the capacity is only enforced by the generic code
+        m_descriptor_pool = null_utility::handle::create();
+        return true;
+    }
+}
@@ -0,0 +1,76 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../../Core/Context.h"
+#include "../../Logging/Log.h"
+//=================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+	RHI_Device::RHI_Device(Context* context)
+	{
+        m_context                          = context;
+        m_rhi_context                      = make_shared<RHI_Context>();
+        null_utility::globals::rhi_context = m_rhi_context.get();
+        null_utility::globals::rhi_device  = this;
+
+        // Device and queues
+        m_rhi_context->device           = null_utility::handle::create();
+        m_rhi_context->queue_graphics   = null_utility::handle::create();
+        m_rhi_context->queue_compute    = null_utility::handle::create();
+        m_rhi_context->queue_transfer   = null_utility::handle::create();
+
+        // There is no display either, so no display modes are registered and the timer doesn't limit the frame rate
+        RegisterPhysicalDevice(PhysicalDevice(0, 0, 0, RHI_PhysicalDevice_Cpu, "Null", 0, nullptr));
+
+        LOG_INFO("Null RHI, commands are recorded but not executed");
+
+		m_initialized = true;
+	}
+
+	RHI_Device::~RHI_Device()
+	{
+        m_rhi_context->device = nullptr;
+	}
+
+    bool RHI_Device::Queue_Present(void* swapchain_view, uint32_t* image_index, void* wait_semaphore /*= nullptr*/) const
+    {
+        return true;
+    }
+
+    bool RHI_Device::Queue_Submit(const RHI_Queue_Type type, void* cmd_buffer, void* wait_semaphore /*= nullptr*/, void* signal_semaphore /*= nullptr*/, void* signal_fence /*= nullptr*/, uint32_t wait_flags /*= 0*/) const
+    {
+        return true;
+    }
+
+    bool RHI_Device::Queue_Wait(const RHI_Queue_Type type) const
+    {
+        return true;
+    }
+}
@@ -0,0 +1,105 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_IndexBuffer.h"
+#include "../../Logging/Log.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void RHI_IndexBuffer::_destroy()
+    {
+        m_mapped = nullptr;
+        null_utility::buffer::destroy(m_buffer);
+    }
+
+	bool RHI_IndexBuffer::_create(const void* indices)
+	{
+		if (!m_rhi_device || !m_rhi_device->GetContextRhi()->device)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+        // Destroy previous buffer
+        _destroy();
+
+        // Create buffer
+        m_buffer = null_utility::buffer::create(m_size_gpu);
+        if (!m_buffer)
+        {
+            LOG_ERROR("Failed to allocate buffer");
+            return false;
+        }
+
+        // Initial data is copied, so the CPU cost of an upload is still paid
+        if (indices)
+        {
+            memcpy(m_buffer, indices, m_size_gpu);
+        }
+
+        // Like the other backends, buffers with initial data are only updated via staging
+        m_is_mappable = indices == nullptr;
+
+		return true;
+	}
+
+	void* RHI_IndexBuffer::Map()
+	{
+        if (!m_is_mappable)
+        {
+            LOG_ERROR("Not mappable, can only be updated via staging");
+            return nullptr;
+        }
+
+        if (!m_buffer)
+        {
+            LOG_ERROR("Invalid buffer");
+            return nullptr;
+        }
+
+        m_mapped = m_buffer;
+        return m_mapped;
+	}
+
+	bool RHI_IndexBuffer::Unmap()
+	{
+        if (!m_is_mappable)
+        {
+            LOG_ERROR("Not mappable, can only be updated via staging");
+            return false;
+        }
+
+        if (!m_persistent_mapping)
+        {
+            m_mapped = nullptr;
+        }
+
+		return true;
+	}
+}
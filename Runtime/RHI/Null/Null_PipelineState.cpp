@@ -0,0 +1,55 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "../RHI_Implementation.h"
+#include "../RHI_PipelineState.h"
+#include "../RHI_SwapChain.h"
+//================================
+
+namespace Spartan
+{
+    bool RHI_PipelineState::CreateFrameResources(const RHI_Device* rhi_device)
+    {
+        m_rhi_device = rhi_device;
+
+        // Destroy existing frame resources
+        DestroyFrameResources();
+
+        // Render pass
+        m_render_pass = null_utility::handle::create();
+
+        // Frame buffers, one per image for the swapchain
+        const uint32_t frame_buffer_count = render_target_swapchain ? render_target_swapchain->GetBufferCount() : 1;
+        for (uint32_t i = 0; i < frame_buffer_count; i++)
+        {
+            m_frame_buffers[i] = null_utility::handle::create();
+        }
+
+        return true;
+    }
+
+    void RHI_PipelineState::DestroyFrameResources()
+    {
+        m_frame_buffers.fill(nullptr);
+        m_render_pass = nullptr;
+    }
+}
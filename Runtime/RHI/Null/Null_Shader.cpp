@@ -0,0 +1,64 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "../RHI_Implementation.h"
+#include "../RHI_Device.h"
+#include "../RHI_Shader.h"
+#include "../RHI_InputLayout.h"
+#include "../../Logging/Log.h"
+#include "../../Core/FileSystem.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_Shader::~RHI_Shader()
+	{
+        m_resource = nullptr;
+	}
+
+	void* RHI_Shader::_Compile(const string& shader)
+	{
+        // Nothing is compiled, so there is no reflection either and shaders have no descriptors.
+        // A missing file is still an error though, as it would be for any other backend.
+        if (FileSystem::IsSupportedShaderFile(shader) && !FileSystem::Exists(shader))
+        {
+            LOG_ERROR("Failed to find %s", shader.c_str());
+            return nullptr;
+        }
+
+        // Create input layout
+        if (m_vertex_type != RHI_Vertex_Type_Unknown)
+        {
+            if (!m_input_layout->Create(m_vertex_type, nullptr))
+            {
+                LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(shader).c_str());
+                return nullptr;
+            }
+        }
+
+        return null_utility::handle::create();
+	}
+}
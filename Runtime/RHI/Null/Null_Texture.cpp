@@ -0,0 +1,144 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "../RHI_Implementation.h"
+#include "../RHI_Texture2D.h"
+#include "../RHI_TextureCube.h"
+#include "../RHI_CommandList.h"
+#include "../../Profiling/Profiler.h"
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    inline RHI_Image_Layout get_target_layout(const RHI_Texture* texture)
+    {
+        RHI_Image_Layout target_layout = RHI_Image_Preinitialized;
+
+        if (texture->IsSampled() && texture->IsColorFormat())
+            target_layout = RHI_Image_Shader_Read_Only_Optimal;
+
+        if (texture->IsRenderTargetColor())
+            target_layout = RHI_Image_Color_Attachment_Optimal;
+
+        if (texture->IsRenderTargetDepthStencil())
+            target_layout = RHI_Image_Depth_Stencil_Attachment_Optimal;
+
+        return target_layout;
+    }
+
+    inline void create_views(RHI_Texture* texture, void*& resource, void** resource_view, array<void*, state_max_render_target_count>& resource_view_render_target, array<void*, state_max_render_target_count>& resource_view_depth_stencil)
+    {
+        resource = null_utility::handle::create();
+
+        // Shader resource views
+        if (texture->IsSampled())
+        {
+            resource_view[0] = null_utility::handle::create();
+
+            if (texture->IsStencilFormat())
+            {
+                resource_view[1] = null_utility::handle::create();
+            }
+        }
+
+        // Render target views
+        for (uint32_t i = 0; i < texture->GetArraySize(); i++)
+        {
+            if (texture->IsRenderTargetColor())
+            {
+                resource_view_render_target[i] = null_utility::handle::create();
+            }
+
+            if (texture->IsRenderTargetDepthStencil())
+            {
+                resource_view_depth_stencil[i] = null_utility::handle::create();
+            }
+        }
+    }
+
+    inline void destroy_views(void*& resource, void** resource_view, array<void*, state_max_render_target_count>& resource_view_render_target, array<void*, state_max_render_target_count>& resource_view_depth_stencil)
+    {
+        resource            = nullptr;
+        resource_view[0]    = nullptr;
+        resource_view[1]    = nullptr;
+        resource_view_render_target.fill(nullptr);
+        resource_view_depth_stencil.fill(nullptr);
+    }
+
+    RHI_Texture2D::~RHI_Texture2D()
+    {
+        m_data.clear();
+        destroy_views(m_resource, m_resource_view, m_resource_view_renderTarget, m_resource_view_depthStencil);
+    }
+
+    void RHI_Texture::SetLayout(const RHI_Image_Layout new_layout, RHI_CommandList* command_list /*= nullptr*/)
+    {
+        // The texture is most likely still initialising
+        if (m_layout == RHI_Image_Undefined)
+            return;
+
+        if (m_layout == new_layout)
+            return;
+
+        // If a command list is provided, this means we should record a pipeline barrier
+        if (command_list)
+        {
+            null_utility::get_command_stream(command_list->GetResource_CommandBuffer())->record(null_utility::command_barrier, m_resource, m_layout, new_layout);
+            m_context->GetSubsystem<Profiler>()->m_rhi_pipeline_barriers++;
+        }
+
+        m_layout = new_layout;
+    }
+
+	bool RHI_Texture2D::CreateResourceGpu()
+	{
+        create_views(this, m_resource, m_resource_view, m_resource_view_renderTarget, m_resource_view_depthStencil);
+
+        // There is nothing to upload to, so the texture is immediately in its target layout
+        m_layout = get_target_layout(this);
+
+        return true;
+	}
+
+	// TEXTURE CUBE
+
+    RHI_TextureCube::~RHI_TextureCube()
+    {
+        m_data.clear();
+        destroy_views(m_resource, m_resource_view, m_resource_view_renderTarget, m_resource_view_depthStencil);
+    }
+
+	bool RHI_TextureCube::CreateResourceGpu()
+	{
+        create_views(this, m_resource, m_resource_view, m_resource_view_renderTarget, m_resource_view_depthStencil);
+
+        // There is nothing to upload to, so the texture is immediately in its target layout
+        m_layout = get_target_layout(this);
+
+        return true;
+	}
+}
@@ -0,0 +1,167 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include "../RHI_Device.h"
+#include "../../Core/EngineDefs.h"
+#include "../../Logging/Log.h"
+#include <atomic>
+#include <chrono>
+#include <vector>
+//================================
+
+namespace Spartan::null_utility
+{
+    struct globals
+    {
+        static inline RHI_Device* rhi_device;
+        static inline RHI_Context* rhi_context;
+    };
+
+    namespace handle
+    {
+        // Unique, non-null values which stand in for API objects, so that the generic
+        // RHI code (hashing, caching, validation) behaves as it does with a real device.
+        inline void* create()
+        {
+            static std::atomic<uint64_t> id = 0;
+            return reinterpret_cast<void*>(++id);
+        }
+    }
+
+    namespace buffer
+    {
+        // Buffers are backed by system memory, the handle is the memory itself
+        inline void* create(const uint64_t size)
+        {
+            return size != 0 ? static_cast<void*>(new std::byte[size]) : nullptr;
+        }
+
+        inline void destroy(void*& buffer)
+        {
+            delete[] static_cast<std::byte*>(buffer);
+            buffer = nullptr;
+        }
+    }
+
+    enum command_type
+    {
+        command_begin_render_pass,
+        command_end_render_pass,
+        command_clear,
+        command_bind_pipeline,
+        command_bind_descriptor_set,
+        command_bind_vertex_buffer,
+        command_bind_index_buffer,
+        command_set_viewport,
+        command_set_scissor,
+        command_draw,
+        command_draw_indexed,
+        command_dispatch,
+        command_barrier
+    };
+
+    struct command
+    {
+        command_type type;
+        const char* pass_name;  // the pass which was active when the command was recorded
+        const void* resource;   // pipeline, descriptor set, buffer, render pass or image
+        uint64_t args[3];       // counts, offsets or dimensions, depending on the type
+    };
+
+    struct pass_timing
+    {
+        const char* name;
+        uint32_t command_start;
+        uint32_t command_count;
+        double cpu_ms;
+    };
+
+    // What a null command list records instead of API calls. It's exposed through
+    // RHI_CommandList::GetResource_CommandBuffer(), is cleared when the command list begins
+    // and stays intact after submission, so the last recorded frame can be inspected.
+    class command_stream
+    {
+    public:
+        void clear()
+        {
+            m_commands.clear();
+            m_passes.clear();
+            m_pass_stack.clear();
+            m_pass_start.clear();
+        }
+
+        void record(const command_type type, const void* resource = nullptr, const uint64_t arg_0 = 0, const uint64_t arg_1 = 0, const uint64_t arg_2 = 0)
+        {
+            const char* pass_name = m_pass_stack.empty() ? nullptr : m_passes[m_pass_stack.back()].name;
+            m_commands.push_back({ type, pass_name, resource, { arg_0, arg_1, arg_2 } });
+        }
+
+        void pass_begin(const char* name)
+        {
+            m_pass_stack.emplace_back(static_cast<uint32_t>(m_passes.size()));
+            m_passes.push_back({ name, static_cast<uint32_t>(m_commands.size()), 0, 0.0 });
+            m_pass_start.emplace_back(std::chrono::high_resolution_clock::now());
+        }
+
+        void pass_end()
+        {
+            if (m_pass_stack.empty())
+                return;
+
+            const std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - m_pass_start.back();
+
+            pass_timing& pass   = m_passes[m_pass_stack.back()];
+            pass.command_count  = static_cast<uint32_t>(m_commands.size()) - pass.command_start;
+            pass.cpu_ms         = duration.count();
+
+            m_pass_stack.pop_back();
+            m_pass_start.pop_back();
+        }
+
+        uint32_t count(const command_type type) const
+        {
+            uint32_t count = 0;
+            for (const command& cmd : m_commands)
+            {
+                count += cmd.type == type ? 1 : 0;
+            }
+
+            return count;
+        }
+
+        const std::vector<command>& get_commands()      const { return m_commands; }
+        const std::vector<pass_timing>& get_passes()    const { return m_passes; }
+
+    private:
+        std::vector<command> m_commands;
+        std::vector<pass_timing> m_passes;
+        std::vector<uint32_t> m_pass_stack;
+        std::vector<std::chrono::high_resolution_clock::time_point> m_pass_start;
+    };
+
+    inline command_stream* get_command_stream(void* cmd_buffer)
+    {
+        return static_cast<command_stream*>(cmd_buffer);
+    }
+}
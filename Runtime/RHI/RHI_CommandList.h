@@ -149,6 +149,7 @@ namespace Spartan
         bool Deferred_BeginRenderPass();
         bool Deferred_BindPipeline();
         bool Deferred_BindDescriptorSet();
+        bool Deferred_BindTextureTable();
         bool OnDraw();
 
         std::atomic<RHI_Cmd_List_State> m_cmd_state = RHI_Cmd_List_Idle;
@@ -157,6 +158,7 @@ namespace Spartan
         Renderer* m_renderer                        = nullptr;
         RHI_PipelineCache* m_pipeline_cache         = nullptr;
         RHI_DescriptorCache* m_descriptor_cache     = nullptr;
+        RHI_TextureTable* m_texture_table           = nullptr;
         RHI_PipelineState* m_pipeline_state         = nullptr;
         RHI_Device* m_rhi_device                    = nullptr;
         Profiler* m_profiler                        = nullptr;
@@ -34,9 +34,12 @@ namespace Spartan
 	class RHI_CommandList;
 	class RHI_PipelineState;
 	class RHI_PipelineCache;
+	class RHI_PipelineDescription;
 	class RHI_Pipeline;
     class RHI_DescriptorSetLayout;
     class RHI_DescriptorCache;
+    class RHI_TextureTable;
+    class RHI_ShaderCache;
 	class RHI_SwapChain;
 	class RHI_RasterizerState;
 	class RHI_BlendState;
@@ -70,7 +73,8 @@ namespace Spartan
     {
         RHI_Api_D3d11,
         RHI_Api_D3d12,
-        RHI_Api_Vulkan
+        RHI_Api_Vulkan,
+        RHI_Api_Null
     };
 
 	enum RHI_Present_Mode : uint32_t
@@ -311,6 +315,8 @@ namespace Spartan
     static const uint8_t        state_max_render_target_count   = 8;
     static const uint8_t        state_max_constant_buffer_count = 8;
     static const uint32_t       state_dynamic_offset_empty      = (std::numeric_limits<uint32_t>::max)();
+    static const uint32_t       state_texture_table_index_empty = (std::numeric_limits<uint32_t>::max)();
+    static const uint32_t       state_texture_table_index_default = 0;
 
     enum RHI_Shader_Type : uint8_t
 	{
@@ -348,6 +348,7 @@ namespace Spartan
             VkFormat surface_format                         = VK_FORMAT_UNDEFINED;
             VkColorSpaceKHR surface_color_space             = VK_COLOR_SPACE_MAX_ENUM_KHR;
             VmaAllocator allocator                          = nullptr;
+            VkPipelineCache pipeline_cache                  = nullptr;
             std::unordered_map<uint64_t, VmaAllocation> allocations;
 
             // Extensions
@@ -368,11 +369,11 @@ namespace Spartan
                 Identify specific sections within a VkQueue or VkCommandBuffer using labels to aid organization and offline analysis in external tools.
 
                 */
-                std::vector<const char*> extensions_device      = { "VK_KHR_swapchain", "VK_EXT_memory_budget", "VK_EXT_depth_clip_enable" };
+                std::vector<const char*> extensions_device      = { "VK_KHR_swapchain", "VK_EXT_memory_budget", "VK_EXT_depth_clip_enable", "VK_EXT_descriptor_indexing" };
                 std::vector<const char*> validation_layers      = { "VK_LAYER_KHRONOS_validation" };
                 std::vector<const char*> extensions_instance    = { "VK_KHR_surface", "VK_KHR_win32_surface", "VK_EXT_debug_report", "VK_EXT_debug_utils" };
             #else
-                std::vector<const char*> extensions_device      = { "VK_KHR_swapchain", "VK_EXT_memory_budget", "VK_EXT_depth_clip_enable" };
+                std::vector<const char*> extensions_device      = { "VK_KHR_swapchain", "VK_EXT_memory_budget", "VK_EXT_depth_clip_enable", "VK_EXT_descriptor_indexing" };
                 std::vector<const char*> validation_layers      = { };
                 std::vector<const char*> extensions_instance    = { "VK_KHR_surface", "VK_KHR_win32_surface" };
             #endif
@@ -381,6 +382,11 @@ namespace Spartan
                 void destroy_allocator();
         #endif
 
+        #if defined(API_GRAPHICS_NULL)
+            RHI_Api_Type api_type   = RHI_Api_Null;
+            void* device            = nullptr;
+        #endif
+
         // Debugging
         #ifdef DEBUG
             bool debug    = true;
@@ -403,10 +409,15 @@ namespace Spartan
         static const uint32_t descriptor_max_constant_buffers_dynamic   = 10;
         static const uint32_t descriptor_max_samplers                   = 10;
         static const uint32_t descriptor_max_textures                   = 10;
+        static const uint32_t descriptor_max_texture_table              = 16384;
 
         // Device limits
         uint32_t max_texture_dimension_2d   = 16384;
         uint32_t max_msaa_level             = 0;
+        uint32_t max_texture_table_size     = 0;
+
+        // Features
+        bool bindless_textures = false;
 
         // Queues
         void* queue_graphics            = nullptr;
@@ -425,6 +436,8 @@ namespace Spartan
     #include "D3D12/D3D12_Utility.h"
 #elif defined (API_GRAPHICS_VULKAN)
     #include "Vulkan/Vulkan_Utility.h"
+#elif defined (API_GRAPHICS_NULL)
+    #include "Null/Null_Utility.h"
 #endif
 
 #endif // RUNTIME
@@ -19,13 +19,19 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ===================
+//= INCLUDES ======================
 #include "RHI_PipelineCache.h"
 #include "RHI_Texture.h"
 #include "RHI_Pipeline.h"
 #include "RHI_SwapChain.h"
 #include "RHI_DescriptorCache.h"
-//==============================
+#include "RHI_Device.h"
+#include "../Core/Context.h"
+#include "../Core/FileSystem.h"
+#include "../IO/FileStream.h"
+#include "../Profiling/Profiler.h"
+#include "../Threading/Threading.h"
+//=================================
 
 //= NAMESPACES =====
 using namespace std;
@@ -33,7 +39,36 @@ using namespace std;
 
 namespace Spartan
 {
-    RHI_Pipeline* RHI_PipelineCache::GetPipeline(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state, void* descriptor_set_layout)
+    static const uint32_t manifest_version          = 1;
+    static const uint32_t manifest_pipelines_max    = 4096; // a count above this is a corrupted file
+
+    RHI_PipelineCache::RHI_PipelineCache(const RHI_Device* rhi_device, const string& directory)
+    {
+        m_rhi_device                = rhi_device;
+        m_file_path_manifest        = directory + "/pipeline_manifest.bin";
+        m_file_path_driver_cache    = directory + "/pipeline_cache.bin";
+        m_descriptor_cache          = make_shared<RHI_DescriptorCache>(rhi_device);
+
+        if (!FileSystem::Exists(directory))
+        {
+            FileSystem::CreateDirectory_(directory);
+        }
+
+        LoadManifest();
+        CreateDriverCache();
+    }
+
+    RHI_PipelineCache::~RHI_PipelineCache()
+    {
+        // Pipelines have to be destroyed before the driver cache
+        m_cache.clear();
+
+        SaveManifest();
+        SaveDriverCache();
+        DestroyDriverCache();
+    }
+
+    RHI_Pipeline* RHI_PipelineCache::GetPipeline(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state, void* descriptor_set_layout, void* descriptor_set_layout_texture_table /*= nullptr*/)
     {
         // Validate it
         if (!pipeline_state.IsValid())
@@ -42,14 +77,75 @@ namespace Spartan
             return nullptr;
         }
 
-        // Render target layout transitions
+        PrepareRenderTargets(cmd_list, pipeline_state);
+
+        // Compute a hash for it
+        pipeline_state.ComputeHash();
+        size_t hash = pipeline_state.GetHash();
+
+        {
+            unique_lock<mutex> lock(m_mutex);
+
+            // A pipeline which is being created (e.g. by the warm-up) is waited for, rather than created twice
+            m_condition.wait(lock, [this, hash] { return m_pending.find(hash) == m_pending.end(); });
+
+            auto it = m_cache.find(hash);
+            if (it != m_cache.end())
+                return it->second.get();
+
+            m_pending.insert(hash);
+        }
+
+        // Creating pipelines mid-frame causes hitches, count them so that regressions are easy to spot
+        m_rhi_device->GetContext()->GetSubsystem<Profiler>()->m_rhi_pipeline_creations++;
+
+        return Create(hash, pipeline_state, descriptor_set_layout, descriptor_set_layout_texture_table);
+    }
+
+    RHI_Pipeline* RHI_PipelineCache::Create(const size_t hash, RHI_PipelineState& pipeline_state, void* descriptor_set_layout, void* descriptor_set_layout_texture_table)
+    {
+        // The hash has been claimed, so the compilation runs without the lock and only lookups of this pipeline wait for it
+        shared_ptr<RHI_Pipeline> pipeline   = make_shared<RHI_Pipeline>(m_rhi_device, pipeline_state, descriptor_set_layout, descriptor_set_layout_texture_table);
+        RHI_Pipeline* pipeline_raw          = pipeline.get();
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_cache.emplace(hash, move(pipeline));
+            if (pipeline_state.shader_vertex)
+            {
+                m_descriptions[hash] = RHI_PipelineDescription(pipeline_state);
+            }
+            m_pending.erase(hash);
+        }
+        m_condition.notify_all();
+
+        return pipeline_raw;
+    }
+
+    void RHI_PipelineCache::WarmUp(vector<RHI_PipelineState>& pipeline_states, void* descriptor_set_layout_texture_table /*= nullptr*/)
+    {
+        m_rhi_device->GetContext()->GetSubsystem<Threading>()->AddTaskLoop([this, &pipeline_states, descriptor_set_layout_texture_table](uint32_t start, uint32_t end)
+        {
+            for (uint32_t i = start; i < end; i++)
+            {
+                WarmUp(pipeline_states[i], descriptor_set_layout_texture_table);
+            }
+        }, static_cast<uint32_t>(pipeline_states.size()));
+    }
+
+    void RHI_PipelineCache::PrepareRenderTargets(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state) const
+    {
+        // Render target layout transitions, without a command list (warm-up) the layouts are only recorded in the state
         {
             // Color
             {
                 // Swapchain
                 if (RHI_SwapChain* swapchain = pipeline_state.render_target_swapchain)
                 {
-                    swapchain->SetLayout(RHI_Image_Present_Src, cmd_list);
+                    if (cmd_list)
+                    {
+                        swapchain->SetLayout(RHI_Image_Present_Src, cmd_list);
+                    }
                     pipeline_state.render_target_color_layout_initial   = RHI_Image_Present_Src;
                     pipeline_state.render_target_color_layout_final     = RHI_Image_Present_Src;
                 }
@@ -59,7 +155,10 @@ namespace Spartan
                 {
                     if (RHI_Texture* texture = pipeline_state.render_target_color_textures[i])
                     {
-                        texture->SetLayout(RHI_Image_Color_Attachment_Optimal, cmd_list);
+                        if (cmd_list)
+                        {
+                            texture->SetLayout(RHI_Image_Color_Attachment_Optimal, cmd_list);
+                        }
                         pipeline_state.render_target_color_layout_initial   = RHI_Image_Color_Attachment_Optimal;
                         pipeline_state.render_target_color_layout_final     = RHI_Image_Color_Attachment_Optimal;
                     }
@@ -69,24 +168,78 @@ namespace Spartan
             // Depth
             if (RHI_Texture* texture = pipeline_state.render_target_depth_texture)
             {
-                texture->SetLayout(RHI_Image_Depth_Stencil_Attachment_Optimal, cmd_list);
+                if (cmd_list)
+                {
+                    texture->SetLayout(RHI_Image_Depth_Stencil_Attachment_Optimal, cmd_list);
+                }
                 pipeline_state.render_target_depth_layout_initial   = RHI_Image_Depth_Stencil_Attachment_Optimal;
                 pipeline_state.render_target_depth_layout_final     = RHI_Image_Depth_Stencil_Attachment_Optimal;
             }
         }
+    }
 
-        // Compute a hash for it
+    void RHI_PipelineCache::WarmUp(RHI_PipelineState& pipeline_state, void* descriptor_set_layout_texture_table)
+    {
+        if (!pipeline_state.IsValid())
+            return;
+
+        PrepareRenderTargets(nullptr, pipeline_state);
         pipeline_state.ComputeHash();
-        size_t hash = pipeline_state.GetHash();
+        const size_t hash = pipeline_state.GetHash();
 
-        // If no pipeline exists for this state, create one
-        auto it = m_cache.find(hash);
-        if (it == m_cache.end())
+        // Claim the hash, so that a draw which needs this pipeline in the meantime waits for it
         {
-            // Cache a new pipeline
-            it = m_cache.emplace(make_pair(hash, move(make_shared<RHI_Pipeline>(m_rhi_device, pipeline_state, descriptor_set_layout)))).first;
+            lock_guard<mutex> lock(m_mutex);
+            if (m_cache.find(hash) != m_cache.end() || !m_pending.insert(hash).second)
+                return;
         }
 
-        return it->second.get();
+        void* descriptor_set_layout = nullptr;
+        {
+            lock_guard<mutex> lock(m_descriptor_cache_mutex);
+            m_descriptor_cache->SetPipelineState(pipeline_state);
+            descriptor_set_layout = m_descriptor_cache->GetResource_DescriptorSetLayout();
+        }
+
+        Create(hash, pipeline_state, descriptor_set_layout, descriptor_set_layout_texture_table);
+    }
+
+    void RHI_PipelineCache::LoadManifest()
+    {
+        if (!FileSystem::Exists(m_file_path_manifest))
+            return;
+
+        // The checksum rejects a file which was only partially written
+        auto file = make_unique<FileStream>(m_file_path_manifest, FileStream_Read | FileStream_Checksum);
+        if (!file->IsOpen())
+            return;
+
+        const uint32_t version  = file->ReadAs<uint32_t>();
+        const uint32_t count    = file->ReadAs<uint32_t>();
+        if (version != manifest_version || count > manifest_pipelines_max)
+        {
+            LOG_WARNING("\"%s\" is outdated or corrupted, pipelines won't be warmed up", m_file_path_manifest.c_str());
+            return;
+        }
+
+        m_manifest.resize(count);
+        for (RHI_PipelineDescription& description : m_manifest)
+        {
+            description.Deserialize(file.get());
+        }
+    }
+
+    void RHI_PipelineCache::SaveManifest() const
+    {
+        auto file = make_unique<FileStream>(m_file_path_manifest, FileStream_Write | FileStream_Checksum);
+        if (!file->IsOpen())
+            return;
+
+        file->Write(manifest_version);
+        file->Write(static_cast<uint32_t>(m_descriptions.size()));
+        for (const auto& [hash, description] : m_descriptions)
+        {
+            description.Serialize(file.get());
+        }
     }
 }
@@ -21,24 +21,62 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ======================
+//= INCLUDES ==========================
 #include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
 #include <unordered_map>
+#include <unordered_set>
 #include "RHI_Definition.h"
+#include "RHI_PipelineDescription.h"
 #include "../Core/Spartan_Object.h"
-//=================================
+//=====================================
 
 namespace Spartan
 {
 	class RHI_PipelineCache : public Spartan_Object
 	{
 	public:
-        RHI_PipelineCache(const RHI_Device* rhi_device) { m_rhi_device = rhi_device; }
-        RHI_Pipeline* GetPipeline(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state, void* descriptor_set_layout);
+        RHI_PipelineCache(const RHI_Device* rhi_device, const std::string& directory);
+        ~RHI_PipelineCache();
+
+        RHI_Pipeline* GetPipeline(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state, void* descriptor_set_layout, void* descriptor_set_layout_texture_table = nullptr);
+        uint32_t GetPipelineCount() const { return static_cast<uint32_t>(m_cache.size()); }
+
+        // Pipelines which previous runs created, the caller resolves them against its objects and passes them to WarmUp()
+        const auto& GetManifest() const { return m_manifest; }
+        // Creates the pipelines of the given states on worker threads and returns when they are all created
+        void WarmUp(std::vector<RHI_PipelineState>& pipeline_states, void* descriptor_set_layout_texture_table = nullptr);
 
 	private:
+        void PrepareRenderTargets(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state) const;
+        void WarmUp(RHI_PipelineState& pipeline_state, void* descriptor_set_layout_texture_table);
+        RHI_Pipeline* Create(const std::size_t hash, RHI_PipelineState& pipeline_state, void* descriptor_set_layout, void* descriptor_set_layout_texture_table);
+        void LoadManifest();
+        void SaveManifest() const;
+
+        // Driver pipeline cache, persisted across runs (API)
+        void CreateDriverCache();
+        void SaveDriverCache() const;
+        void DestroyDriverCache();
+
         // <hash of pipeline state, pipeline state object>
         std::unordered_map<std::size_t, std::shared_ptr<RHI_Pipeline>> m_cache;
+        std::unordered_set<std::size_t> m_pending; // being created, outside of the lock
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        // Manifest, the descriptions of the pipelines of the previous run and of this one
+        std::vector<RHI_PipelineDescription> m_manifest;
+        std::unordered_map<std::size_t, RHI_PipelineDescription> m_descriptions;
+        std::string m_file_path_manifest;
+        std::string m_file_path_driver_cache;
+
+        // Descriptor set layouts of the warm-up (identical to those of the command lists, so pipelines are interchangeable)
+        std::shared_ptr<RHI_DescriptorCache> m_descriptor_cache;
+        std::mutex m_descriptor_cache_mutex;
 
         // Dependencies
         const RHI_Device* m_rhi_device;
@@ -0,0 +1,256 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========================
+#include <algorithm>
+#include <cstring>
+#include "RHI_PipelineDescription.h"
+#include "RHI_PipelineState.h"
+#include "RHI_Shader.h"
+#include "RHI_Texture.h"
+#include "RHI_BlendState.h"
+#include "RHI_RasterizerState.h"
+#include "RHI_DepthStencilState.h"
+#include "../IO/FileStream.h"
+//====================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    static uint32_t float_bits(const float value)
+    {
+        uint32_t bits = 0;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    RHI_PipelineDescription::RHI_PipelineDescription(const RHI_PipelineState& pipeline_state)
+    {
+        shader_vertex       = Describe(pipeline_state.shader_vertex);
+        shader_pixel        = Describe(pipeline_state.shader_pixel);
+        rasterizer_state    = Describe(pipeline_state.rasterizer_state);
+        blend_state         = Describe(pipeline_state.blend_state);
+        depth_stencil_state = Describe(pipeline_state.depth_stencil_state);
+
+        render_target_swapchain = pipeline_state.render_target_swapchain != nullptr;
+        for (uint32_t i = 0; i < state_max_render_target_count; i++)
+        {
+            if (const RHI_Texture* texture = pipeline_state.render_target_color_textures[i])
+            {
+                render_target_color_names[i]    = texture->GetName();
+                render_target_color_formats[i]  = static_cast<uint32_t>(texture->GetFormat());
+            }
+        }
+
+        if (const RHI_Texture* texture = pipeline_state.render_target_depth_texture)
+        {
+            render_target_depth_name    = texture->GetName();
+            render_target_depth_format  = static_cast<uint32_t>(texture->GetFormat());
+        }
+
+        render_target_width     = pipeline_state.GetWidth();
+        render_target_height    = pipeline_state.GetHeight();
+
+        primitive_topology                              = static_cast<uint32_t>(pipeline_state.primitive_topology);
+        viewport                                        = pipeline_state.viewport;
+        scissor                                         = pipeline_state.scissor;
+        dynamic_scissor                                 = pipeline_state.dynamic_scissor;
+        vertex_buffer_stride                            = pipeline_state.vertex_buffer_stride;
+        render_target_color_texture_array_index         = pipeline_state.render_target_color_texture_array_index;
+        render_target_depth_stencil_texture_array_index = pipeline_state.render_target_depth_stencil_texture_array_index;
+        clear_depth                                     = pipeline_state.clear_depth;
+        clear_stencil                                   = pipeline_state.clear_stencil;
+        clear_color                                     = pipeline_state.clear_color;
+    }
+
+    void RHI_PipelineDescription::Serialize(FileStream* stream) const
+    {
+        stream->Write(shader_vertex);
+        stream->Write(shader_pixel);
+        stream->Write(rasterizer_state);
+        stream->Write(blend_state);
+        stream->Write(depth_stencil_state);
+
+        stream->Write(render_target_swapchain);
+        for (uint32_t i = 0; i < state_max_render_target_count; i++)
+        {
+            stream->Write(render_target_color_names[i]);
+            stream->Write(render_target_color_formats[i]);
+        }
+        stream->Write(render_target_depth_name);
+        stream->Write(render_target_depth_format);
+        stream->Write(render_target_width);
+        stream->Write(render_target_height);
+
+        stream->Write(primitive_topology);
+        stream->Write(viewport.x);
+        stream->Write(viewport.y);
+        stream->Write(viewport.width);
+        stream->Write(viewport.height);
+        stream->Write(viewport.depth_min);
+        stream->Write(viewport.depth_max);
+        stream->Write(scissor.left);
+        stream->Write(scissor.top);
+        stream->Write(scissor.right);
+        stream->Write(scissor.bottom);
+        stream->Write(dynamic_scissor);
+        stream->Write(vertex_buffer_stride);
+        stream->Write(render_target_color_texture_array_index);
+        stream->Write(render_target_depth_stencil_texture_array_index);
+        stream->Write(clear_depth);
+        stream->Write(clear_stencil);
+        for (const Math::Vector4& color : clear_color)
+        {
+            stream->Write(color);
+        }
+    }
+
+    void RHI_PipelineDescription::Deserialize(FileStream* stream)
+    {
+        stream->Read(&shader_vertex);
+        stream->Read(&shader_pixel);
+        stream->Read(&rasterizer_state);
+        stream->Read(&blend_state);
+        stream->Read(&depth_stencil_state);
+
+        stream->Read(&render_target_swapchain);
+        for (uint32_t i = 0; i < state_max_render_target_count; i++)
+        {
+            stream->Read(&render_target_color_names[i]);
+            stream->Read(&render_target_color_formats[i]);
+        }
+        stream->Read(&render_target_depth_name);
+        stream->Read(&render_target_depth_format);
+        stream->Read(&render_target_width);
+        stream->Read(&render_target_height);
+
+        stream->Read(&primitive_topology);
+        stream->Read(&viewport.x);
+        stream->Read(&viewport.y);
+        stream->Read(&viewport.width);
+        stream->Read(&viewport.height);
+        stream->Read(&viewport.depth_min);
+        stream->Read(&viewport.depth_max);
+        stream->Read(&scissor.left);
+        stream->Read(&scissor.top);
+        stream->Read(&scissor.right);
+        stream->Read(&scissor.bottom);
+        stream->Read(&dynamic_scissor);
+        stream->Read(&vertex_buffer_stride);
+        stream->Read(&render_target_color_texture_array_index);
+        stream->Read(&render_target_depth_stencil_texture_array_index);
+        stream->Read(&clear_depth);
+        stream->Read(&clear_stencil);
+        for (Math::Vector4& color : clear_color)
+        {
+            stream->Read(&color);
+        }
+    }
+
+    void RHI_PipelineDescription::Apply(RHI_PipelineState& pipeline_state) const
+    {
+        pipeline_state.primitive_topology                               = static_cast<RHI_PrimitiveTopology_Mode>(primitive_topology);
+        pipeline_state.viewport                                         = viewport;
+        pipeline_state.scissor                                          = scissor;
+        pipeline_state.dynamic_scissor                                  = dynamic_scissor;
+        pipeline_state.vertex_buffer_stride                             = vertex_buffer_stride;
+        pipeline_state.render_target_color_texture_array_index          = render_target_color_texture_array_index;
+        pipeline_state.render_target_depth_stencil_texture_array_index  = render_target_depth_stencil_texture_array_index;
+        pipeline_state.clear_depth                                      = clear_depth;
+        pipeline_state.clear_stencil                                    = clear_stencil;
+        pipeline_state.clear_color                                      = clear_color;
+    }
+
+    vector<string> RHI_PipelineDescription::Describe(const RHI_Shader* shader)
+    {
+        if (!shader)
+            return {};
+
+        vector<string> defines;
+        defines.reserve(shader->GetDefines().size());
+        for (const auto& [name, value] : shader->GetDefines())
+        {
+            defines.emplace_back(name + "=" + value);
+        }
+        sort(defines.begin(), defines.end());
+
+        vector<string> description = { shader->GetFilePath() };
+        description.insert(description.end(), defines.begin(), defines.end());
+        return description;
+    }
+
+    vector<uint32_t> RHI_PipelineDescription::Describe(const RHI_RasterizerState* rasterizer_state)
+    {
+        if (!rasterizer_state)
+            return {};
+
+        return
+        {
+            static_cast<uint32_t>(rasterizer_state->GetCullMode()),
+            static_cast<uint32_t>(rasterizer_state->GetFillMode()),
+            static_cast<uint32_t>(rasterizer_state->GetDepthClipEnabled()),
+            static_cast<uint32_t>(rasterizer_state->GetScissorEnabled()),
+            static_cast<uint32_t>(rasterizer_state->GetMultiSampleEnabled()),
+            static_cast<uint32_t>(rasterizer_state->GetAntialisedLineEnabled()),
+            float_bits(rasterizer_state->GetLineWidth())
+        };
+    }
+
+    vector<uint32_t> RHI_PipelineDescription::Describe(const RHI_BlendState* blend_state)
+    {
+        if (!blend_state)
+            return {};
+
+        return
+        {
+            static_cast<uint32_t>(blend_state->GetBlendEnabled()),
+            static_cast<uint32_t>(blend_state->GetSourceBlend()),
+            static_cast<uint32_t>(blend_state->GetDestBlend()),
+            static_cast<uint32_t>(blend_state->GetBlendOp()),
+            static_cast<uint32_t>(blend_state->GetSourceBlendAlpha()),
+            static_cast<uint32_t>(blend_state->GetDestBlendAlpha()),
+            static_cast<uint32_t>(blend_state->GetBlendOpAlpha()),
+            float_bits(blend_state->GetBlendFactor())
+        };
+    }
+
+    vector<uint32_t> RHI_PipelineDescription::Describe(const RHI_DepthStencilState* depth_stencil_state)
+    {
+        if (!depth_stencil_state)
+            return {};
+
+        return
+        {
+            static_cast<uint32_t>(depth_stencil_state->GetDepthTestEnabled()),
+            static_cast<uint32_t>(depth_stencil_state->GetDepthWriteEnabled()),
+            static_cast<uint32_t>(depth_stencil_state->GetDepthFunction()),
+            static_cast<uint32_t>(depth_stencil_state->GetStencilTestEnabled()),
+            static_cast<uint32_t>(depth_stencil_state->GetStencilWriteEnabled()),
+            static_cast<uint32_t>(depth_stencil_state->GetStencilFunction()),
+            static_cast<uint32_t>(depth_stencil_state->GetStencilFailOperation()),
+            static_cast<uint32_t>(depth_stencil_state->GetStencilDepthFailOperation()),
+            static_cast<uint32_t>(depth_stencil_state->GetStencilPassOperation())
+        };
+    }
+}
@@ -0,0 +1,88 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <array>
+#include <string>
+#include <vector>
+#include "RHI_Definition.h"
+#include "RHI_Viewport.h"
+#include "../Math/Rectangle.h"
+//=================================
+
+namespace Spartan
+{
+    class FileStream;
+
+    // A pipeline state in terms which outlive a run (object ids don't), so that it can be saved and resolved against the objects
+    // of a later run. Shaders are described by file and defines, fixed function states by value and render targets by name and format.
+    class SPARTAN_CLASS RHI_PipelineDescription
+    {
+    public:
+        RHI_PipelineDescription() = default;
+        RHI_PipelineDescription(const RHI_PipelineState& pipeline_state);
+        ~RHI_PipelineDescription() = default;
+
+        void Serialize(FileStream* stream) const;
+        void Deserialize(FileStream* stream);
+
+        // Copies the plain values (everything but objects) into a pipeline state
+        void Apply(RHI_PipelineState& pipeline_state) const;
+
+        // An object matches a description when it describes to the same value
+        static std::vector<std::string> Describe(const RHI_Shader* shader);
+        static std::vector<uint32_t> Describe(const RHI_RasterizerState* rasterizer_state);
+        static std::vector<uint32_t> Describe(const RHI_BlendState* blend_state);
+        static std::vector<uint32_t> Describe(const RHI_DepthStencilState* depth_stencil_state);
+
+        // Shaders, the file path followed by the defines ("name=value", sorted), empty if unused
+        std::vector<std::string> shader_vertex;
+        std::vector<std::string> shader_pixel;
+
+        // Fixed function states
+        std::vector<uint32_t> rasterizer_state;
+        std::vector<uint32_t> blend_state;
+        std::vector<uint32_t> depth_stencil_state;
+
+        // Render targets, a name is empty if the slot is unused
+        bool render_target_swapchain = false;
+        std::array<std::string, state_max_render_target_count> render_target_color_names;
+        std::array<uint32_t, state_max_render_target_count> render_target_color_formats = {};
+        std::string render_target_depth_name;
+        uint32_t render_target_depth_format = 0;
+        uint32_t render_target_width        = 0; // names alone are ambiguous for mip chains (e.g. bloom)
+        uint32_t render_target_height       = 0;
+
+        // Plain values
+        uint32_t primitive_topology                                 = 0;
+        RHI_Viewport viewport                                       = RHI_Viewport::Undefined;
+        Math::Rectangle scissor                                     = Math::Rectangle::Zero;
+        bool dynamic_scissor                                        = false;
+        uint32_t vertex_buffer_stride                               = 0;
+        uint32_t render_target_color_texture_array_index            = 0;
+        uint32_t render_target_depth_stencil_texture_array_index    = 0;
+        float clear_depth                                           = state_depth_load;
+        uint32_t clear_stencil                                      = state_stencil_load;
+        std::array<Math::Vector4, state_max_render_target_count> clear_color;
+    };
+}
@@ -166,6 +166,10 @@ namespace Spartan
         static const char* target_profile_vs = "vs_6_0";
         static const char* target_profile_ps = "ps_6_0";
         static const char* target_profile_cs = "cs_6_0";
+        #elif defined(API_GRAPHICS_NULL)
+        static const char* target_profile_vs = "vs_6_0";
+        static const char* target_profile_ps = "ps_6_0";
+        static const char* target_profile_cs = "cs_6_0";
         #endif
 
         if (m_shader_type == RHI_Shader_Vertex)     return target_profile_vs;
@@ -183,6 +187,8 @@ namespace Spartan
         static const char* shader_model = "6_0";
         #elif defined(API_GRAPHICS_VULKAN)
         static const char* shader_model = "6_0";
+        #elif defined(API_GRAPHICS_NULL)
+        static const char* shader_model = "6_0";
         #endif
 
         return shader_model;
@@ -210,6 +216,10 @@ namespace Spartan
 		// Get textures
 		for (const auto& resource : resources.separate_images)
 		{
+            // Textures outside of the first set belong to the texture table, which is bound by the engine
+            if (compiler.get_decoration(resource.id, spv::DecorationDescriptorSet) != 0)
+                continue;
+
             m_descriptors.emplace_back
             (
                 RHI_Descriptor_Type::RHI_Descriptor_Texture,                    // Type
@@ -0,0 +1,197 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "RHI_ShaderCache.h"
+#include "../IO/FileStream.h"
+#include "../Core/FileSystem.h"
+#include "../Core/Stopwatch.h"
+#include "../Utilities/Hash.h"
+#include "../Logging/Log.h"
+#include <map>
+#include <sstream>
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // Bump whenever the layout of an entry (or of RHI_Descriptor) changes
+    static const uint32_t shader_cache_version = 2;
+
+    static string read_text_file(const string& file_path)
+    {
+        ifstream in(file_path);
+        stringstream buffer;
+        buffer << in.rdbuf();
+        return buffer.str();
+    }
+
+    RHI_ShaderCache::RHI_ShaderCache(const string& directory)
+    {
+        m_directory = directory;
+
+        if (!FileSystem::Exists(m_directory))
+        {
+            FileSystem::CreateDirectory_(m_directory);
+        }
+    }
+
+    RHI_ShaderCache::~RHI_ShaderCache()
+    = default;
+
+    RHI_ShaderCache::Key RHI_ShaderCache::ComputeKey(const string& shader, const RHI_Shader_Type shader_type, const unordered_map<string, string>& defines, const size_t compiler_hash) const
+    {
+        Key key;
+        key.hash = compiler_hash;
+
+        Utility::Hash::hash_combine(key.hash, shader_cache_version);
+        Utility::Hash::hash_combine(key.hash, static_cast<uint32_t>(shader_type));
+
+        // Source and every included file (the contents, not the paths, so edits invalidate the entry)
+        if (FileSystem::IsFile(shader))
+        {
+            Utility::Hash::hash_combine(key.hash, read_text_file(shader));
+
+            for (const string& file_path : FileSystem::GetIncludedFiles(shader))
+            {
+                Utility::Hash::hash_combine(key.hash, read_text_file(file_path));
+            }
+        }
+        else
+        {
+            Utility::Hash::hash_combine(key.hash, shader);
+        }
+
+        // Everything but the file contents in readable form, the contents are covered by the hash
+        key.identity = shader + "|" + to_string(static_cast<uint32_t>(shader_type)) + "|" + to_string(compiler_hash);
+
+        // Defines, ordered so that the key doesn't depend on the hash map's iteration order
+        for (const auto& define : map<string, string>(defines.begin(), defines.end()))
+        {
+            Utility::Hash::hash_combine(key.hash, define.first);
+            Utility::Hash::hash_combine(key.hash, define.second);
+            key.identity += "|" + define.first + "=" + define.second;
+        }
+
+        return key;
+    }
+
+    bool RHI_ShaderCache::Load(const Key& key, vector<byte>& bytecode, vector<RHI_Descriptor>& descriptors)
+    {
+        const string file_path = GetEntryFilePath(key.hash);
+        if (!FileSystem::Exists(file_path))
+        {
+            m_misses++;
+            return false;
+        }
+
+        const Stopwatch timer;
+
+        // A truncated or otherwise corrupted entry fails the checksum and doesn't open
+        auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Checksum);
+        if (!file->IsOpen())
+        {
+            m_misses++;
+            return false;
+        }
+
+        // Reject entries written by a different version or for a different shader (whose hash collided with this one)
+        if (file->ReadAs<uint32_t>() != shader_cache_version || file->ReadAs<uint64_t>() != static_cast<uint64_t>(key.hash) || file->ReadAs<string>() != key.identity)
+        {
+            m_misses++;
+            return false;
+        }
+
+        // Read into locals, so that a miss leaves the caller's bytecode and descriptors untouched
+        const float compilation_time_ms = file->ReadAs<float>();
+
+        vector<byte> entry_bytecode;
+        file->Read(&entry_bytecode);
+
+        const uint32_t descriptor_count = file->ReadAs<uint32_t>();
+        vector<RHI_Descriptor> entry_descriptors;
+        entry_descriptors.reserve(descriptor_count);
+        for (uint32_t i = 0; i < descriptor_count; i++)
+        {
+            const RHI_Descriptor_Type type  = static_cast<RHI_Descriptor_Type>(file->ReadAs<uint32_t>());
+            const uint32_t slot             = file->ReadAs<uint32_t>();
+            const uint32_t stage            = file->ReadAs<uint32_t>();
+            entry_descriptors.emplace_back(type, slot, stage);
+        }
+
+        // SPIR-V is a stream of 32-bit words
+        if (entry_bytecode.empty() || entry_bytecode.size() % sizeof(uint32_t) != 0)
+        {
+            m_misses++;
+            return false;
+        }
+
+        bytecode    = move(entry_bytecode);
+        descriptors = move(entry_descriptors);
+
+        m_hits++;
+
+        // Atomic floats have no fetch_add, so do it with a compare exchange loop
+        const float time_saved_ms   = compilation_time_ms - timer.GetElapsedTimeMs();
+        float time_saved_ms_total   = m_time_saved_ms.load();
+        while (!m_time_saved_ms.compare_exchange_weak(time_saved_ms_total, time_saved_ms_total + time_saved_ms));
+
+        return true;
+    }
+
+    void RHI_ShaderCache::Save(const Key& key, const vector<byte>& bytecode, const vector<RHI_Descriptor>& descriptors, const float compilation_time_ms)
+    {
+        auto file = make_unique<FileStream>(GetEntryFilePath(key.hash), FileStream_Write | FileStream_Checksum);
+        if (!file->IsOpen())
+            return;
+
+        file->Write(shader_cache_version);
+        file->Write(static_cast<uint64_t>(key.hash));
+        file->Write(key.identity);
+        file->Write(compilation_time_ms);
+        file->Write(bytecode);
+        file->Write(static_cast<uint32_t>(descriptors.size()));
+        for (const RHI_Descriptor& descriptor : descriptors)
+        {
+            file->Write(static_cast<uint32_t>(descriptor.type));
+            file->Write(descriptor.slot);
+            file->Write(descriptor.stage);
+        }
+    }
+
+    void RHI_ShaderCache::LogStatistics() const
+    {
+        const uint32_t lookups = m_hits + m_misses;
+        if (lookups == 0)
+            return;
+
+        const float hit_rate = 100.0f * static_cast<float>(m_hits) / static_cast<float>(lookups);
+        LOG_INFO("%d/%d shaders loaded from the cache (%.1f%%), %.2f ms of compilation saved", m_hits.load(), lookups, hit_rate, m_time_saved_ms.load());
+    }
+
+    string RHI_ShaderCache::GetEntryFilePath(const size_t key) const
+    {
+        return m_directory + "/" + to_string(key) + ".shader_cache";
+    }
+}
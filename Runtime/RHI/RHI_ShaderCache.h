@@ -0,0 +1,70 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <string>
+#include <vector>
+#include <atomic>
+#include <unordered_map>
+#include "RHI_Definition.h"
+#include "../Core/Spartan_Object.h"
+//=================================
+
+namespace Spartan
+{
+    // A content addressed, on disk cache of compiled shaders. An entry holds the bytecode and the
+    // reflected descriptors, so a warm start skips both compilation and reflection.
+    class SPARTAN_CLASS RHI_ShaderCache : public Spartan_Object
+    {
+    public:
+        // The hash names the entry, the identity is stored in it so that two shaders whose hashes collide can't be mistaken for each other
+        struct Key
+        {
+            std::size_t hash = 0;
+            std::string identity;
+        };
+
+        RHI_ShaderCache(const std::string& directory);
+        ~RHI_ShaderCache();
+
+        // Returns a key which changes whenever the source, any of the included files, the defines, the stage or the compiler change
+        Key ComputeKey(const std::string& shader, const RHI_Shader_Type shader_type, const std::unordered_map<std::string, std::string>& defines, const std::size_t compiler_hash) const;
+
+        // Entries, the outputs are only written on a hit
+        bool Load(const Key& key, std::vector<std::byte>& bytecode, std::vector<RHI_Descriptor>& descriptors);
+        void Save(const Key& key, const std::vector<std::byte>& bytecode, const std::vector<RHI_Descriptor>& descriptors, const float compilation_time_ms);
+
+        // Statistics, the renderer logs them once the initial shaders are compiled
+        void LogStatistics() const;
+
+    private:
+        std::string GetEntryFilePath(const std::size_t key) const;
+
+        std::string m_directory;
+
+        // Statistics
+        std::atomic<uint32_t> m_hits        = 0;
+        std::atomic<uint32_t> m_misses      = 0;
+        std::atomic<float> m_time_saved_ms  = 0.0f;
+    };
+}
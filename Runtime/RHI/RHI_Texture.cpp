@@ -36,7 +36,8 @@ namespace Spartan
 {
 	RHI_Texture::RHI_Texture(Context* context) : IResource(context, Resource_Texture)
 	{
-		m_rhi_device = context->GetSubsystem<Renderer>()->GetRhiDevice();
+		m_rhi_device    = context->GetSubsystem<Renderer>()->GetRhiDevice();
+        m_texture_table = context->GetSubsystem<Renderer>()->GetTextureTable();
 	}
 
 	RHI_Texture::~RHI_Texture()
@@ -198,7 +199,7 @@ namespace Spartan
         // Else attempt to load the data
         else
         {
-            auto file = make_unique<FileStream>(GetResourceFilePathNative(), FileStream_Read);
+            auto file = make_unique<FileStream>(GetResourceFilePathNative(), FileStream_Read | FileStream_Map);
             if (file->IsOpen())
             {
                 auto byte_count = file->ReadAs<uint32_t>();
@@ -206,10 +207,12 @@ namespace Spartan
 
                 if (index < mip_count)
                 {
-                    for (uint32_t i = 0; i <= index; i++)
+                    // Skip the preceding mips instead of reading them
+                    for (uint32_t i = 0; i < index; i++)
                     {
-                        file->Read(&data);
+                        file->Skip(file->ReadAs<uint32_t>());
                     }
+                    file->Read(&data);
                 }
                 else
                 {
@@ -241,7 +244,7 @@ namespace Spartan
 
 	bool RHI_Texture::LoadFromFile_NativeFormat(const string& file_path)
 	{
-		auto file = make_unique<FileStream>(file_path, FileStream_Read);
+		auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Map);
 		if (!file->IsOpen())
 			return false;
 
@@ -115,6 +115,10 @@ namespace Spartan
         const auto& GetViewport()   const { return m_viewport; }
         uint16_t GetFlags()         const { return m_flags; }
 
+        // Texture table (bindless)
+        uint32_t GetTextureTableIndex()                 const { return m_texture_table_index; }
+        void SetTextureTableIndex(const uint32_t index)       { m_texture_table_index = index; }
+
         // GPU resources
         void* Get_Resource()                                                const { return m_resource; }
         void  Set_Resource(void* resource)                                        { m_resource = resource; }
@@ -142,6 +146,8 @@ namespace Spartan
 		RHI_Viewport m_viewport;
 		std::vector<std::vector<std::byte>> m_data;
 		std::shared_ptr<RHI_Device> m_rhi_device;
+        std::shared_ptr<RHI_TextureTable> m_texture_table;
+        uint32_t m_texture_table_index = state_texture_table_index_empty;
 
         // API
         void* m_resource_view[2]                = { nullptr, nullptr }; // color/depth, stencil
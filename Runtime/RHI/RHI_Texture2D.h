@@ -31,8 +31,8 @@ namespace Spartan
 	class SPARTAN_CLASS RHI_Texture2D : public RHI_Texture
 	{
 	public:
-		// Creates a texture from data
-		RHI_Texture2D(Context* context, const uint32_t width, const uint32_t height, const RHI_Format format, const std::vector<std::vector<std::byte>>& data) : RHI_Texture(context)
+		// Creates a texture from data (pass an rvalue to hand the data over without copying it)
+		RHI_Texture2D(Context* context, const uint32_t width, const uint32_t height, const RHI_Format format, std::vector<std::vector<std::byte>> data) : RHI_Texture(context)
 		{
 			m_resource_type = Resource_Texture2d;
 			m_width			= width;
@@ -40,17 +40,17 @@ namespace Spartan
 			m_viewport		= RHI_Viewport(0, 0, static_cast<float>(width), static_cast<float>(height));
 			m_channel_count = GetChannelCountFromFormat(format);
 			m_format		= format;		
-			m_data			= data;
+			m_mip_levels    = static_cast<uint32_t>(data.size());
+			m_data			= std::move(data);
 			m_flags	        = RHI_Texture_ShaderView;
-            m_mip_levels    = static_cast<uint32_t>(data.size());
 
 			RHI_Texture2D::CreateResourceGpu();
 		}
 
-		// Creates a texture from data
-		RHI_Texture2D(Context* context, const uint32_t width, const uint32_t height, const RHI_Format format, const std::vector<std::byte>& data) : RHI_Texture(context)
+		// Creates a texture from data (pass an rvalue to hand the data over without copying it)
+		RHI_Texture2D(Context* context, const uint32_t width, const uint32_t height, const RHI_Format format, std::vector<std::byte> data) : RHI_Texture(context)
 		{
-            m_data.emplace_back(data);
+            m_data.emplace_back(std::move(data));
 
 			m_resource_type = Resource_Texture2d;
 			m_width			= width;
@@ -0,0 +1,117 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// Only the Vulkan backend implements the texture table
+#ifdef API_GRAPHICS_VULKAN
+
+//= INCLUDES ======================
+#include "RHI_TextureTable.h"
+#include "RHI_Texture.h"
+#include "RHI_Implementation.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_TextureTable::RHI_TextureTable(const shared_ptr<RHI_Device>& rhi_device)
+    {
+        m_rhi_device = rhi_device;
+
+        // Only create the table if the device can support it
+        if (!m_rhi_device->GetContextRhi()->bindless_textures)
+            return;
+
+        if (!CreateResources())
+        {
+            LOG_ERROR("Failed to create resources, textures will be bound per draw");
+        }
+    }
+
+    uint32_t RHI_TextureTable::Add(RHI_Texture* texture)
+    {
+        if (!IsSupported() || !texture || !texture->Get_Resource_View())
+            return state_texture_table_index_empty;
+
+        lock_guard<mutex> lock(m_mutex);
+
+        // A texture which re-creates its GPU resource keeps its index, only the descriptor gets updated
+        uint32_t index = texture->GetTextureTableIndex();
+        if (index == state_texture_table_index_empty)
+        {
+            if (!m_free_indices.empty())
+            {
+                index = m_free_indices.back();
+                m_free_indices.pop_back();
+            }
+            else if (m_next < m_capacity)
+            {
+                index = m_next++;
+            }
+            else
+            {
+                LOG_ERROR("Capacity of %d textures has been reached", m_capacity);
+                return state_texture_table_index_empty;
+            }
+
+            m_count++;
+        }
+
+        UpdateDescriptor(index, texture);
+        texture->SetTextureTableIndex(index);
+
+        return index;
+    }
+
+    bool RHI_TextureTable::SetDefault(RHI_Texture* texture)
+    {
+        if (!IsSupported() || !texture || !texture->Get_Resource_View())
+            return false;
+
+        lock_guard<mutex> lock(m_mutex);
+
+        UpdateDescriptor(state_texture_table_index_default, texture);
+        m_has_default = true;
+
+        return true;
+    }
+
+    void RHI_TextureTable::Remove(RHI_Texture* texture)
+    {
+        if (!texture)
+            return;
+
+        const uint32_t index = texture->GetTextureTableIndex();
+        if (index == state_texture_table_index_empty)
+            return;
+
+        lock_guard<mutex> lock(m_mutex);
+
+        // The slot is partially bound, so it can be left as is until it gets handed out again
+        m_free_indices.emplace_back(index);
+        m_count--;
+        texture->SetTextureTableIndex(state_texture_table_index_empty);
+    }
+}
+
+#endif
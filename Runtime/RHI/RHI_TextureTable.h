@@ -0,0 +1,79 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include "../Core/Spartan_Object.h"
+#include "RHI_Definition.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+//=================================
+
+namespace Spartan
+{
+    // A single, large array of sampled textures which is bound once per pipeline (bindless).
+    // Textures are registered when their GPU resource is created and keep a stable index,
+    // which shaders use to sample them without any per draw descriptor updates.
+    // The first slot is reserved for a default texture, so there is always a valid index to fall back to.
+    // Only the Vulkan backend implements it, the other backends bind textures per draw.
+    class SPARTAN_CLASS RHI_TextureTable : public Spartan_Object
+    {
+    public:
+        RHI_TextureTable(const std::shared_ptr<RHI_Device>& rhi_device);
+        ~RHI_TextureTable();
+
+        // Registration
+        uint32_t Add(RHI_Texture* texture);
+        void Remove(RHI_Texture* texture);
+        bool SetDefault(RHI_Texture* texture);
+
+        // Properties
+        bool IsSupported()                      const { return m_descriptor_set != nullptr; }
+        uint32_t GetCapacity()                  const { return m_capacity; }
+        uint32_t GetCount()                     const { return m_count; }
+        bool HasDefault()                       const { return m_has_default; }
+        void* GetResource_DescriptorSetLayout() const { return m_descriptor_set_layout; }
+        void* GetResource_DescriptorSet()       const { return m_descriptor_set; }
+
+    private:
+        bool CreateResources();
+        void UpdateDescriptor(const uint32_t index, RHI_Texture* texture);
+
+        // Indices
+        uint32_t m_capacity = 0;
+        uint32_t m_count    = 0;
+        uint32_t m_next     = state_texture_table_index_default + 1; // first index which has never been handed out
+        std::vector<uint32_t> m_free_indices;
+        std::atomic<bool> m_has_default = false;
+        std::mutex m_mutex;
+
+        // API
+        void* m_descriptor_pool         = nullptr;
+        void* m_descriptor_set_layout   = nullptr;
+        void* m_descriptor_set          = nullptr;
+
+        // Dependencies
+        std::shared_ptr<RHI_Device> m_rhi_device;
+    };
+}
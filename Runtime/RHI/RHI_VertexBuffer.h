@@ -69,7 +69,8 @@ namespace Spartan
 			return _create(nullptr);
 		}
 
-		void* Map();
+		// Discarding hands out fresh memory, otherwise the contents are kept and only parts which the GPU isn't using may be written
+		void* Map(bool discard = true);
 		bool Unmap();
 
 		void* GetResource()         const { return m_buffer; }
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_DescriptorCache.h"
 #include "../RHI_PipelineCache.h"
 #include "../RHI_DescriptorSetLayout.h"
+#include "../RHI_TextureTable.h"
 #include "../../Profiling/Profiler.h"
 #include "../../Rendering/Renderer.h"
 //=====================================
@@ -47,6 +48,7 @@ namespace Spartan
 		m_rhi_device	    = m_renderer->GetRhiDevice().get();
         m_pipeline_cache    = m_renderer->GetPipelineCache();
         m_descriptor_cache  = m_renderer->GetDescriptorCache();
+        m_texture_table     = m_renderer->GetTextureTable().get();
 
         RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
 
@@ -190,6 +192,13 @@ namespace Spartan
             }
         }
 
+        // Submit any batched resource uploads first, so they are visible to this command list
+        if (!vulkan_utility::upload_queue::flush())
+        {
+            LOG_ERROR("Failed to flush upload queue");
+            return false;
+        }
+
         RHI_PipelineState* state = m_pipeline->GetPipelineState();
 
         // Get wait and signal semaphores
@@ -263,7 +272,8 @@ namespace Spartan
             m_descriptor_cache->SetPipelineState(pipeline_state);
 
             // Get a pipeline which matches the pipeline state
-            m_pipeline = m_pipeline_cache->GetPipeline(this, pipeline_state, m_descriptor_cache->GetResource_DescriptorSetLayout());
+            void* descriptor_set_layout_texture_table = m_texture_table->IsSupported() ? m_texture_table->GetResource_DescriptorSetLayout() : nullptr;
+            m_pipeline = m_pipeline_cache->GetPipeline(this, pipeline_state, m_descriptor_cache->GetResource_DescriptorSetLayout(), descriptor_set_layout_texture_table);
             if (!m_pipeline)
             {
                 LOG_ERROR("Failed to acquire appropriate pipeline");
@@ -861,6 +871,30 @@ namespace Spartan
         return result;
     }
 
+    bool RHI_CommandList::Deferred_BindTextureTable()
+    {
+        // The texture table never changes, so it only has to be bound once per pipeline
+        if (!m_texture_table->IsSupported())
+            return true;
+
+        VkDescriptorSet descriptor_sets[1] = { static_cast<VkDescriptorSet>(m_texture_table->GetResource_DescriptorSet()) };
+        vkCmdBindDescriptorSets
+        (
+            static_cast<VkCommandBuffer>(m_cmd_buffer),                     // commandBuffer
+            VK_PIPELINE_BIND_POINT_GRAPHICS,                                // pipelineBindPoint
+            static_cast<VkPipelineLayout>(m_pipeline->GetPipelineLayout()), // layout
+            1,                                                              // firstSet
+            1,                                                              // descriptorSetCount
+            descriptor_sets,                                                // pDescriptorSets
+            0,                                                              // dynamicOffsetCount
+            nullptr                                                         // pDynamicOffsets
+        );
+
+        m_profiler->m_rhi_bindings_descriptor_set++;
+
+        return true;
+    }
+
     bool RHI_CommandList::Deferred_BindPipeline()
     {
         if (VkPipeline vk_pipeline = static_cast<VkPipeline>(m_pipeline->GetPipeline()))
@@ -875,7 +909,7 @@ namespace Spartan
             return false;
         }
 
-        return true;
+        return Deferred_BindTextureTable();
     }
 
     bool RHI_CommandList::OnDraw()
@@ -199,6 +199,53 @@ namespace Spartan
                 ENABLE_FEATURE(imageCubeArray)
             }
 
+            // Get descriptor indexing features (required by the bindless texture table)
+            VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_enabled = {};
+            descriptor_indexing_enabled.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+            if (vulkan_utility::extension::is_present_device("VK_EXT_descriptor_indexing", m_rhi_context->device_physical))
+            {
+                VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features = {};
+                descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+                VkPhysicalDeviceFeatures2 device_features_2 = {};
+                device_features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+                device_features_2.pNext = &descriptor_indexing_features;
+                vkGetPhysicalDeviceFeatures2(m_rhi_context->device_physical, &device_features_2);
+
+                VkPhysicalDeviceDescriptorIndexingProperties descriptor_indexing_properties = {};
+                descriptor_indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+                VkPhysicalDeviceProperties2 device_properties_2 = {};
+                device_properties_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                device_properties_2.pNext = &descriptor_indexing_properties;
+                vkGetPhysicalDeviceProperties2(m_rhi_context->device_physical, &device_properties_2);
+
+                m_rhi_context->bindless_textures =
+                    descriptor_indexing_features.runtimeDescriptorArray &&
+                    descriptor_indexing_features.descriptorBindingPartiallyBound &&
+                    descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind &&
+                    descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing;
+
+                if (m_rhi_context->bindless_textures)
+                {
+                    descriptor_indexing_enabled.runtimeDescriptorArray                          = VK_TRUE;
+                    descriptor_indexing_enabled.descriptorBindingPartiallyBound                 = VK_TRUE;
+                    descriptor_indexing_enabled.descriptorBindingSampledImageUpdateAfterBind    = VK_TRUE;
+                    descriptor_indexing_enabled.shaderSampledImageArrayNonUniformIndexing       = VK_TRUE;
+
+                    m_rhi_context->max_texture_table_size = Helper::Min3
+                    (
+                        RHI_Context::descriptor_max_texture_table,
+                        descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages,
+                        descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages
+                    );
+                }
+                else
+                {
+                    LOG_WARNING("Device doesn't support descriptor indexing, textures will be bound per draw");
+                }
+            }
+
             // Determine enabled graphics shader stages
             m_enabled_graphics_shader_stages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
             if (device_features_enabled.geometryShader)
@@ -222,6 +269,7 @@ namespace Spartan
 				create_info.pEnabledFeatures		= &device_features_enabled;
 				create_info.enabledExtensionCount	= static_cast<uint32_t>(extensions_supported.size());
 				create_info.ppEnabledExtensionNames = extensions_supported.data();
+                create_info.pNext                   = m_rhi_context->bindless_textures ? &descriptor_indexing_enabled : nullptr;
 
 				if (m_rhi_context->debug)
 				{
@@ -269,6 +317,7 @@ namespace Spartan
         // Release resources
 		if (Queue_Wait(RHI_Queue_Graphics))
 		{
+            vulkan_utility::upload_queue::shutdown();
             m_rhi_context->destroy_allocator();
 
             if (m_rhi_context->debug)
@@ -35,7 +35,11 @@ namespace Spartan
 {
     void RHI_IndexBuffer::_destroy()
     {
-        // Wait in case the buffer is still in use
+        if (!m_buffer)
+            return;
+
+        // Wait in case the buffer is still in use (or has a pending upload)
+        vulkan_utility::upload_queue::flush();
         m_rhi_device->Queue_WaitAll();
 
         // Unmap
@@ -83,36 +87,23 @@ namespace Spartan
         {
             // The reason we use staging is because memory with VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT is not mappable but it's fast, we want that.
 
-            // Create staging/source buffer and copy the indices to it
-            void* staging_buffer = nullptr;
-            VmaAllocation allocation_staging = vulkan_utility::buffer::create(staging_buffer, m_size_gpu, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false, indices);
-            if (!allocation_staging)
-                return false;
-
             // Create destination buffer
             VmaAllocation allocation = vulkan_utility::buffer::create(m_buffer, m_size_gpu, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
             if (!allocation)
                 return false;
 
-            // Copy staging buffer to destination buffer
+            // Copy the indices into the shared staging ring, the copy to the destination buffer is batched with other uploads
             {
-                // Create command buffer
-                VkCommandBuffer cmd_buffer = vulkan_utility::command_buffer_immediate::begin(RHI_Queue_Transfer);
+                vulkan_utility::upload_queue::allocation staging;
+                if (!vulkan_utility::upload_queue::begin(staging, m_size_gpu))
+                    return false;
 
-                VkBuffer* buffer_vk         = reinterpret_cast<VkBuffer*>(&m_buffer);
-                VkBuffer* buffer_staging_vk = reinterpret_cast<VkBuffer*>(&staging_buffer);
+                memcpy(staging.data, indices, m_size_gpu);
 
-                // Copy
                 VkBufferCopy copy_region = {};
-                copy_region.size = m_size_gpu;
-                vkCmdCopyBuffer(cmd_buffer, *buffer_staging_vk, *buffer_vk, 1, &copy_region);
-
-                // Flush and free command buffer
-                if (!vulkan_utility::command_buffer_immediate::end(RHI_Queue_Transfer))
-                    return false;
-
-                // Destroy staging buffer
-                vulkan_utility::buffer::destroy(staging_buffer);
+                copy_region.srcOffset    = staging.offset;
+                copy_region.size         = m_size_gpu;
+                vkCmdCopyBuffer(staging.cmd_buffer, staging.buffer, static_cast<VkBuffer>(m_buffer), 1, &copy_region);
             }
 
             m_allocation    = static_cast<void*>(allocation);
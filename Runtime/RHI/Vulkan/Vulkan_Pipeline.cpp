@@ -40,7 +40,7 @@ using namespace std;
 
 namespace Spartan
 {
-	RHI_Pipeline::RHI_Pipeline(const RHI_Device* rhi_device, RHI_PipelineState& pipeline_state, void* descriptor_set_layout)
+	RHI_Pipeline::RHI_Pipeline(const RHI_Device* rhi_device, RHI_PipelineState& pipeline_state, void* descriptor_set_layout, void* descriptor_set_layout_texture_table /*= nullptr*/)
 	{
 		m_rhi_device    = rhi_device;
 		m_state         = pipeline_state;
@@ -281,10 +281,17 @@ namespace Spartan
         // Pipeline layout
 		VkPipelineLayoutCreateInfo pipeline_layout_info	= {};
         { 
+            // Set 0 holds the per pass resources, set 1 (optional) the texture table
+            array<VkDescriptorSetLayout, 2> descriptor_set_layouts =
+            {
+                static_cast<VkDescriptorSetLayout>(descriptor_set_layout),
+                static_cast<VkDescriptorSetLayout>(descriptor_set_layout_texture_table)
+            };
+
 		    pipeline_layout_info.sType					= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 		    pipeline_layout_info.pushConstantRangeCount	= 0;
-		    pipeline_layout_info.setLayoutCount			= 1;		
-		    pipeline_layout_info.pSetLayouts			= reinterpret_cast<VkDescriptorSetLayout*>(&descriptor_set_layout);
+		    pipeline_layout_info.setLayoutCount			= descriptor_set_layout_texture_table ? 2 : 1;
+		    pipeline_layout_info.pSetLayouts			= descriptor_set_layouts.data();
 
             if (!vulkan_utility::error::check(vkCreatePipelineLayout(m_rhi_device->GetContextRhi()->device, &pipeline_layout_info, nullptr, reinterpret_cast<VkPipelineLayout*>(&m_pipeline_layout))))
 			    return;
@@ -313,7 +320,7 @@ namespace Spartan
 
             // Create
             auto pipeline = reinterpret_cast<VkPipeline*>(&m_pipeline);
-            vulkan_utility::error::check(vkCreateGraphicsPipelines(m_rhi_device->GetContextRhi()->device, nullptr, 1, &pipeline_info, nullptr, pipeline));
+            vulkan_utility::error::check(vkCreateGraphicsPipelines(m_rhi_device->GetContextRhi()->device, m_rhi_device->GetContextRhi()->pipeline_cache, 1, &pipeline_info, nullptr, pipeline));
 
             // Name
             vulkan_utility::debug::set_name(*pipeline, m_state.pass_name);
@@ -0,0 +1,92 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "../RHI_Implementation.h"
+#include "../RHI_PipelineCache.h"
+#include "../RHI_Device.h"
+#include "../../IO/FileStream.h"
+#include "../../Core/FileSystem.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void RHI_PipelineCache::CreateDriverCache()
+    {
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+
+        // Load the blob of the previous run, the driver validates it and ignores it if it's incompatible
+        vector<std::byte> data;
+        if (FileSystem::Exists(m_file_path_driver_cache))
+        {
+            auto file = make_unique<FileStream>(m_file_path_driver_cache, FileStream_Read);
+            if (file->IsOpen())
+            {
+                file->Read(&data);
+            }
+        }
+
+        VkPipelineCacheCreateInfo create_info   = {};
+        create_info.sType                       = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        create_info.initialDataSize             = data.size();
+        create_info.pInitialData                = data.empty() ? nullptr : data.data();
+
+        if (!vulkan_utility::error::check(vkCreatePipelineCache(rhi_context->device, &create_info, nullptr, &rhi_context->pipeline_cache)))
+            return;
+
+        LOG_INFO("Loaded %d bytes of pipeline cache data", static_cast<uint32_t>(data.size()));
+    }
+
+    void RHI_PipelineCache::SaveDriverCache() const
+    {
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+        if (!rhi_context->pipeline_cache)
+            return;
+
+        size_t size = 0;
+        if (!vulkan_utility::error::check(vkGetPipelineCacheData(rhi_context->device, rhi_context->pipeline_cache, &size, nullptr)))
+            return;
+
+        vector<std::byte> data(size);
+        if (!vulkan_utility::error::check(vkGetPipelineCacheData(rhi_context->device, rhi_context->pipeline_cache, &size, data.data())))
+            return;
+
+        auto file = make_unique<FileStream>(m_file_path_driver_cache, FileStream_Write);
+        if (!file->IsOpen())
+            return;
+
+        file->Write(data);
+    }
+
+    void RHI_PipelineCache::DestroyDriverCache()
+    {
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+        if (!rhi_context->pipeline_cache)
+            return;
+
+        vkDestroyPipelineCache(rhi_context->device, rhi_context->pipeline_cache, nullptr);
+        rhi_context->pipeline_cache = nullptr;
+    }
+}
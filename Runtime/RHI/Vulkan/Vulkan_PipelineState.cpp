@@ -74,7 +74,9 @@ namespace Spartan
         RHI_SwapChain* render_target_swapchain,
         array<RHI_Texture*, state_max_render_target_count>& render_target_color_textures,
         array<Math::Vector4, state_max_render_target_count>& render_target_color_clear,
+        RHI_Image_Layout render_target_color_layout,
         RHI_Texture* render_target_depth_texture,
+        RHI_Image_Layout render_target_depth_layout,
         float clear_value_depth,
         uint32_t clear_value_stencil,
         void*& render_pass
@@ -117,7 +119,7 @@ namespace Spartan
                         if (!texture)
                             continue;
 
-                        VkImageLayout layout = vulkan_image_layout[texture->GetLayout()];
+                        VkImageLayout layout = vulkan_image_layout[render_target_color_layout];
 
                         VkAttachmentDescription attachment_desc  = {};
                         attachment_desc.format                   = vulkan_format[texture->GetFormat()];
@@ -140,7 +142,7 @@ namespace Spartan
             // Depth
             if (render_target_depth_texture)
             {
-                VkImageLayout layout = vulkan_image_layout[render_target_depth_texture->GetLayout()];
+                VkImageLayout layout = vulkan_image_layout[render_target_depth_layout];
 
                 VkAttachmentDescription attachment_desc  = {};
                 attachment_desc.format                   = vulkan_format[render_target_depth_texture->GetFormat()];
@@ -220,8 +222,8 @@ namespace Spartan
         // Destroy existing frame resources
         DestroyFrameResources();
 
-        // Create a render pass
-        if (!create_render_pass(m_rhi_device->GetContextRhi(), depth_stencil_state, render_target_swapchain, render_target_color_textures, clear_color, render_target_depth_texture, clear_depth, clear_stencil, m_render_pass))
+        // Create a render pass, the layouts come from the state (the textures are only guaranteed to be in them once a command list transitions them)
+        if (!create_render_pass(m_rhi_device->GetContextRhi(), depth_stencil_state, render_target_swapchain, render_target_color_textures, clear_color, render_target_color_layout_initial, render_target_depth_texture, render_target_depth_layout_initial, clear_depth, clear_stencil, m_render_pass))
             return false;
 
         // Name the render pass
@@ -278,7 +280,8 @@ namespace Spartan
 
     void RHI_PipelineState::DestroyFrameResources()
     {
-        if (!m_rhi_device)
+        // Frame buffers are only created after the render pass, so without one there is nothing to wait for
+        if (!m_rhi_device || !m_render_pass)
             return;
 
         // Wait in case the buffer is still in use by the graphics queue
@@ -24,8 +24,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_Device.h"
 #include "../RHI_Shader.h"
 #include "../RHI_InputLayout.h"
+#include "../RHI_ShaderCache.h"
 #include "../../Logging/Log.h"
 #include "../../Core/FileSystem.h"
+#include "../../Core/Stopwatch.h"
+#include "../../Utilities/Hash.h"
+#include "../../Rendering/Renderer.h"
 #include <sstream> 
 #include <fstream>
 #include <atomic>
@@ -222,6 +226,16 @@ namespace Spartan
 			{
 				DxcCreateInstance(CLSID_DxcCompiler, __uuidof(IDxcCompiler), reinterpret_cast<void**>(&compiler));
 				DxcCreateInstance(CLSID_DxcLibrary, __uuidof(IDxcLibrary), reinterpret_cast<void**>(&library));
+
+                // Get the compiler version, it's part of the shader cache key
+                CComPtr<IDxcVersionInfo> version_info = nullptr;
+                if (compiler && SUCCEEDED(compiler.QueryInterface(&version_info)))
+                {
+                    UINT32 version_major = 0;
+                    UINT32 version_minor = 0;
+                    version_info->GetVersion(&version_major, &version_minor);
+                    version = to_string(version_major) + "." + to_string(version_minor);
+                }
 			}
 
 			static Instance& Get()
@@ -232,6 +246,7 @@ namespace Spartan
 
 			CComPtr<IDxcCompiler> compiler = nullptr;
 			CComPtr<IDxcLibrary> library = nullptr;
+            string version = "unknown";
 		};
 
 		typedef std::vector<uint8_t> Blob;
@@ -402,92 +417,124 @@ namespace Spartan
 			defines.emplace_back(DxcDefine{ define.first.c_str(), define.second.c_str() });
 		}
 
-		// Get shader source as a buffer
-		CComPtr<IDxcBlobEncoding> shader_blob = nullptr;
-		{
-			HRESULT result;
-			if (is_file)
-			{
-                const auto file_path = FileSystem::StringToWstring(shader);				
-				result = DxShaderCompiler::Instance::Get().library->CreateBlobFromFile(file_path.c_str(), nullptr, &shader_blob);
-			}
-			else // Source
-			{
-				result = DxShaderCompiler::Instance::Get().library->CreateBlobWithEncodingFromPinned(shader.c_str(), static_cast<uint32_t>(shader.size()), CP_UTF8, &shader_blob);
-			}
+        // Identify the compiled output, so that the shader cache can skip compilation and reflection
+        RHI_ShaderCache* shader_cache = m_context ? m_context->GetSubsystem<Renderer>()->GetShaderCache() : nullptr;
+        RHI_ShaderCache::Key cache_key;
+        vector<std::byte> bytecode;
+        bool is_cached = false;
+        if (shader_cache)
+        {
+            size_t compiler_hash = 0;
+            Utility::Hash::hash_combine(compiler_hash, DxShaderCompiler::Instance::Get().version);
+            Utility::Hash::hash_combine(compiler_hash, string(GetEntryPoint()));
+            Utility::Hash::hash_combine(compiler_hash, string(GetTargetProfile()));
+            for (LPCWSTR argument : arguments)
+            {
+                Utility::Hash::hash_combine(compiler_hash, wstring(argument));
+            }
 
-			if (FAILED(result))
-			{
-				LOG_ERROR("Failed to create source buffer.");
-				return nullptr;
-			}
-		}
+            cache_key = shader_cache->ComputeKey(shader, m_shader_type, m_defines, compiler_hash);
+            is_cached = shader_cache->Load(cache_key, bytecode, m_descriptors);
+        }
 
-		// Compile
-        const CComPtr<IDxcIncludeHandler> include_handler = new DxShaderCompiler::SpartanIncludeHandler(file_directory);
-		CComPtr<IDxcOperationResult> compilation_result = nullptr;
-		{
-            DxShaderCompiler::Instance::Get().compiler->Compile
+        if (!is_cached)
+        {
+            const Stopwatch timer;
+
+		    // Get shader source as a buffer
+		    CComPtr<IDxcBlobEncoding> shader_blob = nullptr;
+		    {
+			    HRESULT result;
+			    if (is_file)
+			    {
+                    const auto file_path = FileSystem::StringToWstring(shader);				
+				    result = DxShaderCompiler::Instance::Get().library->CreateBlobFromFile(file_path.c_str(), nullptr, &shader_blob);
+			    }
+			    else // Source
+			    {
+				    result = DxShaderCompiler::Instance::Get().library->CreateBlobWithEncodingFromPinned(shader.c_str(), static_cast<uint32_t>(shader.size()), CP_UTF8, &shader_blob);
+			    }
+
+			    if (FAILED(result))
+			    {
+				    LOG_ERROR("Failed to create source buffer.");
+				    return nullptr;
+			    }
+		    }
+
+		    // Compile
+            const CComPtr<IDxcIncludeHandler> include_handler = new DxShaderCompiler::SpartanIncludeHandler(file_directory);
+		    CComPtr<IDxcOperationResult> compilation_result = nullptr;
+		    {
+                DxShaderCompiler::Instance::Get().compiler->Compile
+                (
+                    shader_blob,												// shader blob
+                    file_name.c_str(),											// file name (for warnings and errors)
+                    FileSystem::StringToWstring(GetEntryPoint()).c_str(),		// entry point function
+                    FileSystem::StringToWstring(GetTargetProfile()).c_str(),	// target profile
+                    arguments.data(), static_cast<uint32_t>(arguments.size()),	// compilation arguments
+                    defines.data(), static_cast<uint32_t>(defines.size()),		// shader defines
+                    include_handler,											// handler for #include directives
+                    &compilation_result
+                );
+
+			    if (!DxShaderCompiler::ValidateOperationResult(compilation_result))
+			    {
+				    LOG_ERROR("Failed to compile %s", shader.c_str());
+				    return nullptr;
+			    }
+		    }
+
+            // Get the compiled bytecode
+            CComPtr<IDxcBlob> shader_compiled = nullptr;
+            if (FAILED(compilation_result->GetResult(&shader_compiled)))
+            {
+                LOG_ERROR("Failed to get shader buffer.");
+                return nullptr;
+            }
+            const std::byte* bytecode_ptr = static_cast<const std::byte*>(shader_compiled->GetBufferPointer());
+            bytecode.assign(bytecode_ptr, bytecode_ptr + shader_compiled->GetBufferSize());
+
+            // Reflect shader resources (so that descriptor sets can be created later)
+            _Reflect
             (
-                shader_blob,												// shader blob
-                file_name.c_str(),											// file name (for warnings and errors)
-                FileSystem::StringToWstring(GetEntryPoint()).c_str(),		// entry point function
-                FileSystem::StringToWstring(GetTargetProfile()).c_str(),	// target profile
-                arguments.data(), static_cast<uint32_t>(arguments.size()),	// compilation arguments
-                defines.data(), static_cast<uint32_t>(defines.size()),		// shader defines
-                include_handler,											// handler for #include directives
-                &compilation_result
+                m_shader_type,
+                reinterpret_cast<const uint32_t*>(bytecode.data()),
+                static_cast<uint32_t>(bytecode.size() / 4)
             );
 
-			if (!DxShaderCompiler::ValidateOperationResult(compilation_result))
-			{
-				LOG_ERROR("Failed to compile %s", shader.c_str());
-				return nullptr;
-			}
-		}
+            // Cache the bytecode and the reflected descriptors
+            if (shader_cache)
+            {
+                shader_cache->Save(cache_key, bytecode, m_descriptors, timer.GetElapsedTimeMs());
+            }
+        }
 		
 		// Create shader module
-		CComPtr<IDxcBlob> shader_compiled	= nullptr;
-		VkShaderModule shader_module		= nullptr;
-        if (SUCCEEDED(compilation_result->GetResult(&shader_compiled)))
+		VkShaderModule shader_module = nullptr;
         {
 			VkShaderModuleCreateInfo create_info = {};
 			create_info.sType		= VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-			create_info.codeSize	= static_cast<size_t>(shader_compiled->GetBufferSize());
-			create_info.pCode		= reinterpret_cast<const uint32_t*>(shader_compiled->GetBufferPointer());
+			create_info.codeSize	= bytecode.size();
+			create_info.pCode		= reinterpret_cast<const uint32_t*>(bytecode.data());
 	
-			if (vkCreateShaderModule(m_rhi_device->GetContextRhi()->device, &create_info, nullptr, &shader_module) == VK_SUCCESS)
-			{
-				// Reflect shader resources (so that descriptor sets can be created later)
-				_Reflect
-				(
-                    m_shader_type,
-					reinterpret_cast<uint32_t*>(shader_compiled->GetBufferPointer()),
-					static_cast<uint32_t>(shader_compiled->GetBufferSize() / 4)
-				);
-
-                // Create input layout
-                if (m_vertex_type != RHI_Vertex_Type_Unknown)
-                {
-                    if (!m_input_layout->Create(m_vertex_type, nullptr))
-                    {
-                        LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(shader).c_str());
-                        return nullptr;
-                    }
-                }
-			}
-            else
+			if (vkCreateShaderModule(m_rhi_device->GetContextRhi()->device, &create_info, nullptr, &shader_module) != VK_SUCCESS)
             {
                 LOG_ERROR("Failed to create shader module.");
                 return nullptr;
             }
-		}	
-        else
-		{
-            LOG_ERROR("Failed to get shader buffer.");
-            return nullptr;
 		}
 
+        // Create input layout
+        if (m_vertex_type != RHI_Vertex_Type_Unknown)
+        {
+            if (!m_input_layout->Create(m_vertex_type, nullptr))
+            {
+                LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(shader).c_str());
+                return nullptr;
+            }
+        }
+
 		return static_cast<void*>(shader_module);
 	}		
 }
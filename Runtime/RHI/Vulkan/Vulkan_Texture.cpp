@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI_Texture2D.h"
 #include "../RHI_TextureCube.h"
 #include "../RHI_CommandList.h"
+#include "../RHI_TextureTable.h"
 #include "../../Math/MathHelper.h"
 #include "../../Profiling/Profiler.h"
 //===================================
@@ -67,109 +68,108 @@ namespace Spartan
         }
     }
 
-    inline bool copy_to_staging_buffer(RHI_Texture* texture, std::vector<VkBufferImageCopy>& buffer_image_copies, void*& staging_buffer)
+    inline RHI_Image_Layout get_target_layout(const RHI_Texture* texture)
     {
-        if (!texture->HasData())
-        {
-            LOG_WARNING("No data to stage");
-            return true;
-        }
+        RHI_Image_Layout target_layout = RHI_Image_Preinitialized;
+
+        if (texture->IsSampled() && texture->IsColorFormat())
+            target_layout = RHI_Image_Shader_Read_Only_Optimal;
+
+        if (texture->IsRenderTargetColor())
+            target_layout = RHI_Image_Color_Attachment_Optimal;
 
+        if (texture->IsRenderTargetDepthStencil())
+            target_layout = RHI_Image_Depth_Stencil_Attachment_Optimal;
+
+        return target_layout;
+    }
+
+    inline bool upload(RHI_Texture* texture, RHI_Image_Layout& texture_layout, const RHI_Image_Layout target_layout)
+    {
         const uint32_t width            = texture->GetWidth();
         const uint32_t height           = texture->GetHeight();
         const uint32_t array_size       = texture->GetArraySize();
         const uint32_t mip_levels       = texture->GetMiplevels();
         const uint32_t bytes_per_pixel  = texture->GetBytesPerPixel();
+        const bool has_data             = texture->HasData();
 
-        // Fill out VkBufferImageCopy structs describing the array and the mip levels   
-        VkDeviceSize buffer_offset = 0;
-        for (uint32_t array_index = 0; array_index < array_size; array_index++)
+        // Compute the staging memory requirement (in bytes) of the array and the mip levels
+        uint64_t staging_size = 0;
+        if (has_data)
         {
             for (uint32_t mip_index = 0; mip_index < mip_levels; mip_index++)
             {
-                uint32_t mip_width  = width >> mip_index;
-                uint32_t mip_height = height >> mip_index;
-
-                VkBufferImageCopy region				= {};
-                region.bufferOffset						= buffer_offset;
-                region.bufferRowLength					= 0;
-                region.bufferImageHeight				= 0;
-                region.imageSubresource.aspectMask      = vulkan_utility::image::get_aspect_mask(texture);
-                region.imageSubresource.mipLevel		= mip_index;
-                region.imageSubresource.baseArrayLayer	= array_index;
-                region.imageSubresource.layerCount		= array_size;
-                region.imageOffset						= { 0, 0, 0 };
-                region.imageExtent						= { mip_width, mip_height, 1 };
-
-                buffer_image_copies[mip_index] = region;
-
-                // Update staging buffer memory requirement (in bytes)
-                buffer_offset += mip_width * mip_height * bytes_per_pixel;
+                staging_size += static_cast<uint64_t>(width >> mip_index) * (height >> mip_index) * bytes_per_pixel;
             }
+            staging_size *= array_size;
         }
 
-        // Create staging buffer
-        VmaAllocation allocation = vulkan_utility::buffer::create(staging_buffer, buffer_offset, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        // Buffer offsets have to be a multiple of both the texel size and 4
+        const uint64_t alignment = (bytes_per_pixel % 4 == 0) ? bytes_per_pixel : bytes_per_pixel * 4;
 
-        // Copy array and mip level data to the staging buffer
-        void* data = nullptr;
-        buffer_offset = 0;
-        if (vulkan_utility::error::check(vmaMapMemory(vulkan_utility::globals::rhi_context->allocator, allocation, &data)))
+        // Reserve staging memory and get the shared upload command buffer
+        vulkan_utility::upload_queue::allocation allocation;
+        if (!vulkan_utility::upload_queue::begin(allocation, staging_size, alignment))
         {
+            LOG_ERROR("Failed to begin upload");
+            return false;
+        }
+
+        if (has_data)
+        {
+            // Copy the texture's data straight into staging memory and describe where each array slice and mip level lives
+            std::vector<VkBufferImageCopy> buffer_image_copies(array_size * mip_levels);
+            VkDeviceSize buffer_offset = 0;
             for (uint32_t array_index = 0; array_index < array_size; array_index++)
             {
                 for (uint32_t mip_index = 0; mip_index < mip_levels; mip_index++)
                 {
-                    uint64_t buffer_size = (width >> mip_index) * (height >> mip_index) * bytes_per_pixel;
-                    memcpy(static_cast<std::byte*>(data) + buffer_offset, texture->GetData(array_index + mip_index)->data(), buffer_size);
-                    buffer_offset += buffer_size;
+                    const uint32_t mip_width    = width >> mip_index;
+                    const uint32_t mip_height   = height >> mip_index;
+                    const uint64_t mip_size     = static_cast<uint64_t>(mip_width) * mip_height * bytes_per_pixel;
+
+                    if (const std::vector<std::byte>* data = texture->GetData(array_index * mip_levels + mip_index))
+                    {
+                        memcpy(static_cast<std::byte*>(allocation.data) + buffer_offset, data->data(), Helper::Min<uint64_t>(mip_size, data->size()));
+                    }
+
+                    VkBufferImageCopy& region               = buffer_image_copies[array_index * mip_levels + mip_index];
+                    region.bufferOffset						= allocation.offset + buffer_offset;
+                    region.bufferRowLength					= 0;
+                    region.bufferImageHeight				= 0;
+                    region.imageSubresource.aspectMask      = vulkan_utility::image::get_aspect_mask(texture);
+                    region.imageSubresource.mipLevel		= mip_index;
+                    region.imageSubresource.baseArrayLayer	= array_index;
+                    region.imageSubresource.layerCount		= 1;
+                    region.imageOffset						= { 0, 0, 0 };
+                    region.imageExtent						= { mip_width, mip_height, 1 };
+
+                    buffer_offset += mip_size;
                 }
             }
 
-            vmaUnmapMemory(vulkan_utility::globals::rhi_context->allocator, allocation);
-        }
-
-        return true;
-    }
-
-    inline bool stage(RHI_Texture* texture, RHI_Image_Layout& texture_layout)
-    {
-        // Copy the texture's data to a staging buffer
-        void* staging_buffer = nullptr;
-        std::vector<VkBufferImageCopy> buffer_image_copies(texture->GetMiplevels());
-        if (!copy_to_staging_buffer(texture, buffer_image_copies, staging_buffer))
-            return false;
-
-        // Copy the staging buffer into the image
-        if (VkCommandBuffer cmd_buffer = vulkan_utility::command_buffer_immediate::begin(RHI_Queue_Graphics))
-        {
             // Optimal layout for images which are the destination of a transfer format
-            RHI_Image_Layout layout = RHI_Image_Transfer_Dst_Optimal;
-
-            // Transition to layout
-            if (!vulkan_utility::image::set_layout(cmd_buffer, texture, layout))
+            if (!vulkan_utility::image::set_layout(allocation.cmd_buffer, texture, RHI_Image_Transfer_Dst_Optimal))
                 return false;
+            texture_layout = RHI_Image_Transfer_Dst_Optimal;
 
-            // Copy the staging buffer to the image
+            // Copy the staging memory to the image
             vkCmdCopyBufferToImage(
-                cmd_buffer,
-                static_cast<VkBuffer>(staging_buffer),
+                allocation.cmd_buffer,
+                allocation.buffer,
                 static_cast<VkImage>(texture->Get_Resource()),
-                vulkan_image_layout[layout],
+                vulkan_image_layout[RHI_Image_Transfer_Dst_Optimal],
                 static_cast<uint32_t>(buffer_image_copies.size()),
                 buffer_image_copies.data()
             );
+        }
 
-            // End/flush
-            if (!vulkan_utility::command_buffer_immediate::end(RHI_Queue_Graphics))
-                return false;
-
-            // Free staging buffer
-            vulkan_utility::buffer::destroy(staging_buffer);
+        // Transition to the final layout
+        if (!vulkan_utility::image::set_layout(allocation.cmd_buffer, texture, target_layout))
+            return false;
 
-            // Let the texture know about it's new layout
-            texture_layout = layout;
-        }
+        // The upload is submitted before the next frame, so the texture can already assume it's new layout
+        texture_layout = target_layout;
 
         return true;
     }
@@ -179,9 +179,16 @@ namespace Spartan
         if (!m_rhi_device->IsInitialized())
             return;
 
+        // Make sure no pending upload references this texture
+        vulkan_utility::upload_queue::flush();
         m_rhi_device->Queue_WaitAll();
         m_data.clear();
 
+        if (m_texture_table)
+        {
+            m_texture_table->Remove(this);
+        }
+
         vulkan_utility::image::view::destroy(m_resource_view[0]);
         vulkan_utility::image::view::destroy(m_resource_view[1]);
         for (uint32_t i = 0; i < state_max_render_target_count; i++)
@@ -222,46 +229,11 @@ namespace Spartan
             return false;
         }
 
-        // If the texture has any data, stage it
-        if (HasData())
+        // Stage any data and transition to the target layout
+        if (!upload(this, m_layout, get_target_layout(this)))
         {
-            if (!stage(this, m_layout))
-            {
-                LOG_ERROR("Failed to stage");
-                return false;
-            }
-        }
-
-        // Transition to target layout
-        if (VkCommandBuffer cmd_buffer = vulkan_utility::command_buffer_immediate::begin(RHI_Queue_Graphics))
-        {    
-            RHI_Image_Layout target_layout = RHI_Image_Preinitialized;
-        
-            if (IsSampled() && IsColorFormat())
-                target_layout = RHI_Image_Shader_Read_Only_Optimal;
-        
-            if (IsRenderTargetColor())
-                target_layout = RHI_Image_Color_Attachment_Optimal;
-        
-            if (IsRenderTargetDepthStencil())
-                target_layout = RHI_Image_Depth_Stencil_Attachment_Optimal;
-        
-            // Transition to the final layout
-            if (!vulkan_utility::image::set_layout(cmd_buffer, this, target_layout))
-            {
-                LOG_ERROR("Failed to transition layout");
-                return false;
-            }
-        
-            // Flush
-            if (!vulkan_utility::command_buffer_immediate::end(RHI_Queue_Graphics))
-            {
-                LOG_ERROR("Failed to end command buffer");
-                return false;
-            }
-
-            // Update this texture with the new layout
-            m_layout = target_layout;
+            LOG_ERROR("Failed to upload");
+            return false;
         }
 
         // Create image views
@@ -308,6 +280,12 @@ namespace Spartan
             set_debug_name(this);
         }
 
+        // Register with the texture table, only textures which always stay in a shader read layout qualify
+        if (m_texture_table && IsSampled() && IsColorFormat() && !IsRenderTargetColor() && !IsRenderTargetCompute())
+        {
+            m_texture_table->Add(this);
+        }
+
 		return true;
 	}
 
@@ -318,6 +296,8 @@ namespace Spartan
         if (!m_rhi_device->IsInitialized())
             return;
 
+        // Make sure no pending upload references this texture
+        vulkan_utility::upload_queue::flush();
         m_rhi_device->Queue_WaitAll();
         m_data.clear();
 
@@ -340,37 +320,11 @@ namespace Spartan
             return false;
         }
 
-        // If the texture has any data, stage it
-        if (HasData())
+        // Stage any data and transition to the target layout
+        if (!upload(this, m_layout, get_target_layout(this)))
         {
-            if (!stage(this, m_layout))
-                return false;
-        }
-
-        // Transition to target layout
-        if (VkCommandBuffer cmd_buffer = vulkan_utility::command_buffer_immediate::begin(RHI_Queue_Graphics))
-        {
-            RHI_Image_Layout target_layout = RHI_Image_Preinitialized;
-
-            if (IsSampled() && IsColorFormat())
-                target_layout = RHI_Image_Shader_Read_Only_Optimal;
-
-            if (IsRenderTargetColor())
-                target_layout = RHI_Image_Color_Attachment_Optimal;
-
-            if (IsRenderTargetDepthStencil())
-                target_layout = RHI_Image_Depth_Stencil_Attachment_Optimal;
-
-            // Transition to the final layout
-            if (!vulkan_utility::image::set_layout(cmd_buffer, this, target_layout))
-                return false;
-
-            // Flush
-            if (!vulkan_utility::command_buffer_immediate::end(RHI_Queue_Graphics))
-                return false;
-
-            // Update this texture with the new layout
-            m_layout = target_layout;
+            LOG_ERROR("Failed to upload");
+            return false;
         }
 
         // Create image views
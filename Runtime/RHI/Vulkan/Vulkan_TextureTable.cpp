@@ -0,0 +1,150 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "../RHI_Implementation.h"
+#include "../RHI_TextureTable.h"
+#include "../RHI_Texture.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    RHI_TextureTable::~RHI_TextureTable()
+    {
+        if (!m_descriptor_pool && !m_descriptor_set_layout)
+            return;
+
+        // Wait in case the descriptor set is still in use
+        m_rhi_device->Queue_WaitAll();
+
+        // Destroying the pool frees the descriptor set as well
+        if (m_descriptor_pool)
+        {
+            vkDestroyDescriptorPool(m_rhi_device->GetContextRhi()->device, static_cast<VkDescriptorPool>(m_descriptor_pool), nullptr);
+            m_descriptor_pool   = nullptr;
+            m_descriptor_set    = nullptr;
+        }
+
+        if (m_descriptor_set_layout)
+        {
+            vkDestroyDescriptorSetLayout(m_rhi_device->GetContextRhi()->device, static_cast<VkDescriptorSetLayout>(m_descriptor_set_layout), nullptr);
+            m_descriptor_set_layout = nullptr;
+        }
+    }
+
+    bool RHI_TextureTable::CreateResources()
+    {
+        RHI_Context* rhi_context    = m_rhi_device->GetContextRhi();
+        m_capacity                  = rhi_context->max_texture_table_size;
+
+        // Descriptor pool
+        {
+            VkDescriptorPoolSize pool_size  = {};
+            pool_size.type                  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            pool_size.descriptorCount       = m_capacity;
+
+            VkDescriptorPoolCreateInfo create_info  = {};
+            create_info.sType                       = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            create_info.flags                       = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+            create_info.poolSizeCount               = 1;
+            create_info.pPoolSizes                  = &pool_size;
+            create_info.maxSets                     = 1;
+
+            if (!vulkan_utility::error::check(vkCreateDescriptorPool(rhi_context->device, &create_info, nullptr, reinterpret_cast<VkDescriptorPool*>(&m_descriptor_pool))))
+                return false;
+        }
+
+        // Descriptor set layout
+        {
+            // The table can be updated while command lists which use it are being recorded, and not every slot has to hold a valid texture
+            VkDescriptorBindingFlags binding_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+
+            VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info  = {};
+            binding_flags_info.sType                                        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            binding_flags_info.bindingCount                                 = 1;
+            binding_flags_info.pBindingFlags                                = &binding_flags;
+
+            VkDescriptorSetLayoutBinding layout_binding = {};
+            layout_binding.binding                      = rhi_context->shader_shift_texture;
+            layout_binding.descriptorType               = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            layout_binding.descriptorCount              = m_capacity;
+            layout_binding.stageFlags                   = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+            layout_binding.pImmutableSamplers           = nullptr;
+
+            VkDescriptorSetLayoutCreateInfo create_info = {};
+            create_info.sType                           = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            create_info.flags                           = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+            create_info.pNext                           = &binding_flags_info;
+            create_info.bindingCount                    = 1;
+            create_info.pBindings                       = &layout_binding;
+
+            if (!vulkan_utility::error::check(vkCreateDescriptorSetLayout(rhi_context->device, &create_info, nullptr, reinterpret_cast<VkDescriptorSetLayout*>(&m_descriptor_set_layout))))
+                return false;
+
+            vulkan_utility::debug::set_name(static_cast<VkDescriptorSetLayout>(m_descriptor_set_layout), "texture_table");
+        }
+
+        // Descriptor set
+        {
+            VkDescriptorSetAllocateInfo allocate_info   = {};
+            allocate_info.sType                         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocate_info.descriptorPool                = static_cast<VkDescriptorPool>(m_descriptor_pool);
+            allocate_info.descriptorSetCount            = 1;
+            allocate_info.pSetLayouts                   = reinterpret_cast<VkDescriptorSetLayout*>(&m_descriptor_set_layout);
+
+            void* descriptor_set = nullptr;
+            if (!vulkan_utility::error::check(vkAllocateDescriptorSets(rhi_context->device, &allocate_info, reinterpret_cast<VkDescriptorSet*>(&descriptor_set))))
+                return false;
+
+            vulkan_utility::debug::set_name(static_cast<VkDescriptorSet>(descriptor_set), "texture_table");
+
+            // Only assign once everything succeeded, IsSupported() relies on it
+            m_descriptor_set = descriptor_set;
+        }
+
+        LOG_INFO("Capacity is %d textures", m_capacity);
+
+        return true;
+    }
+
+    void RHI_TextureTable::UpdateDescriptor(const uint32_t index, RHI_Texture* texture)
+    {
+        VkDescriptorImageInfo image_info    = {};
+        image_info.sampler                  = nullptr;
+        image_info.imageView                = static_cast<VkImageView>(texture->Get_Resource_View());
+        image_info.imageLayout              = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet write_descriptor_set   = {};
+        write_descriptor_set.sType                  = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_descriptor_set.dstSet                 = static_cast<VkDescriptorSet>(m_descriptor_set);
+        write_descriptor_set.dstBinding             = m_rhi_device->GetContextRhi()->shader_shift_texture;
+        write_descriptor_set.dstArrayElement        = index;
+        write_descriptor_set.descriptorCount        = 1;
+        write_descriptor_set.descriptorType         = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        write_descriptor_set.pImageInfo             = &image_info;
+
+        vkUpdateDescriptorSets(m_rhi_device->GetContextRhi()->device, 1, &write_descriptor_set, 0, nullptr);
+    }
+}
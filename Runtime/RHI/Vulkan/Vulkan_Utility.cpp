@@ -42,6 +42,14 @@ namespace Spartan::vulkan_utility
     mutex                                                                   command_buffer_immediate::m_mutex_begin;
     mutex                                                                   command_buffer_immediate::m_mutex_end;
     unordered_map<RHI_Queue_Type, command_buffer_immediate::cmdbi_object>   command_buffer_immediate::m_objects;
+    mutex                                                                   upload_queue::m_mutex;
+    array<upload_queue::batch, upload_queue::m_batch_count>                 upload_queue::m_batches;
+    uint32_t                                                                upload_queue::m_batch_index                         = 0;
+    void*                                                                   upload_queue::m_ring_buffer                         = nullptr;
+    VmaAllocation                                                           upload_queue::m_ring_allocation                     = nullptr;
+    std::byte*                                                              upload_queue::m_ring_data                           = nullptr;
+    uint64_t                                                                upload_queue::m_ring_head                           = 0;
+    uint64_t                                                                upload_queue::m_ring_tail                           = 0;
 
 	bool image::create(RHI_Texture* texture)
 	{
@@ -201,4 +209,265 @@ namespace Spartan::vulkan_utility
             _buffer = nullptr;
         }
     }
+
+    bool upload_queue::begin(allocation& _allocation, const uint64_t size /*= 0*/, const uint64_t alignment /*= 4*/)
+    {
+        unique_lock<mutex> lock(m_mutex);
+
+        if (!m_ring_buffer && !initialise())
+            return false;
+
+        // Recycle the staging memory of any batches the GPU is done with
+        retire_completed(false);
+
+        // Find room in the ring, anything larger than the ring gets a dedicated staging buffer
+        uint64_t offset = 0;
+        if (size != 0 && size <= m_ring_size)
+        {
+            while (true)
+            {
+                offset = ((m_ring_head + alignment - 1) / alignment) * alignment;
+
+                // Don't straddle the end of the ring, wrap around instead
+                if ((offset % m_ring_size) + size > m_ring_size)
+                {
+                    offset = (offset / m_ring_size + 1) * m_ring_size;
+                }
+
+                if (offset + size - m_ring_tail <= m_ring_size)
+                    break;
+
+                // Out of space, submit what we have and wait for the GPU to free up memory
+                if (m_batches[m_batch_index].recording)
+                {
+                    if (!submit())
+                        return false;
+                }
+                else if (m_ring_tail != m_ring_head)
+                {
+                    const uint64_t tail = m_ring_tail;
+                    retire_completed(true);
+                    if (m_ring_tail == tail)
+                    {
+                        LOG_ERROR("Failed to reclaim staging memory");
+                        return false;
+                    }
+                }
+                else
+                {
+                    // Nothing is pending, start over from the beginning of the ring
+                    m_ring_head = 0;
+                    m_ring_tail = 0;
+                }
+            }
+        }
+
+        // Start recording, waiting for the batch to come back from the GPU if needed
+        batch& current = m_batches[m_batch_index];
+        if (!current.recording)
+        {
+            if (current.in_flight && !retire(current, true))
+                return false;
+
+            VkCommandBufferBeginInfo begin_info = {};
+            begin_info.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            begin_info.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            if (!error::check(vkBeginCommandBuffer(static_cast<VkCommandBuffer>(current.cmd_buffer), &begin_info)))
+                return false;
+
+            current.recording = true;
+        }
+
+        _allocation             = allocation();
+        _allocation.cmd_buffer  = static_cast<VkCommandBuffer>(current.cmd_buffer);
+
+        if (size != 0 && size <= m_ring_size)
+        {
+            m_ring_head             = offset + size;
+            _allocation.buffer      = static_cast<VkBuffer>(m_ring_buffer);
+            _allocation.offset      = offset % m_ring_size;
+            _allocation.data        = m_ring_data + _allocation.offset;
+        }
+        else if (size != 0)
+        {
+            void* buffer                = nullptr;
+            VmaAllocation allocation    = buffer::create(buffer, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            if (!allocation || !error::check(vmaMapMemory(globals::rhi_context->allocator, allocation, &_allocation.data)))
+            {
+                buffer::destroy(buffer);
+                return false;
+            }
+
+            current.dedicated_buffers.emplace_back(buffer, allocation);
+            _allocation.buffer = static_cast<VkBuffer>(buffer);
+        }
+
+        _allocation.lock = move(lock);
+
+        return true;
+    }
+
+    bool upload_queue::flush(const bool wait /*= false*/)
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        if (!m_ring_buffer)
+            return true;
+
+        if (!submit())
+            return false;
+
+        retire_completed(wait);
+
+        return true;
+    }
+
+    void upload_queue::shutdown()
+    {
+        flush(true);
+
+        lock_guard<mutex> lock(m_mutex);
+
+        for (batch& _batch : m_batches)
+        {
+            if (_batch.cmd_buffer)
+            {
+                command_buffer::destroy(_batch.cmd_pool, _batch.cmd_buffer);
+                command_pool::destroy(_batch.cmd_pool);
+            }
+
+            fence::destroy(_batch.fence);
+            _batch = batch();
+        }
+
+        if (m_ring_allocation)
+        {
+            vmaUnmapMemory(globals::rhi_context->allocator, m_ring_allocation);
+            m_ring_allocation = nullptr;
+        }
+
+        buffer::destroy(m_ring_buffer);
+        m_ring_data = nullptr;
+        m_ring_head = 0;
+        m_ring_tail = 0;
+    }
+
+    bool upload_queue::initialise()
+    {
+        // Uploads go through the graphics queue so that image layout transitions and ordering with the frame are implicit
+        for (batch& _batch : m_batches)
+        {
+            if (!command_pool::create(_batch.cmd_pool, RHI_Queue_Graphics))
+                return false;
+
+            if (!command_buffer::create(_batch.cmd_pool, _batch.cmd_buffer, VK_COMMAND_BUFFER_LEVEL_PRIMARY))
+                return false;
+
+            if (!fence::create(_batch.fence))
+                return false;
+        }
+
+        // Create the staging ring and keep it mapped
+        m_ring_allocation = buffer::create(m_ring_buffer, m_ring_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        if (!m_ring_allocation)
+        {
+            LOG_ERROR("Failed to create staging ring");
+            return false;
+        }
+
+        void* data = nullptr;
+        if (!error::check(vmaMapMemory(globals::rhi_context->allocator, m_ring_allocation, &data)))
+        {
+            LOG_ERROR("Failed to map staging ring");
+            return false;
+        }
+        m_ring_data = static_cast<std::byte*>(data);
+
+        debug::set_name(static_cast<VkBuffer>(m_ring_buffer), "upload_queue_staging_ring");
+
+        return true;
+    }
+
+    bool upload_queue::submit()
+    {
+        batch& current = m_batches[m_batch_index];
+        if (!current.recording)
+            return true;
+
+        VkCommandBuffer cmd_buffer = static_cast<VkCommandBuffer>(current.cmd_buffer);
+
+        // Make the copies visible to whatever reads the resources next
+        VkMemoryBarrier barrier = {};
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_MEMORY_READ_BIT;
+        vkCmdPipelineBarrier(cmd_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        if (!error::check(vkEndCommandBuffer(cmd_buffer)))
+        {
+            LOG_ERROR("Failed to end command buffer");
+            return false;
+        }
+
+        // No-op for host coherent memory
+        vmaFlushAllocation(globals::rhi_context->allocator, m_ring_allocation, 0, VK_WHOLE_SIZE);
+
+        if (!fence::reset(current.fence))
+            return false;
+
+        if (!globals::rhi_device->Queue_Submit(RHI_Queue_Graphics, current.cmd_buffer, nullptr, nullptr, current.fence))
+        {
+            LOG_ERROR("Failed to submit to queue");
+            return false;
+        }
+
+        current.ring_end    = m_ring_head;
+        current.recording   = false;
+        current.in_flight   = true;
+        m_batch_index       = (m_batch_index + 1) % m_batch_count;
+
+        return true;
+    }
+
+    bool upload_queue::retire(batch& _batch, const bool wait)
+    {
+        if (!_batch.in_flight)
+            return true;
+
+        if (wait)
+        {
+            if (!fence::wait(_batch.fence))
+            {
+                LOG_ERROR("Failed to wait for fence");
+                return false;
+            }
+        }
+        else if (!fence::is_signaled(_batch.fence))
+        {
+            return false;
+        }
+
+        for (auto& dedicated_buffer : _batch.dedicated_buffers)
+        {
+            vmaUnmapMemory(globals::rhi_context->allocator, dedicated_buffer.second);
+            buffer::destroy(dedicated_buffer.first);
+        }
+        _batch.dedicated_buffers.clear();
+
+        m_ring_tail         = _batch.ring_end;
+        _batch.in_flight    = false;
+
+        return true;
+    }
+
+    void upload_queue::retire_completed(const bool wait)
+    {
+        // Batches complete in submission order, so walk them from oldest to newest
+        for (uint32_t i = 0; i < m_batch_count; i++)
+        {
+            batch& _batch = m_batches[(m_batch_index + i) % m_batch_count];
+            if (_batch.in_flight && !retire(_batch, wait))
+                break;
+        }
+    }
 }
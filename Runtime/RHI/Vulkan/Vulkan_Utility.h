@@ -471,6 +471,57 @@ namespace Spartan::vulkan_utility
         void destroy(void*& _buffer);
 	}
 
+    // Thread-safe upload queue. Copies from many resources are recorded into a shared command buffer, sourced from a
+    // persistently mapped staging ring, and submitted together (at the latest, right before the next frame is submitted).
+    class upload_queue
+    {
+    public:
+        // Keeps the queue locked for as long as it lives, so copies can be recorded into the command buffer
+        struct allocation
+        {
+            VkCommandBuffer cmd_buffer  = nullptr;
+            VkBuffer buffer             = nullptr;
+            VkDeviceSize offset         = 0;
+            void* data                  = nullptr;
+            std::unique_lock<std::mutex> lock;
+        };
+
+        // Reserves staging memory (if a size is provided), the queue stays locked until the allocation goes out of scope
+        static bool begin(allocation& _allocation, const uint64_t size = 0, const uint64_t alignment = 4);
+
+        // Submits everything recorded since the last flush, optionally waiting for all uploads to complete
+        static bool flush(const bool wait = false);
+        static void shutdown();
+
+    private:
+        struct batch
+        {
+            void* cmd_pool          = nullptr;
+            void* cmd_buffer        = nullptr;
+            void* fence             = nullptr;
+            uint64_t ring_end       = 0;
+            bool recording          = false;
+            bool in_flight          = false;
+            std::vector<std::pair<void*, VmaAllocation>> dedicated_buffers;
+        };
+
+        static bool initialise();
+        static bool submit();
+        static bool retire(batch& _batch, const bool wait);
+        static void retire_completed(const bool wait);
+
+        static const uint64_t m_ring_size   = 64 * 1024 * 1024;
+        static const uint32_t m_batch_count = 3;
+        static std::mutex m_mutex;
+        static std::array<batch, m_batch_count> m_batches;
+        static uint32_t m_batch_index;
+        static void* m_ring_buffer;
+        static VmaAllocation m_ring_allocation;
+        static std::byte* m_ring_data;
+        static uint64_t m_ring_head;
+        static uint64_t m_ring_tail;
+    };
+
     namespace image
     {
         inline VkImageTiling get_format_tiling(const RHI_Format format, VkFormatFeatureFlags feature_flags)
@@ -19,28 +19,375 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES =========
+//= INCLUDES ==================
 #include "Animation.h"
-//====================
+#include <algorithm>
+#include "../IO/FileStream.h"
+//=============================
 
-//= NAMESPACES =====
+//= NAMESPACES ===============
 using namespace std;
-//==================
+using namespace Spartan::Math;
+//============================
 
 namespace Spartan
 {
+    namespace
+    {
+        constexpr float quantization_max        = 65535.0f;
+        constexpr float smallest_three_max      = 32767.0f;
+        constexpr float smallest_three_range    = 0.70710678f; // the three smallest components of a unit quaternion are within [-1/sqrt(2), 1/sqrt(2)]
+
+        // Tolerances of the key reduction
+        constexpr float tolerance_translation   = 0.0001f;  // units
+        constexpr float tolerance_rotation      = 0.000001f; // 1 - |dot|, roughly 0.16 degrees
+        constexpr float tolerance_scale         = 0.0001f;
+
+        inline float quaternion_dot(const Quaternion& a, const Quaternion& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
+        inline float vector_error(const Vector3& a, const Vector3& b)
+        {
+            return Helper::Max3(Helper::Abs(a.x - b.x), Helper::Abs(a.y - b.y), Helper::Abs(a.z - b.z));
+        }
+
+        inline float quaternion_error(const Quaternion& a, const Quaternion& b)
+        {
+            return 1.0f - Helper::Abs(quaternion_dot(a, b));
+        }
+
+        // Returns the keys that have to be kept so that interpolating between them reproduces the dropped ones within the tolerance
+        template <typename T, typename Interpolate, typename Error>
+        vector<uint32_t> reduce_keys(const vector<T>& keys, Interpolate interpolate, Error error, const float tolerance)
+        {
+            vector<uint32_t> kept;
+            const auto count = static_cast<uint32_t>(keys.size());
+            if (count == 0)
+                return kept;
+
+            kept.emplace_back(0);
+
+            // Extend the segment from the anchor for as long as it fits all the keys in between
+            uint32_t anchor = 0;
+            for (uint32_t end = anchor + 2; end < count; end++)
+            {
+                const double span = keys[end].time - keys[anchor].time;
+
+                for (uint32_t i = anchor + 1; i < end; i++)
+                {
+                    const float alpha = span > 0.0 ? static_cast<float>((keys[i].time - keys[anchor].time) / span) : 0.0f;
+                    if (error(interpolate(keys[anchor].value, keys[end].value, alpha), keys[i].value) > tolerance)
+                    {
+                        anchor = end - 1;
+                        kept.emplace_back(anchor);
+                        break;
+                    }
+                }
+            }
+
+            if (count > 1)
+            {
+                kept.emplace_back(count - 1);
+            }
+
+            // A constant curve needs a single key
+            if (kept.size() == 2 && error(keys[kept[0]].value, keys[kept[1]].value) <= tolerance)
+            {
+                kept.pop_back();
+            }
+
+            return kept;
+        }
+
+        inline uint16_t quantize(const float value, const float min, const float extent)
+        {
+            if (extent <= 0.0f)
+                return 0;
+
+            return static_cast<uint16_t>(Helper::Clamp((value - min) / extent, 0.0f, 1.0f) * quantization_max + 0.5f);
+        }
+
+        inline float dequantize(const uint16_t value, const float min, const float extent)
+        {
+            return min + (static_cast<float>(value) / quantization_max) * extent;
+        }
+
+        inline uint16_t quantize_smallest_three(const float value)
+        {
+            return static_cast<uint16_t>(Helper::Clamp(value / smallest_three_range * 0.5f + 0.5f, 0.0f, 1.0f) * smallest_three_max + 0.5f);
+        }
+
+        inline float dequantize_smallest_three(const uint16_t value)
+        {
+            return ((static_cast<float>(value & 0x7FFF) / smallest_three_max) * 2.0f - 1.0f) * smallest_three_range;
+        }
+    }
+
 	Animation::Animation(Context* context): IResource(context, Resource_Animation)
 	{
 
 	}
 
-    bool Animation::LoadFromFile(const string& filePath)
+    bool Animation::LoadFromFile(const string& file_path)
 	{
+        auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Map | FileStream_Checksum);
+        if (!file->IsOpen())
+            return false;
+
+        SetResourceFilePath(file->ReadAs<string>());
+        file->Read(&m_name);
+        file->Read(&m_duration);
+        file->Read(&m_ticksPerSec);
+        file->Read(&m_key_count_source);
+
+        m_tracks.resize(file->ReadAs<uint32_t>());
+        for (AnimationTrack& track : m_tracks)
+        {
+            file->Read(&track.name);
+            for (AnimationCurve& curve : track.curves)
+            {
+                file->Read(&curve.key_offset);
+                file->Read(&curve.key_count);
+                file->Read(&curve.range_min);
+                file->Read(&curve.range_extent);
+            }
+        }
+
+        const auto key_count = file->ReadAs<uint32_t>();
+        for (vector<uint16_t>* stream : { &m_key_times, &m_key_x, &m_key_y, &m_key_z })
+        {
+            stream->resize(key_count);
+            file->ReadSpan(stream->data(), key_count);
+        }
+
 		return true;
 	}
 
-	bool Animation::SaveToFile(const string& filePath)
+	bool Animation::SaveToFile(const string& file_path)
 	{
+        auto file = make_unique<FileStream>(file_path, FileStream_Write | FileStream_Checksum);
+        if (!file->IsOpen())
+            return false;
+
+        file->Write(GetResourceFilePath());
+        file->Write(m_name);
+        file->Write(m_duration);
+        file->Write(m_ticksPerSec);
+        file->Write(m_key_count_source);
+
+        file->Write(static_cast<uint32_t>(m_tracks.size()));
+        for (const AnimationTrack& track : m_tracks)
+        {
+            file->Write(track.name);
+            for (const AnimationCurve& curve : track.curves)
+            {
+                file->Write(curve.key_offset);
+                file->Write(curve.key_count);
+                file->Write(curve.range_min);
+                file->Write(curve.range_extent);
+            }
+        }
+
+        const auto key_count = static_cast<uint32_t>(m_key_times.size());
+        file->Write(key_count);
+        for (const vector<uint16_t>* stream : { &m_key_times, &m_key_x, &m_key_y, &m_key_z })
+        {
+            file->WriteSpan(stream->data(), key_count);
+        }
+
 		return true;
 	}
+
+    void Animation::AddTrack(const AnimationNode& node)
+    {
+        AnimationTrack& track = m_tracks.emplace_back();
+        track.name = node.name;
+
+        const auto time_normalized = [this](const double time)
+        {
+            return m_duration > 0.0 ? static_cast<uint16_t>(Helper::Clamp(static_cast<float>(time / m_duration), 0.0f, 1.0f) * quantization_max + 0.5f) : uint16_t(0);
+        };
+
+        // Translation and scale are quantized within the range of the kept keys
+        const auto add_vector_curve = [this, &time_normalized](AnimationCurve& curve, const vector<KeyVector>& keys, const float tolerance)
+        {
+            const vector<uint32_t> kept = reduce_keys(keys, Vector3::Lerp, vector_error, tolerance);
+
+            Vector3 min = Vector3::Infinity;
+            Vector3 max = Vector3::InfinityNeg;
+            for (const uint32_t i : kept)
+            {
+                const Vector3& value = keys[i].value;
+                min = Vector3(Helper::Min(min.x, value.x), Helper::Min(min.y, value.y), Helper::Min(min.z, value.z));
+                max = Vector3(Helper::Max(max.x, value.x), Helper::Max(max.y, value.y), Helper::Max(max.z, value.z));
+            }
+
+            curve.key_offset    = static_cast<uint32_t>(m_key_times.size());
+            curve.key_count     = static_cast<uint32_t>(kept.size());
+            curve.range_min     = kept.empty() ? Vector3::Zero : min;
+            curve.range_extent  = kept.empty() ? Vector3::Zero : max - min;
+
+            for (const uint32_t i : kept)
+            {
+                const Vector3& value = keys[i].value;
+                m_key_times.emplace_back(time_normalized(keys[i].time));
+                m_key_x.emplace_back(quantize(value.x, curve.range_min.x, curve.range_extent.x));
+                m_key_y.emplace_back(quantize(value.y, curve.range_min.y, curve.range_extent.y));
+                m_key_z.emplace_back(quantize(value.z, curve.range_min.z, curve.range_extent.z));
+            }
+
+            m_key_count_source += static_cast<uint32_t>(keys.size());
+        };
+
+        add_vector_curve(track.curves[AnimationChannel_Translation], node.positionFrames, tolerance_translation);
+        add_vector_curve(track.curves[AnimationChannel_Scale], node.scaleFrames, tolerance_scale);
+
+        // Rotations store the three smallest components (15 bits each), the index of the largest one goes in the top bits of x and y
+        {
+            const vector<uint32_t> kept = reduce_keys(node.rotationFrames, Quaternion::Lerp, quaternion_error, tolerance_rotation);
+
+            AnimationCurve& curve   = track.curves[AnimationChannel_Rotation];
+            curve.key_offset        = static_cast<uint32_t>(m_key_times.size());
+            curve.key_count         = static_cast<uint32_t>(kept.size());
+
+            for (const uint32_t i : kept)
+            {
+                const Quaternion rotation = node.rotationFrames[i].value.Normalized();
+                float components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+
+                uint32_t largest = 0;
+                for (uint32_t c = 1; c < 4; c++)
+                {
+                    if (Helper::Abs(components[c]) > Helper::Abs(components[largest]))
+                    {
+                        largest = c;
+                    }
+                }
+
+                // q and -q are the same rotation, keep the largest component positive so it can be reconstructed
+                const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+                uint16_t smallest[3];
+                for (uint32_t c = 0, s = 0; c < 4; c++)
+                {
+                    if (c != largest)
+                    {
+                        smallest[s++] = quantize_smallest_three(components[c] * sign);
+                    }
+                }
+
+                m_key_times.emplace_back(time_normalized(node.rotationFrames[i].time));
+                m_key_x.emplace_back(static_cast<uint16_t>(smallest[0] | ((largest & 1) << 15)));
+                m_key_y.emplace_back(static_cast<uint16_t>(smallest[1] | ((largest >> 1) << 15)));
+                m_key_z.emplace_back(smallest[2]);
+            }
+
+            m_key_count_source += static_cast<uint32_t>(node.rotationFrames.size());
+        }
+    }
+
+    int32_t Animation::GetTrackIndex(const string& name) const
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_tracks.size()); i++)
+        {
+            if (m_tracks[i].name == name)
+                return static_cast<int32_t>(i);
+        }
+
+        return -1;
+    }
+
+    void Animation::Sample(const uint32_t track_index, const float time, Vector3& translation, Quaternion& rotation, Vector3& scale) const
+    {
+        const AnimationTrack& track = m_tracks[track_index];
+        const float duration        = GetDurationSeconds();
+        const float time_normalized = duration > 0.0f ? Helper::Clamp(time / duration, 0.0f, 1.0f) * quantization_max : 0.0f;
+
+        // Channels without keys leave the output untouched (e.g. the bind pose)
+        uint32_t key;
+        float alpha;
+
+        const AnimationCurve& curve_translation = track.curves[AnimationChannel_Translation];
+        if (curve_translation.key_count != 0)
+        {
+            SampleCurve(curve_translation, time_normalized, &key, &alpha);
+            translation = alpha == 0.0f ? DecodeVector(curve_translation, key) : Vector3::Lerp(DecodeVector(curve_translation, key), DecodeVector(curve_translation, key + 1), alpha);
+        }
+
+        const AnimationCurve& curve_rotation = track.curves[AnimationChannel_Rotation];
+        if (curve_rotation.key_count != 0)
+        {
+            SampleCurve(curve_rotation, time_normalized, &key, &alpha);
+            rotation = alpha == 0.0f ? DecodeQuaternion(key) : Quaternion::Lerp(DecodeQuaternion(key), DecodeQuaternion(key + 1), alpha);
+        }
+
+        const AnimationCurve& curve_scale = track.curves[AnimationChannel_Scale];
+        if (curve_scale.key_count != 0)
+        {
+            SampleCurve(curve_scale, time_normalized, &key, &alpha);
+            scale = alpha == 0.0f ? DecodeVector(curve_scale, key) : Vector3::Lerp(DecodeVector(curve_scale, key), DecodeVector(curve_scale, key + 1), alpha);
+        }
+    }
+
+    void Animation::SampleCurve(const AnimationCurve& curve, const float time_normalized, uint32_t* key, float* alpha) const
+    {
+        *key    = curve.key_offset;
+        *alpha  = 0.0f;
+
+        if (curve.key_count == 1)
+            return;
+
+        // Find the first key after the time
+        const uint16_t* begin   = m_key_times.data() + curve.key_offset;
+        const uint16_t* end     = begin + curve.key_count;
+        const uint16_t* next    = upper_bound(begin, end, time_normalized, [](const float time, const uint16_t key_time) { return time < static_cast<float>(key_time); });
+
+        if (next == begin)
+            return;
+
+        if (next == end)
+        {
+            *key    = curve.key_offset + curve.key_count - 2;
+            *alpha  = 1.0f;
+            return;
+        }
+
+        const auto index    = static_cast<uint32_t>(next - begin) - 1;
+        const float t0      = static_cast<float>(begin[index]);
+        const float t1      = static_cast<float>(begin[index + 1]);
+        *key                = curve.key_offset + index;
+        *alpha              = (time_normalized - t0) / (t1 - t0);
+    }
+
+    Vector3 Animation::DecodeVector(const AnimationCurve& curve, const uint32_t key) const
+    {
+        return Vector3
+        (
+            dequantize(m_key_x[key], curve.range_min.x, curve.range_extent.x),
+            dequantize(m_key_y[key], curve.range_min.y, curve.range_extent.y),
+            dequantize(m_key_z[key], curve.range_min.z, curve.range_extent.z)
+        );
+    }
+
+    Quaternion Animation::DecodeQuaternion(const uint32_t key) const
+    {
+        const uint16_t x        = m_key_x[key];
+        const uint16_t y        = m_key_y[key];
+        const uint16_t z        = m_key_z[key];
+        const uint32_t largest  = (x >> 15) | ((y >> 15) << 1);
+        const float a           = dequantize_smallest_three(x);
+        const float b           = dequantize_smallest_three(y);
+        const float c           = dequantize_smallest_three(z);
+        const float d           = Helper::Sqrt(Helper::Max(0.0f, 1.0f - a * a - b * b - c * c));
+
+        switch (largest)
+        {
+            case 0:  return Quaternion(d, a, b, c);
+            case 1:  return Quaternion(a, d, b, c);
+            case 2:  return Quaternion(a, b, d, c);
+            default: return Quaternion(a, b, c, d);
+        }
+    }
 }
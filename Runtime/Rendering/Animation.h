@@ -28,19 +28,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
-    struct AnimationVertexWeight
-    {
-        uint32_t vertexID;
-        float weight;
-    };
-
-    struct AnimationBone
-    {
-        std::string name;
-        std::vector<AnimationVertexWeight> vertexWeights;
-        Math::Matrix offset;
-    };
-
     struct KeyVector
     {
         double time;
@@ -53,6 +40,7 @@ namespace Spartan
         Math::Quaternion value;
     };
 
+    // The raw keys of a single node, as they come from the importer
     struct AnimationNode
     {
         std::string name;
@@ -61,6 +49,30 @@ namespace Spartan
         std::vector<KeyVector> scaleFrames;
     };
 
+    enum AnimationChannel : uint32_t
+    {
+        AnimationChannel_Translation,
+        AnimationChannel_Rotation,
+        AnimationChannel_Scale,
+        AnimationChannel_Count
+    };
+
+    // A compressed curve, its keys live in the key streams of the animation
+    struct AnimationCurve
+    {
+        uint32_t key_offset = 0;
+        uint32_t key_count  = 0;
+        Math::Vector3 range_min;    // dequantization range of translations and scales
+        Math::Vector3 range_extent;
+    };
+
+    // Each track animates a single node
+    struct AnimationTrack
+    {
+        std::string name;
+        AnimationCurve curves[AnimationChannel_Count];
+    };
+
 	class SPARTAN_CLASS Animation : public IResource
 	{
 	public:
@@ -68,20 +80,44 @@ namespace Spartan
 		~Animation() = default;
 
 		//= IResource ==========================================
-		bool LoadFromFile(const std::string& filePath) override;
-		bool SaveToFile(const std::string& filePath) override;
+		bool LoadFromFile(const std::string& file_path) override;
+		bool SaveToFile(const std::string& file_path) override;
 		//======================================================
 
 		void SetName(const std::string& name)   { m_name = name; }
 		void SetDuration(double duration)       { m_duration = duration; }
 		void SetTicksPerSec(double ticksPerSec) { m_ticksPerSec = ticksPerSec; }
+        const auto& GetName()           const { return m_name; }
+        float GetDurationSeconds()      const { return m_ticksPerSec != 0.0 ? static_cast<float>(m_duration / m_ticksPerSec) : 0.0f; }
+
+        // Reduces the keys of a node (dropping the ones that interpolation can reproduce) and quantizes them into a new track.
+        // The duration and the ticks per second have to be set first, as key times are stored relative to the duration.
+        void AddTrack(const AnimationNode& node);
+        const auto& GetTracks()         const { return m_tracks; }
+        int32_t GetTrackIndex(const std::string& name) const;
+
+        // Samples a track at the given time (in seconds)
+        void Sample(uint32_t track_index, float time, Math::Vector3& translation, Math::Quaternion& rotation, Math::Vector3& scale) const;
+
+        // Compression statistics
+        uint32_t GetKeyCountSource()    const { return m_key_count_source; }
+        uint32_t GetKeyCount()          const { return static_cast<uint32_t>(m_key_times.size()); }
 
 	private:
+        void SampleCurve(const AnimationCurve& curve, float time_normalized, uint32_t* key, float* alpha) const;
+        Math::Vector3 DecodeVector(const AnimationCurve& curve, uint32_t key) const;
+        Math::Quaternion DecodeQuaternion(uint32_t key) const;
+
 		std::string m_name;
 		double m_duration       = 0;
 		double m_ticksPerSec    = 0;
+        std::vector<AnimationTrack> m_tracks;
 
-		// Each channel controls a single node
-		std::vector<AnimationNode> m_channels;
+        // Key streams (SoA), times are normalized to the duration, values are quantized to 16 bits (rotations use the smallest three)
+        std::vector<uint16_t> m_key_times;
+        std::vector<uint16_t> m_key_x;
+        std::vector<uint16_t> m_key_y;
+        std::vector<uint16_t> m_key_z;
+        uint32_t m_key_count_source = 0;
 	};
 }
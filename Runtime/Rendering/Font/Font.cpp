@@ -20,14 +20,17 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 //= INCLUDES ==================================
+#include <algorithm>
 #include "Font.h"
 #include "../Renderer.h"
 #include "../../Core/Stopwatch.h"
 #include "../../RHI/RHI_Vertex.h"
 #include "../../RHI/RHI_VertexBuffer.h"
 #include "../../RHI/RHI_IndexBuffer.h"
+#include "../../RHI/RHI_Texture2D.h"
 #include "../../Resource/ResourceCache.h"
 #include "../../Resource/Import/FontImporter.h"
+#include "../../Utilities/Hash.h"
 //=============================================
 
 //= NAMESPACES ================
@@ -38,6 +41,7 @@ using namespace Spartan::Math;
 #define ASCII_TAB		9
 #define ASCII_NEW_LINE	10
 #define ASCII_SPACE		32
+#define QUAD_CAPACITY_MIN	256
 
 namespace Spartan
 {
@@ -52,6 +56,10 @@ namespace Spartan
 		
 		SetSize(font_size);
 		Font::LoadFromFile(file_path);
+
+		// Create the buffers up front so that their stride is known before any text is drawn
+		GrowQuads(0);
+		UpdateBuffers();
 	}
 
 	bool Font::SaveToFile(const string& file_path)
@@ -86,73 +94,250 @@ namespace Spartan
 
 	void Font::SetText(const string& text, const Vector2& position)
 	{
-        const bool same_text    = text == m_current_text;
-        const bool has_buffers  = (m_vertex_buffer && m_index_buffer);
+		ClearText();
+		AddText(text, position);
+	}
 
-		if (same_text || !has_buffers)
+	void Font::AddText(const string& text, const Vector2& position)
+	{
+		m_text_queue.emplace_back(LayoutText(text, position));
+		m_ranges_dirty		= true;
+		m_vertices_dirty	= true; // cached text may not be in the vertex buffer anymore
+	}
+
+	void Font::ClearText()
+	{
+		if (m_text_queue.empty())
 			return;
 
-        Vector2 pen = position;
-		m_current_text = text;
-		m_vertices.clear();
+		m_text_queue.clear();
+		m_ranges_dirty = true;
+	}
+
+	size_t Font::LayoutText(const string& text, const Vector2& position)
+	{
+		size_t key = 0;
+		Utility::Hash::hash_combine(key, text);
+		Utility::Hash::hash_combine(key, position.x);
+		Utility::Hash::hash_combine(key, position.y);
+		Utility::Hash::hash_combine(key, m_font_size);
+
+		// Text which was already laid out at this position still has its glyphs in the vertex buffer
+		if (m_layouts.find(key) != m_layouts.end())
+			return key;
+
+		// Every character other than white space is a quad, they are written straight into their place in the ring
+		TextLayout layout;
+		layout.quad_count = static_cast<uint32_t>(count_if(text.begin(), text.end(), [](const char c) { return c != ASCII_TAB && c != ASCII_NEW_LINE && c != ASCII_SPACE; }));
+		if (layout.quad_count != 0)
+		{
+			AllocateQuads(layout.quad_count, layout.quad_offset);
+		}
+		RHI_Vertex_PosTex* vertex = m_quad_vertices.data() + layout.quad_offset * 4;
+		Vector2 pen = position;
+
+		// The atlas is a distance field which is scaled to the requested size
+		const float scale = m_atlas_glyph_size != 0.0f ? GetSizePixels() / m_atlas_glyph_size : 1.0f;
 
 		// Draw each letter onto a quad.
-		for (auto text_char : m_current_text)
+		for (auto text_char : text)
 		{
             Glyph& glyph = m_glyphs[text_char];
 
 			if (text_char == ASCII_TAB)
 			{
-				const uint32_t space_offset	        = m_glyphs[ASCII_SPACE].horizontal_advance;
-				const uint32_t space_count	        = 8; // spaces in a typical terminal
-				const uint32_t tab_spacing	        = space_offset * space_count;
-                const uint32_t offset_from_start    = static_cast<uint32_t>(Math::Helper::Abs(pen.x - position.x));
-                const uint32_t next_column_index    = (offset_from_start / tab_spacing) + 1;
-                const uint32_t offset_to_column     = (next_column_index * tab_spacing) - offset_from_start;
+				const float space_offset	        = m_glyphs[ASCII_SPACE].horizontal_advance * scale;
+				const float space_count	            = 8.0f; // spaces in a typical terminal
+				const float tab_spacing	            = space_offset * space_count;
+                const float offset_from_start       = Math::Helper::Abs(pen.x - position.x);
+                const float next_column_index       = Math::Helper::Floor(offset_from_start / tab_spacing) + 1.0f;
+                const float offset_to_column        = (next_column_index * tab_spacing) - offset_from_start;
 				pen.x                               += offset_to_column;
 			}
 			else if (text_char == ASCII_NEW_LINE)
 			{
-				pen.y -= m_char_max_height;
+				pen.y -= m_char_max_height * scale;
 				pen.x = position.x;
 			}
 			else if (text_char == ASCII_SPACE)
 			{
                 // Advance
-                pen.x += glyph.horizontal_advance;
+                pen.x += glyph.horizontal_advance * scale;
 			}
             else // Any other char
             {
-			    // First triangle in quad.		
-			    m_vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_left,  glyph.uv_y_top);       // top left
-			    m_vertices.emplace_back(pen.x + glyph.offset_x  + glyph.width,  pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_right, glyph.uv_y_bottom);    // bottom right
-			    m_vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_left,  glyph.uv_y_bottom);    // bottom left
-			    // Second triangle in quad.
-			    m_vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_left,  glyph.uv_y_top);       // top left
-			    m_vertices.emplace_back(pen.x + glyph.offset_x	+ glyph.width,	pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_right, glyph.uv_y_top);       // top right
-			    m_vertices.emplace_back(pen.x + glyph.offset_x	+ glyph.width,	pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_right, glyph.uv_y_bottom);    // bottom right
+                const float left    = pen.x + glyph.offset_x * scale;
+                const float right   = left + glyph.width * scale;
+                const float top     = pen.y + glyph.offset_y * scale;
+                const float bottom  = top - glyph.height * scale;
+
+			    // Two triangles share these, see the index pattern in UpdateBuffers()
+			    *vertex++ = RHI_Vertex_PosTex(left,  top,    0.0f, glyph.uv_x_left,  glyph.uv_y_top);      // top left
+			    *vertex++ = RHI_Vertex_PosTex(right, bottom, 0.0f, glyph.uv_x_right, glyph.uv_y_bottom);   // bottom right
+			    *vertex++ = RHI_Vertex_PosTex(left,  bottom, 0.0f, glyph.uv_x_left,  glyph.uv_y_bottom);   // bottom left
+			    *vertex++ = RHI_Vertex_PosTex(right, top,    0.0f, glyph.uv_x_right, glyph.uv_y_top);      // top right
 
 			    // Advance
-                pen.x += glyph.horizontal_advance;
+                pen.x += glyph.horizontal_advance * scale;
             }
 		}
-		m_vertices.shrink_to_fit();		
-		
-		m_indices.clear();
-		for (uint32_t i = 0; i < m_vertices.size(); i++)
+
+		m_layouts[key] = layout;
+
+		return key;
+	}
+
+	void Font::AllocateQuads(const uint32_t quad_count, uint32_t& quad_offset)
+	{
+		// Wrap around, older layouts will be evicted as they get overwritten
+		if (m_quad_head + quad_count > m_quad_capacity)
+		{
+			m_quad_head = 0;
+		}
+
+		const uint32_t begin	= m_quad_head;
+		const uint32_t end		= m_quad_head + quad_count;
+		const auto is_queued	= [this](const size_t key) { return find(m_text_queue.begin(), m_text_queue.end(), key) != m_text_queue.end(); };
+		const auto overlaps		= [begin, end](const TextLayout& layout) { return layout.quad_offset < end && begin < layout.quad_offset + layout.quad_count; };
+
+		// If the range is too small or would overwrite text that is about to be drawn, grow instead
+		bool grow = end > m_quad_capacity;
+		for (const auto& it : m_layouts)
+		{
+			if (grow)
+				break;
+
+			grow = overlaps(it.second) && is_queued(it.first);
+		}
+
+		if (grow)
+		{
+			GrowQuads(quad_count);
+		}
+		else
+		{
+			for (auto it = m_layouts.begin(); it != m_layouts.end();)
+			{
+				if (!overlaps(it->second))
+				{
+					it++;
+					continue;
+				}
+
+				// The GPU may still be drawing the evicted text from a previous frame, so its quads can't be overwritten in place
+				m_upload_discard = m_upload_discard || it->second.resident;
+				it = m_layouts.erase(it);
+			}
+		}
+
+		quad_offset	= m_quad_head;
+		m_quad_head	+= quad_count;
+	}
+
+	void Font::GrowQuads(const uint32_t quad_count)
+	{
+		// Only the queued text survives a resize, it's compacted to the start of the new buffer
+		uint32_t quad_count_queued = 0;
+		for (const size_t key : m_text_queue)
+		{
+			const auto it = m_layouts.find(key);
+			quad_count_queued += it != m_layouts.end() ? it->second.quad_count : 0;
+		}
+
+		uint32_t capacity = Helper::Max<uint32_t>(m_quad_capacity * 2, QUAD_CAPACITY_MIN);
+		while (capacity < quad_count_queued + quad_count)
 		{
-			m_indices.emplace_back(i);
+			capacity *= 2;
 		}
 
-		UpdateBuffers(m_vertices, m_indices);
+		vector<RHI_Vertex_PosTex> vertices(capacity * 4, RHI_Vertex_PosTex(Vector3::Zero, Vector2::Zero));
+		unordered_map<size_t, TextLayout> layouts;
+		uint32_t head = 0;
+		for (const size_t key : m_text_queue)
+		{
+			const auto it = m_layouts.find(key);
+			if (it == m_layouts.end() || layouts.find(key) != layouts.end())
+				continue;
+
+			const TextLayout& layout_old	= it->second;
+			TextLayout& layout				= layouts[key];
+			layout.quad_offset				= head;
+			layout.quad_count				= layout_old.quad_count;
+			copy_n(m_quad_vertices.begin() + layout_old.quad_offset * 4, layout_old.quad_count * 4, vertices.begin() + head * 4);
+			head += layout.quad_count;
+		}
+
+		m_quad_vertices.swap(vertices);
+		m_layouts.swap(layouts);
+		m_quad_capacity		= capacity;
+		m_quad_head			= head;
+		m_vertices_dirty	= true;
+		m_ranges_dirty		= true;
+		m_upload_discard	= true;
 	}
 
 	void Font::SetSize(const uint32_t size)
 	{
-		m_font_size = Helper::Clamp<uint32_t>(size, 8, 50);
+		const uint32_t font_size = Helper::Clamp<uint32_t>(size, 8, 50);
+		if (font_size == m_font_size)
+			return;
+
+		m_font_size = font_size;
+		UpdateOutline();
 	}
 
-	bool Font::UpdateBuffers(vector<RHI_Vertex_PosTex>& vertices, vector<uint32_t>& indices) const
+	void Font::SetOutline(const Font_Outline_Type outline)
+	{
+		if (outline == m_outline)
+			return;
+
+		m_outline = outline;
+		UpdateOutline();
+	}
+
+	void Font::SetOutlineSize(const uint32_t outline_size)
+	{
+		if (outline_size == m_outline_size)
+			return;
+
+		m_outline_size = outline_size;
+		UpdateOutline();
+	}
+
+	void Font::SetAtlas(const uint32_t width, const uint32_t height, vector<std::byte> field, const float glyph_size, const float spread)
+	{
+		m_atlas_width		= width;
+		m_atlas_height		= height;
+		m_atlas_glyph_size	= glyph_size;
+		m_atlas_spread		= spread;
+		m_atlas_field		= field;
+		m_atlas				= make_shared<RHI_Texture2D>(m_context, width, height, RHI_Format_R8_Unorm, move(field));
+
+		UpdateOutline();
+	}
+
+	void Font::UpdateOutline()
+	{
+		m_atlas_outline = nullptr;
+
+		const uint32_t outline_size = (m_outline != Font_Outline_None) ? m_outline_size : 0;
+		if (outline_size == 0 || m_atlas_field.empty() || m_atlas_spread == 0.0f)
+			return;
+
+		// The outline is the same field with its edge pushed outwards, by the outline size at the current text size
+		const float outline_size_atlas	= static_cast<float>(outline_size) * m_atlas_glyph_size / GetSizePixels();
+		const uint32_t shift			= static_cast<uint32_t>(outline_size_atlas / (m_atlas_spread * 2.0f) * 255.0f);
+
+		vector<std::byte> field_outline(m_atlas_field.size());
+		for (size_t i = 0; i < m_atlas_field.size(); i++)
+		{
+			field_outline[i] = static_cast<std::byte>(Helper::Min<uint32_t>(static_cast<uint32_t>(m_atlas_field[i]) + shift, 255));
+		}
+
+		m_atlas_outline = make_shared<RHI_Texture2D>(m_context, m_atlas_width, m_atlas_height, RHI_Format_R8_Unorm, move(field_outline));
+	}
+
+	bool Font::UpdateBuffers()
 	{
 		if (!m_context || !m_vertex_buffer || !m_index_buffer)
 		{
@@ -161,37 +346,129 @@ namespace Spartan
 		}
 
 		// Grow buffers (if needed)
-		if (vertices.size() > m_vertex_buffer->GetVertexCount())
+		if (m_quad_capacity * 4 > m_vertex_buffer->GetVertexCount())
 		{
 			// Vertex buffer
-			if (!m_vertex_buffer->CreateDynamic<RHI_Vertex_PosTex>(static_cast<uint32_t>(vertices.size())))
+			if (!m_vertex_buffer->CreateDynamic<RHI_Vertex_PosTex>(m_quad_capacity * 4))
 			{
 				LOG_ERROR("Failed to update vertex buffer.");
 				return false;
 			}
 
-			// Index buffer
-			if (!m_index_buffer->CreateDynamic<uint32_t>(static_cast<uint32_t>(indices.size())))
+			// Index buffer, every quad uses the same pattern so it only changes when it grows
+			vector<uint32_t> indices(m_quad_capacity * 6);
+			for (uint32_t i = 0; i < m_quad_capacity; i++)
+			{
+				const uint32_t vertex = i * 4;
+				indices[i * 6 + 0] = vertex + 0; // top left
+				indices[i * 6 + 1] = vertex + 1; // bottom right
+				indices[i * 6 + 2] = vertex + 2; // bottom left
+				indices[i * 6 + 3] = vertex + 0; // top left
+				indices[i * 6 + 4] = vertex + 3; // top right
+				indices[i * 6 + 5] = vertex + 1; // bottom right
+			}
+
+			if (!m_index_buffer->Create(indices))
 			{
 				LOG_ERROR("Failed to update index buffer.");
 				return false;
 			}
+
+			m_vertices_dirty	= true;
+			m_upload_discard	= true;
 		}
 
-        bool mapped_vertex = false;
-        if (const auto vertex_buffer = static_cast<RHI_Vertex_PosTex*>(m_vertex_buffer->Map()))
-        {
-            copy(vertices.begin(), vertices.end(), vertex_buffer);
-            mapped_vertex = m_vertex_buffer->Unmap();
-        }
+		// Upload the queued text which isn't in the vertex buffer, each layout is written to its own range. Unless text that the GPU
+		// may still be drawing was evicted, the rest of the buffer is kept. Otherwise it's discarded and all queued text goes up again.
+		if (m_vertices_dirty)
+		{
+			if (m_upload_discard)
+			{
+				for (auto& it : m_layouts)
+				{
+					it.second.resident = false;
+				}
+			}
+
+			m_layouts_upload.clear();
+			for (const size_t key : m_text_queue)
+			{
+				const auto it = m_layouts.find(key);
+				if (it != m_layouts.end() && it->second.quad_count != 0 && !it->second.resident)
+				{
+					it->second.resident = true;
+					m_layouts_upload.emplace_back(&it->second);
+				}
+			}
+
+			if (!m_layouts_upload.empty())
+			{
+				const auto vertex_buffer = static_cast<RHI_Vertex_PosTex*>(m_vertex_buffer->Map(m_upload_discard));
+				if (!vertex_buffer)
+				{
+					LOG_ERROR("Failed to map vertex buffer.");
+					m_upload_discard = true;
+					return false;
+				}
 
-        bool mapped_index = false;
-        if (const auto index_buffer = static_cast<uint32_t*>(m_index_buffer->Map()))
-        {
-            copy(indices.begin(), indices.end(), index_buffer);
-            mapped_index = m_index_buffer->Unmap();
-        }
+				for (const TextLayout* layout : m_layouts_upload)
+				{
+					copy_n(m_quad_vertices.begin() + layout->quad_offset * 4, layout->quad_count * 4, vertex_buffer + layout->quad_offset * 4);
+				}
 
-		return mapped_vertex && mapped_index;
+				if (!m_vertex_buffer->Unmap())
+				{
+					m_upload_discard = true;
+					return false;
+				}
+
+				m_upload_discard = false;
+			}
+
+			m_vertices_dirty = false;
+		}
+
+		// Merge queued text which is adjacent in the vertex buffer, so that it's drawn with a single call
+		if (m_ranges_dirty)
+		{
+			m_layouts_sorted.clear();
+			for (const size_t key : m_text_queue)
+			{
+				const auto it = m_layouts.find(key);
+				if (it != m_layouts.end() && it->second.quad_count != 0)
+				{
+					m_layouts_sorted.emplace_back(it->second);
+				}
+			}
+
+			sort(m_layouts_sorted.begin(), m_layouts_sorted.end(), [](const TextLayout& a, const TextLayout& b) { return a.quad_offset < b.quad_offset; });
+
+			m_draw_ranges.clear();
+			uint32_t quad_end = 0;
+			for (const TextLayout& layout : m_layouts_sorted)
+			{
+				// The same text can be queued more than once
+				if (!m_draw_ranges.empty() && layout.quad_offset < quad_end)
+					continue;
+
+				if (!m_draw_ranges.empty() && layout.quad_offset == quad_end)
+				{
+					m_draw_ranges.back().index_count += layout.quad_count * 6;
+				}
+				else
+				{
+					Font_DrawRange range;
+					range.index_count	= layout.quad_count * 6;
+					range.vertex_offset	= layout.quad_offset * 4;
+					m_draw_ranges.emplace_back(range);
+				}
+
+				quad_end = layout.quad_offset + layout.quad_count;
+			}
+
+			m_ranges_dirty = false;
+		}
+
+		return true;
 	}
 }
@@ -21,15 +21,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ========================
+//= INCLUDES =========================
 #include <memory>
+#include <vector>
+#include <cstddef>
 #include <unordered_map>
 #include "Glyph.h"
+#include "../../RHI/RHI_Vertex.h"
 #include "../../RHI/RHI_Definition.h"
 #include "../../Core/EngineDefs.h"
 #include "../../Resource/IResource.h"
 #include "../../Math/Vector4.h"
-//===================================
+//====================================
 
 namespace Spartan
 {
@@ -53,6 +56,13 @@ namespace Spartan
         Font_Outline_Negative
     };
 
+    // A run of glyph quads which sit next to each other in the vertex buffer and can be drawn with a single call
+    struct Font_DrawRange
+    {
+        uint32_t index_count    = 0;
+        uint32_t vertex_offset  = 0;
+    };
+
 	class SPARTAN_CLASS Font : public IResource
 	{
 	public:
@@ -64,7 +74,13 @@ namespace Spartan
 		bool LoadFromFile(const std::string& file_path) override;
 		//======================================================
 
+		// Replaces all queued text with a single label
 		void SetText(const std::string& text, const Math::Vector2& position);
+		// Queues an additional label, labels which were laid out before are reused from the cache
+		void AddText(const std::string& text, const Math::Vector2& position);
+		void ClearText();
+		// Uploads any newly laid out glyphs and rebuilds the draw ranges, call once before drawing
+		bool UpdateBuffers();
 		void SetSize(uint32_t size);
 
 		const Math::Vector4& GetColor()                                 const { return m_color; }
@@ -73,28 +89,38 @@ namespace Spartan
         const Math::Vector4& GetColorOutline()                          const { return m_color_outline; }
         void SetColorOutline(const Math::Vector4& color)                      { m_color_outline = color; }
 
-		void SetOutline(const Font_Outline_Type outline)			    	  { m_outline = outline; }
+		void SetOutline(Font_Outline_Type outline);
         const Font_Outline_Type GetOutline()                            const { return m_outline; }
 
-        void SetOutlineSize(const uint32_t outline_size)                      { m_outline_size = outline_size; }
+        void SetOutlineSize(uint32_t outline_size);
         const uint32_t GetOutlineSize()                                 const { return m_outline_size; }
 
+        // The distance field (a byte per texel) and the glyph size and spread (in pixels) it was generated with
+        void SetAtlas(uint32_t width, uint32_t height, std::vector<std::byte> field, float glyph_size, float spread);
 		const auto& GetAtlas()                                          const { return m_atlas; }
-        void SetAtlas(const std::shared_ptr<RHI_Texture>& atlas)              { m_atlas = atlas; }
-
         const auto& GetAtlasOutline()                                   const { return m_atlas_outline; }
-        void SetAtlasOutline(const std::shared_ptr<RHI_Texture>& atlas)       { m_atlas_outline = atlas; }
 
         RHI_IndexBuffer* GetIndexBuffer()                               const { return m_index_buffer.get(); }
         RHI_VertexBuffer* GetVertexBuffer()                             const { return m_vertex_buffer.get(); }
-        uint32_t GetIndexCount()                                        const { return static_cast<uint32_t>(m_indices.size()); }
+        const auto& GetDrawRanges()                                     const { return m_draw_ranges; }
         uint32_t GetSize()                                              const { return m_font_size; }
+        float GetSizePixels()                                           const { return m_font_size * 96.0f / 72.0f; } // points at 96 DPI
 		void SetGlyph(const uint32_t char_code, const Glyph& glyph)			  { m_glyphs[char_code] = glyph; }
         Font_Hinting_Type GetHinting()                                  const { return m_hinting; }
 		auto GetForceAutohint()                                         const { return m_force_autohint; }
 			
-	private:	
-		bool UpdateBuffers(std::vector<RHI_Vertex_PosTex>& vertices, std::vector<uint32_t>& indices) const;
+	private:
+		struct TextLayout
+		{
+			uint32_t quad_offset	= 0;
+			uint32_t quad_count		= 0;
+			bool resident			= false; // its quads are in the vertex buffer
+		};
+
+		size_t LayoutText(const std::string& text, const Math::Vector2& position);
+		void AllocateQuads(uint32_t quad_count, uint32_t& quad_offset);
+		void GrowQuads(uint32_t quad_count);
+		void UpdateOutline();
 
 		uint32_t m_font_size	        = 14;
         uint32_t m_outline_size         = 2;
@@ -103,16 +129,32 @@ namespace Spartan
         Font_Outline_Type m_outline     = Font_Outline_Positive;
 		Math::Vector4 m_color           = Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
         Math::Vector4 m_color_outline   = Math::Vector4(0.0f, 0.0f, 0.0f, 1.0f);
-		std::string m_current_text;
 		uint32_t m_char_max_width;
 		uint32_t m_char_max_height;
+		float m_atlas_glyph_size		= 0.0f; // pixel size of the glyphs in the (distance field) atlas
+		float m_atlas_spread			= 0.0f; // pixels the field extends to on each side of an edge, at the above size
+		uint32_t m_atlas_width			= 0;
+		uint32_t m_atlas_height			= 0;
+		std::vector<std::byte> m_atlas_field; // kept to derive the outline from whenever the size or the outline changes
 		std::shared_ptr<RHI_Texture> m_atlas;
         std::shared_ptr<RHI_Texture> m_atlas_outline;
 		std::unordered_map<uint32_t, Glyph> m_glyphs;
 		std::shared_ptr<RHI_VertexBuffer> m_vertex_buffer;
 		std::shared_ptr<RHI_IndexBuffer> m_index_buffer;
-		std::vector<RHI_Vertex_PosTex> m_vertices;
-		std::vector<uint32_t> m_indices;	
+
+		// Laid out text, keyed by a hash of the string and its position
+		std::unordered_map<size_t, TextLayout> m_layouts;
+		std::vector<size_t> m_text_queue;
+		std::vector<Font_DrawRange> m_draw_ranges;
+		// CPU copy of the glyph quads (4 vertices each), allocated as a ring
+		std::vector<RHI_Vertex_PosTex> m_quad_vertices;
+		uint32_t m_quad_capacity	= 0;
+		uint32_t m_quad_head		= 0;
+		bool m_vertices_dirty		= false;
+		bool m_ranges_dirty			= false;
+		bool m_upload_discard		= false; // the next upload replaces the whole vertex buffer
+		std::vector<TextLayout*> m_layouts_upload;
+		std::vector<TextLayout> m_layouts_sorted;
 		std::shared_ptr<RHI_Device> m_rhi_device;
 	};
 }
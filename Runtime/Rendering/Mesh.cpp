@@ -51,7 +51,7 @@ namespace Spartan
 
 	void Mesh::Geometry_Get(uint32_t indexOffset, uint32_t indexCount, uint32_t vertexOffset, unsigned vertexCount, vector<uint32_t>* indices, vector<RHI_Vertex_PosTexNorTan>* vertices)
 	{
-		if (indexOffset == 0 || indexCount == 0 || vertexOffset == 0 || vertexCount == 0 || !vertices || !indices)
+		if (indexCount == 0 || vertexCount == 0 || !vertices || !indices) // the first sub-mesh starts at offset 0
 		{
 			LOG_ERROR("Mesh::Geometry_Get: Invalid parameters");
 			return;
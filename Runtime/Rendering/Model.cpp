@@ -80,7 +80,7 @@ namespace Spartan
         if (FileSystem::GetExtensionFromFilePath(file_path) == EXTENSION_MODEL)
         {
             // Deserialize
-            auto file = make_unique<FileStream>(file_path, FileStream_Read);
+            auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Map | FileStream_Checksum);
             if (!file->IsOpen())
                 return false;
 
@@ -129,7 +129,7 @@ namespace Spartan
 
 	bool Model::SaveToFile(const string& file_path)
 	{
-		auto file = make_unique<FileStream>(file_path, FileStream_Write);
+		auto file = make_unique<FileStream>(file_path, FileStream_Write | FileStream_Checksum);
 		if (!file->IsOpen())
 			return false;
 
@@ -45,6 +45,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_Implementation.h"
 #include "../RHI/RHI_DescriptorCache.h"
+#include "../RHI/RHI_TextureTable.h"
+#include "../RHI/RHI_ShaderCache.h"
 //=========================================
 
 //= NAMESPACES ===============
@@ -89,6 +91,9 @@ namespace Spartan
 
 	Renderer::~Renderer()
 	{
+        // The warm-up uses the pipeline cache and the resources of the renderer
+        WaitForPipelineWarmUp();
+
 		// Unsubscribe from events
 		UNSUBSCRIBE_FROM_EVENT(Event_World_Resolve_Complete, EVENT_HANDLER_VARIANT(RenderablesAcquire));
 
@@ -125,11 +130,19 @@ namespace Spartan
         }
 
         // Create pipeline cache
-        m_pipeline_cache = make_shared<RHI_PipelineCache>(m_rhi_device.get());
+        m_pipeline_cache = make_shared<RHI_PipelineCache>(m_rhi_device.get(), m_resource_cache->GetDataDirectory() + "/pipeline_cache");
 
         // Create descriptor cache
         m_descriptor_cache = make_shared<RHI_DescriptorCache>(m_rhi_device.get());
 
+        // Create texture table (bindless), it has to exist before any texture gets created
+        #ifdef API_GRAPHICS_VULKAN
+        m_texture_table = make_shared<RHI_TextureTable>(m_rhi_device);
+        #endif
+
+        // Create shader cache, it has to exist before any shader gets compiled
+        m_shader_cache = make_shared<RHI_ShaderCache>(m_resource_cache->GetDataDirectory() + "/shader_cache");
+
         // Create swap chain
         {
             m_swap_chain = make_shared<RHI_SwapChain>
@@ -191,6 +204,12 @@ namespace Spartan
 		if (!m_rhi_device || !m_rhi_device->IsInitialized())
 			return;
 
+        // Pre-create the pipelines which previous runs used, as soon as the shaders are compiled
+        if (!m_pipelines_warm_up_started)
+        {
+            WarmUpPipelines();
+        }
+
         // Don't do any work if the swapchain is not presenting
         if (m_swap_chain && !m_swap_chain->IsPresenting())
             return;
@@ -746,6 +765,11 @@ namespace Spartan
         return m_rhi_device->GetContextRhi()->max_texture_dimension_2d;
     }
 
+    bool Renderer::IsBindless() const
+    {
+        return m_texture_table && m_texture_table->IsSupported();
+    }
+
     void Renderer::SetGlobalShaderObjectTransform(RHI_CommandList* cmd_list, const Math::Matrix& transform)
     {
         m_buffer_object_cpu.object = transform;
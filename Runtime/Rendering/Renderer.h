@@ -25,6 +25,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <unordered_map>
 #include <array>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include "Renderer_ConstantBuffers.h"
 #include "Material.h"
 #include "../Core/ISubsystem.h"
@@ -242,6 +244,9 @@ namespace Spartan
         const std::shared_ptr<RHI_Device>& GetRhiDevice()   const { return m_rhi_device; } 
         RHI_PipelineCache* GetPipelineCache()               const { return m_pipeline_cache.get(); }
         RHI_DescriptorCache* GetDescriptorCache()           const { return m_descriptor_cache.get(); }
+        const std::shared_ptr<RHI_TextureTable>& GetTextureTable() const { return m_texture_table; }
+        bool IsBindless() const;
+        RHI_ShaderCache* GetShaderCache()                   const { return m_shader_cache.get(); }
         RHI_Texture* GetFrameTexture()                      const { return m_render_targets.at(RenderTarget_Composition_Ldr).get(); }
         auto GetFrameNum()                                  const { return m_frame_num; }
         const auto& GetCamera()                             const { return m_camera; }
@@ -266,6 +271,8 @@ namespace Spartan
 		void CreateShaders();
 		void CreateSamplers();
 		void CreateRenderTextures();
+        void WarmUpPipelines();
+        void WaitForPipelineWarmUp();
 
 		// Passes
 		void Pass_Main(RHI_CommandList* cmd_list);
@@ -396,6 +403,10 @@ namespace Spartan
         const float m_gizmo_size_max                = 2.0f;
         const float m_gizmo_size_min                = 0.1f;
         bool m_update_ortho_proj                    = true;
+        bool m_pipelines_warm_up_started            = false;
+        bool m_pipelines_warming                    = false; // worker threads are creating pipelines of the manifest
+        std::mutex m_pipelines_warming_mutex;
+        std::condition_variable m_pipelines_warming_condition;
                                                                   
         //= BUFFERS ==============================================
         BufferFrame m_buffer_frame_cpu;
@@ -429,6 +440,8 @@ namespace Spartan
         std::shared_ptr<RHI_SwapChain> m_swap_chain;
         std::shared_ptr<RHI_PipelineCache> m_pipeline_cache;
         std::shared_ptr<RHI_DescriptorCache> m_descriptor_cache;
+        std::shared_ptr<RHI_TextureTable> m_texture_table;
+        std::shared_ptr<RHI_ShaderCache> m_shader_cache;
 
         // Dependencies
         Profiler* m_profiler            = nullptr;
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ===============
+#include <array>
 #include "..\Math\Vector2.h"
 #include "..\Math\Vector3.h"
 #include "..\Math\Matrix.h"
@@ -102,11 +103,15 @@ namespace Spartan
         float mat_id;
         Math::Vector3 padding;
 
+        // Texture table indices (bindless), in the same order as the material texture slots
+        std::array<uint32_t, 8> mat_textures = { 0 };
+
         bool operator==(const BufferUber& rhs) const
         {
             return
                 transform           == rhs.transform            &&
                 mat_id              == rhs.mat_id               &&
+                mat_textures        == rhs.mat_textures         &&
                 mat_albedo          == rhs.mat_albedo           &&
                 mat_tiling_uv       == rhs.mat_tiling_uv        &&
                 mat_offset_uv       == rhs.mat_offset_uv        &&
@@ -33,6 +33,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_PipelineState.h"
 #include "../RHI/RHI_Texture.h"
+#include "../RHI/RHI_TextureTable.h"
 #include "../World/Entity.h"
 #include "../World/Components/Light.h"
 #include "../World/Components/Camera.h"
@@ -398,6 +399,21 @@ namespace Spartan
         pso.viewport                        = tex_albedo->GetViewport();
         pso.primitive_topology              = RHI_PrimitiveTopology_TriangleList;
 
+        // Material textures are either indexed through the texture table or bound per material
+        const bool bindless = IsBindless();
+        if (bindless && !m_texture_table->HasDefault())
+        {
+            LOG_ERROR("The texture table has no default texture, unregistered textures can't be indexed");
+            return;
+        }
+
+        // Textures which aren't registered (yet) fall back to the default slot, which always holds a valid texture
+        const auto texture_table_index = [](RHI_Texture* texture)
+        {
+            const uint32_t index = texture ? texture->GetTextureTableIndex() : state_texture_table_index_empty;
+            return index != state_texture_table_index_empty ? index : state_texture_table_index_default;
+        };
+
         bool cleared = false;
         uint32_t material_index = 0;
         uint32_t material_bound_id = 0;
@@ -481,15 +497,29 @@ namespace Spartan
                         LOG_ERROR("Material instance array has reached it's maximum capacity of %d elements. Consider increasing the size.", m_max_material_instances);
                     }
 
-                    // Bind material textures		
-                    cmd_list->SetTexture(0, material->GetTexture_Ptr(Material_Color));
-                    cmd_list->SetTexture(1, material->GetTexture_Ptr(Material_Roughness));
-                    cmd_list->SetTexture(2, material->GetTexture_Ptr(Material_Metallic));
-                    cmd_list->SetTexture(3, material->GetTexture_Ptr(Material_Normal));
-                    cmd_list->SetTexture(4, material->GetTexture_Ptr(Material_Height));
-                    cmd_list->SetTexture(5, material->GetTexture_Ptr(Material_Occlusion));
-                    cmd_list->SetTexture(6, material->GetTexture_Ptr(Material_Emission));
-                    cmd_list->SetTexture(7, material->GetTexture_Ptr(Material_Mask));
+                    // Bind material textures
+                    if (bindless)
+                    {
+                        m_buffer_uber_cpu.mat_textures[0] = texture_table_index(material->GetTexture_Ptr(Material_Color));
+                        m_buffer_uber_cpu.mat_textures[1] = texture_table_index(material->GetTexture_Ptr(Material_Roughness));
+                        m_buffer_uber_cpu.mat_textures[2] = texture_table_index(material->GetTexture_Ptr(Material_Metallic));
+                        m_buffer_uber_cpu.mat_textures[3] = texture_table_index(material->GetTexture_Ptr(Material_Normal));
+                        m_buffer_uber_cpu.mat_textures[4] = texture_table_index(material->GetTexture_Ptr(Material_Height));
+                        m_buffer_uber_cpu.mat_textures[5] = texture_table_index(material->GetTexture_Ptr(Material_Occlusion));
+                        m_buffer_uber_cpu.mat_textures[6] = texture_table_index(material->GetTexture_Ptr(Material_Emission));
+                        m_buffer_uber_cpu.mat_textures[7] = texture_table_index(material->GetTexture_Ptr(Material_Mask));
+                    }
+                    else
+                    {
+                        cmd_list->SetTexture(0, material->GetTexture_Ptr(Material_Color));
+                        cmd_list->SetTexture(1, material->GetTexture_Ptr(Material_Roughness));
+                        cmd_list->SetTexture(2, material->GetTexture_Ptr(Material_Metallic));
+                        cmd_list->SetTexture(3, material->GetTexture_Ptr(Material_Normal));
+                        cmd_list->SetTexture(4, material->GetTexture_Ptr(Material_Height));
+                        cmd_list->SetTexture(5, material->GetTexture_Ptr(Material_Occlusion));
+                        cmd_list->SetTexture(6, material->GetTexture_Ptr(Material_Emission));
+                        cmd_list->SetTexture(7, material->GetTexture_Ptr(Material_Mask));
+                    }
                 
                     // Update uber buffer with material properties
                     m_buffer_uber_cpu.mat_id            = static_cast<float>(material_index);
@@ -2156,6 +2186,8 @@ namespace Spartan
         // Update text
         const auto text_pos = Vector2(-m_viewport.width * 0.5f + 5.0f, m_viewport.height * 0.5f - m_font->GetSize() - 2.0f);
         m_font->SetText(m_profiler->GetMetrics(), text_pos);
+        if (!m_font->UpdateBuffers() || m_font->GetDrawRanges().empty())
+            return;
 
         // Draw outline
         if (m_font->GetOutline() != Font_Outline_None && m_font->GetOutlineSize() != 0)
@@ -2170,7 +2202,10 @@ namespace Spartan
                 cmd_list->SetBufferIndex(m_font->GetIndexBuffer());
                 cmd_list->SetBufferVertex(m_font->GetVertexBuffer());
                 cmd_list->SetTexture(30, m_font->GetAtlasOutline());
-                cmd_list->DrawIndexed(m_font->GetIndexCount());
+                for (const Font_DrawRange& range : m_font->GetDrawRanges())
+                {
+                    cmd_list->DrawIndexed(range.index_count, 0, range.vertex_offset);
+                }
                 cmd_list->EndRenderPass();
             }
         }
@@ -2186,7 +2221,10 @@ namespace Spartan
             cmd_list->SetBufferIndex(m_font->GetIndexBuffer());
             cmd_list->SetBufferVertex(m_font->GetVertexBuffer());
             cmd_list->SetTexture(30, m_font->GetAtlas());
-            cmd_list->DrawIndexed(m_font->GetIndexCount());
+            for (const Font_DrawRange& range : m_font->GetDrawRanges())
+            {
+                cmd_list->DrawIndexed(range.index_count, 0, range.vertex_offset);
+            }
             cmd_list->EndRenderPass();
         }
 	}
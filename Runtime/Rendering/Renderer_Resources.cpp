@@ -34,6 +34,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_DepthStencilState.h"
 #include "../RHI/RHI_SwapChain.h"
 #include "../RHI/RHI_CommandList.h"
+#include "../RHI/RHI_TextureTable.h"
+#include "../RHI/RHI_PipelineCache.h"
+#include "../RHI/RHI_ShaderCache.h"
+#include "../RHI/RHI_PipelineState.h"
+#include "../Threading/Threading.h"
 //=======================================
 
 //= NAMESPACES ===============
@@ -113,6 +118,9 @@ namespace Spartan
             return;
         }
 
+        // Pipelines which are being warmed up reference the render targets
+        WaitForPipelineWarmUp();
+
         Flush();
 
         // G-Buffer
@@ -394,6 +402,10 @@ namespace Spartan
 
         m_tex_black_transparent = make_shared<RHI_Texture2D>(m_context, generate_mipmaps);
         m_tex_black_transparent->LoadFromFile(dir_texture + "black_transparent.png");
+        if (IsBindless() && !m_texture_table->SetDefault(m_tex_black_transparent.get()))
+        {
+            LOG_ERROR("Failed to set the default texture of the texture table");
+        }
 
         m_tex_black_opaque = make_shared<RHI_Texture2D>(m_context, generate_mipmaps);
         m_tex_black_opaque->LoadFromFile(dir_texture + "black_opaque.png");
@@ -408,4 +420,137 @@ namespace Spartan
         m_gizmo_tex_light_spot = make_shared<RHI_Texture2D>(m_context, generate_mipmaps);
         m_gizmo_tex_light_spot->LoadFromFile(dir_texture + "flashlight.png");
     }
+
+    void Renderer::WarmUpPipelines()
+    {
+        // A pipeline can only be created once its shaders are compiled
+        for (const auto& [type, shader] : m_shaders)
+        {
+            if (shader->GetCompilationState() == Shader_Compilation_Compiling)
+                return;
+        }
+        m_pipelines_warm_up_started = true;
+
+        // The initial shaders are compiled, so this is when the shader cache has something to report
+        m_shader_cache->LogStatistics();
+
+        // Describe what the renderer owns, the manifest is resolved against it
+        vector<pair<vector<string>, RHI_Shader*>> shaders;
+        {
+            auto add_shader = [&shaders](RHI_Shader* shader)
+            {
+                if (shader->IsCompiled())
+                {
+                    shaders.emplace_back(RHI_PipelineDescription::Describe(shader), shader);
+                }
+            };
+
+            for (const auto& [type, shader] : m_shaders)            { add_shader(shader.get()); }
+            for (const auto& [flags, shader] : ShaderGBuffer::GetVariations()) { add_shader(shader.get()); }
+            for (const auto& [flags, shader] : ShaderLight::GetVariations())   { add_shader(shader.get()); }
+        }
+
+        vector<pair<vector<uint32_t>, RHI_RasterizerState*>> rasterizer_states;
+        for (const auto& state : { m_rasterizer_cull_back_solid, m_rasterizer_cull_back_solid_no_clip, m_rasterizer_cull_front_solid, m_rasterizer_cull_none_solid, m_rasterizer_cull_back_wireframe, m_rasterizer_cull_front_wireframe, m_rasterizer_cull_none_wireframe })
+        {
+            rasterizer_states.emplace_back(RHI_PipelineDescription::Describe(state.get()), state.get());
+        }
+
+        vector<pair<vector<uint32_t>, RHI_BlendState*>> blend_states;
+        for (const auto& state : { m_blend_disabled, m_blend_alpha, m_blend_additive })
+        {
+            blend_states.emplace_back(RHI_PipelineDescription::Describe(state.get()), state.get());
+        }
+
+        vector<pair<vector<uint32_t>, RHI_DepthStencilState*>> depth_stencil_states;
+        for (const auto& state : { m_depth_stencil_off_off, m_depth_stencil_off_on_r, m_depth_stencil_on_off_w, m_depth_stencil_on_off_r, m_depth_stencil_on_on_w })
+        {
+            depth_stencil_states.emplace_back(RHI_PipelineDescription::Describe(state.get()), state.get());
+        }
+
+        vector<RHI_Texture*> render_targets;
+        for (const auto& [type, texture] : m_render_targets) { render_targets.emplace_back(texture.get()); }
+        for (const auto& texture : m_render_tex_bloom)      { render_targets.emplace_back(texture.get()); }
+
+        auto find = [](const auto& candidates, const auto& description) -> decltype(candidates.front().second)
+        {
+            for (const auto& [candidate_description, candidate] : candidates)
+            {
+                if (candidate_description == description)
+                    return candidate;
+            }
+
+            return nullptr;
+        };
+
+        auto find_render_target = [&render_targets](const RHI_PipelineDescription& description, const string& name, const uint32_t format) -> RHI_Texture*
+        {
+            for (RHI_Texture* texture : render_targets)
+            {
+                if (texture->GetName() == name && static_cast<uint32_t>(texture->GetFormat()) == format && texture->GetWidth() == description.render_target_width && texture->GetHeight() == description.render_target_height)
+                    return texture;
+            }
+
+            return nullptr;
+        };
+
+        // Descriptions which refer to anything else (e.g. the shadow maps of lights) are dropped
+        vector<RHI_PipelineState> pipeline_states;
+        for (const RHI_PipelineDescription& description : m_pipeline_cache->GetManifest())
+        {
+            RHI_PipelineState pipeline_state;
+            description.Apply(pipeline_state);
+
+            pipeline_state.shader_vertex        = find(shaders, description.shader_vertex);
+            pipeline_state.shader_pixel         = description.shader_pixel.empty() ? nullptr : find(shaders, description.shader_pixel);
+            pipeline_state.rasterizer_state     = find(rasterizer_states, description.rasterizer_state);
+            pipeline_state.blend_state          = find(blend_states, description.blend_state);
+            pipeline_state.depth_stencil_state  = find(depth_stencil_states, description.depth_stencil_state);
+            bool resolved = pipeline_state.shader_vertex && (description.shader_pixel.empty() || pipeline_state.shader_pixel) && pipeline_state.rasterizer_state && pipeline_state.blend_state && pipeline_state.depth_stencil_state;
+
+            pipeline_state.render_target_swapchain = description.render_target_swapchain ? m_swap_chain.get() : nullptr;
+            for (uint32_t i = 0; i < state_max_render_target_count; i++)
+            {
+                if (!description.render_target_color_names[i].empty())
+                {
+                    pipeline_state.render_target_color_textures[i] = find_render_target(description, description.render_target_color_names[i], description.render_target_color_formats[i]);
+                    resolved = resolved && pipeline_state.render_target_color_textures[i];
+                }
+            }
+
+            if (!description.render_target_depth_name.empty())
+            {
+                pipeline_state.render_target_depth_texture = find_render_target(description, description.render_target_depth_name, description.render_target_depth_format);
+                resolved = resolved && pipeline_state.render_target_depth_texture;
+            }
+
+            if (resolved)
+            {
+                pipeline_states.emplace_back(pipeline_state);
+            }
+        }
+
+        if (pipeline_states.empty())
+            return;
+
+        // Created in the background, a draw which needs one of them in the meantime waits for it rather than creating it again
+        m_pipelines_warming = true;
+        m_context->GetSubsystem<Threading>()->AddTask([this, pipeline_states = move(pipeline_states)]() mutable
+        {
+            void* descriptor_set_layout_texture_table = IsBindless() ? m_texture_table->GetResource_DescriptorSetLayout() : nullptr;
+            m_pipeline_cache->WarmUp(pipeline_states, descriptor_set_layout_texture_table);
+
+            {
+                lock_guard<mutex> lock(m_pipelines_warming_mutex);
+                m_pipelines_warming = false;
+            }
+            m_pipelines_warming_condition.notify_all();
+        });
+    }
+
+    void Renderer::WaitForPipelineWarmUp()
+    {
+        unique_lock<mutex> lock(m_pipelines_warming_mutex);
+        m_pipelines_warming_condition.wait(lock, [this] { return !m_pipelines_warming; });
+    }
 }
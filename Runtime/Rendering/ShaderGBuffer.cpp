@@ -22,7 +22,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =========================
 #include "ShaderGBuffer.h"
 #include "Material.h"
+#include "Renderer.h"
 #include "../Resource/ResourceCache.h"
+#include "../RHI/RHI_TextureTable.h"
 //====================================
 
 //= NAMESPACES =====
@@ -65,6 +67,7 @@ namespace Spartan
         shader->AddDefine("OCCLUSION_MAP",  (flags & Material_Occlusion)  ? "1" : "0");
         shader->AddDefine("EMISSION_MAP",   (flags & Material_Emission)   ? "1" : "0");
         shader->AddDefine("MASK_MAP",       (flags & Material_Mask)       ? "1" : "0");
+        shader->AddDefine("BINDLESS",       context->GetSubsystem<Renderer>()->IsBindless() ? "1" : "0");
 
         // Compile
         shader->CompileAsync(RHI_Shader_Pixel, file_path);
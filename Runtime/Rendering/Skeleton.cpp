@@ -0,0 +1,130 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============
+#include "Skeleton.h"
+#include "../IO/FileStream.h"
+#include "../Logging/Log.h"
+//==========================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    uint32_t Skeleton::AddJoint(const string& name, const int32_t parent, const Matrix& local)
+    {
+        const auto index = static_cast<uint32_t>(m_names.size());
+
+        m_names.emplace_back(name);
+        m_parents.emplace_back(parent);
+        m_bind_translations.emplace_back(local.GetTranslation());
+        m_bind_rotations.emplace_back(local.GetRotation());
+        m_bind_scales.emplace_back(local.GetScale());
+        m_joint_lookup[name] = index;
+
+        return index;
+    }
+
+    int32_t Skeleton::AddBone(const uint32_t joint, const Matrix& offset)
+    {
+        // Already a bone (meshes which share the skeleton list the same bones)
+        const int32_t existing = GetBoneIndex(joint);
+        if (existing != -1)
+            return existing;
+
+        if (GetBoneCount() >= skeleton_max_bones)
+        {
+            LOG_WARNING("Bone \"%s\" exceeds the maximum of %d bones, it will be ignored", m_names[joint].c_str(), skeleton_max_bones);
+            return -1;
+        }
+
+        m_bone_joints.emplace_back(joint);
+        m_bone_offsets.emplace_back(offset);
+
+        return static_cast<int32_t>(m_bone_joints.size() - 1);
+    }
+
+    int32_t Skeleton::GetJointIndex(const string& name) const
+    {
+        const auto it = m_joint_lookup.find(name);
+        return it != m_joint_lookup.end() ? static_cast<int32_t>(it->second) : -1;
+    }
+
+    int32_t Skeleton::GetBoneIndex(const uint32_t joint) const
+    {
+        for (uint32_t i = 0; i < GetBoneCount(); i++)
+        {
+            if (m_bone_joints[i] == joint)
+                return static_cast<int32_t>(i);
+        }
+
+        return -1;
+    }
+
+    void Skeleton::Serialize(FileStream* stream) const
+    {
+        const uint32_t joint_count = GetJointCount();
+        stream->Write(joint_count);
+        for (uint32_t i = 0; i < joint_count; i++)
+        {
+            stream->Write(m_names[i]);
+        }
+        stream->WriteSpan(m_parents.data(), joint_count);
+        stream->WriteSpan(m_bind_translations.data(), joint_count);
+        stream->WriteSpan(m_bind_rotations.data(), joint_count);
+        stream->WriteSpan(m_bind_scales.data(), joint_count);
+
+        const uint32_t bone_count = GetBoneCount();
+        stream->Write(bone_count);
+        stream->WriteSpan(m_bone_joints.data(), bone_count);
+        stream->WriteSpan(m_bone_offsets.data(), bone_count);
+    }
+
+    void Skeleton::Deserialize(FileStream* stream)
+    {
+        const auto joint_count = stream->ReadAs<uint32_t>();
+        m_names.resize(joint_count);
+        m_joint_lookup.clear();
+        for (uint32_t i = 0; i < joint_count; i++)
+        {
+            stream->Read(&m_names[i]);
+            m_joint_lookup[m_names[i]] = i;
+        }
+
+        m_parents.resize(joint_count);
+        m_bind_translations.resize(joint_count);
+        m_bind_rotations.resize(joint_count);
+        m_bind_scales.resize(joint_count);
+        stream->ReadSpan(m_parents.data(), joint_count);
+        stream->ReadSpan(m_bind_translations.data(), joint_count);
+        stream->ReadSpan(m_bind_rotations.data(), joint_count);
+        stream->ReadSpan(m_bind_scales.data(), joint_count);
+
+        const auto bone_count = stream->ReadAs<uint32_t>();
+        m_bone_joints.resize(bone_count);
+        m_bone_offsets.resize(bone_count);
+        stream->ReadSpan(m_bone_joints.data(), bone_count);
+        stream->ReadSpan(m_bone_offsets.data(), bone_count);
+    }
+}
@@ -0,0 +1,80 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../Core/EngineDefs.h"
+#include "../Math/Matrix.h"
+//=============================
+
+namespace Spartan
+{
+    class FileStream;
+
+    // Must not be higher than the palette size of the skinning shader
+    static const uint32_t skeleton_max_bones = 64;
+
+    // A hierarchy of joints, stored as SoA with parents always preceding their children.
+    // Bones are the joints which deform vertices, their order defines the skinning palette.
+    class SPARTAN_CLASS Skeleton
+    {
+    public:
+        Skeleton() = default;
+        ~Skeleton() = default;
+
+        // Joints have to be added parents first, returns the index of the joint
+        uint32_t AddJoint(const std::string& name, int32_t parent, const Math::Matrix& local);
+        // Marks a joint as a bone, returns the index of the bone in the skinning palette (or -1 if the palette is full)
+        int32_t AddBone(uint32_t joint, const Math::Matrix& offset);
+        int32_t GetJointIndex(const std::string& name) const;
+        int32_t GetBoneIndex(uint32_t joint) const;
+
+        uint32_t GetJointCount()            const { return static_cast<uint32_t>(m_names.size()); }
+        uint32_t GetBoneCount()             const { return static_cast<uint32_t>(m_bone_joints.size()); }
+        const auto& GetNames()              const { return m_names; }
+        const auto& GetParents()            const { return m_parents; }
+        const auto& GetBindTranslations()   const { return m_bind_translations; }
+        const auto& GetBindRotations()      const { return m_bind_rotations; }
+        const auto& GetBindScales()         const { return m_bind_scales; }
+        const auto& GetBoneJoints()         const { return m_bone_joints; }
+        const auto& GetBoneOffsets()        const { return m_bone_offsets; }
+
+        void Serialize(FileStream* stream) const;
+        void Deserialize(FileStream* stream);
+
+    private:
+        // Joints
+        std::vector<std::string> m_names;
+        std::vector<int32_t> m_parents;
+        std::vector<Math::Vector3> m_bind_translations;
+        std::vector<Math::Quaternion> m_bind_rotations;
+        std::vector<Math::Vector3> m_bind_scales;
+        std::unordered_map<std::string, uint32_t> m_joint_lookup;
+
+        // Bones
+        std::vector<uint32_t> m_bone_joints;
+        std::vector<Math::Matrix> m_bone_offsets; // model space to bone space (the inverse bind pose)
+    };
+}
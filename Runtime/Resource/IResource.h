@@ -63,7 +63,7 @@ namespace Spartan
 
 		void SetResourceFilePath(const std::string& path)
         {
-            const bool is_native_file = FileSystem::IsEngineMaterialFile(path) || FileSystem::IsEngineModelFile(path);
+            const bool is_native_file = FileSystem::IsEngineMaterialFile(path) || FileSystem::IsEngineModelFile(path) || FileSystem::IsEngineAnimationFile(path);
 
             // If this is an native engine file, don't do a file check as no actual foreign material exists (it was created on the fly)
             if (!is_native_file)
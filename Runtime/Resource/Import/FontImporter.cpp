@@ -20,10 +20,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 //= INCLUDES =========================
+#include <fstream>
 #include "FontImporter.h"
-#include "freetype/ftstroke.h"
+#include "freetype/ftoutln.h"
 #include "../../Core/Settings.h"
-#include "../../RHI/RHI_Texture2D.h"
+#include "../../Core/FileSystem.h"
+#include "../../IO/FileStream.h"
+#include "../../Threading/Threading.h"
+#include "../../Utilities/Hash.h"
 #include "../../Rendering/Font/Font.h"
 //====================================
 
@@ -34,33 +38,47 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-	// Properties of the texture font atlas which holds all visible ASCII characters
-	static const uint32_t GLYPH_START	= 32;
-	static const uint32_t GLYPH_END		= 127;
-	static const uint32_t ATLAS_WIDTH	= 512;
-
-    static FT_UInt32 g_glyph_load_flags = 0;
+	// Properties of the signed distance field atlas which holds all visible ASCII characters
+	static const uint32_t GLYPH_START	    = 32;
+	static const uint32_t GLYPH_END		    = 127;
+	static const uint32_t ATLAS_WIDTH	    = 512;
+    static const uint32_t SDF_GLYPH_SIZE    = 48;   // pixel size the field is generated at, it scales to any text size
+    static const uint32_t SDF_SPREAD        = 6;    // distance (in pixels) the field extends to on each side of an edge
+    static const uint32_t SDF_GLYPH_GAP     = 1;
+    static const uint32_t SDF_CURVE_STEPS   = 8;    // line segments per curve
+    static const uint32_t SDF_CACHE_VERSION = 1;
+
+    namespace sdf_helper
+    {
+        struct segment
+        {
+            float x0;
+            float y0;
+            float x1;
+            float y1;
+        };
 
-    // FreeType questionable design, but it's free, so we just write this namespace and forget about it
-	namespace ft_helper
-	{
-        struct ft_bitmap
+        struct glyph_outline
         {
-            ~ft_bitmap()
-            {
-                if (buffer)
-                {
-                    delete buffer;
-                    buffer = nullptr;
-                }
-            }
+            uint32_t char_code  = 0;
+            uint32_t atlas_x    = 0;
+            uint32_t atlas_y    = 0;
+            Glyph glyph;
+            vector<segment> segments;
+        };
 
-            uint32_t width              = 0;
-            uint32_t height             = 0;
-            unsigned char pixel_mode    = 0;
-            unsigned char* buffer       = nullptr;
+        struct atlas
+        {
+            uint32_t width  = 0;
+            uint32_t height = 0;
+            vector<Glyph> glyphs; // starting from GLYPH_START
+            vector<std::byte> data;
         };
+    }
 
+    // FreeType questionable design, but it's free, so we just write this namespace and forget about it
+	namespace ft_helper
+	{
 		inline bool handle_error(int error_code)
 		{
 			if (error_code == FT_Err_Ok)
@@ -177,201 +195,335 @@ namespace Spartan
 			return false;
 		}
 
-        inline FT_UInt32 get_load_flags(const Font* font)
+        // Collects the contours of an outline as line segments, curves are flattened
+        struct outline_decomposer
         {
-            FT_UInt32 flags = FT_LOAD_DEFAULT | FT_LOAD_RENDER;
-
-            flags |= font->GetForceAutohint() ? FT_LOAD_FORCE_AUTOHINT : 0;
+            vector<sdf_helper::segment>* segments = nullptr;
+            float x = 0.0f;
+            float y = 0.0f;
 
-            switch (font->GetHinting())
+            void add(const float to_x, const float to_y)
             {
-            case Font_Hinting_None:
-                flags |= FT_LOAD_NO_HINTING;
-                break;
-            case Font_Hinting_Light:
-                flags |= FT_LOAD_TARGET_LIGHT;
-                break;
-            default: // Hinting_Normal
-                flags |= FT_LOAD_TARGET_NORMAL;
-                break;
+                segments->push_back({ x, y, to_x, to_y });
+                x = to_x;
+                y = to_y;
             }
+        };
 
-            return flags;
+        inline int move_to(const FT_Vector* to, void* user)
+        {
+            auto decomposer = static_cast<outline_decomposer*>(user);
+            decomposer->x   = to->x / 64.0f;
+            decomposer->y   = to->y / 64.0f;
+            return 0;
         }
 
-        inline bool load_glyph(const FT_Face& face, const uint32_t char_code, const uint32_t flags = g_glyph_load_flags)
+        inline int line_to(const FT_Vector* to, void* user)
         {
-            return ft_helper::handle_error(FT_Load_Char(face, char_code, flags));
+            static_cast<outline_decomposer*>(user)->add(to->x / 64.0f, to->y / 64.0f);
+            return 0;
         }
 
-		inline void get_character_max_dimensions(uint32_t* max_width, uint32_t* max_height, FT_Face& face, const uint32_t outline_size)
-		{
-            uint32_t width  = 0;
-            uint32_t height = 0;
-
-            for (uint32_t char_code = GLYPH_START; char_code < GLYPH_END; char_code++)
+        inline int conic_to(const FT_Vector* control, const FT_Vector* to, void* user)
+        {
+            auto decomposer     = static_cast<outline_decomposer*>(user);
+            const float x0      = decomposer->x;
+            const float y0      = decomposer->y;
+            const float x1      = control->x / 64.0f;
+            const float y1      = control->y / 64.0f;
+            const float x2      = to->x / 64.0f;
+            const float y2      = to->y / 64.0f;
+
+            for (uint32_t i = 1; i <= SDF_CURVE_STEPS; i++)
             {
-                if (!load_glyph(face, char_code))
-                    continue;
+                const float t = static_cast<float>(i) / static_cast<float>(SDF_CURVE_STEPS);
+                const float u = 1.0f - t;
+                decomposer->add(u * u * x0 + 2.0f * u * t * x1 + t * t * x2, u * u * y0 + 2.0f * u * t * y1 + t * t * y2);
+            }
 
-                FT_Bitmap* bitmap   = &face->glyph->bitmap;
-                width               = Helper::Max<uint32_t>(width,  bitmap->width);
-				height			    = Helper::Max<uint32_t>(height, bitmap->rows);
-			}
+            return 0;
+        }
 
-            *max_width  = width  + outline_size * 2;
-			*max_height = height + outline_size * 2;
-		}
+        inline int cubic_to(const FT_Vector* control_a, const FT_Vector* control_b, const FT_Vector* to, void* user)
+        {
+            auto decomposer     = static_cast<outline_decomposer*>(user);
+            const float x0      = decomposer->x;
+            const float y0      = decomposer->y;
+            const float x1      = control_a->x / 64.0f;
+            const float y1      = control_a->y / 64.0f;
+            const float x2      = control_b->x / 64.0f;
+            const float y2      = control_b->y / 64.0f;
+            const float x3      = to->x / 64.0f;
+            const float y3      = to->y / 64.0f;
+
+            for (uint32_t i = 1; i <= SDF_CURVE_STEPS; i++)
+            {
+                const float t = static_cast<float>(i) / static_cast<float>(SDF_CURVE_STEPS);
+                const float u = 1.0f - t;
+                decomposer->add
+                (
+                    u * u * u * x0 + 3.0f * u * u * t * x1 + 3.0f * u * t * t * x2 + t * t * t * x3,
+                    u * u * u * y0 + 3.0f * u * u * t * y1 + 3.0f * u * t * t * y2 + t * t * t * y3
+                );
+            }
 
-		inline void get_texture_atlas_dimensions(uint32_t* atlas_width, uint32_t* atlas_height, uint32_t* atlas_cell_width, uint32_t* atlas_cell_height, FT_Face& face, const uint32_t outline_size)
-		{
-            uint32_t max_width  = 0;
-            uint32_t max_height = 0;
-			get_character_max_dimensions(&max_width, &max_height, face, outline_size);
-
-            uint32_t glyph_count    = GLYPH_END - GLYPH_START;
-            uint32_t glyphs_per_row = ATLAS_WIDTH / max_width;
-            uint32_t row_count      = static_cast<uint32_t>(Helper::Ceil(float(glyph_count) / float(glyphs_per_row)));
-
-            *atlas_width        = ATLAS_WIDTH;
-            *atlas_height       = max_height * row_count;
-            *atlas_cell_width   = max_width;
-            *atlas_cell_height  = max_height;
-		}
+            return 0;
+        }
 
-        inline void get_bitmap(ft_bitmap* bitmap, const Font* font, const FT_Stroker& stroker, FT_Face& ft_font, const uint32_t char_code)
+        // Loads a glyph's outline (unhinted, so that it holds for every size) and its metrics, FreeType isn't thread safe so this runs serially
+        inline bool load_glyph_outline(const FT_Face& ft_font, const uint32_t char_code, sdf_helper::glyph_outline* outline)
         {
-            // Load glyph
-            if (!load_glyph(ft_font, char_code, stroker ? FT_LOAD_NO_BITMAP : g_glyph_load_flags))
-                return;
+            if (!handle_error(FT_Load_Char(ft_font, char_code, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING)))
+                return false;
 
-            FT_Bitmap* bitmap_temp = nullptr; // will deallocate it's buffer the moment will load another glyph
+            outline->char_code                  = char_code;
+            FT_Glyph_Metrics& metrics           = ft_font->glyph->metrics;
+            outline->glyph.horizontal_advance   = metrics.horiAdvance >> 6;
 
-            // Get bitmap
-            if (!stroker)
+            // Kerning is the process of adjusting the position of two subsequent glyph images 
+            // in a string of text in order to improve the general appearance of text. 
+            // For example, if a glyph for an uppercase ‘A’ is followed by a glyph for an 
+            // uppercase ‘V’, the space between the two glyphs can be slightly reduced to 
+            // avoid extra ‘diagonal whitespace’.
+            if (char_code >= 1 && FT_HAS_KERNING(ft_font))
             {
-                bitmap_temp = &ft_font->glyph->bitmap;
+            	FT_Vector kerningVec;
+            	FT_Get_Kerning(ft_font, char_code - 1, char_code, FT_KERNING_DEFAULT, &kerningVec);
+            	outline->glyph.horizontal_advance += kerningVec.x >> 6;
             }
-            else
+
+            // Whitespace characters have nothing to draw
+            if (ft_font->glyph->format != FT_GLYPH_FORMAT_OUTLINE || ft_font->glyph->outline.n_contours == 0)
+                return true;
+
+            FT_Outline_Funcs funcs  = {};
+            funcs.move_to           = move_to;
+            funcs.line_to           = line_to;
+            funcs.conic_to          = conic_to;
+            funcs.cubic_to          = cubic_to;
+
+            // Contours are closed by FreeType, so the segments form closed loops
+            outline_decomposer decomposer;
+            decomposer.segments = &outline->segments;
+            FT_Outline* ft_outline = &ft_font->glyph->outline;
+            if (!handle_error(FT_Outline_Decompose(ft_outline, &funcs, &decomposer)))
+                return false;
+
+            if (outline->segments.empty())
+                return true;
+
+            FT_BBox box;
+            FT_Outline_Get_CBox(ft_outline, &box);
+            const int32_t x_min     = static_cast<int32_t>(floor(box.xMin / 64.0f));
+            const int32_t y_max     = static_cast<int32_t>(ceil(box.yMax / 64.0f));
+            const int32_t x_max     = static_cast<int32_t>(ceil(box.xMax / 64.0f));
+            const int32_t y_min     = static_cast<int32_t>(floor(box.yMin / 64.0f));
+
+            // The field extends past the outline by the spread, so that edges can be smoothed and outlined
+            outline->glyph.offset_x = x_min - static_cast<int32_t>(SDF_SPREAD);
+            outline->glyph.offset_y = y_max + static_cast<int32_t>(SDF_SPREAD);
+            outline->glyph.width    = static_cast<uint32_t>(x_max - x_min) + SDF_SPREAD * 2;
+            outline->glyph.height   = static_cast<uint32_t>(y_max - y_min) + SDF_SPREAD * 2;
+
+            return true;
+        }
+	}
+
+    namespace sdf_helper
+    {
+        // Signed distance from a point to the closest edge, positive inside the glyph (non-zero winding rule, as TrueType)
+        inline float get_distance(const vector<segment>& segments, const float x, const float y)
+        {
+            float distance_squared  = numeric_limits<float>::max();
+            int32_t winding         = 0;
+
+            for (const segment& s : segments)
             {
-                if (ft_font->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+                const float edge_x  = s.x1 - s.x0;
+                const float edge_y  = s.y1 - s.y0;
+                const float to_x    = x - s.x0;
+                const float to_y    = y - s.y0;
+
+                const float length_squared  = edge_x * edge_x + edge_y * edge_y;
+                const float t               = length_squared > 0.0f ? Helper::Clamp((to_x * edge_x + to_y * edge_y) / length_squared, 0.0f, 1.0f) : 0.0f;
+                const float delta_x         = to_x - edge_x * t;
+                const float delta_y         = to_y - edge_y * t;
+                distance_squared            = Helper::Min(distance_squared, delta_x * delta_x + delta_y * delta_y);
+
+                // Count the crossings of a ray towards +x
+                const float side = edge_x * to_y - edge_y * to_x;
+                if (s.y0 <= y)
                 {
-                    FT_Glyph glyph;
-                    if (handle_error(FT_Get_Glyph(ft_font->glyph, &glyph)))
-                    {
-                        bool stroked = false;
-
-                        if (font->GetOutline() == Font_Outline_Edge)
-                        {
-                            stroked = handle_error(FT_Glyph_Stroke(&glyph, stroker, true));
-                        }
-                        else if (font->GetOutline() == Font_Outline_Positive)
-                        {
-                            stroked = handle_error(FT_Glyph_StrokeBorder(&glyph, stroker, false, true));
-                        }
-                        else if (font->GetOutline() == Font_Outline_Negative)
-                        {
-                            stroked = handle_error(FT_Glyph_StrokeBorder(&glyph, stroker, true, true));
-                        }
-
-                        if (stroked)
-                        {
-                            if (handle_error(FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, nullptr, true)))
-                            {
-                                bitmap_temp = &reinterpret_cast<FT_BitmapGlyph>(glyph)->bitmap;
-                            }
-                        }
-                    }
+                    winding += (s.y1 > y && side > 0.0f) ? 1 : 0;
                 }
                 else
                 {
-                    LOG_ERROR("Can't apply outline as the glyph doesn't have an outline format");
-                    bitmap_temp = &ft_font->glyph->bitmap;
+                    winding -= (s.y1 <= y && side < 0.0f) ? 1 : 0;
                 }
             }
 
-            // Copy bitmap
-            if (bitmap_temp && bitmap_temp->buffer)
-            { 
-                bitmap->width        = bitmap_temp->width;
-                bitmap->height       = bitmap_temp->rows;
-                bitmap->pixel_mode   = bitmap_temp->pixel_mode;
-                bitmap->buffer       = new unsigned char[bitmap->width * bitmap->height];
-                memcpy(bitmap->buffer, bitmap_temp->buffer, bitmap->width * bitmap->height);
-            }
+            const float distance = sqrt(distance_squared);
+            return winding != 0 ? distance : -distance;
         }
 
-        inline void copy_to_atlas(vector<std::byte>& atlas, const ft_bitmap& bitmap, const Vector2& pen, const uint32_t atlas_width, const uint32_t outline_size)
+        // Writes the distance field of a glyph into its (exclusive) region of the atlas
+        inline void write_distance_field(vector<std::byte>& atlas, const uint32_t atlas_width, const glyph_outline& outline)
         {
-            for (uint32_t glyph_y = 0; glyph_y < bitmap.height; glyph_y++)
+            const float left    = static_cast<float>(outline.glyph.offset_x);
+            const float top     = static_cast<float>(outline.glyph.offset_y);
+            const float scale   = 1.0f / static_cast<float>(SDF_SPREAD * 2);
+
+            for (uint32_t y = 0; y < outline.glyph.height; y++)
             {
-                for (uint32_t glyph_x = 0; glyph_x < bitmap.width; glyph_x++)
+                for (uint32_t x = 0; x < outline.glyph.width; x++)
                 {
-                    // Compute 
-                    uint32_t atlas_x = static_cast<uint32_t>(pen.x + glyph_x);
-                    uint32_t atlas_y = static_cast<uint32_t>(pen.y + glyph_y);
-
-                    // In case there is an outline, the text has to offset away from the outline's edge
-                    atlas_x += outline_size;
-                    atlas_y += outline_size;
+                    // Sample at texel centers, rows go top to bottom while the outline's y goes up
+                    const float distance    = get_distance(outline.segments, left + x + 0.5f, top - y - 0.5f);
+                    const float value       = Helper::Saturate(0.5f + distance * scale);
 
-                    // Ensure we are not doing any wrong math
-                    const uint32_t atlas_pos = atlas_x + atlas_y * atlas_width;
+                    const uint32_t atlas_pos = (outline.atlas_x + x) + (outline.atlas_y + y) * atlas_width;
                     SPARTAN_ASSERT(atlas.size() > atlas_pos);
+                    atlas[atlas_pos] = static_cast<std::byte>(static_cast<uint8_t>(value * 255.0f + 0.5f));
+                }
+            }
+        }
 
-                    switch (bitmap.pixel_mode)
-                    {
-                    case FT_PIXEL_MODE_MONO: {
-                        // implement if it's ever needed
-                    } break;
-
-                    case FT_PIXEL_MODE_GRAY: {
-                        atlas[atlas_pos] = static_cast<std::byte>(bitmap.buffer[glyph_x + glyph_y * bitmap.width]);
-                    } break;
+        // Places the glyphs in rows, returns the atlas height
+        inline uint32_t pack(vector<glyph_outline>& outlines)
+        {
+            uint32_t pen_x      = 0;
+            uint32_t pen_y      = 0;
+            uint32_t row_height = 0;
 
-                    case FT_PIXEL_MODE_BGRA: {
-                        // implement if it's ever needed
-                    } break;
+            for (glyph_outline& outline : outlines)
+            {
+                if (outline.segments.empty())
+                    continue;
 
-                    default:
-                        LOG_ERROR("Font uses unsupported pixel format");
-                        break;
-                    }
+                // Advance row
+                if (pen_x + outline.glyph.width > ATLAS_WIDTH)
+                {
+                    pen_x       = 0;
+                    pen_y       += row_height + SDF_GLYPH_GAP;
+                    row_height  = 0;
                 }
+
+                outline.atlas_x = pen_x;
+                outline.atlas_y = pen_y;
+                pen_x           += outline.glyph.width + SDF_GLYPH_GAP;
+                row_height      = Helper::Max(row_height, outline.glyph.height);
             }
+
+            return pen_y + row_height;
         }
 
-        inline Glyph get_glyph(const FT_Face& ft_font, const uint32_t char_code, const Vector2& pen, const uint32_t atlas_width, const uint32_t atlas_height, const uint32_t outline_size)
+        // Stable across runs, the atlas depends on the font file and the generation parameters only (not the font's size)
+        inline uint64_t get_cache_key(const string& file_path)
         {
-            // The glyph metrics refer to whatever the last loaded glyph was, this is up to the caller of the function
-            FT_Glyph_Metrics& metrics = ft_font->glyph->metrics; 
-
-            Glyph glyph                 = {};
-            glyph.offset_x              = metrics.horiBearingX >> 6;
-            glyph.offset_y              = metrics.horiBearingY >> 6;
-            glyph.width                 = (metrics.width >> 6) + outline_size * 2;
-            glyph.height                = (metrics.height >> 6) + outline_size * 2;
-            glyph.horizontal_advance    = metrics.horiAdvance >> 6;
-            glyph.uv_x_left             = static_cast<float>(pen.x)                 / static_cast<float>(atlas_width);
-            glyph.uv_x_right            = static_cast<float>(pen.x + glyph.width)   / static_cast<float>(atlas_width);
-            glyph.uv_y_top              = static_cast<float>(pen.y)                 / static_cast<float>(atlas_height);
-            glyph.uv_y_bottom           = static_cast<float>(pen.y + glyph.height)  / static_cast<float>(atlas_height);
+            ifstream file(file_path, ios::binary);
+            const string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
 
-            // Kerning is the process of adjusting the position of two subsequent glyph images 
-            // in a string of text in order to improve the general appearance of text. 
-            // For example, if a glyph for an uppercase ‘A’ is followed by a glyph for an 
-            // uppercase ‘V’, the space between the two glyphs can be slightly reduced to 
-            // avoid extra ‘diagonal whitespace’.
-            if (char_code >= 1 && FT_HAS_KERNING(ft_font))
+            const uint32_t parameters[] = { SDF_CACHE_VERSION, GLYPH_START, GLYPH_END, ATLAS_WIDTH, SDF_GLYPH_SIZE, SDF_SPREAD, SDF_CURVE_STEPS };
+            const uint64_t key = Utility::Hash::fnv1a(parameters, sizeof(parameters));
+            return Utility::Hash::fnv1a(data.data(), data.size(), key);
+        }
+
+        inline bool load_atlas(atlas* atlas, const string& cache_file_path)
+        {
+            if (!FileSystem::Exists(cache_file_path))
+                return false;
+
+            auto file = make_unique<FileStream>(cache_file_path, FileStream_Read | FileStream_Checksum);
+            if (!file->IsOpen())
+                return false;
+
+            if (file->ReadAs<uint32_t>() != SDF_CACHE_VERSION)
+                return false;
+
+            atlas->width                = file->ReadAs<uint32_t>();
+            atlas->height               = file->ReadAs<uint32_t>();
+            const uint32_t glyph_count  = file->ReadAs<uint32_t>();
+            if (glyph_count != GLYPH_END - GLYPH_START)
+                return false;
+
+            atlas->glyphs.resize(glyph_count);
+            file->ReadSpan(atlas->glyphs.data(), glyph_count);
+            file->Read(&atlas->data);
+
+            return atlas->data.size() == static_cast<size_t>(atlas->width) * atlas->height;
+        }
+
+        inline void save_atlas(const atlas& atlas, const string& cache_file_path)
+        {
+            auto file = make_unique<FileStream>(cache_file_path, FileStream_Write | FileStream_Checksum);
+            if (!file->IsOpen())
+                return;
+
+            file->Write(SDF_CACHE_VERSION);
+            file->Write(atlas.width);
+            file->Write(atlas.height);
+            file->Write(static_cast<uint32_t>(atlas.glyphs.size()));
+            file->WriteSpan(atlas.glyphs.data(), atlas.glyphs.size());
+            file->Write(atlas.data);
+        }
+
+        inline bool generate_atlas(atlas* atlas, FT_Library library, Threading* threading, const string& file_path)
+        {
+            // Load font (called face)
+            FT_Face ft_font = nullptr;
+            if (!ft_helper::handle_error(FT_New_Face(library, file_path.c_str(), 0, &ft_font)))
             {
-            	FT_Vector kerningVec;
-            	FT_Get_Kerning(ft_font, char_code - 1, char_code, FT_KERNING_DEFAULT, &kerningVec);
-            	glyph.horizontal_advance += kerningVec.x >> 6;
+                ft_helper::handle_error(FT_Done_Face(ft_font));
+                return false;
             }
 
-            return glyph;
+            // Set the size the field is generated at
+            if (!ft_helper::handle_error(FT_Set_Pixel_Sizes(ft_font, 0, SDF_GLYPH_SIZE)))
+            {
+                ft_helper::handle_error(FT_Done_Face(ft_font));
+                return false;
+            }
+
+            // Go through each glyph
+            vector<glyph_outline> outlines(GLYPH_END - GLYPH_START);
+            for (uint32_t char_code = GLYPH_START; char_code < GLYPH_END; char_code++)
+            {
+                ft_helper::load_glyph_outline(ft_font, char_code, &outlines[char_code - GLYPH_START]);
+            }
+
+            // Free face
+            ft_helper::handle_error(FT_Done_Face(ft_font));
+
+            atlas->width    = ATLAS_WIDTH;
+            atlas->height   = pack(outlines);
+            atlas->data.resize(static_cast<size_t>(atlas->width) * atlas->height);
+
+            // Compute the distance fields, each glyph writes to its own region of the atlas
+            threading->AddTaskLoop([atlas, &outlines](uint32_t start, uint32_t end)
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    if (!outlines[i].segments.empty())
+                    {
+                        write_distance_field(atlas->data, atlas->width, outlines[i]);
+                    }
+                }
+            }, static_cast<uint32_t>(outlines.size()));
+
+            atlas->glyphs.resize(outlines.size());
+            for (size_t i = 0; i < outlines.size(); i++)
+            {
+                Glyph& glyph        = outlines[i].glyph;
+                glyph.uv_x_left     = static_cast<float>(outlines[i].atlas_x)                   / static_cast<float>(atlas->width);
+                glyph.uv_x_right    = static_cast<float>(outlines[i].atlas_x + glyph.width)     / static_cast<float>(atlas->width);
+                glyph.uv_y_top      = static_cast<float>(outlines[i].atlas_y)                   / static_cast<float>(atlas->height);
+                glyph.uv_y_bottom   = static_cast<float>(outlines[i].atlas_y + glyph.height)    / static_cast<float>(atlas->height);
+                atlas->glyphs[i]    = glyph;
+            }
+
+            return true;
         }
-	}
+    }
 
 	FontImporter::FontImporter(Context* context)
 	{
@@ -381,10 +533,6 @@ namespace Spartan
         if (!ft_helper::handle_error(FT_Init_FreeType(&m_library)))
 			return;
 
-        // Initialize stroker
-        if (!ft_helper::handle_error(FT_Stroker_New(m_library, &m_stroker)))
-            return;
-
 		// Get version
 		FT_Int major;
 		FT_Int minor;
@@ -395,122 +543,31 @@ namespace Spartan
 
 	FontImporter::~FontImporter()
 	{
-        FT_Stroker_Done(m_stroker);
         ft_helper::handle_error(FT_Done_FreeType(m_library));
 	}
 
 	bool FontImporter::LoadFromFile(Font* font, const string& file_path)
 	{
-		// Load font (called face)
-        FT_Face ft_font = nullptr;
-		if (!ft_helper::handle_error(FT_New_Face(m_library, file_path.c_str(), 0, &ft_font)))
-		{
-            ft_helper::handle_error(FT_Done_Face(ft_font));
-			return false;
-		}
-
-		// Set font size
-		if (!ft_helper::handle_error(FT_Set_Char_Size(
-			ft_font,			    // handle to face object
-			0,						// char_width in 1/64th of points 
-			font->GetSize() * 64,	// char_height in 1/64th of points
-			96,						// horizontal device resolution
-			96)))					// vertical device resolution
-		{
-            ft_helper::handle_error(FT_Done_Face(ft_font));
-			return false;
-		}
-
-        // Set outline size
-        uint32_t outline_size   = (font->GetOutline() != Font_Outline_None) ? font->GetOutlineSize() : 0;
-        bool outline            = outline_size != 0;
-        if (outline)
+        // The atlas doesn't depend on the font's size, so a previously generated one can be used as is
+        sdf_helper::atlas atlas;
+        const string cache_file_path = FileSystem::GetFilePathWithoutExtension(file_path) + "_" + to_string(sdf_helper::get_cache_key(file_path)) + ".sdf";
+        if (!sdf_helper::load_atlas(&atlas, cache_file_path))
         {
-            FT_Stroker_Set(m_stroker, outline_size * 64, FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-        }
-
-        g_glyph_load_flags = ft_helper::get_load_flags(font);
-
-        // Get the size of the font atlas texture (if an outline is requested, it accounts for a big enough atlas)
-        uint32_t atlas_width        = 0;
-        uint32_t atlas_height       = 0;
-        uint32_t atlas_cell_width   = 0;
-        uint32_t atlas_cell_height  = 0;
-        ft_helper::get_texture_atlas_dimensions(&atlas_width, &atlas_height, &atlas_cell_width, &atlas_cell_height, ft_font, outline_size);
+            if (!sdf_helper::generate_atlas(&atlas, m_library, m_context->GetSubsystem<Threading>(), file_path))
+                return false;
 
-        // Atlas for text
-        vector<std::byte> atlas_text(atlas_width * atlas_height);
-        atlas_text.reserve(atlas_text.size());
-
-        // Atlas for outline (if needed)
-        vector<std::byte> atlas_outline;
-        if (outline_size != 0)
-        {
-            atlas_outline.resize(atlas_text.size());
-            atlas_outline.reserve(atlas_text.size());
+            sdf_helper::save_atlas(atlas, cache_file_path);
         }
 
-		// Go through each glyph
-        Vector2 pen = 0.0f;
-        bool writting_started = false;
-        for (uint32_t char_code = GLYPH_START; char_code < GLYPH_END; char_code++)
+        for (uint32_t i = 0; i < static_cast<uint32_t>(atlas.glyphs.size()); i++)
         {
-            // Load text bitmap
-            ft_helper::ft_bitmap bitmap_text;
-            ft_helper::get_bitmap(&bitmap_text, font, nullptr, ft_font, char_code);
-
-            // Load glyph bitmap (if needeD)
-            ft_helper::ft_bitmap bitmap_outline;
-            if (outline)
-            {
-                ft_helper::get_bitmap(&bitmap_outline, font, m_stroker, ft_font, char_code);
-            }
-
-            // Advance pen
-            // Whitespace characters don't have a buffer and don't write on the atlas, hence no need to advance the pen in these cases.
-            if (bitmap_text.buffer && writting_started)
-            {
-                // Advance column
-                pen.x += atlas_cell_width;
-
-                // Advance row
-                if (pen.x + atlas_cell_width > atlas_width)
-                {
-                    pen.x = 0;
-                    pen.y += atlas_cell_height;
-                }
-            }
-
-            // Copy to atlas buffers
-            if (bitmap_text.buffer)
-            {
-                ft_helper::copy_to_atlas(atlas_text, bitmap_text, pen, atlas_width, outline_size);
-
-                if (bitmap_outline.buffer)
-                {
-                    ft_helper::copy_to_atlas(atlas_outline, bitmap_outline, pen, atlas_width, 0);
-                }
-
-                writting_started = true;
-            }
-
-			// Get glyph
-            font->SetGlyph(char_code, ft_helper::get_glyph(ft_font, char_code, pen, atlas_width, atlas_height, outline_size));
-		}
-
-		// Free face
-        ft_helper::handle_error(FT_Done_Face(ft_font));
-
-		// Create a texture with of font atlas and a texture of the font outline atlas
-        {
-            font->SetAtlas(move(static_pointer_cast<RHI_Texture>(make_shared<RHI_Texture2D>(m_context, atlas_width, atlas_height, RHI_Format_R8_Unorm, atlas_text))));
-
-            if (outline_size != 0)
-            {
-                font->SetAtlasOutline(move(static_pointer_cast<RHI_Texture>(make_shared<RHI_Texture2D>(m_context, atlas_width, atlas_height, RHI_Format_R8_Unorm, atlas_outline))));
-            }
+            font->SetGlyph(GLYPH_START + i, atlas.glyphs[i]);
         }
 
+        // The outline is derived by the font, as it depends on the size the text is drawn at
+        font->SetAtlas(atlas.width, atlas.height, move(atlas.data), static_cast<float>(SDF_GLYPH_SIZE), static_cast<float>(SDF_SPREAD));
+
 		return true;
 	}
+
 }
@@ -28,7 +28,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= FORWARD DECLARATIONS =
 struct FT_LibraryRec_;
-struct FT_StrokerRec_;
 //========================
 
 namespace Spartan
@@ -47,6 +46,5 @@ namespace Spartan
 	private:
 		Context* m_context			= nullptr;
 		FT_LibraryRec_* m_library	= nullptr;
-        FT_StrokerRec_* m_stroker   = nullptr;
 	};
 }
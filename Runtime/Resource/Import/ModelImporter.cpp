@@ -26,13 +26,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <assimp/version.h>
 #include "AssimpHelper.h"
 #include "../ProgressReport.h"
+#include "../ResourceCache.h"
 #include "../../RHI/RHI_Texture.h"
 #include "../../Core/Settings.h"
 #include "../../Rendering/Model.h"
 #include "../../Rendering/Animation.h"
+#include "../../Rendering/Skeleton.h"
 #include "../../Rendering/Material.h"
 #include "../../World/World.h"
 #include "../../World/Components/Renderable.h"
+#include "../../World/Components/Animator.h"
 #include "../../RHI/RHI_Vertex.h"
 //============================================
 
@@ -128,6 +131,19 @@ namespace Spartan
             params.scene            = scene;
             params.has_animation    = scene->mNumAnimations != 0;
 
+            // Skinned meshes and animations share a skeleton, built from the node hierarchy before the meshes reference it
+            bool has_bones = false;
+            for (uint32_t i = 0; i < scene->mNumMeshes; i++)
+            {
+                has_bones |= scene->mMeshes[i]->HasBones();
+            }
+
+            if (params.has_animation || has_bones)
+            {
+                params.skeleton = make_shared<Skeleton>();
+                ParseSkeleton(scene->mRootNode, params);
+            }
+
             // Create root entity to match Assimp's root node
             const bool is_active = false;
             shared_ptr<Entity> new_entity = m_world->EntityCreate(is_active);
@@ -142,7 +158,7 @@ namespace Spartan
             // Parse all nodes, starting from the root node and continuing recursively
 			ParseNode(scene->mRootNode, params, nullptr, new_entity.get());
             // Parse animations
-			ParseAnimations(params);
+			ParseAnimations(params, new_entity.get());
             // Update model geometry
 			model->UpdateGeometry();
 
@@ -215,8 +231,22 @@ namespace Spartan
         }
     }
 
-    void ModelImporter::ParseAnimations(const ModelParams& params)
+    void ModelImporter::ParseSkeleton(const aiNode* assimp_node, const ModelParams& params, const int32_t parent /*= -1*/)
+    {
+        // The root's transform is carried by the root entity, so joints (and the skinning palette) are relative to it
+        const Matrix local = parent == -1 ? Matrix::Identity : AssimpHelper::ai_matrix4_x4_to_matrix(assimp_node->mTransformation);
+        const auto joint = static_cast<int32_t>(params.skeleton->AddJoint(assimp_node->mName.C_Str(), parent, local));
+
+        for (uint32_t i = 0; i < assimp_node->mNumChildren; i++)
+        {
+            ParseSkeleton(assimp_node->mChildren[i], params, joint);
+        }
+    }
+
+    void ModelImporter::ParseAnimations(const ModelParams& params, Entity* entity_root)
 	{
+        shared_ptr<Animation> animation_first;
+
 		for (uint32_t i = 0; i < params.scene->mNumAnimations; i++)
 		{
 			const auto assimp_animation = params.scene->mAnimations[i];
@@ -247,7 +277,7 @@ namespace Spartan
 				// Rotation keys
 				for (uint32_t k = 0; k < static_cast<uint32_t>(assimp_node_anim->mNumRotationKeys); k++)
 				{
-					const auto time = assimp_node_anim->mPositionKeys[k].mTime;
+					const auto time = assimp_node_anim->mRotationKeys[k].mTime;
 					const auto value = AssimpHelper::to_quaternion(assimp_node_anim->mRotationKeys[k].mValue);
 
 					animation_node.rotationFrames.emplace_back(KeyQuaternion{ time, value });
@@ -256,13 +286,37 @@ namespace Spartan
 				// Scaling keys
 				for (uint32_t k = 0; k < static_cast<uint32_t>(assimp_node_anim->mNumScalingKeys); k++)
 				{
-					const auto time = assimp_node_anim->mPositionKeys[k].mTime;
+					const auto time = assimp_node_anim->mScalingKeys[k].mTime;
 					const auto value = AssimpHelper::to_vector3(assimp_node_anim->mScalingKeys[k].mValue);
 
 					animation_node.scaleFrames.emplace_back(KeyVector{ time, value });
 				}
+
+                // Reduce and quantize
+                animation->AddTrack(animation_node);
 			}
+
+            LOG_INFO("Animation \"%s\", %d keys compressed to %d", assimp_animation->mName.C_Str(), animation->GetKeyCountSource(), animation->GetKeyCount());
+
+            // Set a resource file path so it can be used by the resource cache
+            const string name = string(assimp_animation->mName.C_Str()).empty() ? to_string(i) : string(assimp_animation->mName.C_Str());
+            animation->SetResourceFilePath(FileSystem::RemoveIllegalCharacters(FileSystem::GetDirectoryFromFilePath(params.file_path) + params.name + "_" + name + EXTENSION_ANIMATION));
+            animation = m_context->GetSubsystem<ResourceCache>()->Cache(animation);
+
+            if (!animation_first)
+            {
+                animation_first = animation;
+            }
 		}
+
+        // Bind the skeleton (and the first animation) to an animator
+        if (params.skeleton && entity_root)
+        {
+            Animator* animator = entity_root->AddComponent<Animator>();
+            animator->SetSkeleton(params.skeleton);
+            animator->Play(animation_first);
+            params.model->SetAnimated(animation_first != nullptr);
+        }
 	}
 
 	void ModelImporter::LoadMesh(aiMesh* assimp_mesh, Entity* entity_parent, const ModelParams& params)
@@ -371,42 +425,22 @@ namespace Spartan
 
     void ModelImporter::LoadBones(const aiMesh* assimp_mesh, const ModelParams& params)
     {
-        // Maximum number of bones per mesh
-        // Must not be higher than same const in skinning shader
-        constexpr uint8_t MAX_BONES = 64;
-        // Maximum number of bones per vertex
-        constexpr uint8_t MAX_BONES_PER_VERTEX = 4;
-
-        //for (uint32_t i = 0; i < assimp_mesh->mNumBones; i++)
-        //{
-        //    uint32_t index = 0;
-
-        //    assert(assimp_mesh->mNumBones <= MAX_BONES);
-
-        //    string name = assimp_mesh->mBones[i]->mName.data;
-
-        //    if (boneMapping.find(name) == boneMapping.end())
-        //    {
-        //        // Bone not present, add new one
-        //        index = numBones;
-        //        numBones++;
-        //        BoneInfo bone;
-        //        boneInfo.push_back(bone);
-        //        boneInfo[index].offset = pMesh->mBones[i]->mOffsetMatrix;
-        //        boneMapping[name] = index;
-        //    }
-        //    else
-        //    {
-        //        index = boneMapping[name];
-        //    }
-
-        //    for (uint32_t j = 0; j < assimp_mesh->mBones[i]->mNumWeights; j++)
-        //    {
-        //        uint32_t vertexID = vertexOffset + pMesh->mBones[i]->mWeights[j].mVertexId;
-        //        Bones[vertexID].add(index, pMesh->mBones[i]->mWeights[j].mWeight);
-        //    }
-        //}
-        //boneTransforms.resize(numBones);
+        if (!params.skeleton)
+            return;
+
+        // Meshes reference their bones by name, the offset takes a vertex from mesh space to bone space
+        for (uint32_t i = 0; i < assimp_mesh->mNumBones; i++)
+        {
+            const aiBone* assimp_bone   = assimp_mesh->mBones[i];
+            const int32_t joint         = params.skeleton->GetJointIndex(assimp_bone->mName.C_Str());
+            if (joint == -1)
+            {
+                LOG_WARNING("Bone \"%s\" has no matching node", assimp_bone->mName.C_Str());
+                continue;
+            }
+
+            params.skeleton->AddBone(static_cast<uint32_t>(joint), AssimpHelper::ai_matrix4_x4_to_matrix(assimp_bone->mOffsetMatrix));
+        }
     }
 
     shared_ptr<Material> ModelImporter::LoadMaterial(aiMaterial* assimp_material, const ModelParams& params)
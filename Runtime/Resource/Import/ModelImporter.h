@@ -39,6 +39,7 @@ namespace Spartan
 	class Entity;
 	class Model;
 	class World;
+	class Skeleton;
 
     struct ModelParams
     {
@@ -51,6 +52,7 @@ namespace Spartan
         bool has_animation;
         Model* model            = nullptr;
         const aiScene* scene    = nullptr;
+        std::shared_ptr<Skeleton> skeleton;
     };
 
 	class SPARTAN_CLASS ModelImporter
@@ -65,7 +67,8 @@ namespace Spartan
         // Parsing
 		void ParseNode(const aiNode* assimp_node, const ModelParams& params, Entity* parent_node = nullptr, Entity* new_entity = nullptr);
         void ParseNodeMeshes(const aiNode* assimp_node, Entity* new_entity, const ModelParams& params);
-        void ParseAnimations(const ModelParams& params);
+        void ParseSkeleton(const aiNode* assimp_node, const ModelParams& params, int32_t parent = -1);
+        void ParseAnimations(const ModelParams& params, Entity* entity_root);
 
         // Loading
 		void LoadMesh(aiMesh* assimp_mesh, Entity* entity_parent, const ModelParams& params);
@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_TextureCube.h"
 #include "../Audio/AudioClip.h"
 #include "../Rendering/Model.h"
+#include "../Rendering/Animation.h"
 //=================================
 
 //= NAMESPACES ================
@@ -136,7 +137,7 @@ namespace Spartan
 
 		// Create resource list file
 		string file_path = GetProjectDirectoryAbsolute() + m_context->GetSubsystem<World>()->GetName() + "_resources.dat";
-		auto file = make_unique<FileStream>(file_path, FileStream_Write);
+		auto file = make_unique<FileStream>(file_path, FileStream_Write | FileStream_Checksum);
 		if (!file->IsOpen())
 		{
 			LOG_ERROR_GENERIC_FAILURE();
@@ -177,7 +178,7 @@ namespace Spartan
 	{
 		// Open resource list file
 		auto file_path = GetProjectDirectoryAbsolute() + m_context->GetSubsystem<World>()->GetName() + "_resources.dat";
-		auto file = make_unique<FileStream>(file_path, FileStream_Read);
+		auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Checksum);
 		if (!file->IsOpen())
 			return;
 		
@@ -211,6 +212,9 @@ namespace Spartan
 				break;
             case Resource_Audio:
                 Load<AudioClip>(file_path);
+                break;
+            case Resource_Animation:
+                Load<Animation>(file_path);
                 break;
 			}
 		}
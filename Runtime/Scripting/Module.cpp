@@ -21,10 +21,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =============================
 #include "Module.h"
+#include <fstream>
+#include <sstream>
+#include <filesystem>
 #include <scriptbuilder/scriptbuilder.cpp>
 #include "Scripting.h"
 #include "../Logging/Log.h"
 #include "../Core/FileSystem.h"
+#include "../IO/FileStream.h"
+#include "../Utilities/Hash.h"
 //========================================
 
 //= NAMESPACES =====
@@ -33,21 +38,67 @@ using namespace std;
 
 namespace Spartan
 {
-	Module::Module(const string& moduleName, Scripting* scriptEngine)
+	static const uint32_t bytecode_cache_version = 1;
+
+	// Adapts a byte vector to the stream interface that AngelScript saves and loads bytecode through
+	class ByteCodeStream : public asIBinaryStream
+	{
+	public:
+		ByteCodeStream(vector<byte>& bytes) : m_bytes(bytes) {}
+
+		int Read(void* ptr, asUINT size) override
+		{
+			if (m_position + size > m_bytes.size())
+				return asERROR;
+
+			memcpy(ptr, m_bytes.data() + m_position, size);
+			m_position += size;
+			return size;
+		}
+
+		int Write(const void* ptr, asUINT size) override
+		{
+			const auto bytes = static_cast<const byte*>(ptr);
+			m_bytes.insert(m_bytes.end(), bytes, bytes + size);
+			return size;
+		}
+
+	private:
+		vector<byte>& m_bytes;
+		size_t m_position = 0;
+	};
+
+	static string read_text_file(const string& file_path)
+	{
+		ifstream in(file_path);
+		stringstream buffer;
+		buffer << in.rdbuf();
+		return buffer.str();
+	}
+
+	static int64_t get_write_time(const string& file_path)
 	{
-		m_moduleName	= moduleName;
-		m_scripting	    = scriptEngine;
+		error_code error;
+		const auto time = filesystem::last_write_time(file_path, error);
+		return error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+	}
+
+	Module::Module(const string& file_path, Scripting* scripting)
+	{
+		m_file_path	= file_path;
+		m_scripting	= scripting;
 	}
 
 	Module::~Module()
 	{
-		if (auto scriptEngine = m_scripting)
+		if (m_module)
 		{
-			scriptEngine->DiscardModule(m_moduleName);
+			m_module->Discard();
+			m_module = nullptr;
 		}
 	}
 
-	bool Module::LoadScript(const string& filePath)
+	bool Module::Load()
 	{
 		if (!m_scripting)
 		{
@@ -55,9 +106,98 @@ namespace Spartan
 			return false;
 		}
 
+		UpdateWriteTimes();
+
+		// Every build gets a unique name, so the previous one can stay alive until the new one succeeds
+		const string module_name	= m_file_path + "#" + to_string(m_version + 1);
+		const size_t key			= ComputeKey();
+		if (!LoadByteCode(module_name, key) && !Build(module_name, key))
+			return false;
+
+		// Objects created from the previous build keep their types alive, so it's safe to discard it
+		if (m_module)
+		{
+			m_module->Discard();
+		}
+
+		m_module = m_scripting->GetAsIScriptEngine()->GetModule(module_name.c_str(), asGM_ONLY_IF_EXISTS);
+		m_version++;
+
+		return m_module != nullptr;
+	}
+
+	bool Module::IsOutdated() const
+	{
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_source_files.size()); i++)
+		{
+			if (get_write_time(m_source_files[i]) != m_source_write_times[i])
+				return true;
+		}
+
+		return false;
+	}
+
+	size_t Module::ComputeKey() const
+	{
+		size_t hash = ANGELSCRIPT_VERSION;
+
+		Utility::Hash::hash_combine(hash, bytecode_cache_version);
+
+		// The contents, not the paths, so edits invalidate the entry
+		for (const string& file_path : m_source_files)
+		{
+			Utility::Hash::hash_combine(hash, read_text_file(file_path));
+		}
+
+		return hash;
+	}
+
+	string Module::GetCacheFilePath(const size_t key) const
+	{
+		return m_scripting->GetCacheDirectory() + "/" + to_string(key) + ".script_cache";
+	}
+
+	bool Module::LoadByteCode(const string& module_name, const size_t key)
+	{
+		const string file_path = GetCacheFilePath(key);
+		if (!FileSystem::Exists(file_path))
+			return false;
+
+		vector<byte> bytecode;
+		{
+			auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Checksum);
+			if (!file->IsOpen())
+				return false;
+
+			file->Read(&bytecode);
+		}
+
+		if (bytecode.empty())
+			return false;
+
+		asIScriptModule* module = m_scripting->GetAsIScriptEngine()->GetModule(module_name.c_str(), asGM_ALWAYS_CREATE);
+		if (!module)
+			return false;
+
+		// Fails if the bytecode references parts of the application interface which are no longer registered
+		ByteCodeStream stream(bytecode);
+		if (module->LoadByteCode(&stream) < 0)
+		{
+			LOG_WARNING("Discarding stale bytecode for \"%s\"", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
+			module->Discard();
+			FileSystem::Delete(file_path);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Module::Build(const string& module_name, const size_t key)
+	{
+		CScriptBuilder builder;
+
 		// start new module
-		m_scriptBuilder = make_unique<CScriptBuilder>();
-		int result = m_scriptBuilder->StartNewModule(m_scripting->GetAsIScriptEngine(), m_moduleName.c_str());
+		int result = builder.StartNewModule(m_scripting->GetAsIScriptEngine(), module_name.c_str());
 		if (result < 0)
 		{
 			LOG_ERROR("Failed to start new module, make sure there is enough memory for it to be allocated.");
@@ -65,32 +205,47 @@ namespace Spartan
 		}
 
 		// load the script
-		result = m_scriptBuilder->AddSectionFromFile(filePath.c_str());
+		result = builder.AddSectionFromFile(m_file_path.c_str());
 		if (result < 0)
 		{
-			LOG_ERROR("Failed to load script \"%s\".", filePath.c_str());
+			LOG_ERROR("Failed to load script \"%s\".", m_file_path.c_str());
+			builder.GetModule()->Discard();
 			return false;
 		}
 
 		// build the script
-		result = m_scriptBuilder->BuildModule();
+		result = builder.BuildModule();
 		if (result < 0)
 		{
-			LOG_ERROR("Failed to compile script \"%s\". Correct any errors and try again.", FileSystem::GetFileNameFromFilePath(filePath).c_str());
+			LOG_ERROR("Failed to compile script \"%s\". Correct any errors and try again.", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
+			builder.GetModule()->Discard();
 			return false;
 		}
 
+		// Save the bytecode, debug info included so that exceptions can still report line numbers
+		vector<byte> bytecode;
+		ByteCodeStream stream(bytecode);
+		if (builder.GetModule()->SaveByteCode(&stream) >= 0)
+		{
+			auto file = make_unique<FileStream>(GetCacheFilePath(key), FileStream_Write | FileStream_Checksum);
+			if (file->IsOpen())
+			{
+				file->Write(bytecode);
+			}
+		}
+
 		return true;
 	}
 
-	asIScriptModule* Module::GetAsIScriptModule() const
-    {
-		if (!m_scriptBuilder)
+	void Module::UpdateWriteTimes()
+	{
+		m_source_files = FileSystem::GetIncludedFiles(m_file_path);
+		m_source_files.insert(m_source_files.begin(), m_file_path);
+
+		m_source_write_times.clear();
+		for (const string& file_path : m_source_files)
 		{
-			LOG_ERROR_INVALID_INTERNALS();
-			return nullptr;
+			m_source_write_times.emplace_back(get_write_time(file_path));
 		}
-
-		return m_scriptBuilder->GetModule();
 	}
 }
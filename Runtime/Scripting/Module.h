@@ -23,29 +23,47 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ====
 #include <string>
+#include <vector>
 #include <memory>
 //===============
 
 class asIScriptModule;
-class CScriptBuilder;
 class asIScriptEngine;
 
 namespace Spartan
 {
 	class Scripting;
 
+	// A compiled script file. A module is shared by every instance of the script and is
+	// loaded from the bytecode cache when the source (and its includes) haven't changed.
 	class Module
 	{
 	public:
-		Module(const std::string& moduleName, Scripting* scriptEngine);
+		Module(const std::string& file_path, Scripting* scripting);
 		~Module();
 
-		bool LoadScript(const std::string& filePath);
-		asIScriptModule* GetAsIScriptModule() const;
+		// Builds the module, or loads it from the bytecode cache. On failure, the previous build (if any) is kept.
+		bool Load();
+
+		// Returns true if the source or any of the included files has been modified since the last load
+		bool IsOutdated() const;
+
+		asIScriptModule* GetAsIScriptModule() const	{ return m_module; }
+		const auto& GetFilePath() const				{ return m_file_path; }
+		uint32_t GetVersion() const					{ return m_version; }
 
 	private:
-		std::string m_moduleName;
-		std::unique_ptr<CScriptBuilder> m_scriptBuilder;
-        Scripting* m_scripting;
+		std::size_t ComputeKey() const;
+		std::string GetCacheFilePath(std::size_t key) const;
+		bool LoadByteCode(const std::string& module_name, std::size_t key);
+		bool Build(const std::string& module_name, std::size_t key);
+		void UpdateWriteTimes();
+
+		std::string m_file_path;
+		std::vector<std::string> m_source_files;
+		std::vector<int64_t> m_source_write_times;
+		asIScriptModule* m_module	= nullptr;
+		uint32_t m_version			= 0;
+		Scripting* m_scripting		= nullptr;
 	};
 }
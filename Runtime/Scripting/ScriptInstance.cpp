@@ -36,15 +36,12 @@ namespace Spartan
 {
     ScriptInstance::~ScriptInstance()
 	{
-		if (m_scriptObject)
+		if (m_scripting)
 		{
-			m_scriptObject->Release();
-			m_scriptObject = nullptr;
+			m_scripting->RemoveInstance(this);
 		}
 
-		m_constructorFunction	= nullptr;
-		m_startFunction			= nullptr;
-		m_updateFunction		= nullptr;
+		ReleaseScriptObject();
 		m_scripting			    = nullptr;
 		m_isInstantiated		= false;
 	}
@@ -60,11 +57,14 @@ namespace Spartan
 		m_scriptPath				= path;
 		m_entity					= entity;
 		m_className					= FileSystem::GetFileNameNoExtensionFromFilePath(m_scriptPath);
-		m_moduleName				= m_className + to_string(m_entity.lock()->GetId());
 		m_constructorDeclaration	= m_className + " @" + m_className + "(Entity @)";
 
 		// Instantiate the script
 		m_isInstantiated = CreateScriptObject();
+		if (m_isInstantiated)
+		{
+			m_scripting->AddInstance(this);
+		}
 
 		return m_isInstantiated;
 	}
@@ -80,15 +80,31 @@ namespace Spartan
 		m_scripting->ExecuteCall(m_startFunction, m_scriptObject);
 	}
 
-	void ScriptInstance::ExecuteUpdate(float delta_time) const
-    {
-		if (!m_scripting)
+	bool ScriptInstance::Refresh()
+	{
+		if (!m_isInstantiated)
+			return false;
+
+		// The module has been rebuilt (the script was modified), so re-create the object from the new types
+		if (m_module->GetVersion() != m_moduleVersion)
 		{
-			LOG_ERROR_INVALID_INTERNALS();
-			return;
+			ReleaseScriptObject();
+			if (!CreateScriptObject())
+			{
+				m_isInstantiated = false;
+				return false;
+			}
+
+			ExecuteStart();
 		}
 
-		m_scripting->ExecuteCall(m_updateFunction, m_scriptObject, delta_time);
+		return true;
+	}
+
+	bool ScriptInstance::IsActive() const
+	{
+		const auto entity = m_entity.lock();
+		return entity && entity->IsActive();
 	}
 
 	bool ScriptInstance::CreateScriptObject()
@@ -99,11 +115,14 @@ namespace Spartan
 			return false;
 		}
 
-		// Create module
-		m_module	= make_shared<Module>(m_moduleName, m_scripting);
-        const bool result = m_module->LoadScript(m_scriptPath);
-		if (!result)
-			return false;
+		// Get the module, it's compiled once and shared by every instance of the script
+		if (!m_module)
+		{
+			m_module = m_scripting->GetModule(m_scriptPath);
+			if (!m_module)
+				return false;
+		}
+		m_moduleVersion = m_module->GetVersion();
 
 		// Get type
         const auto type_id		= m_module->GetAsIScriptModule()->GetTypeIdByDecl(m_className.c_str());
@@ -115,6 +134,7 @@ namespace Spartan
 		m_startFunction			= type->GetMethodByDecl("void Start()"); // Get the Start function from the script
 		m_updateFunction		= type->GetMethodByDecl("void Update(float delta_time)"); // Get the Update function from the script
 		m_constructorFunction	= type->GetFactoryByDecl(m_constructorDeclaration.c_str()); // Get the constructor function from the script
+		m_isThreadSafe			= type->Implements(m_scripting->GetAsIScriptEngine()->GetTypeInfoByName("ThreadSafe")); // Scripts opt in to being updated across threads
 		if (!m_constructorFunction)
 		{
 			LOG_ERROR("Couldn't find the appropriate factory for the type '%s'", m_className.c_str());
@@ -143,4 +163,17 @@ namespace Spartan
 
 		return true;
 	}
+
+	void ScriptInstance::ReleaseScriptObject()
+	{
+		if (m_scriptObject)
+		{
+			m_scriptObject->Release();
+			m_scriptObject = nullptr;
+		}
+
+		m_constructorFunction	= nullptr;
+		m_startFunction			= nullptr;
+		m_updateFunction		= nullptr;
+	}
 }
@@ -45,22 +45,32 @@ namespace Spartan
 		const auto& GetScriptPath() const { return m_scriptPath; }
 
 		void ExecuteStart() const;
-		void ExecuteUpdate(float delta_time) const;
+
+		// Updates are executed by Scripting, in batches per script type
+		bool Refresh();
+		bool IsActive() const;
+		const Module* GetModule() const						{ return m_module.get(); }
+		asIScriptObject* GetScriptObject() const			{ return m_scriptObject; }
+		asIScriptFunction* GetUpdateFunction() const		{ return m_updateFunction; }
+		bool IsThreadSafe() const							{ return m_isThreadSafe; }
+		const auto& GetClassName() const					{ return m_className; }
 
 	private:
 		bool CreateScriptObject();
+		void ReleaseScriptObject();
 
 		std::string m_scriptPath;
 		std::string m_className;
 		std::string m_constructorDeclaration;
-		std::string m_moduleName;
 		std::weak_ptr<Entity> m_entity;
 		std::shared_ptr<Module> m_module;
+		uint32_t m_moduleVersion					= 0;
 		asIScriptObject* m_scriptObject				= nullptr;
 		asIScriptFunction* m_constructorFunction	= nullptr;
 		asIScriptFunction* m_startFunction			= nullptr;
 		asIScriptFunction* m_updateFunction			= nullptr;
         Scripting* m_scripting	                    = nullptr;
 		bool m_isInstantiated						= false;
+		bool m_isThreadSafe							= false;
 	};
 }
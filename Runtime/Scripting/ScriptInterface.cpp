@@ -21,14 +21,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==============================
 #include "ScriptInterface.h"
+#include <thread>
 #include <angelscript.h>
+#include "Scripting.h"
 #include "../Rendering/Material.h"
 #include "../Input/Input.h"
+#include "../World/World.h"
+#include "../Physics/Physics.h"
 #include "../World/Entity.h"
 #include "../World/Components/RigidBody.h"
 #include "../World/Components/Camera.h"
 #include "../World/Components/Transform.h"
 #include "../World/Components/Renderable.h"
+#include "../Math/Ray.h"
 //=========================================
 
 //= NAMESPACES ===============
@@ -38,10 +43,29 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+	// The world and physics interfaces keep their results in statics and physics locks the simulation, so they
+	// are only callable from the main thread. ThreadSafe scripts (updated on worker threads) have to Defer() these calls.
+	static thread::id main_thread_id;
+
+	static bool is_main_thread()
+	{
+		if (this_thread::get_id() == main_thread_id)
+			return true;
+
+		// Abort the script, the exception is logged by Scripting
+		if (asIScriptContext* context = asGetActiveContext())
+		{
+			context->SetException("World and physics can only be accessed from the main thread, use Defer()");
+		}
+
+		return false;
+	}
+
 	void ScriptInterface::Register(asIScriptEngine* scriptEngine, Context* context)
 	{
 		m_context		= context;
 		m_scriptEngine	= scriptEngine;
+		main_thread_id	= this_thread::get_id(); // registration happens on the main thread
 
 		RegisterEnumerations();
 		RegisterTypes();
@@ -54,7 +78,10 @@ namespace Spartan
 		RegisterMaterial();
 		RegisterRigidBody();
 		RegisterEntity();
+		RegisterWorld();
+		RegisterPhysics();
 		RegisterLog();
+		RegisterScripting();
 	}
 
 	void ScriptInterface::RegisterEnumerations() const
@@ -78,6 +105,7 @@ namespace Spartan
 		m_scriptEngine->RegisterEnumValue("ComponentType", "Script",		int(ComponentType_Script));
 		m_scriptEngine->RegisterEnumValue("ComponentType", "Environment",	int(ComponentType_Environment));
 		m_scriptEngine->RegisterEnumValue("ComponentType", "Transform",		int(ComponentType_Transform));
+		m_scriptEngine->RegisterEnumValue("ComponentType", "Animator",		int(ComponentType_Animator));
 
 		// KeyCode
 		m_scriptEngine->RegisterEnum("KeyCode");
@@ -112,6 +140,13 @@ namespace Spartan
 		m_scriptEngine->RegisterEnumValue("KeyCode", "Click_Middle",	int(Click_Middle));
 		m_scriptEngine->RegisterEnumValue("KeyCode", "Click_Right",		int(Click_Right));
 
+		// PhysicsFilter
+		m_scriptEngine->RegisterEnum("PhysicsFilter");
+		m_scriptEngine->RegisterEnumValue("PhysicsFilter", "Dynamic",	int(PhysicsFilter_Dynamic));
+		m_scriptEngine->RegisterEnumValue("PhysicsFilter", "Static",	int(PhysicsFilter_Static));
+		m_scriptEngine->RegisterEnumValue("PhysicsFilter", "Kinematic",	int(PhysicsFilter_Kinematic));
+		m_scriptEngine->RegisterEnumValue("PhysicsFilter", "All",		int(PhysicsFilter_All));
+
 		// ForceMode
 		m_scriptEngine->RegisterEnum("ForceMode");
 		m_scriptEngine->RegisterEnumValue("ForceMode", "Force",		int(Force));
@@ -124,6 +159,8 @@ namespace Spartan
 		m_scriptEngine->RegisterObjectType("Input", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("Time", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("Entity", 0, asOBJ_REF | asOBJ_NOCOUNT);
+		m_scriptEngine->RegisterObjectType("World", 0, asOBJ_REF | asOBJ_NOCOUNT);
+		m_scriptEngine->RegisterObjectType("Physics", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("Transform", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("Renderable", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("Material", 0, asOBJ_REF | asOBJ_NOCOUNT);
@@ -164,6 +201,265 @@ namespace Spartan
 		m_scriptEngine->RegisterObjectMethod("Entity", "Renderable &GetRenderable()", asMETHOD(Entity, GetComponent<Renderable>), asCALL_THISCALL);
 	}
 
+	/*------------------------------------------------------------------------------
+										[WORLD]
+	------------------------------------------------------------------------------*/
+	// Results of the last sphere/box query, scripts read them back by index
+	static vector<Entity*> world_query_results;
+
+	static Entity* WorldRayCast(const Vector3& origin, const Vector3& direction, float max_distance, World* self)
+	{
+		if (!is_main_thread())
+			return nullptr;
+
+		return self->RayCastClosest(Ray(origin, origin + direction), max_distance);
+	}
+
+	static uint32_t WorldQuerySphere(const Vector3& center, float radius, World* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		self->QuerySphere(center, radius, world_query_results);
+		return static_cast<uint32_t>(world_query_results.size());
+	}
+
+	static uint32_t WorldQueryBox(const Vector3& min, const Vector3& max, World* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		self->QueryBox(BoundingBox(min, max), world_query_results);
+		return static_cast<uint32_t>(world_query_results.size());
+	}
+
+	static Entity* WorldGetQueryResult(uint32_t index, World* self)
+	{
+		if (!is_main_thread())
+			return nullptr;
+
+		return index < world_query_results.size() ? world_query_results[index] : nullptr;
+	}
+
+	void ScriptInterface::RegisterWorld() const
+    {
+		auto r = 0;
+
+		r = m_scriptEngine->RegisterGlobalProperty("World world", m_context->GetSubsystem<World>());																							SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("World", "Entity@ RayCast(const Vector3& in, const Vector3& in, float)",	asFUNCTION(WorldRayCast),			asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("World", "uint QuerySphere(const Vector3& in, float)",						asFUNCTION(WorldQuerySphere),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("World", "uint QueryBox(const Vector3& in, const Vector3& in)",			asFUNCTION(WorldQueryBox),			asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("World", "Entity@ GetQueryResult(uint)",									asFUNCTION(WorldGetQueryResult),	asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+	}
+
+	/*------------------------------------------------------------------------------
+										[PHYSICS]
+	------------------------------------------------------------------------------*/
+	// Scripts queue queries, execute them as one batch and read the results back by the index which queuing returned.
+	// While the simulation is threaded the batch executes in between two steps, AreQueriesDone() tells when its results
+	// can be read (usually by the next frame), they stay readable until the next batch is executed.
+	static const uint32_t physics_query_max_bodies = 16;
+	static shared_ptr<PhysicsQueryBatch> physics_batch_pending;
+	static shared_ptr<PhysicsQueryBatch> physics_batch_executed;
+	static shared_ptr<PhysicsQueryBatch> physics_batch_spare;
+	static vector<pair<uint32_t, uint32_t>> physics_queries_pending; // kind (0 ray, 1 sweep, 2 overlap), index into that kind's queries
+	static vector<pair<uint32_t, uint32_t>> physics_queries_executed;
+
+	static PhysicsQueryBatch& PhysicsGetPendingBatch()
+	{
+		if (!physics_batch_pending)
+		{
+			// Reuse the memory of an older batch, once the physics is done with it
+			if (physics_batch_spare && physics_batch_spare.use_count() == 1)
+			{
+				physics_batch_pending = move(physics_batch_spare);
+				physics_batch_pending->Clear();
+			}
+			else
+			{
+				physics_batch_pending = make_shared<PhysicsQueryBatch>();
+			}
+		}
+
+		return *physics_batch_pending;
+	}
+
+	static uint32_t PhysicsQueueQuery(const uint32_t kind, const uint32_t index)
+	{
+		physics_queries_pending.emplace_back(kind, index);
+		return static_cast<uint32_t>(physics_queries_pending.size() - 1);
+	}
+
+	static uint32_t PhysicsQueueRay(const Vector3& from, const Vector3& to, uint32_t mask, Physics* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		vector<PhysicsRay>& rays = PhysicsGetPendingBatch().rays;
+		rays.push_back({ from, to, mask });
+		return PhysicsQueueQuery(0, static_cast<uint32_t>(rays.size() - 1));
+	}
+
+	static uint32_t PhysicsQueueSphereSweep(const Vector3& from, const Vector3& to, float radius, uint32_t mask, Physics* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		vector<PhysicsSweep>& sweeps = PhysicsGetPendingBatch().sweeps;
+		sweeps.push_back({ PhysicsQueryShape_Sphere, Vector3(radius), Quaternion::Identity, from, to, mask });
+		return PhysicsQueueQuery(1, static_cast<uint32_t>(sweeps.size() - 1));
+	}
+
+	static uint32_t PhysicsQueueBoxSweep(const Vector3& from, const Vector3& to, const Vector3& extents, const Quaternion& rotation, uint32_t mask, Physics* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		vector<PhysicsSweep>& sweeps = PhysicsGetPendingBatch().sweeps;
+		sweeps.push_back({ PhysicsQueryShape_Box, extents, rotation, from, to, mask });
+		return PhysicsQueueQuery(1, static_cast<uint32_t>(sweeps.size() - 1));
+	}
+
+	static uint32_t PhysicsQueueSphereOverlap(const Vector3& center, float radius, uint32_t mask, Physics* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		vector<PhysicsOverlap>& overlaps = PhysicsGetPendingBatch().overlaps;
+		overlaps.push_back({ PhysicsQueryShape_Sphere, Vector3(radius), Quaternion::Identity, center, mask });
+		return PhysicsQueueQuery(2, static_cast<uint32_t>(overlaps.size() - 1));
+	}
+
+	static uint32_t PhysicsQueueBoxOverlap(const Vector3& center, const Vector3& extents, const Quaternion& rotation, uint32_t mask, Physics* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		vector<PhysicsOverlap>& overlaps = PhysicsGetPendingBatch().overlaps;
+		overlaps.push_back({ PhysicsQueryShape_Box, extents, rotation, center, mask });
+		return PhysicsQueueQuery(2, static_cast<uint32_t>(overlaps.size() - 1));
+	}
+
+	static void PhysicsExecuteQueries(Physics* self)
+	{
+		if (!is_main_thread())
+			return;
+
+		PhysicsGetPendingBatch().overlap_max_bodies = physics_query_max_bodies;
+		self->Submit(physics_batch_pending);
+
+		physics_batch_spare		= move(physics_batch_executed);
+		physics_batch_executed	= move(physics_batch_pending);
+		physics_queries_executed.swap(physics_queries_pending);
+		physics_queries_pending.clear();
+	}
+
+	static bool PhysicsAreQueriesDone(Physics* self)
+	{
+		if (!is_main_thread())
+			return false;
+
+		return !physics_batch_executed || physics_batch_executed->IsDone();
+	}
+
+	// The executed batch, if its results can be read
+	static const PhysicsQueryBatch* PhysicsGetExecutedBatch()
+	{
+		return physics_batch_executed && physics_batch_executed->IsDone() ? physics_batch_executed.get() : nullptr;
+	}
+
+	static const PhysicsHit* PhysicsGetHitResult(const uint32_t query)
+	{
+		const PhysicsQueryBatch* batch = PhysicsGetExecutedBatch();
+		if (!batch || query >= physics_queries_executed.size())
+			return nullptr;
+
+		const auto& [kind, index] = physics_queries_executed[query];
+		if (kind == 0 && index < batch->ray_hits.size())	return &batch->ray_hits[index];
+		if (kind == 1 && index < batch->sweep_hits.size())	return &batch->sweep_hits[index];
+		return nullptr;
+	}
+
+	static bool PhysicsGetHit(uint32_t query, Physics* self)
+	{
+		if (!is_main_thread())
+			return false;
+
+		const PhysicsHit* hit = PhysicsGetHitResult(query);
+		return hit && hit->hit;
+	}
+
+	static Entity* PhysicsGetHitEntity(uint32_t query, Physics* self)
+	{
+		if (!is_main_thread())
+			return nullptr;
+
+		const PhysicsHit* hit = PhysicsGetHitResult(query);
+		return hit && hit->body ? hit->body->GetEntity() : nullptr;
+	}
+
+	static Vector3 PhysicsGetHitPosition(uint32_t query, Physics* self)
+	{
+		if (!is_main_thread())
+			return Vector3::Zero;
+
+		const PhysicsHit* hit = PhysicsGetHitResult(query);
+		return hit ? hit->position : Vector3::Zero;
+	}
+
+	static Vector3 PhysicsGetHitNormal(uint32_t query, Physics* self)
+	{
+		if (!is_main_thread())
+			return Vector3::Zero;
+
+		const PhysicsHit* hit = PhysicsGetHitResult(query);
+		return hit ? hit->normal : Vector3::Zero;
+	}
+
+	static uint32_t PhysicsGetOverlapCount(uint32_t query, Physics* self)
+	{
+		if (!is_main_thread())
+			return 0;
+
+		const PhysicsQueryBatch* batch = PhysicsGetExecutedBatch();
+		if (!batch || query >= physics_queries_executed.size() || physics_queries_executed[query].first != 2 || physics_queries_executed[query].second >= batch->overlap_counts.size())
+			return 0;
+
+		return batch->overlap_counts[physics_queries_executed[query].second];
+	}
+
+	static Entity* PhysicsGetOverlapEntity(uint32_t query, uint32_t i, Physics* self)
+	{
+		if (!is_main_thread())
+			return nullptr;
+
+		if (i >= PhysicsGetOverlapCount(query, self))
+			return nullptr;
+
+		const PhysicsQueryBatch* batch = PhysicsGetExecutedBatch();
+		return batch->overlap_bodies[physics_queries_executed[query].second * batch->overlap_max_bodies + i]->GetEntity();
+	}
+
+	void ScriptInterface::RegisterPhysics() const
+	{
+		auto r = 0;
+
+		r = m_scriptEngine->RegisterGlobalProperty("Physics physics", m_context->GetSubsystem<Physics>());																												SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "uint QueueRay(const Vector3& in, const Vector3& in, uint = 0xFFFFFFFF)",										asFUNCTION(PhysicsQueueRay),			asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "uint QueueSphereSweep(const Vector3& in, const Vector3& in, float, uint = 0xFFFFFFFF)",							asFUNCTION(PhysicsQueueSphereSweep),	asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "uint QueueBoxSweep(const Vector3& in, const Vector3& in, const Vector3& in, const Quaternion& in, uint = 0xFFFFFFFF)",	asFUNCTION(PhysicsQueueBoxSweep),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "uint QueueSphereOverlap(const Vector3& in, float, uint = 0xFFFFFFFF)",										asFUNCTION(PhysicsQueueSphereOverlap),	asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "uint QueueBoxOverlap(const Vector3& in, const Vector3& in, const Quaternion& in, uint = 0xFFFFFFFF)",			asFUNCTION(PhysicsQueueBoxOverlap),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "void ExecuteQueries()",																						asFUNCTION(PhysicsExecuteQueries),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "bool AreQueriesDone()",																						asFUNCTION(PhysicsAreQueriesDone),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "bool GetHit(uint)",																							asFUNCTION(PhysicsGetHit),				asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "Entity@ GetHitEntity(uint)",																					asFUNCTION(PhysicsGetHitEntity),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "Vector3 GetHitPosition(uint)",																				asFUNCTION(PhysicsGetHitPosition),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "Vector3 GetHitNormal(uint)",																					asFUNCTION(PhysicsGetHitNormal),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "uint GetOverlapCount(uint)",																					asFUNCTION(PhysicsGetOverlapCount),		asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Physics", "Entity@ GetOverlapEntity(uint, uint)",																		asFUNCTION(PhysicsGetOverlapEntity),	asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+	}
+
 	/*------------------------------------------------------------------------------
 										[TRANSFORM]
 	------------------------------------------------------------------------------*/
@@ -446,4 +742,19 @@ namespace Spartan
 		r = m_scriptEngine->RegisterGlobalFunction("void Log(const Vector3& in, LogType)",		asFUNCTIONPR(Log::Write, (const Vector3&, Log_Type), void),		asCALL_CDECL);	SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterGlobalFunction("void Log(const Quaternion& in, LogType)",	asFUNCTIONPR(Log::Write, (const Quaternion&, Log_Type), void),	asCALL_CDECL);	SPARTAN_ASSERT(r >= 0);
 	}
+
+	/*------------------------------------------------------------------------------
+										[SCRIPTING]
+	------------------------------------------------------------------------------*/
+	// The instances of a script class which implements ThreadSafe are updated across threads. World and physics calls made
+	// from those threads raise a script exception, anything which touches the world (like moving an entity) has to go
+	// through Defer(), which calls back on the main thread once all the updates are done.
+	void ScriptInterface::RegisterScripting() const
+	{
+		auto r = 0;
+
+		r = m_scriptEngine->RegisterInterface("ThreadSafe");																													SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterFuncdef("void DeferredCall()");																												SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterGlobalFunction("void Defer(DeferredCall@)", asMETHOD(Scripting, Defer), asCALL_THISCALL_ASGLOBAL, m_context->GetSubsystem<Scripting>());	SPARTAN_ASSERT(r >= 0);
+	}
 }
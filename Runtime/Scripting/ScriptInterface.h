@@ -37,6 +37,8 @@ namespace Spartan
 		void RegisterTypes() const;
 		void RegisterInput() const;
 		void RegisterEntity();
+		void RegisterWorld() const;
+		void RegisterPhysics() const;
 		void RegisterTransform() const;
 		void RegisterMaterial() const;
 		void RegisterRigidBody() const;
@@ -45,6 +47,7 @@ namespace Spartan
 		void RegisterQuaternion() const;
 		void RegisterMath() const;
 		void RegisterLog() const;
+		void RegisterScripting() const;
 
 		asIScriptEngine* m_scriptEngine;
 		Context* m_context;
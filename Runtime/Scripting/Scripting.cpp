@@ -22,16 +22,38 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =================================
 #include "Scripting.h"
 #include <scriptstdstring/scriptstdstring.cpp>
+#include <algorithm>
 #include "ScriptInterface.h"
+#include "Module.h"
+#include "ScriptInstance.h"
 #include "../Logging/Log.h"
 #include "../Core/FileSystem.h"
 #include "../Core/EventSystem.h"
 #include "../Core/Settings.h"
 #include "../Core/Context.h"
+#include "../Core/Stopwatch.h"
+#include "../Resource/ResourceCache.h"
+#include "../Profiling/Profiler.h"
+#include "../Threading/Threading.h"
 //===========================================
 
 namespace Spartan
 {
+	// How often the source files of the loaded modules are checked for modifications
+	static const float hot_reload_interval_sec = 1.0f;
+
+	// Thread safe batches with fewer instances aren't worth waking up the threads for
+	static const uint32_t parallel_batch_min = 32;
+
+	// Each thread pulls contexts from its own pool, so requesting one never contends with other threads
+	struct ContextPool
+	{
+		const Scripting* owner	= nullptr;
+		uint32_t generation		= 0;
+		std::vector<asIScriptContext*> contexts;
+	};
+	static thread_local ContextPool context_pool;
+
 	Scripting::Scripting(Context* context) : ISubsystem(context)
 	{
 		// Subscribe to events
@@ -40,7 +62,15 @@ namespace Spartan
 
 	Scripting::~Scripting()
 	{
+		// Calls which were never executed
+		for (asIScriptFunction* callback : m_deferred)
+		{
+			callback->Release();
+		}
+		m_deferred.clear();
+
 		Clear();
+		m_modules.clear();
 
 		if (m_scriptEngine)
 		{
@@ -51,6 +81,9 @@ namespace Spartan
 
     bool Scripting::Initialize()
     {
+        // Scripts can execute from worker threads, so the thread manager has to exist before the engine does
+        asPrepareMultithread();
+
         m_scriptEngine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
         if (!m_scriptEngine)
         {
@@ -70,6 +103,17 @@ namespace Spartan
 
         m_scriptEngine->SetEngineProperty(asEP_BUILD_WITHOUT_LINE_CUES, true);
 
+        // Get dependencies
+        m_profiler	= m_context->GetSubsystem<Profiler>();
+        m_threading	= m_context->GetSubsystem<Threading>();
+
+        // Compiled modules are cached on disk
+        m_cache_directory = m_context->GetSubsystem<ResourceCache>()->GetDataDirectory() + "/script_cache";
+        if (!FileSystem::Exists(m_cache_directory))
+        {
+            FileSystem::CreateDirectory_(m_cache_directory);
+        }
+
         // Get version
         const string major = to_string(ANGELSCRIPT_VERSION).erase(1, 4);
         const string minor = to_string(ANGELSCRIPT_VERSION).erase(0, 1).erase(2, 2);
@@ -79,8 +123,30 @@ namespace Spartan
         return true;
     }
 
+    void Scripting::Tick(float delta_time)
+    {
+        m_hot_reload_timer += delta_time;
+        if (m_hot_reload_timer < hot_reload_interval_sec)
+            return;
+
+        m_hot_reload_timer = 0.0f;
+
+        // Rebuild any module whose source has changed, its instances re-create their objects on their next update
+        std::lock_guard<std::mutex> lock(m_modules_mutex);
+        for (auto& it : m_modules)
+        {
+            Module* module = it.second.get();
+            if (module->IsOutdated() && module->Load())
+            {
+                LOG_INFO("Reloaded \"%s\"", FileSystem::GetFileNameFromFilePath(module->GetFilePath()).c_str());
+            }
+        }
+    }
+
     void Scripting::Clear()
 	{
+		std::lock_guard<std::mutex> lock(m_contexts_mutex);
+
 		for (auto& context : m_contexts)
 		{
 			context->Release();
@@ -88,6 +154,9 @@ namespace Spartan
 
 		m_contexts.clear();
 		m_contexts.shrink_to_fit();
+
+		// Invalidate the per thread pools, they point to the contexts which were just released
+		m_contexts_generation++;
 	}
 
 	asIScriptEngine* Scripting::GetAsIScriptEngine() const
@@ -102,17 +171,25 @@ namespace Spartan
 	// They say you must pool them to avoid overhead. So I do as they say.
 	asIScriptContext* Scripting::RequestContext()
 	{
-		asIScriptContext* context = nullptr;
-		if (m_contexts.size())
+		if (context_pool.owner != this || context_pool.generation != m_contexts_generation)
 		{
-			context = *m_contexts.rbegin();
-			m_contexts.pop_back();
+			context_pool.owner		= this;
+			context_pool.generation	= m_contexts_generation;
+			context_pool.contexts.clear();
 		}
-		else
+
+		if (!context_pool.contexts.empty())
 		{
-			context = m_scriptEngine->CreateContext();
+			asIScriptContext* context = context_pool.contexts.back();
+			context_pool.contexts.pop_back();
+			return context;
 		}
 
+		// Only creation touches shared state, so that Clear() can release the contexts of every thread
+		asIScriptContext* context = m_scriptEngine->CreateContext();
+		std::lock_guard<std::mutex> lock(m_contexts_mutex);
+		m_contexts.emplace_back(context);
+
 		return context;
 	}
 
@@ -125,8 +202,8 @@ namespace Spartan
 			LOG_ERROR("Scripting::ReturnContext: Context is null");
 			return;
 		}
-		m_contexts.push_back(context);
 		context->Unprepare();
+		context_pool.contexts.emplace_back(context);
 	}
 
 	/*------------------------------------------------------------------------------
@@ -156,12 +233,187 @@ namespace Spartan
 		return true;
 	}
 
+	/*------------------------------------------------------------------------------
+								[UPDATES]
+	------------------------------------------------------------------------------*/
+	void Scripting::AddInstance(ScriptInstance* instance)
+	{
+		// Scripts are instantiated from the threads which load the world too
+		std::lock_guard<std::mutex> lock(m_instances_mutex);
+
+		if (find(m_instances.begin(), m_instances.end(), instance) != m_instances.end())
+			return;
+
+		m_instances.emplace_back(instance);
+	}
+
+	void Scripting::RemoveInstance(ScriptInstance* instance)
+	{
+		std::lock_guard<std::mutex> lock(m_instances_mutex);
+
+		const auto it = find(m_instances.begin(), m_instances.end(), instance);
+		if (it == m_instances.end())
+			return;
+
+		*it = m_instances.back();
+		m_instances.pop_back();
+
+		replace(m_instances_updating.begin(), m_instances_updating.end(), instance, static_cast<ScriptInstance*>(nullptr));
+	}
+
+	void Scripting::ExecuteUpdates(const float delta_time)
+	{
+		// Group the instances by script type, the batches are kept so that their storage is re-used
+		for (auto& it : m_batches)
+		{
+			it.second.objects.clear();
+			it.second.time_ms = 0.0f;
+		}
+
+		// Work on a copy, refreshing an instance runs its Start(), which can create or destroy other scripts
+		{
+			std::lock_guard<std::mutex> lock(m_instances_mutex);
+			m_instances_updating = m_instances;
+		}
+
+		for (size_t i = 0; i < m_instances_updating.size(); i++)
+		{
+			// Instances destroyed since the copy was made are nulled by RemoveInstance()
+			ScriptInstance* instance = m_instances_updating[i];
+			if (!instance || !instance->IsActive() || !instance->Refresh() || !instance->GetUpdateFunction())
+				continue;
+
+			ScriptBatch& batch = m_batches[instance->GetModule()];
+			if (batch.objects.empty())
+			{
+				batch.name				= instance->GetClassName();
+				batch.update_function	= instance->GetUpdateFunction(); // shared by every instance of the type
+				batch.thread_safe		= instance->IsThreadSafe();
+			}
+			batch.objects.emplace_back(instance->GetScriptObject());
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_instances_mutex);
+			m_instances_updating.clear();
+		}
+
+		// Execute
+		for (auto& it : m_batches)
+		{
+			ScriptBatch& batch = it.second;
+			const auto count = static_cast<uint32_t>(batch.objects.size());
+			if (count == 0)
+				continue;
+
+			TIME_BLOCK_START_NAMED(m_profiler, batch.name.c_str());
+			const Stopwatch stopwatch;
+
+			if (batch.thread_safe && count >= parallel_batch_min)
+			{
+				// Every thread executes its chunk with a context from its own pool
+				m_threading->AddTaskLoop([this, &batch, delta_time](const uint32_t start, const uint32_t end)
+				{
+					ExecuteBatch(batch.update_function, &batch.objects[start], end - start, delta_time);
+				}, count);
+			}
+			else
+			{
+				ExecuteBatch(batch.update_function, batch.objects.data(), count, delta_time);
+			}
+
+			batch.time_ms = stopwatch.GetElapsedTimeMs();
+			TIME_BLOCK_END(m_profiler);
+		}
+
+		ExecuteDeferred();
+	}
+
+	void Scripting::ExecuteBatch(asIScriptFunction* function, asIScriptObject* const* objects, const uint32_t count, const float delta_time)
+	{
+		asIScriptContext* ctx = RequestContext();
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			// The context is only fully prepared for the first object, re-preparing it for the function it last executed is cheap
+			ctx->Prepare(function);
+			ctx->SetObject(objects[i]);
+			ctx->SetArgFloat(0, delta_time);
+
+			if (ctx->Execute() == asEXECUTION_EXCEPTION)
+			{
+				LogExceptionInfo(ctx);
+			}
+		}
+
+		ReturnContext(ctx);
+	}
+
+	void Scripting::Defer(asIScriptFunction* callback)
+	{
+		if (!callback)
+			return;
+
+		// The handle's reference is owned by the queue, until the call is executed
+		std::lock_guard<std::mutex> lock(m_deferred_mutex);
+		m_deferred.emplace_back(callback);
+	}
+
+	void Scripting::ExecuteDeferred()
+	{
+		std::vector<asIScriptFunction*> deferred;
+		{
+			std::lock_guard<std::mutex> lock(m_deferred_mutex);
+			deferred.swap(m_deferred);
+		}
+
+		if (deferred.empty())
+			return;
+
+		asIScriptContext* ctx = RequestContext();
+
+		for (asIScriptFunction* callback : deferred)
+		{
+			// Delegates carry the object they are bound to
+			if (callback->GetFuncType() == asFUNC_DELEGATE)
+			{
+				ctx->Prepare(callback->GetDelegateFunction());
+				ctx->SetObject(callback->GetDelegateObject());
+			}
+			else
+			{
+				ctx->Prepare(callback);
+			}
+
+			if (ctx->Execute() == asEXECUTION_EXCEPTION)
+			{
+				LogExceptionInfo(ctx);
+			}
+
+			callback->Release();
+		}
+
+		ReturnContext(ctx);
+	}
+
 	/*------------------------------------------------------------------------------
 										[MODULE]
 	------------------------------------------------------------------------------*/
-	void Scripting::DiscardModule(const string& moduleName) const
-    {
-		m_scriptEngine->DiscardModule(moduleName.c_str());
+	std::shared_ptr<Module> Scripting::GetModule(const std::string& file_path)
+	{
+		std::lock_guard<std::mutex> lock(m_modules_mutex);
+
+		const auto it = m_modules.find(file_path);
+		if (it != m_modules.end())
+			return it->second;
+
+		// Failures aren't cached, so that a corrected script can be assigned again
+		auto module = std::make_shared<Module>(file_path, this);
+		if (!module->Load())
+			return nullptr;
+
+		m_modules[file_path] = module;
+		return module;
 	}
 
 	/*------------------------------------------------------------------------------
@@ -24,6 +24,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <vector>
 #include <string>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
 #include "../Core/ISubsystem.h"
 //=============================
 
@@ -41,6 +45,19 @@ struct asSMessageInfo;
 namespace Spartan
 {
 	class Module;
+	class ScriptInstance;
+	class Profiler;
+	class Threading;
+
+	// The instances of a script type, updated together with a single context preparation
+	struct ScriptBatch
+	{
+		std::string name;
+		asIScriptFunction* update_function = nullptr;
+		bool thread_safe = false; // the type implements ThreadSafe, so its instances are updated across threads
+		std::vector<asIScriptObject*> objects;
+		float time_ms = 0.0f; // duration of the last update
+	};
 
 	class Scripting : public ISubsystem
 	{
@@ -50,25 +67,58 @@ namespace Spartan
 
         //= Subsystem =============
         bool Initialize() override;
+        void Tick(float delta_time) override;
         //=========================
 
 		void Clear();
 		asIScriptEngine* GetAsIScriptEngine() const;
+		const auto& GetCacheDirectory() const { return m_cache_directory; }
 
-		// Contexts
+		// Contexts, pooled per thread so that scripts can execute from worker threads
 		asIScriptContext* RequestContext();
 		void ReturnContext(asIScriptContext* ctx);
 
 		// Calls
 		bool ExecuteCall(asIScriptFunction* scriptFunc, asIScriptObject* obj, float delta_time = -1.0f);
 
-		// Modules
-		void DiscardModule(const std::string& moduleName) const;
+		// Modules, one per script file and shared by all of its instances
+		std::shared_ptr<Module> GetModule(const std::string& file_path);
+
+		// Updates, instances register themselves and are updated in batches per script type
+		void AddInstance(ScriptInstance* instance);
+		void RemoveInstance(ScriptInstance* instance);
+		void ExecuteUpdates(float delta_time);
+		const auto& GetBatches() const { return m_batches; }
+
+		// Queues a script function to be called on the main thread, once the updates are done (this is how thread safe scripts touch the world)
+		void Defer(asIScriptFunction* callback);
 
 	private:
         asIScriptEngine* m_scriptEngine = nullptr;
-		std::vector<asIScriptContext*> m_contexts;
+		std::string m_cache_directory;
+
+		// Contexts
+		std::vector<asIScriptContext*> m_contexts; // every context created, across all threads
+		std::mutex m_contexts_mutex;
+		std::atomic<uint32_t> m_contexts_generation = 0;
+
+		// Modules
+		std::unordered_map<std::string, std::shared_ptr<Module>> m_modules;
+		std::mutex m_modules_mutex;
+		float m_hot_reload_timer = 0.0f;
+
+		// Updates
+		std::vector<ScriptInstance*> m_instances;
+		std::vector<ScriptInstance*> m_instances_updating; // copy of m_instances, taken when the updates begin
+		std::mutex m_instances_mutex;
+		std::unordered_map<const Module*, ScriptBatch> m_batches;
+		std::vector<asIScriptFunction*> m_deferred;
+		std::mutex m_deferred_mutex;
+		Profiler* m_profiler	= nullptr;
+		Threading* m_threading	= nullptr;
 
+		void ExecuteBatch(asIScriptFunction* function, asIScriptObject* const* objects, uint32_t count, float delta_time);
+		void ExecuteDeferred();
 		void LogExceptionInfo(asIScriptContext* ctx) const;
 		void message_callback(const asSMessageInfo& msg) const;
 	};
@@ -84,6 +84,14 @@ namespace Spartan
         return available_threads;
     }
 
+    const string& Threading::GetThreadName(thread::id thread_id) const
+    {
+        static const string empty;
+
+        auto it = m_thread_names.find(thread_id);
+        return it != m_thread_names.end() ? it->second : empty;
+    }
+
     void Threading::Flush(bool removed_queued /*= false*/)
     {
         // Clear any queued tasks
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==================
 #include <vector>
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <deque>
@@ -83,7 +84,7 @@ namespace Spartan
         void AddTaskLoop(Function&& function, uint32_t range)
         {
             uint32_t available_threads  = GetThreadsAvailable();
-            vector<bool> tasks_done     = vector<bool>(available_threads, false);
+            std::atomic<uint32_t> tasks_done(0); // a counter, as the threads can't safely write to neighbouring bits of a vector<bool>
             const uint32_t task_count   = available_threads + 1; // plus one for the current thread
 
             uint32_t start  = 0;
@@ -94,21 +95,16 @@ namespace Spartan
                 end     = start + (range / task_count);
 
                 // Kick off task
-                AddTask([&function, &tasks_done, i, start, end] { function(start, end); tasks_done[i] = true; });
+                AddTask([&function, &tasks_done, start, end] { function(start, end); tasks_done++; });
             }
 
             // Do last task in the current thread
             function(end, range);
 
             // Wait till the threads are done
-            uint32_t tasks = 0;
-            while (tasks != tasks_done.size())
+            while (tasks_done != available_threads)
             {
-                tasks = 0;
-                for (const bool job_done : tasks_done)
-                {
-                    tasks += job_done ? 1 : 0;
-                }
+                std::this_thread::yield();
             }
         }
 
@@ -120,6 +116,8 @@ namespace Spartan
         uint32_t GetThreadsAvailable()      const;
         // Returns true if at least one task is running
         bool AreTasksRunning()              const { return GetThreadsAvailable() != GetThreadCount(); }
+        // Get the name which was given to a thread on creation (empty if the thread is not known)
+        const std::string& GetThreadName(std::thread::id thread_id) const;
         // Waits for all executing (and queued if requested) tasks to finish
         void Flush(bool removed_queued = false);
 
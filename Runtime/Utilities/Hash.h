@@ -21,6 +21,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
+//= INCLUDES ======
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+//=================
+
 namespace Spartan::Utility::Hash
 {
     template <class T>
@@ -29,4 +35,18 @@ namespace Spartan::Utility::Hash
         std::hash<T> hasher;
         seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
     }
+
+    // 64-bit FNV-1a, unlike std::hash it's the same on every run and platform, so it can key files on disk.
+    // Pass the previous result as the basis to hash several pieces as one.
+    constexpr uint64_t fnv1a_basis = 0xCBF29CE484222325;
+    inline uint64_t fnv1a(const void* data, const size_t size, uint64_t hash = fnv1a_basis)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3;
+        }
+
+        return hash;
+    }
 }
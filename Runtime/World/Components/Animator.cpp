@@ -0,0 +1,264 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===============================
+#include "Animator.h"
+#include "../../Rendering/Animation.h"
+#include "../../Rendering/Skeleton.h"
+#include "../../IO/FileStream.h"
+#include "../../Resource/ResourceCache.h"
+//==========================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    Animator::Animator(Context* context, Entity* entity, uint32_t id /*= 0*/) : IComponent(context, entity, id)
+    {
+
+    }
+
+    void Animator::Serialize(FileStream* stream)
+    {
+        const bool has_skeleton = m_skeleton != nullptr;
+        stream->Write(has_skeleton);
+        if (has_skeleton)
+        {
+            m_skeleton->Serialize(stream);
+        }
+
+        const bool has_animation = m_layer.animation != nullptr;
+        stream->Write(has_animation);
+        if (has_animation)
+        {
+            stream->Write(m_layer.animation->GetResourceName());
+        }
+
+        stream->Write(m_layer.time);
+        stream->Write(m_speed);
+        stream->Write(m_is_looping);
+        stream->Write(m_is_playing);
+    }
+
+    void Animator::Deserialize(FileStream* stream)
+    {
+        if (stream->ReadAs<bool>())
+        {
+            auto skeleton = make_shared<Skeleton>();
+            skeleton->Deserialize(stream);
+            SetSkeleton(skeleton);
+        }
+
+        if (stream->ReadAs<bool>())
+        {
+            m_layer.animation = m_context->GetSubsystem<ResourceCache>()->GetByName<Animation>(stream->ReadAs<string>());
+            LayerBind(m_layer);
+        }
+
+        stream->Read(&m_layer.time);
+        stream->Read(&m_speed);
+        stream->Read(&m_is_looping);
+        stream->Read(&m_is_playing);
+        m_pose_dirty = true;
+    }
+
+    void Animator::SetSkeleton(const shared_ptr<Skeleton>& skeleton)
+    {
+        m_skeleton = skeleton;
+
+        const uint32_t joint_count  = m_skeleton ? m_skeleton->GetJointCount() : 0;
+        const uint32_t bone_count   = m_skeleton ? m_skeleton->GetBoneCount() : 0;
+
+        m_pose_translations.resize(joint_count);
+        m_pose_rotations.resize(joint_count);
+        m_pose_scales.resize(joint_count);
+        m_fade_translations.resize(joint_count);
+        m_fade_rotations.resize(joint_count);
+        m_fade_scales.resize(joint_count);
+        m_joint_matrices.assign(joint_count, Matrix::Identity);
+        m_bone_matrices.resize(bone_count);
+        m_skinning_matrices.assign(bone_count, Matrix::Identity);
+
+        // The track mapping depends on the skeleton
+        LayerBind(m_layer);
+        LayerBind(m_layer_fading);
+        m_pose_dirty = true;
+    }
+
+    void Animator::Play(const shared_ptr<Animation>& animation, const float fade_duration /*= 0.0f*/)
+    {
+        // Cross-fade from the current animation
+        if (fade_duration > 0.0f && m_layer.animation && m_is_playing)
+        {
+            m_layer_fading  = m_layer;
+            m_fade_duration = fade_duration;
+            m_fade_time     = 0.0f;
+        }
+        else
+        {
+            m_layer_fading  = Layer();
+            m_fade_duration = 0.0f;
+        }
+
+        m_layer.animation   = animation;
+        m_layer.time        = 0.0f;
+        m_is_playing        = animation != nullptr;
+        m_pose_dirty        = true;
+        LayerBind(m_layer);
+    }
+
+    void Animator::Advance(const float delta_time)
+    {
+        if (!m_is_playing || !m_layer.animation)
+            return;
+
+        LayerAdvance(m_layer, delta_time);
+
+        // The animation which fades out keeps playing until the fade is over
+        if (m_layer_fading.animation)
+        {
+            m_fade_time += delta_time;
+            if (m_fade_time < m_fade_duration)
+            {
+                LayerAdvance(m_layer_fading, delta_time);
+            }
+            else
+            {
+                m_layer_fading = Layer();
+            }
+        }
+
+        m_pose_dirty = true;
+    }
+
+    void Animator::PoseUpdate()
+    {
+        if (!m_pose_dirty)
+            return;
+
+        m_pose_dirty = false;
+
+        if (!m_skeleton || !m_layer.animation)
+            return;
+
+        const uint32_t joint_count = m_skeleton->GetJointCount();
+        if (joint_count == 0)
+            return;
+
+        // Sample
+        LayerSample(m_layer, m_pose_translations.data(), m_pose_rotations.data(), m_pose_scales.data());
+
+        // Blend with the animation which fades out
+        if (m_layer_fading.animation)
+        {
+            LayerSample(m_layer_fading, m_fade_translations.data(), m_fade_rotations.data(), m_fade_scales.data());
+
+            const float weight = m_fade_time / m_fade_duration;
+            for (uint32_t i = 0; i < joint_count; i++)
+            {
+                m_pose_translations[i]  = m_fade_translations[i] + (m_pose_translations[i] - m_fade_translations[i]) * weight;
+                m_pose_scales[i]        = m_fade_scales[i] + (m_pose_scales[i] - m_fade_scales[i]) * weight;
+                m_pose_rotations[i]     = Quaternion::Lerp(m_fade_rotations[i], m_pose_rotations[i], weight);
+            }
+        }
+
+        // Local to model space, parents precede their children so they are always resolved first
+        const vector<int32_t>& parents = m_skeleton->GetParents();
+        for (uint32_t i = 0; i < joint_count; i++)
+        {
+            const Matrix local  = Matrix(m_pose_translations[i], m_pose_rotations[i], m_pose_scales[i]);
+            const int32_t parent = parents[i];
+            m_joint_matrices[i] = parent >= 0 ? local * m_joint_matrices[parent] : local;
+        }
+
+        // Skinning palette, in a single batch
+        const uint32_t bone_count = m_skeleton->GetBoneCount();
+        if (bone_count != 0)
+        {
+            const vector<uint32_t>& bone_joints = m_skeleton->GetBoneJoints();
+            for (uint32_t i = 0; i < bone_count; i++)
+            {
+                m_bone_matrices[i] = m_joint_matrices[bone_joints[i]];
+            }
+
+            Matrix::Multiply(m_skeleton->GetBoneOffsets().data(), m_bone_matrices.data(), m_skinning_matrices.data(), bone_count);
+        }
+    }
+
+    void Animator::LayerBind(Layer& layer) const
+    {
+        layer.tracks.clear();
+
+        if (!m_skeleton || !layer.animation)
+            return;
+
+        // Resolve the tracks by name once, sampling only deals with indices
+        const vector<string>& names = m_skeleton->GetNames();
+        layer.tracks.resize(names.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(names.size()); i++)
+        {
+            layer.tracks[i] = layer.animation->GetTrackIndex(names[i]);
+        }
+    }
+
+    void Animator::LayerAdvance(Layer& layer, const float delta_time) const
+    {
+        const float duration = layer.animation->GetDurationSeconds();
+        layer.time += delta_time * m_speed;
+
+        if (duration <= 0.0f)
+        {
+            layer.time = 0.0f;
+        }
+        else if (m_is_looping)
+        {
+            layer.time = fmodf(layer.time, duration);
+            layer.time = layer.time < 0.0f ? layer.time + duration : layer.time;
+        }
+        else
+        {
+            layer.time = Helper::Clamp(layer.time, 0.0f, duration);
+        }
+    }
+
+    void Animator::LayerSample(const Layer& layer, Vector3* translations, Quaternion* rotations, Vector3* scales) const
+    {
+        // Start from the bind pose, joints (or channels) without keys keep it
+        const uint32_t joint_count = m_skeleton->GetJointCount();
+        memcpy(translations, m_skeleton->GetBindTranslations().data(), sizeof(Vector3) * joint_count);
+        memcpy(rotations, m_skeleton->GetBindRotations().data(), sizeof(Quaternion) * joint_count);
+        memcpy(scales, m_skeleton->GetBindScales().data(), sizeof(Vector3) * joint_count);
+
+        if (layer.tracks.size() != joint_count)
+            return;
+
+        for (uint32_t i = 0; i < joint_count; i++)
+        {
+            if (layer.tracks[i] != -1)
+            {
+                layer.animation->Sample(static_cast<uint32_t>(layer.tracks[i]), layer.time, translations[i], rotations[i], scales[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include "IComponent.h"
+#include <memory>
+#include <vector>
+#include "../../Math/Matrix.h"
+//=============================
+
+namespace Spartan
+{
+    class Animation;
+    class Skeleton;
+
+    class SPARTAN_CLASS Animator : public IComponent
+    {
+    public:
+        Animator(Context* context, Entity* entity, uint32_t id = 0);
+        ~Animator() = default;
+
+        //= IComponent ===============================
+        void Serialize(FileStream* stream) override;
+        void Deserialize(FileStream* stream) override;
+        //============================================
+
+        // Skeleton
+        void SetSkeleton(const std::shared_ptr<Skeleton>& skeleton);
+        const auto& GetSkeleton() const { return m_skeleton; }
+
+        // Playback
+        void Play(const std::shared_ptr<Animation>& animation, float fade_duration = 0.0f);
+        void Stop()                             { m_is_playing = false; }
+        bool IsPlaying()                const   { return m_is_playing; }
+        Animation* GetAnimation()       const   { return m_layer.animation.get(); }
+        float GetTime()                 const   { return m_layer.time; }
+        void SetTime(const float time)          { m_layer.time = time; m_pose_dirty = true; }
+        float GetSpeed()                const   { return m_speed; }
+        void SetSpeed(const float speed)        { m_speed = speed; }
+        bool GetLooping()               const   { return m_is_looping; }
+        void SetLooping(const bool looping)     { m_is_looping = looping; }
+
+        // Advances the playback, the world calls it every tick. It's cheap, the pose is only evaluated when it's asked for.
+        void Advance(float delta_time);
+
+        // Model space matrices of every joint, and the skinning palette (offset * model space matrix of every bone).
+        // The pose is evaluated on first access after the playback moved, so nothing is computed for animators which nobody reads.
+        const auto& GetJointMatrices()      { PoseUpdate(); return m_joint_matrices; }
+        const auto& GetSkinningMatrices()   { PoseUpdate(); return m_skinning_matrices; }
+
+    private:
+        struct Layer
+        {
+            std::shared_ptr<Animation> animation;
+            std::vector<int32_t> tracks; // track of every joint (-1 if the joint is not animated)
+            float time = 0.0f;
+        };
+
+        void PoseUpdate();
+        void LayerBind(Layer& layer) const;
+        void LayerAdvance(Layer& layer, float delta_time) const;
+        void LayerSample(const Layer& layer, Math::Vector3* translations, Math::Quaternion* rotations, Math::Vector3* scales) const;
+
+        std::shared_ptr<Skeleton> m_skeleton;
+        Layer m_layer;
+        Layer m_layer_fading; // the previous animation, while fading out
+        float m_fade_duration   = 0.0f;
+        float m_fade_time       = 0.0f;
+        float m_speed           = 1.0f;
+        bool m_is_looping       = true;
+        bool m_is_playing       = false;
+        bool m_pose_dirty       = true;
+
+        // Pose (SoA), local to the parent joint
+        std::vector<Math::Vector3> m_pose_translations;
+        std::vector<Math::Quaternion> m_pose_rotations;
+        std::vector<Math::Vector3> m_pose_scales;
+        std::vector<Math::Vector3> m_fade_translations;
+        std::vector<Math::Quaternion> m_fade_rotations;
+        std::vector<Math::Vector3> m_fade_scales;
+
+        // Output
+        std::vector<Math::Matrix> m_joint_matrices;
+        std::vector<Math::Matrix> m_bone_matrices;
+        std::vector<Math::Matrix> m_skinning_matrices;
+    };
+}
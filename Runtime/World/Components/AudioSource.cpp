@@ -21,6 +21,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ============================
 #include "AudioSource.h"
+#include "Transform.h"
+#include "../../Audio/Audio.h"
 #include "../../Audio/AudioClip.h"
 #include "../../IO/FileStream.h"
 #include "../../Resource/ResourceCache.h"
@@ -42,7 +44,9 @@ namespace Spartan
 		m_volume			= 1.0f;
 		m_pitch				= 1.0f;
 		m_pan				= 0.0f;
+		m_position			= 0.0f;
 		m_audio_clip_loaded	= false;
+		m_audio				= m_context->GetSubsystem<Audio>();
 	}
 	
 	void AudioSource::OnInitialize()
@@ -69,18 +73,12 @@ namespace Spartan
 	
 	void AudioSource::OnRemove()
 	{
-		if (!m_audio_clip)
-			return;
-	
-		m_audio_clip->Stop();
+		Stop();
 	}
 	
 	void AudioSource::OnTick(float delta_time)
 	{
-		if (!m_audio_clip)
-			return;
-	
-		m_audio_clip->Update();
+		// 3D attributes are updated by Audio, for the voices which are real
 	}
 	
 	void AudioSource::Serialize(FileStream* stream)
@@ -133,27 +131,97 @@ namespace Spartan
 		return m_audio_clip ? m_audio_clip->GetResourceName() : "";
 	}
 	
-	bool AudioSource::Play() const
+	bool AudioSource::Play()
     {
 		if (!m_audio_clip)
 			return false;
+
+		// Audio decides whether this gets a real channel
+		m_position = 0.0f;
+		m_audio->AddVoice(this);
+	
+		return true;
+	}
 	
-		m_audio_clip->Play();
+	bool AudioSource::Stop()
+    {
+		m_audio->RemoveVoice(this);
+
+		if (!m_audio_clip)
+			return false;
+	
+		return m_audio_clip->Stop();
+	}
+
+	bool AudioSource::PlayReal()
+	{
+		if (!m_audio_clip || !m_audio_clip->Play(m_position))
+			return false;
+
 		m_audio_clip->SetMute(m_mute);
 		m_audio_clip->SetVolume(m_volume);
 		m_audio_clip->SetLoop(m_loop);
 		m_audio_clip->SetPriority(m_priority);
+		m_audio_clip->SetPitch(m_pitch);
 		m_audio_clip->SetPan(m_pan);
-	
+
 		return true;
 	}
-	
-	bool AudioSource::Stop() const
-    {
+
+	void AudioSource::PlayVirtual()
+	{
+		if (!m_audio_clip)
+			return;
+
+		m_position = m_audio_clip->GetPosition();
+		m_audio_clip->Stop();
+	}
+
+	bool AudioSource::Advance(const float delta_time)
+	{
 		if (!m_audio_clip)
 			return false;
-	
-		return m_audio_clip->Stop();
+
+		const float length	= m_audio_clip->GetLength();
+		m_position			+= delta_time * m_pitch;
+		if (m_position < length)
+			return true;
+
+		if (!m_loop || length <= 0.0f)
+			return false;
+
+		m_position = fmod(m_position, length);
+		return true;
+	}
+
+	float AudioSource::GetAudibility(const Vector3& listener_position, const bool has_listener) const
+	{
+		if (!m_audio_clip || m_mute)
+			return 0.0f;
+
+		if (!has_listener)
+			return m_volume;
+
+		// Linear rolloff, the same as the clip's channel uses
+		const float distance_min	= m_audio_clip->GetMinDistance();
+		const float distance_max	= m_audio_clip->GetMaxDistance();
+		const float distance		= Vector3::Distance(GetTransform()->GetPosition(), listener_position);
+		const float attenuation		= distance_max > distance_min ? 1.0f - Helper::Saturate((distance - distance_min) / (distance_max - distance_min)) : 1.0f;
+
+		return m_volume * attenuation;
+	}
+
+	bool AudioSource::IsPlayingReal() const
+	{
+		return m_audio_clip && m_audio_clip->IsPlaying();
+	}
+
+	void AudioSource::UpdateReal() const
+	{
+		if (!m_audio_clip)
+			return;
+
+		m_audio_clip->Update();
 	}
 	
 	void AudioSource::SetMute(bool mute)
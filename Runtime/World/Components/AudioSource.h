@@ -30,6 +30,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Spartan
 {
 	class AudioClip;
+	class Audio;
+
+	namespace Math
+	{
+		class Vector3;
+	}
 
 	class SPARTAN_CLASS AudioSource : public IComponent
 	{
@@ -51,8 +57,8 @@ namespace Spartan
         void SetAudioClip(const std::string& file_path);
 		std::string GetAudioClipName() const;
 
-		bool Play() const;
-		bool Stop() const;
+		bool Play();
+		bool Stop();
 
 		bool GetMute() const { return m_mute; }
 		void SetMute(bool mute);
@@ -76,6 +82,19 @@ namespace Spartan
 		void SetPan(float pan);
 		//================================================================================
 
+		//= VOICE (driven by Audio) ===============================================
+		// Plays on a real channel, from where playback has (logically) got to
+		bool PlayReal();
+		// Releases the channel, playback continues logically
+		void PlayVirtual();
+		// Advances virtual playback, returns false once a non looping clip has ended
+		bool Advance(float delta_time);
+		// Volume after distance attenuation, in the range [0, 1]
+		float GetAudibility(const Math::Vector3& listener_position, bool has_listener) const;
+		bool IsPlayingReal() const;
+		void UpdateReal() const;
+		//=========================================================================
+
 	private:
 		std::shared_ptr<AudioClip> m_audio_clip;
 		bool m_mute;
@@ -85,6 +104,8 @@ namespace Spartan
 		float m_volume;
 		float m_pitch;
 		float m_pan;
+		float m_position;
 		bool m_audio_clip_loaded;
+		Audio* m_audio;
 	};
 }
@@ -177,22 +177,9 @@ namespace Spartan
 		m_ray		= Ray(GetTransform()->GetPosition(), Unproject(mouse_position_relative));
 		auto hits	= m_ray.Trace(m_context);
 
-        // Create a struct to hold hit related data
-        struct scored_entity
-        {
-            scored_entity(const shared_ptr<Entity>& entity, const float distance_ray, const float distance_obb)
-            {
-                this->entity = entity;
-                score = distance_ray * 0.1f + distance_obb * 0.9f;
-            }
-
-            shared_ptr<Entity> entity;
-            float score;
-        };
-        vector<scored_entity> m_scored;
-
-        // Go through all the hits and score them
-        m_scored.reserve(hits.size());
+        // Keep the hit with the highest score, the hits come from the world's bounding volume hierarchy
+        picked = nullptr;
+        float score_best = -INFINITY;
 		for (const auto& hit : hits)
 		{
             // Filter hits that start inside OBBs
@@ -200,27 +187,18 @@ namespace Spartan
 				continue;
 
             // Score this hit
-            const BoundingBox& aabb = hit.m_entity->GetComponent<Renderable>()->GetAabb();
-            const float distance_abb      = Vector3::DistanceSquared(hit.m_position, aabb.GetCenter());
-            m_scored.emplace_back
-            (
-                hit.m_entity,
-                1.0f - hit.m_distance / m_ray.GetLength(),          // normalized ray distance score
-                1.0f - (distance_abb / aabb.GetExtents().Length())  // normalized aabb center distance score
-            );
-		}
-        m_scored.shrink_to_fit();
+            const BoundingBox& aabb     = hit.m_entity->GetRenderable()->GetAabb();
+            const float distance_abb    = Vector3::DistanceSquared(hit.m_position, aabb.GetCenter());
+            const float score_ray       = 1.0f - hit.m_distance / m_ray.GetLength();              // normalized ray distance score
+            const float score_aabb      = 1.0f - (distance_abb / aabb.GetExtents().Length());     // normalized aabb center distance score
+            const float score           = score_ray * 0.1f + score_aabb * 0.9f;
 
-        // Return entity with highest score
-        picked = nullptr;
-        if (!m_scored.empty())
-        {
-            // ordering descendingly
-            sort(m_scored.begin(), m_scored.end(), [](const scored_entity& a, const scored_entity& b) { return a.score > b.score; });
-
-            picked = m_scored.front().entity;
-            return true;
-        }
+            if (score > score_best)
+            {
+                score_best  = score;
+                picked      = hit.m_entity;
+            }
+		}
 
         // If no hit was good enough but there are hits, compromise by picking the closest one
         if (!picked && !hits.empty())
@@ -26,9 +26,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Renderable.h"
 #include "../Entity.h"
 #include "../../IO/FileStream.h"
+#include "../../Core/Context.h"
+#include "../../Core/FileSystem.h"
+#include "../../Physics/Physics.h"
 #include "../../Physics/BulletPhysicsHelper.h"
 #include "../../Logging/Log.h"
 #include "../../RHI/RHI_Vertex.h"
+#include "../../Rendering/Model.h"
 #pragma warning(push, 0) // Hide warnings which belong to Bullet
 #include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletCollision/CollisionShapes/btCylinderShape.h>
@@ -36,6 +40,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
 #include <BulletCollision/CollisionShapes/btConeShape.h>
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 #pragma warning(pop)
 //=============================================================
 
@@ -170,6 +176,7 @@ namespace Spartan
 			break;
 
 		case ColliderShape_Mesh:
+		{
 			// Get Renderable
 			Renderable* renderable = GetEntity()->GetComponent<Renderable>();
 			if (!renderable)
@@ -215,6 +222,51 @@ namespace Spartan
 			break;
 		}
 
+		case ColliderShape_MeshStatic:
+		{
+			Renderable* renderable = GetEntity()->GetComponent<Renderable>();
+			if (!renderable)
+			{
+				LOG_WARNING("Can't construct static mesh shape, there is no Renderable component attached.");
+				return;
+			}
+
+			if (const auto& rigid_body = m_entity->GetComponent<RigidBody>())
+			{
+				if (rigid_body->GetMass() != 0.0f && !rigid_body->GetIsKinematic())
+				{
+					LOG_WARNING("Static mesh shapes can't be simulated, the rigid body should have no mass or be kinematic.");
+				}
+			}
+
+			vector<uint32_t> indices;
+			vector<RHI_Vertex_PosTexNorTan> vertices;
+			renderable->GeometryGet(&indices, &vertices);
+
+			// Cache the BVH next to the model, default geometry is cheap enough to build every time
+			string cache_file_path_base;
+			if (const Model* model = renderable->GeometryModel())
+			{
+				if (renderable->GeometryType() == Geometry_Custom && !model->GetResourceFilePathNative().empty())
+				{
+					const string& model_path	= model->GetResourceFilePathNative();
+					cache_file_path_base		= FileSystem::GetDirectoryFromFilePath(model_path) + FileSystem::GetFileNameNoExtensionFromFilePath(model_path);
+				}
+			}
+
+			m_mesh_static = GetContext()->GetSubsystem<Physics>()->AcquireStaticMesh(indices, vertices, cache_file_path_base);
+			if (!m_mesh_static)
+			{
+				LOG_WARNING("Failed to construct static mesh shape.");
+				return;
+			}
+
+			// The triangles and their BVH are shared, only the scale is per collider
+			m_shape = new btScaledBvhTriangleMeshShape(m_mesh_static, ToBtVector3(worldScale));
+			break;
+		}
+		}
+
 		m_shape->setUserPointer(this);
 
 		RigidBody_SetShape(m_shape);
@@ -224,7 +276,8 @@ namespace Spartan
 	void Collider::Shape_Release()
 	{
 		RigidBody_SetShape(nullptr);
-		safe_delete(m_shape);
+		GetContext()->GetSubsystem<Physics>()->RemoveShape(m_shape);
+		GetContext()->GetSubsystem<Physics>()->ReleaseStaticMesh(m_mesh_static);
 	}
 
 	void Collider::RigidBody_SetShape(btCollisionShape* shape) const
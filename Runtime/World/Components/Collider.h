@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //=============================
 
 class btCollisionShape;
+class btBvhTriangleMeshShape;
 
 namespace Spartan
 {
@@ -41,6 +42,7 @@ namespace Spartan
 		ColliderShape_Capsule,
 		ColliderShape_Cone,
 		ColliderShape_Mesh,
+		ColliderShape_MeshStatic, // exact triangles, for static (or kinematic) bodies only
 	};
 
 	class SPARTAN_CLASS Collider : public IComponent
@@ -82,6 +84,7 @@ namespace Spartan
 
 		ColliderShape m_shapeType;
 		btCollisionShape* m_shape;
+		btBvhTriangleMeshShape* m_mesh_static = nullptr; // shared with every collider on the same geometry
 		Math::Vector3 m_size;
 		Math::Vector3 m_center;
 		uint32_t m_vertexLimit = 100000;
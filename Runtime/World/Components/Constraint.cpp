@@ -230,46 +230,47 @@ namespace Spartan
 		Vector3 own_body_scaled_position    = m_position * m_transform->GetScale() - rigid_body_own->GetCenterOfMass();
 		Vector3 other_body_scaled_position  = !m_bodyOther.expired() ? m_positionOther * rigid_body_other->GetTransform()->GetScale() - rigid_body_other->GetCenterOfMass() : m_positionOther;
 
-		switch (m_constraint->getConstraintType())
-		{
-		case POINT2POINT_CONSTRAINT_TYPE:
-		{
-			auto* point_constraint = dynamic_cast<btPoint2PointConstraint*>(m_constraint);
-			point_constraint->setPivotA(ToBtVector3(own_body_scaled_position));
-			point_constraint->setPivotB(ToBtVector3(other_body_scaled_position));
-		}
-		break;
-
-		case HINGE_CONSTRAINT_TYPE:
-		{
-			auto* hinge_constraint = dynamic_cast<btHingeConstraint*>(m_constraint);
-			btTransform own_frame(ToBtQuaternion(m_rotation), ToBtVector3(own_body_scaled_position));
-			btTransform other_frame(ToBtQuaternion(m_rotationOther), ToBtVector3(other_body_scaled_position));
-			hinge_constraint->setFrames(own_frame, other_frame);
-		}
-		break;
-
-		case SLIDER_CONSTRAINT_TYPE:
-		{
-			auto* slider_constraint = dynamic_cast<btSliderConstraint*>(m_constraint);
-			btTransform own_frame(ToBtQuaternion(m_rotation), ToBtVector3(own_body_scaled_position));
-			btTransform other_frame(ToBtQuaternion(m_rotationOther), ToBtVector3(other_body_scaled_position));
-			slider_constraint->setFrames(own_frame, other_frame);
-		}
-		break;
+		const btTransform own_frame(ToBtQuaternion(m_rotation), ToBtVector3(own_body_scaled_position));
+		const btTransform other_frame(ToBtQuaternion(m_rotationOther), ToBtVector3(other_body_scaled_position));
 
-		case CONETWIST_CONSTRAINT_TYPE:
+		// The constraint may be in a world which is being simulated on another thread
+		m_physics->Enqueue([constraint = m_constraint, own_frame, other_frame]()
 		{
-			auto* cone_twist_constraint = dynamic_cast<btConeTwistConstraint*>(m_constraint);
-			btTransform own_frame(ToBtQuaternion(m_rotation), ToBtVector3(own_body_scaled_position));
-			btTransform other_frame(ToBtQuaternion(m_rotationOther), ToBtVector3(other_body_scaled_position));
-			cone_twist_constraint->setFrames(own_frame, other_frame);
-		}
-		break;
-
-		default:
-			break;
-		}
+		    switch (constraint->getConstraintType())
+		    {
+		    case POINT2POINT_CONSTRAINT_TYPE:
+		    {
+			    auto* point_constraint = dynamic_cast<btPoint2PointConstraint*>(constraint);
+			    point_constraint->setPivotA(own_frame.getOrigin());
+			    point_constraint->setPivotB(other_frame.getOrigin());
+		    }
+		    break;
+
+		    case HINGE_CONSTRAINT_TYPE:
+		    {
+			    auto* hinge_constraint = dynamic_cast<btHingeConstraint*>(constraint);
+			    hinge_constraint->setFrames(own_frame, other_frame);
+		    }
+		    break;
+
+		    case SLIDER_CONSTRAINT_TYPE:
+		    {
+			    auto* slider_constraint = dynamic_cast<btSliderConstraint*>(constraint);
+			    slider_constraint->setFrames(own_frame, other_frame);
+		    }
+		    break;
+
+		    case CONETWIST_CONSTRAINT_TYPE:
+		    {
+			    auto* cone_twist_constraint = dynamic_cast<btConeTwistConstraint*>(constraint);
+			    cone_twist_constraint->setFrames(own_frame, other_frame);
+		    }
+		    break;
+
+		    default:
+			    break;
+		    }
+		});
 	}
 
 	/*------------------------------------------------------------------------------
@@ -366,44 +367,48 @@ namespace Spartan
 		if (!m_constraint)
 			return;
 
-		switch (m_constraint->getConstraintType())
-		{
-			case HINGE_CONSTRAINT_TYPE:
-			    {
-			        auto* hinge_constraint = dynamic_cast<btHingeConstraint*>(m_constraint);
-			        hinge_constraint->setLimit(m_lowLimit.x * Helper::DEG_TO_RAD, m_highLimit.x * Helper::DEG_TO_RAD);
-			    }
-			    break;
-
-			case SLIDER_CONSTRAINT_TYPE:
-			    {
-			        auto* slider_constraint = dynamic_cast<btSliderConstraint*>(m_constraint);
-			        slider_constraint->setUpperLinLimit(m_highLimit.x);
-			        slider_constraint->setUpperAngLimit(m_highLimit.y * Helper::DEG_TO_RAD);
-			        slider_constraint->setLowerLinLimit(m_lowLimit.x);
-			        slider_constraint->setLowerAngLimit(m_lowLimit.y * Helper::DEG_TO_RAD);
-			    }
-			    break;
-
-			case CONETWIST_CONSTRAINT_TYPE:
-			    {
-			        auto* cone_twist_constraint = dynamic_cast<btConeTwistConstraint*>(m_constraint);
-			        cone_twist_constraint->setLimit(m_highLimit.y * Helper::DEG_TO_RAD, m_highLimit.y * Helper::DEG_TO_RAD, m_highLimit.x * Helper::DEG_TO_RAD);
-			    }
-			    break;
-
-			default:
-			    break;
-		}
-
-		if (m_errorReduction != 0.0f)
+		// The constraint may be in a world which is being simulated on another thread
+		m_physics->Enqueue([constraint = m_constraint, low_limit = m_lowLimit, high_limit = m_highLimit, error_reduction = m_errorReduction, force_mixing = m_constraintForceMixing]()
 		{
-		    m_constraint->setParam(BT_CONSTRAINT_STOP_ERP, m_errorReduction);
-		}
-
-		if (m_constraintForceMixing != 0.0f)
-		{
-			m_constraint->setParam(BT_CONSTRAINT_STOP_CFM, m_constraintForceMixing);
-		}
+		    switch (constraint->getConstraintType())
+		    {
+			    case HINGE_CONSTRAINT_TYPE:
+			        {
+			            auto* hinge_constraint = dynamic_cast<btHingeConstraint*>(constraint);
+			            hinge_constraint->setLimit(low_limit.x * Helper::DEG_TO_RAD, high_limit.x * Helper::DEG_TO_RAD);
+			        }
+			        break;
+
+			    case SLIDER_CONSTRAINT_TYPE:
+			        {
+			            auto* slider_constraint = dynamic_cast<btSliderConstraint*>(constraint);
+			            slider_constraint->setUpperLinLimit(high_limit.x);
+			            slider_constraint->setUpperAngLimit(high_limit.y * Helper::DEG_TO_RAD);
+			            slider_constraint->setLowerLinLimit(low_limit.x);
+			            slider_constraint->setLowerAngLimit(low_limit.y * Helper::DEG_TO_RAD);
+			        }
+			        break;
+
+			    case CONETWIST_CONSTRAINT_TYPE:
+			        {
+			            auto* cone_twist_constraint = dynamic_cast<btConeTwistConstraint*>(constraint);
+			            cone_twist_constraint->setLimit(high_limit.y * Helper::DEG_TO_RAD, high_limit.y * Helper::DEG_TO_RAD, high_limit.x * Helper::DEG_TO_RAD);
+			        }
+			        break;
+
+			    default:
+			        break;
+		    }
+
+		    if (error_reduction != 0.0f)
+		    {
+		        constraint->setParam(BT_CONSTRAINT_STOP_ERP, error_reduction);
+		    }
+
+		    if (force_mixing != 0.0f)
+		    {
+			    constraint->setParam(BT_CONSTRAINT_STOP_CFM, force_mixing);
+		    }
+		});
 	}
 }
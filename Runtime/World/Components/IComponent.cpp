@@ -34,6 +34,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Renderable.h"
 #include "Transform.h"
 #include "Terrain.h"
+#include "Animator.h"
 #include "../Entity.h"
 #include "../../Core/FileSystem.h"
 //================================
@@ -83,4 +84,5 @@ namespace Spartan
 	REGISTER_COMPONENT(Environment,		ComponentType_Environment)
     REGISTER_COMPONENT(Terrain,         ComponentType_Terrain)
 	REGISTER_COMPONENT(Transform,		ComponentType_Transform)
+    REGISTER_COMPONENT(Animator,        ComponentType_Animator)
 }
@@ -53,6 +53,7 @@ namespace Spartan
 		ComponentType_Environment,
 		ComponentType_Transform,
         ComponentType_Terrain,
+        ComponentType_Animator,
 		ComponentType_Unknown
 	};
 
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ============================
 #include "Renderable.h"
 #include "Transform.h"
+#include "../World.h"
 #include "../../IO/FileStream.h"
 #include "../../Resource/ResourceCache.h"
 #include "../../Utilities/Geometry.h"
@@ -144,6 +145,7 @@ namespace Spartan
 		m_geometryVertexOffset	= stream->ReadAs<uint32_t>();
 		m_geometryVertexCount	= stream->ReadAs<uint32_t>();
 		stream->Read(&m_bounding_box);
+		m_aabb_dirty = true;
 		string model_name;
 		stream->Read(&model_name);
 		m_model = m_context->GetSubsystem<ResourceCache>()->GetByName<Model>(model_name);
@@ -179,6 +181,13 @@ namespace Spartan
 		m_geometryVertexCount	= vertex_count;
 		m_bounding_box			= bounding_box;
 		m_model					= model ? model->GetSharedPtr() : nullptr;
+		m_aabb_dirty			= true;
+
+		// Let the world refit the bounds of this entity
+		if (World* world = m_context->GetSubsystem<World>())
+		{
+			world->SpatialMarkDirty(m_entity);
+		}
 	}
 
 	void Renderable::GeometrySet(const Geometry_Type type)
@@ -210,10 +219,11 @@ namespace Spartan
     const BoundingBox& Renderable::GetAabb()
 	{
         // Updated if dirty
-        if (m_last_transform != GetTransform()->GetMatrix())
+        if (m_aabb_dirty || m_last_transform != GetTransform()->GetMatrix())
         {
             m_aabb = m_bounding_box.Transform(GetTransform()->GetMatrix());
             m_last_transform = GetTransform()->GetMatrix();
+            m_aabb_dirty = false;
         }
 
 		return m_aabb;
@@ -115,6 +115,7 @@ namespace Spartan
 		Math::BoundingBox m_bounding_box;
 		Math::BoundingBox m_aabb;
         Math::Matrix m_last_transform   = Math::Matrix::Identity;
+        bool m_aabb_dirty               = true;
         bool m_castShadows              = true;
         bool m_receiveShadows           = true;
 		bool m_material_default;
@@ -52,29 +52,54 @@ namespace Spartan
 	class MotionState : public btMotionState
 	{
 	public:
-		MotionState(RigidBody* rigidBody) { m_rigidBody = rigidBody; }
+		MotionState(RigidBody* rigidBody, Physics* physics)
+		{
+			m_rigidBody	= rigidBody;
+			m_physics	= physics;
+			m_transform	= GetEngineTransform();
+		}
 
 		// Update from engine, ENGINE -> BULLET
 		void getWorldTransform(btTransform& worldTrans) const override
 		{
-            const Vector3 lastPos		= m_rigidBody->GetTransform()->GetPosition();
-            const Quaternion lastRot	= m_rigidBody->GetTransform()->GetRotation();
-
-			worldTrans.setOrigin(ToBtVector3(lastPos + lastRot * m_rigidBody->GetCenterOfMass()));
-			worldTrans.setRotation(ToBtQuaternion(lastRot));
+			// When threaded, the engine's transform can't be read from here, the game thread queues it instead (kinematic bodies)
+			worldTrans = m_physics->IsSimulationThreaded() ? m_transform : GetEngineTransform();
 		}
 
 		// Update from bullet, BULLET -> ENGINE
 		void setWorldTransform(const btTransform& worldTrans) override
 		{
+			// When threaded, the game thread picks up the published body states instead
+			if (m_physics->IsSimulationThreaded())
+				return;
+
             const Quaternion newWorldRot	= ToQuaternion(worldTrans.getRotation());
             const Vector3 newWorldPos		= ToVector3(worldTrans.getOrigin()) - newWorldRot * m_rigidBody->GetCenterOfMass();
 
-			m_rigidBody->GetTransform()->SetPosition(newWorldPos);
-			m_rigidBody->GetTransform()->SetRotation(newWorldRot);
+			// Bullet calls this for every moved body while stepping, the transforms are written back in one pass after the step
+			if (m_physics->IsSimulating())
+			{
+				m_physics->QueueTransform(m_rigidBody->GetTransform(), newWorldPos, newWorldRot);
+				return;
+			}
+
+			m_rigidBody->GetTransform()->SetPositionAndRotation(newWorldPos, newWorldRot);
 		}
+
+		void SetTransform(const btTransform& transform) { m_transform = transform; }
+
     private:
+		btTransform GetEngineTransform() const
+		{
+            const Vector3 lastPos		= m_rigidBody->GetTransform()->GetPosition();
+            const Quaternion lastRot	= m_rigidBody->GetTransform()->GetRotation();
+
+			return btTransform(ToBtQuaternion(lastRot), ToBtVector3(lastPos + lastRot * m_rigidBody->GetCenterOfMass()));
+		}
+
         RigidBody* m_rigidBody;
+        Physics* m_physics;
+        btTransform m_transform;
 	};
 
 	RigidBody::RigidBody(Context* context, Entity* entity, uint32_t id /*= 0*/) : IComponent(context, entity, id)
@@ -129,8 +154,17 @@ namespace Spartan
 
 	void RigidBody::OnTick(float delta_time)
 	{
-		// When the rigid body is inactive or we are in editor mode, allow the user to move/rotate it
-		if (!IsActivated() || !m_context->m_engine->EngineMode_IsSet(Engine_Game))
+		if (m_physics->IsSimulationThreaded() && m_rigidBody && m_context->m_engine->EngineMode_IsSet(Engine_Game))
+		{
+			SyncFromSimulationThread();
+			return;
+		}
+
+		if (!m_rigidBody)
+			return;
+
+		// When we are in editor mode or the rigid body is inactive, allow the user to move/rotate it
+		if (!m_context->m_engine->EngineMode_IsSet(Engine_Game) || !IsActivated())
 		{
             if (GetPosition() != GetTransform()->GetPosition())
             {
@@ -195,7 +229,7 @@ namespace Spartan
 			return;
 
 		m_friction = friction;
-		m_rigidBody->setFriction(friction);
+		m_physics->Enqueue([body = m_rigidBody, friction]() { body->setFriction(friction); });
 	}
 
 	void RigidBody::SetFrictionRolling(float frictionRolling)
@@ -204,7 +238,7 @@ namespace Spartan
 			return;
 
 		m_friction_rolling = frictionRolling;
-		m_rigidBody->setRollingFriction(frictionRolling);
+		m_physics->Enqueue([body = m_rigidBody, frictionRolling]() { body->setRollingFriction(frictionRolling); });
 	}
 
 	void RigidBody::SetRestitution(float restitution)
@@ -213,7 +247,7 @@ namespace Spartan
 			return;
 
 		m_restitution = restitution;
-		m_rigidBody->setRestitution(restitution);
+		m_physics->Enqueue([body = m_rigidBody, restitution]() { body->setRestitution(restitution); });
 	}
 
 	void RigidBody::SetUseGravity(bool gravity)
@@ -248,7 +282,7 @@ namespace Spartan
 		if (!m_rigidBody)
 			return;
 
-		m_rigidBody->setLinearVelocity(ToBtVector3(velocity));
+		m_physics->Enqueue([body = m_rigidBody, velocity]() { body->setLinearVelocity(ToBtVector3(velocity)); });
 		if (velocity != Vector3::Zero && activate)
 		{
             Activate();
@@ -260,7 +294,7 @@ namespace Spartan
 		if (!m_rigidBody)
 			return;
 
-		m_rigidBody->setAngularVelocity(ToBtVector3(velocity));
+		m_physics->Enqueue([body = m_rigidBody, velocity]() { body->setAngularVelocity(ToBtVector3(velocity)); });
 		if (velocity != Vector3::Zero && activate)
 		{
 			Activate();
@@ -274,13 +308,15 @@ namespace Spartan
 
 		Activate();
 
-		if (mode == Force)
+		// When threaded, a force would accumulate over all the frames which happen during a step, so it's applied as this frame's impulse instead
+		if (mode == Force && !m_physics->IsSimulationThreaded())
 		{
-			m_rigidBody->applyCentralForce(ToBtVector3(force));
+			m_physics->Enqueue([body = m_rigidBody, force]() { body->applyCentralForce(ToBtVector3(force)); });
 		}
-		else if (mode == Impulse)
+		else
 		{
-			m_rigidBody->applyCentralImpulse(ToBtVector3(force));
+			const Vector3 impulse = mode == Force ? force * m_physics->GetFrameDeltaTime() : force;
+			m_physics->Enqueue([body = m_rigidBody, impulse]() { body->applyCentralImpulse(ToBtVector3(impulse)); });
 		}
 	}
 
@@ -291,13 +327,14 @@ namespace Spartan
 
 		Activate();
 
-		if (mode == Force)
+		if (mode == Force && !m_physics->IsSimulationThreaded())
 		{
-			m_rigidBody->applyForce(ToBtVector3(force), ToBtVector3(position));
+			m_physics->Enqueue([body = m_rigidBody, force, position]() { body->applyForce(ToBtVector3(force), ToBtVector3(position)); });
 		}
-		else if (mode == Impulse)
+		else
 		{
-			m_rigidBody->applyImpulse(ToBtVector3(force), ToBtVector3(position));
+			const Vector3 impulse = mode == Force ? force * m_physics->GetFrameDeltaTime() : force;
+			m_physics->Enqueue([body = m_rigidBody, impulse, position]() { body->applyImpulse(ToBtVector3(impulse), ToBtVector3(position)); });
 		}
 	}
 
@@ -308,13 +345,14 @@ namespace Spartan
 
 		Activate();
 
-		if (mode == Force)
+		if (mode == Force && !m_physics->IsSimulationThreaded())
 		{
-			m_rigidBody->applyTorque(ToBtVector3(torque));
+			m_physics->Enqueue([body = m_rigidBody, torque]() { body->applyTorque(ToBtVector3(torque)); });
 		}
-		else if (mode == Impulse)
+		else
 		{
-			m_rigidBody->applyTorqueImpulse(ToBtVector3(torque));
+			const Vector3 impulse = mode == Force ? torque * m_physics->GetFrameDeltaTime() : torque;
+			m_physics->Enqueue([body = m_rigidBody, impulse]() { body->applyTorqueImpulse(ToBtVector3(impulse)); });
 		}
 	}
 
@@ -336,7 +374,7 @@ namespace Spartan
 			return;
 
 		m_position_lock = lock;
-		m_rigidBody->setLinearFactor(ToBtVector3(Vector3::One - lock));
+		m_physics->Enqueue([body = m_rigidBody, lock]() { body->setLinearFactor(ToBtVector3(Vector3::One - lock)); });
 	}
 
 	void RigidBody::SetRotationLock(bool lock)
@@ -357,7 +395,7 @@ namespace Spartan
 			return;
 
 		m_rotation_lock = lock;
-		m_rigidBody->setAngularFactor(ToBtVector3(Vector3::One - lock));
+		m_physics->Enqueue([body = m_rigidBody, lock]() { body->setAngularFactor(ToBtVector3(Vector3::One - lock)); });
 	}
 
 	void RigidBody::SetCenterOfMass(const Vector3& centerOfMass)
@@ -368,6 +406,17 @@ namespace Spartan
 
 	Vector3 RigidBody::GetPosition() const
 	{
+		if (m_physics->IsSimulationThreaded())
+		{
+			PhysicsBodyState state;
+			if (m_rigidBody && m_physics->GetBodyState(m_rigidBody->getUserIndex(), state))
+			{
+				m_pose_position = state.position - state.rotation * m_center_of_mass;
+			}
+
+			return m_pose_position;
+		}
+
 		if (m_rigidBody)
 		{
 			const btTransform& transform = m_rigidBody->getWorldTransform();
@@ -382,14 +431,19 @@ namespace Spartan
 		if (!m_rigidBody)
 			return;
 
-        // Set position to world transform
-		btTransform& transform_world = m_rigidBody->getWorldTransform();
-		transform_world.setOrigin(ToBtVector3(position + ToQuaternion(transform_world.getRotation()) * m_center_of_mass));
+		m_pose_position = position;
+
+        m_physics->Enqueue([body = m_rigidBody, position, center_of_mass = m_center_of_mass]()
+        {
+            // Set position to world transform
+		    btTransform& transform_world = body->getWorldTransform();
+		    transform_world.setOrigin(ToBtVector3(position + ToQuaternion(transform_world.getRotation()) * center_of_mass));
 
-        // Set position to interpolated world transform
-        btTransform transform_world_interpolated = m_rigidBody->getInterpolationWorldTransform();
-        transform_world_interpolated.setOrigin(transform_world.getOrigin());
-        m_rigidBody->setInterpolationWorldTransform(transform_world_interpolated);
+            // Set position to interpolated world transform
+            btTransform transform_world_interpolated = body->getInterpolationWorldTransform();
+            transform_world_interpolated.setOrigin(transform_world.getOrigin());
+            body->setInterpolationWorldTransform(transform_world_interpolated);
+        });
 
         if (activate)
         {
@@ -399,6 +453,17 @@ namespace Spartan
 
 	Quaternion RigidBody::GetRotation() const
 	{
+		if (m_physics->IsSimulationThreaded())
+		{
+			PhysicsBodyState state;
+			if (m_rigidBody && m_physics->GetBodyState(m_rigidBody->getUserIndex(), state))
+			{
+				m_pose_rotation = state.rotation;
+			}
+
+			return m_pose_rotation;
+		}
+
 		return m_rigidBody ? ToQuaternion(m_rigidBody->getWorldTransform().getRotation()) : Quaternion::Identity;
 	}
 
@@ -407,25 +472,30 @@ namespace Spartan
 		if (!m_rigidBody)
 			return;
 
-        // Set rotation to world transform
-        const Vector3 oldPosition = GetPosition();
-		btTransform& transform_world = m_rigidBody->getWorldTransform();
-		transform_world.setRotation(ToBtQuaternion(rotation));
-		if (m_center_of_mass != Vector3::Zero)
-		{
-			transform_world.setOrigin(ToBtVector3(oldPosition + rotation * m_center_of_mass));
-		}
+		m_pose_rotation = rotation;
 
-        // Set rotation to interpolated world transform
-        btTransform interpTrans = m_rigidBody->getInterpolationWorldTransform();
-        interpTrans.setRotation(transform_world.getRotation());
-        if (m_center_of_mass != Vector3::Zero)
+        m_physics->Enqueue([body = m_rigidBody, rotation, center_of_mass = m_center_of_mass]()
         {
-            interpTrans.setOrigin(transform_world.getOrigin());
-        }
-        m_rigidBody->setInterpolationWorldTransform(interpTrans);
+            // Set rotation to world transform
+		    btTransform& transform_world = body->getWorldTransform();
+            const Vector3 oldPosition = ToVector3(transform_world.getOrigin()) - ToQuaternion(transform_world.getRotation()) * center_of_mass;
+		    transform_world.setRotation(ToBtQuaternion(rotation));
+		    if (center_of_mass != Vector3::Zero)
+		    {
+			    transform_world.setOrigin(ToBtVector3(oldPosition + rotation * center_of_mass));
+		    }
+
+            // Set rotation to interpolated world transform
+            btTransform interpTrans = body->getInterpolationWorldTransform();
+            interpTrans.setRotation(transform_world.getRotation());
+            if (center_of_mass != Vector3::Zero)
+            {
+                interpTrans.setOrigin(transform_world.getOrigin());
+            }
+            body->setInterpolationWorldTransform(interpTrans);
 
-		m_rigidBody->updateInertiaTensor();
+		    body->updateInertiaTensor();
+        });
 
         if (activate)
         {
@@ -438,7 +508,7 @@ namespace Spartan
 		if (!m_rigidBody)
 			return;
 
-		m_rigidBody->clearForces();
+		m_physics->Enqueue([body = m_rigidBody]() { body->clearForces(); });
 	}
 
 	void RigidBody::Activate() const
@@ -448,7 +518,7 @@ namespace Spartan
 
 		if (m_mass > 0.0f)
 		{
-			m_rigidBody->activate(true);
+			m_physics->Enqueue([body = m_rigidBody]() { body->activate(true); });
 		}
 	}
 
@@ -457,7 +527,7 @@ namespace Spartan
 		if (!m_rigidBody)
 			return;
 
-		m_rigidBody->setActivationState(WANTS_DEACTIVATION);
+		m_physics->Enqueue([body = m_rigidBody]() { body->setActivationState(WANTS_DEACTIVATION); });
 	}
 
 	void RigidBody::AddConstraint(Constraint* constraint)
@@ -506,9 +576,8 @@ namespace Spartan
 
 		// Transfer inertia to new collision shape
 		btVector3 local_intertia = btVector3(0, 0, 0);
-		if (m_collision_shape && m_rigidBody)
+		if (m_collision_shape && m_rigidBody && !m_collision_shape->isNonMoving()) // static triangle meshes have no inertia
 		{
-			local_intertia = m_rigidBody ? m_rigidBody->getLocalInertia() : local_intertia;
 			m_collision_shape->calculateLocalInertia(m_mass, local_intertia);
 		}
 		
@@ -517,7 +586,7 @@ namespace Spartan
 		// CONSTRUCTION
 		{
 			// Create a motion state (memory will be freed by the RigidBody)
-            const auto motion_state = new MotionState(this);
+            const auto motion_state = new MotionState(this, m_physics);
 			
 			// Info
 			btRigidBody::btRigidBodyConstructionInfo constructionInfo(m_mass, motion_state, m_collision_shape, local_intertia);
@@ -611,49 +680,106 @@ namespace Spartan
 
 	void RigidBody::Flags_UpdateKinematic() const
     {
-		int flags = m_rigidBody->getCollisionFlags();
-
-		if (m_is_kinematic)
-		{
-			flags |= btCollisionObject::CF_KINEMATIC_OBJECT;
-		}
-		else
+		m_physics->Enqueue([body = m_rigidBody, is_kinematic = m_is_kinematic]()
 		{
-			flags &= ~btCollisionObject::CF_KINEMATIC_OBJECT;
-		}
+		    int flags = body->getCollisionFlags();
 
-		m_rigidBody->setCollisionFlags(flags);
-		m_rigidBody->forceActivationState(m_is_kinematic ? DISABLE_DEACTIVATION : ISLAND_SLEEPING);
-		m_rigidBody->setDeactivationTime(DEFAULT_DEACTIVATION_TIME);
+		    if (is_kinematic)
+		    {
+			    flags |= btCollisionObject::CF_KINEMATIC_OBJECT;
+		    }
+		    else
+		    {
+			    flags &= ~btCollisionObject::CF_KINEMATIC_OBJECT;
+		    }
+
+		    body->setCollisionFlags(flags);
+		    body->forceActivationState(is_kinematic ? DISABLE_DEACTIVATION : ISLAND_SLEEPING);
+		    body->setDeactivationTime(DEFAULT_DEACTIVATION_TIME);
+		});
 	}
 
 	void RigidBody::Flags_UpdateGravity() const
     {
-		int flags = m_rigidBody->getFlags();
+		m_physics->Enqueue([body = m_rigidBody, use_gravity = m_use_gravity, gravity = m_gravity]()
+		{
+		    int flags = body->getFlags();
 
-		if (m_use_gravity)
+		    if (use_gravity)
+		    {
+			    flags &= ~BT_DISABLE_WORLD_GRAVITY;
+		    }
+		    else
+		    {
+			    flags |= BT_DISABLE_WORLD_GRAVITY;
+		    }
+
+		    body->setFlags(flags);
+
+		    if (use_gravity)
+		    {
+			    body->setGravity(ToBtVector3(gravity));
+		    }
+		    else
+		    {
+			    body->setGravity(btVector3(0.0f, 0.0f, 0.0f));
+		    }
+		});
+	}
+
+	bool RigidBody::IsActivated() const
+	{
+		if (m_physics->IsSimulationThreaded())
 		{
-			flags &= ~BT_DISABLE_WORLD_GRAVITY;
+			// Not stepped yet, so not active
+			PhysicsBodyState state;
+			return m_physics->GetBodyState(m_rigidBody->getUserIndex(), state) && state.active;
 		}
-		else
+
+		return m_rigidBody->isActive();
+	}
+
+	void RigidBody::SyncFromSimulationThread()
+	{
+		// Kinematic bodies are driven by the transform, Bullet reads it through the motion state when it steps
+		if (m_is_kinematic)
 		{
-			flags |= BT_DISABLE_WORLD_GRAVITY;
+			const Vector3 position		= GetTransform()->GetPosition();
+			const Quaternion rotation	= GetTransform()->GetRotation();
+			const btTransform transform(ToBtQuaternion(rotation), ToBtVector3(position + rotation * m_center_of_mass));
+			auto motion_state			= static_cast<MotionState*>(m_rigidBody->getMotionState());
+			m_physics->Enqueue([motion_state, transform]() { motion_state->SetTransform(transform); });
+			return;
 		}
 
-		m_rigidBody->setFlags(flags);
+		PhysicsBodyState state;
+		if (!m_physics->GetBodyState(m_rigidBody->getUserIndex(), state))
+			return;
 
-		if (m_use_gravity)
+		// Follow the simulation, interpolating between the last two steps
+		if (state.active || state.position != m_state_position || state.rotation != m_state_rotation)
 		{
-			m_rigidBody->setGravity(ToBtVector3(m_gravity));
+			const float alpha			= m_physics->GetInterpolationAlpha();
+			const Quaternion rotation	= Quaternion::Lerp(state.rotation_previous, state.rotation, alpha);
+			const Vector3 position		= Vector3::Lerp(state.position_previous, state.position, alpha) - rotation * m_center_of_mass;
+
+			GetTransform()->SetPositionAndRotation(position, rotation);
+
+			m_state_position	= state.position;
+			m_state_rotation	= state.rotation;
+			m_synced_position	= position;
+			m_synced_rotation	= rotation;
 		}
-		else
+		// Asleep and moved by the user, move the body along
+		else if (GetTransform()->GetPosition() != m_synced_position || GetTransform()->GetRotation() != m_synced_rotation)
 		{
-			m_rigidBody->setGravity(btVector3(0.0f, 0.0f, 0.0f));
-		}
-	}
+			m_synced_position	= GetTransform()->GetPosition();
+			m_synced_rotation	= GetTransform()->GetRotation();
 
-	bool RigidBody::IsActivated() const
-	{
-		return m_rigidBody->isActive();
+			SetPosition(m_synced_position, false);
+			SetRotation(m_synced_rotation, false);
+			SetLinearVelocity(Vector3::Zero, false);
+			SetAngularVelocity(Vector3::Zero, false);
+		}
 	}
 }
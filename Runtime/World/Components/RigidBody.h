@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "IComponent.h"
 #include <vector>
 #include "../../Math/Vector3.h"
+#include "../../Math/Quaternion.h"
 //=============================
 
 class btRigidBody;
@@ -35,7 +36,6 @@ namespace Spartan
 	class Entity;
 	class Constraint;
 	class Physics;
-	namespace Math { class Quaternion; }
 
 	enum ForceMode
 	{
@@ -146,6 +146,7 @@ namespace Spartan
 		void Flags_UpdateKinematic() const;
 		void Flags_UpdateGravity() const;
 		bool IsActivated() const;
+		void SyncFromSimulationThread();
 
 		float m_mass                    = 0.0f;
 		float m_friction                = 0.0f;
@@ -162,6 +163,15 @@ namespace Spartan
 		btCollisionShape* m_collision_shape = nullptr;
         bool m_in_world                     = false;
 		Physics* m_physics                  = nullptr;
+
+        // Threaded simulation, the last state applied to the transform and the transform it resulted in
+        Math::Vector3 m_state_position          = Math::Vector3::Zero;
+        Math::Quaternion m_state_rotation       = Math::Quaternion::Identity;
+        Math::Vector3 m_synced_position         = Math::Vector3::Zero;
+        Math::Quaternion m_synced_rotation      = Math::Quaternion::Identity;
+        // The last pose known to the game thread, returned when no state has been published for the body yet (Bullet can't be read while it steps)
+        mutable Math::Vector3 m_pose_position       = Math::Vector3::Zero;
+        mutable Math::Quaternion m_pose_rotation    = Math::Quaternion::Identity;
         std::vector<Constraint*> m_constraints;
 	};
 }
@@ -50,17 +50,6 @@ namespace Spartan
 		m_scriptInstance->ExecuteStart();
 	}
 
-	void Script::OnTick(float delta_time)
-	{
-		if (!m_scriptInstance)
-			return;
-
-		if (!m_scriptInstance->IsInstantiated())
-			return;
-
-		m_scriptInstance->ExecuteUpdate(delta_time);
-	}
-
 	void Script::Serialize(FileStream* stream)
 	{
 		stream->Write(m_scriptInstance ? m_scriptInstance->GetScriptPath() : "");
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
+	// The script's update isn't executed from OnTick(), Scripting updates all the instances of a script together
 	class SPARTAN_CLASS Script : public IComponent
 	{
 	public:
@@ -36,7 +37,6 @@ namespace Spartan
 
 		//= ICOMPONENT ===============================
 		void OnStart() override;
-		void OnTick(float delta_time) override;
 		void Serialize(FileStream* stream) override;
 		void Deserialize(FileStream* stream) override;
 		//============================================
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Core/Context.h"
 #include "../../Physics/Physics.h"
 #include "../../Physics/BulletPhysicsHelper.h"
+#include "../../Logging/Log.h"
 #pragma warning(push, 0) // Hide warnings which belong to Bullet
 #include <BulletSoftBody/btSoftBody.h>
 #include <BulletSoftBody/btSoftBodyHelpers.h>
@@ -51,6 +52,12 @@ namespace Spartan
 
     void SoftBody::OnInitialize()
     {
+        if (!m_physics->IsSoftBodySupported())
+        {
+            LOG_ERROR("Soft bodies are not supported by this build, it was generated with premake's --no_soft_bodies option");
+            return;
+        }
+
         // Test
         m_mass = 30.0f;
         CreateBox();
@@ -96,6 +103,9 @@ namespace Spartan
 
     Math::Vector3 SoftBody::GetPosition() const
     {
+        if (m_physics->IsSimulationThreaded())
+            return m_pose_position;
+
         if (m_soft_body)
         {
             const btTransform& transform = m_soft_body->getWorldTransform();
@@ -110,15 +120,23 @@ namespace Spartan
         if (!m_soft_body)
             return;
 
+        m_pose_position = position;
+
         // Set position to world transform
-        btTransform& worldTrans = m_soft_body->getWorldTransform();
-        worldTrans.setOrigin(ToBtVector3(position + ToQuaternion(worldTrans.getRotation()) * m_center_of_mass));
+        m_physics->Enqueue([body = m_soft_body, position, center_of_mass = m_center_of_mass]()
+        {
+            btTransform& worldTrans = body->getWorldTransform();
+            worldTrans.setOrigin(ToBtVector3(position + ToQuaternion(worldTrans.getRotation()) * center_of_mass));
+        });
 
         Activate();
     }
 
     Math::Quaternion SoftBody::GetRotation() const
     {
+        if (m_physics->IsSimulationThreaded())
+            return m_pose_rotation;
+
         return m_soft_body ? ToQuaternion(m_soft_body->getWorldTransform().getRotation()) : Math::Quaternion::Identity;
     }
 
@@ -127,14 +145,19 @@ namespace Spartan
         if (!m_soft_body)
             return;
 
+        m_pose_rotation = rotation;
+
         // Set rotation to world transform
-        const Math::Vector3 oldPosition = GetPosition();
-        btTransform& worldTrans = m_soft_body->getWorldTransform();
-        worldTrans.setRotation(ToBtQuaternion(rotation));
-        if (m_center_of_mass != Math::Vector3::Zero)
+        m_physics->Enqueue([body = m_soft_body, rotation, center_of_mass = m_center_of_mass]()
         {
-            worldTrans.setOrigin(ToBtVector3(oldPosition + rotation * m_center_of_mass));
-        }
+            btTransform& worldTrans = body->getWorldTransform();
+            const Math::Vector3 oldPosition = ToVector3(worldTrans.getOrigin()) - ToQuaternion(worldTrans.getRotation()) * center_of_mass;
+            worldTrans.setRotation(ToBtQuaternion(rotation));
+            if (center_of_mass != Math::Vector3::Zero)
+            {
+                worldTrans.setOrigin(ToBtVector3(oldPosition + rotation * center_of_mass));
+            }
+        });
 
         Activate();
     }
@@ -146,7 +169,7 @@ namespace Spartan
 
         if (m_mass > 0.0f)
         {
-            m_soft_body->activate(true);
+            m_physics->Enqueue([body = m_soft_body]() { body->activate(true); });
         }
     }
 
@@ -246,7 +269,7 @@ namespace Spartan
 
     void SoftBody::Body_AddToWorld()
     {
-        if (!m_physics)
+        if (!m_physics || !m_soft_body)
             return;
 
         m_soft_body->setTotalMass(m_mass);
@@ -78,5 +78,8 @@ namespace Spartan
         bool m_in_world                 = false;
         Math::Vector3 m_center_of_mass  = Math::Vector3::Zero;
         float m_mass                    = 0.0f;
+        // The last pose set from the game thread, returned while the simulation is threaded (Bullet can't be read while it steps)
+        mutable Math::Vector3 m_pose_position       = Math::Vector3::Zero;
+        mutable Math::Quaternion m_pose_rotation    = Math::Quaternion::Identity;
     };
 }
@@ -43,6 +43,7 @@ namespace Spartan
 		m_matrixLocal		= Matrix::Identity;
 		m_wvp_previous		= Matrix::Identity;
 		m_parent			= nullptr;
+		m_world				= context->GetSubsystem<World>();
 
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_positionLocal,	Vector3);
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_rotationLocal,	Quaternion);
@@ -73,16 +74,9 @@ namespace Spartan
 		stream->Read(&m_rotationLocal);
 		stream->Read(&m_scaleLocal);
 		stream->Read(&m_lookAt);
-		uint32_t parententity_id = 0;
-		stream->Read(&parententity_id);
 
-		if (parententity_id != 0)
-		{
-			if (const auto parent = GetContext()->GetSubsystem<World>()->EntityGetById(parententity_id))
-			{
-				parent->GetTransform()->AddChild(this);
-			}
-		}
+		// The parent is resolved by whoever deserializes the entity (searching the world for it here made loading quadratic)
+		stream->Skip(sizeof(uint32_t));
 
 		UpdateTransform();
 	}
@@ -102,6 +96,12 @@ namespace Spartan
 			m_matrix = m_matrixLocal * GetParentTransformMatrix();
 		}
 		
+		// Let the world refit the bounds of this entity
+		if (m_world && m_entity->HasComponent(ComponentType_Renderable))
+		{
+			m_world->SpatialMarkDirty(m_entity);
+		}
+
 		// Update children
 		for (const auto& child : m_children)
 		{
@@ -186,6 +186,19 @@ namespace Spartan
 		}
 	}
 
+	void Transform::SetPositionAndRotation(const Vector3& position, const Quaternion& rotation)
+	{
+		const Vector3 position_local	= !HasParent() ? position : position * GetParent()->GetMatrix().Inverted();
+		const Quaternion rotation_local	= !HasParent() ? rotation : rotation * GetParent()->GetRotation().Inverse();
+
+		if (m_positionLocal == position_local && m_rotationLocal == rotation_local)
+			return;
+
+		m_positionLocal = position_local;
+		m_rotationLocal = rotation_local;
+		UpdateTransform();
+	}
+
 	void Transform::Rotate(const Quaternion& delta)
 	{
 		if (!HasParent())
@@ -364,6 +377,16 @@ namespace Spartan
 		}
 	}
 
+	void Transform::LinkToParent(Transform* parent)
+	{
+		m_parent = parent;
+
+		if (m_parent)
+		{
+			m_parent->m_children.emplace_back(this);
+		}
+	}
+
 	bool Transform::IsDescendantOf(const Transform* transform) const
 	{
         for (const Transform* child : transform->GetChildren())
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include "IComponent.h"
 #include <vector>
+#include <atomic>
 #include "../../Math/Vector3.h"
 #include "../../Math/Quaternion.h"
 #include "../../Math/Matrix.h"
@@ -33,6 +34,7 @@ namespace Spartan
 {
 	class RHI_Device;
 	class RHI_ConstantBuffer;
+	class World;
 
 	class SPARTAN_CLASS Transform : public IComponent
 	{
@@ -69,10 +71,12 @@ namespace Spartan
 		void SetScaleLocal(const Math::Vector3& scale);
 		//===============================================================
 
-		//= TRANSLATION/ROTATION ==================
+		//= TRANSLATION/ROTATION ==================================================================
 		void Translate(const Math::Vector3& delta);
 		void Rotate(const Math::Quaternion& delta);
-		//=========================================
+		// Sets both in world space with a single hierarchy update (SetPosition() and SetRotation() update it once each)
+		void SetPositionAndRotation(const Math::Vector3& position, const Math::Quaternion& rotation);
+		//=========================================================================================
 
 		//= DIRECTIONS ===================
 		Math::Vector3 GetUp()       const;
@@ -98,6 +102,8 @@ namespace Spartan
 		const std::vector<Transform*>& GetChildren() const	{ return m_children; }
 	
 		void AcquireChildren();
+		// Links to a parent without searching the world for children, for loaders which resolve the whole hierarchy
+		void LinkToParent(Transform* parent);
 		bool IsDescendantOf(const Transform* transform) const;
 		void GetDescendants(std::vector<Transform*>* descendants);
 		//======================================================================================
@@ -124,5 +130,20 @@ namespace Spartan
 		std::vector<Transform*> m_children; // the children of this transform
 
 		Math::Matrix m_wvp_previous;
+		World* m_world = nullptr;
+
+		// Queued by the world for a bounds refit, a transform is in the (intrusive) queue at most once.
+		// The link belongs to this instance, assigning another transform (e.g. from scripts) leaves it as it is.
+		friend class World;
+		struct SpatialLink
+		{
+			SpatialLink() = default;
+			SpatialLink(const SpatialLink&) {}
+			SpatialLink& operator=(const SpatialLink&) { return *this; }
+
+			std::atomic<bool> queued	= false;
+			Transform* next				= nullptr;
+		};
+		SpatialLink m_spatial_link;
 	};
 }
@@ -35,6 +35,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Components/AudioSource.h"
 #include "Components/AudioListener.h"
 #include "Components/Terrain.h"
+#include "Components/Animator.h"
 #include "../IO/FileStream.h"
 #include "../Core/Context.h"
 //===================================
@@ -295,6 +296,7 @@ namespace Spartan
             case ComponentType_Environment:		return AddComponent<Environment>(id);
             case ComponentType_Transform:		return AddComponent<Transform>(id);
             case ComponentType_Terrain:		    return AddComponent<Terrain>(id);
+            case ComponentType_Animator:        return AddComponent<Animator>(id);
             case ComponentType_Unknown:			return nullptr;
             default:                            return nullptr;
         }
@@ -27,6 +27,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Components/Light.h"
 #include "Components/Environment.h"
 #include "Components/AudioListener.h"
+#include "Components/Renderable.h"
+#include "Components/Animator.h"
+#include "../Math/Ray.h"
+#include "../Math/RayHit.h"
+#include "../Math/Frustum.h"
 #include "../Core/Engine.h"
 #include "../Core/Stopwatch.h"
 #include "../Resource/ResourceCache.h"
@@ -36,6 +41,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Rendering/Renderer.h"
 #include "../Input/Input.h"
 #include "../RHI/RHI_Device.h"
+#include "../Threading/Threading.h"
+#include "../Scripting/Scripting.h"
 //=====================================
 
 //= NAMESPACES ================
@@ -45,6 +52,112 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+	/*
+	World file layout (all offsets are absolute, so chunks can be read independently or from a mapped file)
+
+	Header		magic, version, entity count, chunk count, string table offset, chunk index offset
+	Entities	per entity: id, parent index, name, active, hierarchy visibility, component count, (type, id) per component
+	Components	one chunk per component type: record offsets, then per record: entity index, component id, payload
+	Strings		every string written while saving, chunks refer to them by index
+	Chunk index	per chunk: type, record count, offset, size
+	*/
+	static constexpr uint32_t world_format_magic		= 0x44575053; // "SPWD"
+	static constexpr uint32_t world_format_version		= 2;
+	static constexpr uint32_t world_chunk_entities		= 0xFFFFFFFF;
+	static constexpr uint32_t world_no_parent			= 0xFFFFFFFF;
+
+	struct WorldChunk
+	{
+		uint32_t type	= 0;
+		uint32_t count	= 0;
+		uint64_t offset	= 0;
+		uint64_t size	= 0;
+	};
+
+	// Component payloads are deserialized in this order, it respects the dependencies between components (e.g. a rigid body needs the collider's shape).
+	// Transforms come first, and are read in parallel as they only touch their own data.
+	static const ComponentType world_deserialization_order[] =
+	{
+		ComponentType_Renderable,
+		ComponentType_Animator,
+		ComponentType_Light,
+		ComponentType_Camera,
+		ComponentType_AudioListener,
+		ComponentType_AudioSource,
+		ComponentType_Environment,
+		ComponentType_Terrain,
+		ComponentType_Collider,
+		ComponentType_RigidBody,
+		ComponentType_SoftBody,
+		ComponentType_Constraint,
+		ComponentType_Script
+	};
+
+	// Flattens a hierarchy depth first, parents always precede their children
+	inline void flatten_hierarchy(Transform* transform, const uint32_t parent_index, vector<Entity*>& entities, vector<uint32_t>& parents)
+	{
+		const auto index = static_cast<uint32_t>(entities.size());
+		entities.emplace_back(transform->GetEntity());
+		parents.emplace_back(parent_index);
+
+		for (Transform* child : transform->GetChildren())
+		{
+			flatten_hierarchy(child, index, entities, parents);
+		}
+	}
+
+	// Components are matched by id, unique ones fall back to their type (an entity creates it's transform before it's id is known)
+	inline IComponent* find_component(Entity* entity, const ComponentType type, const uint32_t id)
+	{
+		IComponent* component_of_type = nullptr;
+		for (const auto& component : entity->GetAllComponents())
+		{
+			if (component->GetType() != type)
+				continue;
+
+			if (component->GetId() == id)
+				return component.get();
+
+			if (!component_of_type && type != ComponentType_Script)
+			{
+				component_of_type = component.get();
+			}
+		}
+
+		return component_of_type;
+	}
+
+	// Reads records [start, end) of a component chunk, the stream must be positioned at the first one
+	inline void deserialize_records(FileStream* stream, const vector<Entity*>& entities, const ComponentType type, const uint32_t start, const uint32_t end)
+	{
+		for (uint32_t i = start; i < end; i++)
+		{
+			const auto entity_index	= stream->ReadAs<uint32_t>();
+			const auto component_id	= stream->ReadAs<uint32_t>();
+			IComponent* component	= entity_index < entities.size() ? find_component(entities[entity_index], type, component_id) : nullptr;
+			if (!component)
+			{
+				LOG_ERROR("Component %u of entity %u is missing, aborting chunk", component_id, entity_index);
+				return;
+			}
+
+			component->Deserialize(stream);
+		}
+	}
+
+	// Returns the world space bounds of an entity, or null if it has nothing to render
+	inline const BoundingBox* get_bounds(Entity* entity)
+	{
+		if (!entity->HasComponent<Renderable>())
+			return nullptr;
+
+		Renderable* renderable = entity->GetRenderable();
+		if (!renderable->GetBoundingBox().Defined())
+			return nullptr;
+
+		return &renderable->GetAabb();
+	}
+
 	World::World(Context* context) : ISubsystem(context)
 	{
 		// Subscribe to events
@@ -58,12 +171,14 @@ namespace Spartan
 		Unload();
         m_input     = nullptr;
         m_profiler  = nullptr;
+        m_scripting = nullptr;
 	}
 
 	bool World::Initialize()
 	{
 		m_input		= m_context->GetSubsystem<Input>();
 		m_profiler	= m_context->GetSubsystem<Profiler>();
+		m_scripting	= m_context->GetSubsystem<Scripting>();
 
 		CreateCamera();
 		CreateEnvironment();
@@ -115,6 +230,9 @@ namespace Spartan
             {
                 entity->Tick(delta_time);
             }
+
+            // Scripts, updated in batches per script type
+            m_scripting->ExecuteUpdates(delta_time);
 		}
 
         if (m_is_dirty)
@@ -133,10 +251,18 @@ namespace Spartan
                 }
             }
 
+            SpatialResolve();
+            AnimatorsResolve();
+
             // Notify Renderer
             FIRE_EVENT_DATA(Event_World_Resolve_Complete, m_entities);
             m_is_dirty = false;
         }
+
+        SpatialUpdate();
+
+        // Animate after resolving, so that removed animators are never evaluated
+        AnimatorsTick(delta_time);
 	}
 
 	void World::Unload()
@@ -144,9 +270,18 @@ namespace Spartan
         // Notify any systems that the entities are about to be cleared
 		FIRE_EVENT(Event_World_Unload);
 
+        // Collected before the entities go, so the queue never links to a destroyed transform
+        SpatialCollectDirty();
+
         m_entities.clear();
         m_entities.shrink_to_fit();
 
+        m_spatial_tree.Clear();
+        m_spatial_proxies.clear();
+        m_spatial_dirty.clear();
+
+        m_animators.clear();
+
 		m_is_dirty = true;
 	}
 
@@ -169,36 +304,137 @@ namespace Spartan
 		// Notify subsystems that need to save data
 		FIRE_EVENT(Event_World_Save);
 
-		// Create a prefab file
-		auto file = make_unique<FileStream>(file_path, FileStream_Write);
+		// Create a world file
+		auto file = make_unique<FileStream>(file_path, FileStream_Write | FileStream_Checksum);
 		if (!file->IsOpen())
 		{
 			LOG_ERROR_GENERIC_FAILURE();
 			return false;
 		}
 
-		// Only save root entities as they will also save their descendants
-		auto root_actors = EntityGetRoots();
-		const auto root_entity_count = static_cast<uint32_t>(root_actors.size());
+		// Flatten the hierarchy and group the components by type
+		vector<Entity*> entities;
+		vector<uint32_t> parents;
+		vector<vector<pair<uint32_t, IComponent*>>> components(ComponentType_Unknown);
+		entities.reserve(m_entities.size());
+		parents.reserve(m_entities.size());
+		for (const auto& root : EntityGetRoots())
+		{
+			flatten_hierarchy(root->GetTransform(), world_no_parent, entities, parents);
+		}
+		for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i++)
+		{
+			for (const auto& component : entities[i]->GetAllComponents())
+			{
+				if (component->GetType() < ComponentType_Unknown)
+				{
+					components[component->GetType()].emplace_back(i, component.get());
+				}
+			}
+		}
+
+		const auto entity_count = static_cast<uint32_t>(entities.size());
+		ProgressReport::Get().SetJobCount(g_progress_world, entity_count);
 
-		ProgressReport::Get().SetJobCount(g_progress_world, root_entity_count);
+		// Header, the counts and offsets are patched once everything is written
+		const auto write_header = [&file, entity_count](const uint32_t chunk_count, const uint64_t string_table_offset, const uint64_t chunk_index_offset)
+		{
+			file->Write(world_format_magic);
+			file->Write(world_format_version);
+			file->Write(entity_count);
+			file->Write(chunk_count);
+			file->Write(string_table_offset);
+			file->Write(chunk_index_offset);
+		};
+		write_header(0, 0, 0);
+
+		FileStream_StringTable string_table;
+		file->SetStringTable(&string_table);
+		vector<WorldChunk> chunks;
+
+		// Entities
+		{
+			WorldChunk& chunk	= chunks.emplace_back();
+			chunk.type			= world_chunk_entities;
+			chunk.count			= entity_count;
+			chunk.offset		= file->GetPosition();
+
+			for (uint32_t i = 0; i < entity_count; i++)
+			{
+				Entity* entity = entities[i];
+				file->Write(entity->GetId());
+				file->Write(parents[i]);
+				file->Write(entity->GetName());
+				file->Write(entity->IsActive());
+				file->Write(entity->IsVisibleInHierarchy());
+
+				const auto& entity_components = entity->GetAllComponents();
+				file->Write(static_cast<uint32_t>(entity_components.size()));
+				for (const auto& component : entity_components)
+				{
+					file->Write(static_cast<uint32_t>(component->GetType()));
+					file->Write(component->GetId());
+				}
+
+				ProgressReport::Get().IncrementJobsDone(g_progress_world);
+			}
 
-		// Save root entity count
-		file->Write(root_entity_count);
+			chunk.size = file->GetPosition() - chunk.offset;
+		}
 
-		// Save root entity IDs
-		for (const auto& root : root_actors)
+		// Components
+		for (uint32_t type = 0; type < ComponentType_Unknown; type++)
 		{
-			file->Write(root->GetId());
+			const auto& records = components[type];
+			if (records.empty())
+				continue;
+
+			// Start on an aligned offset, so that a mapped load can use the record offsets in place
+			file->Align(alignof(uint64_t));
+
+			WorldChunk& chunk	= chunks.emplace_back();
+			chunk.type			= type;
+			chunk.count			= static_cast<uint32_t>(records.size());
+			chunk.offset		= file->GetPosition();
+
+			// Reserve the record offsets, they are known once the records are written
+			vector<uint64_t> record_offsets(records.size());
+			file->WriteSpan(record_offsets.data(), record_offsets.size());
+
+			for (uint32_t i = 0; i < chunk.count; i++)
+			{
+				record_offsets[i] = file->GetPosition();
+				file->Write(records[i].first);
+				file->Write(records[i].second->GetId());
+				records[i].second->Serialize(file.get());
+			}
+
+			const uint64_t chunk_end = file->GetPosition();
+			chunk.size = chunk_end - chunk.offset;
+
+			file->Seek(chunk.offset);
+			file->WriteSpan(record_offsets.data(), record_offsets.size());
+			file->Seek(chunk_end);
 		}
+		file->SetStringTable(nullptr);
 
-		// Save root entities
-		for (const auto& root : root_actors)
+		// String table
+		const uint64_t string_table_offset = file->GetPosition();
+		file->Write(string_table.strings);
+
+		// Chunk index
+		const uint64_t chunk_index_offset = file->GetPosition();
+		for (const WorldChunk& chunk : chunks)
 		{
-			root->Serialize(file.get());
-			ProgressReport::Get().IncrementJobsDone(g_progress_world);
+			file->Write(chunk.type);
+			file->Write(chunk.count);
+			file->Write(chunk.offset);
+			file->Write(chunk.size);
 		}
 
+		file->Seek(0);
+		write_header(static_cast<uint32_t>(chunks.size()), string_table_offset, chunk_index_offset);
+
 		// Finish with progress report and timer
 		ProgressReport::Get().SetIsLoading(g_progress_world, false);
 		LOG_INFO("Saving took %.2f ms", timer.GetElapsedTimeMs());
@@ -234,7 +470,7 @@ namespace Spartan
 		Unload();
 
 		// Read all the resource file paths
-		auto file = make_unique<FileStream>(file_path, FileStream_Read);
+		auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Map | FileStream_Checksum);
 		if (!file->IsOpen())
 			return false;
 
@@ -243,23 +479,36 @@ namespace Spartan
 		// Notify subsystems that need to load data
 		FIRE_EVENT(Event_World_Load);
 
-		// Load root entity count
-        const auto root_entity_count = file->ReadAs<uint32_t>();
-
-		ProgressReport::Get().SetJobCount(g_progress_world, root_entity_count);
-
-		// Load root entity IDs
-		for (uint32_t i = 0; i < root_entity_count; i++)
+		// Chunked files start with a magic number, older ones with their root entity count
+		const auto magic = file->ReadAs<uint32_t>();
+		if (magic == world_format_magic)
 		{
-			auto& entity = EntityCreate();
-			entity->SetId(file->ReadAs<uint32_t>());
+			if (!LoadChunked(file.get(), file_path))
+			{
+				ProgressReport::Get().SetIsLoading(g_progress_world, false);
+				m_state = Ticking;
+				return false;
+			}
 		}
-
-		// Serialize root entities
-		for (uint32_t i = 0; i < root_entity_count; i++)
+		else
 		{
-			m_entities[i]->Deserialize(file.get(), nullptr);
-			ProgressReport::Get().IncrementJobsDone(g_progress_world);
+			const auto root_entity_count = magic;
+
+			ProgressReport::Get().SetJobCount(g_progress_world, root_entity_count);
+
+			// Load root entity IDs
+			for (uint32_t i = 0; i < root_entity_count; i++)
+			{
+				auto& entity = EntityCreate();
+				entity->SetId(file->ReadAs<uint32_t>());
+			}
+
+			// Serialize root entities
+			for (uint32_t i = 0; i < root_entity_count; i++)
+			{
+				m_entities[i]->Deserialize(file.get(), nullptr);
+				ProgressReport::Get().IncrementJobsDone(g_progress_world);
+			}
 		}
 
 		m_is_dirty	= true;
@@ -271,6 +520,148 @@ namespace Spartan
 		return true;
 	}
 
+	bool World::LoadChunked(FileStream* file, const string& file_path)
+	{
+		// Header
+		const auto version = file->ReadAs<uint32_t>();
+		if (version != world_format_version)
+		{
+			LOG_ERROR("Unsupported world format version %u, expected %u", version, world_format_version);
+			return false;
+		}
+		const auto entity_count			= file->ReadAs<uint32_t>();
+		const auto chunk_count			= file->ReadAs<uint32_t>();
+		const auto string_table_offset	= file->ReadAs<uint64_t>();
+		const auto chunk_index_offset	= file->ReadAs<uint64_t>();
+
+		// String table
+		FileStream_StringTable string_table;
+		file->Seek(string_table_offset);
+		file->Read(&string_table.strings);
+		file->SetStringTable(&string_table);
+
+		// Chunk index
+		vector<WorldChunk> chunks(chunk_count);
+		file->Seek(chunk_index_offset);
+		for (WorldChunk& chunk : chunks)
+		{
+			file->Read(&chunk.type);
+			file->Read(&chunk.count);
+			file->Read(&chunk.offset);
+			file->Read(&chunk.size);
+		}
+
+		const auto get_chunk = [&chunks](const uint32_t type) -> const WorldChunk*
+		{
+			for (const WorldChunk& chunk : chunks)
+			{
+				if (chunk.type == type)
+					return &chunk;
+			}
+
+			return nullptr;
+		};
+
+		const WorldChunk* chunk_entities = get_chunk(world_chunk_entities);
+		if (!chunk_entities || chunk_entities->count != entity_count)
+		{
+			LOG_ERROR("\"%s\" has no valid entity chunk", file_path.c_str());
+			return false;
+		}
+
+		ProgressReport::Get().SetJobCount(g_progress_world, entity_count);
+
+		// Create the entities and their components
+		vector<Entity*> entities(entity_count);
+		vector<uint32_t> parents(entity_count);
+		m_entities.reserve(m_entities.size() + entity_count);
+		file->Seek(chunk_entities->offset);
+		for (uint32_t i = 0; i < entity_count; i++)
+		{
+			const auto id		= file->ReadAs<uint32_t>();
+			parents[i]			= file->ReadAs<uint32_t>();
+			const auto name		= file->ReadAs<string>();
+			const auto active	= file->ReadAs<bool>();
+			const auto visible	= file->ReadAs<bool>();
+
+			auto& entity = EntityCreate(active);
+			entity->SetId(id);
+			entity->SetName(name);
+			entity->SetHierarchyVisibility(visible);
+
+			const auto component_count = file->ReadAs<uint32_t>();
+			for (uint32_t c = 0; c < component_count; c++)
+			{
+				const auto component_type	= file->ReadAs<uint32_t>();
+				const auto component_id		= file->ReadAs<uint32_t>();
+				entity->AddComponent(static_cast<ComponentType>(component_type), component_id);
+			}
+
+			entities[i] = entity.get();
+			ProgressReport::Get().IncrementJobsDone(g_progress_world);
+		}
+
+		// Transforms, every thread reads a range of records through it's own stream
+		if (const WorldChunk* chunk = get_chunk(ComponentType_Transform))
+		{
+			// Used in place when the file is mapped (and the chunk is aligned), copied otherwise
+			file->Seek(chunk->offset);
+			vector<uint64_t> record_offsets_copy;
+			const uint64_t* record_offsets = file->ViewSpan<uint64_t>(chunk->count);
+			if (!record_offsets)
+			{
+				record_offsets_copy.resize(chunk->count);
+				file->ReadSpan(record_offsets_copy.data(), record_offsets_copy.size());
+				record_offsets = record_offsets_copy.data();
+			}
+
+			m_context->GetSubsystem<Threading>()->AddTaskLoop([&file_path, &string_table, &entities, record_offsets](const uint32_t start, const uint32_t end)
+			{
+				if (start == end)
+					return;
+
+				FileStream stream(file_path, FileStream_Read | FileStream_Map);
+				if (!stream.IsOpen())
+					return;
+
+				stream.SetStringTable(&string_table);
+				stream.Seek(record_offsets[start]);
+				deserialize_records(&stream, entities, ComponentType_Transform, start, end);
+			}, chunk->count);
+		}
+
+		// Link the hierarchy (parents always precede their children) and compute the world transforms top down
+		for (uint32_t i = 0; i < entity_count; i++)
+		{
+			if (parents[i] < i)
+			{
+				entities[i]->GetTransform()->LinkToParent(entities[parents[i]]->GetTransform());
+			}
+		}
+		for (Entity* entity : entities)
+		{
+			if (entity->GetTransform()->IsRoot())
+			{
+				entity->GetTransform()->UpdateTransform();
+			}
+		}
+
+		// The remaining components, in dependency order
+		for (const ComponentType type : world_deserialization_order)
+		{
+			const WorldChunk* chunk = get_chunk(type);
+			if (!chunk)
+				continue;
+
+			// Skip the record offsets, the records are read sequentially
+			file->Seek(chunk->offset + static_cast<uint64_t>(chunk->count) * sizeof(uint64_t));
+			deserialize_records(file, entities, type, 0, chunk->count);
+		}
+
+		file->SetStringTable(nullptr);
+		return true;
+	}
+
     shared_ptr<Entity>& World::EntityCreate(bool is_active /*= true*/)
     {
         auto& entity = m_entities.emplace_back(make_shared<Entity>(m_context));
@@ -355,6 +746,15 @@ namespace Spartan
             EntityRemove(child->GetEntity()->GetPtrShared());
         }
 
+        // Stop tracking it's bounds
+        SpatialCollectDirty();
+        const auto it = m_spatial_proxies.find(entity.get());
+        if (it != m_spatial_proxies.end())
+        {
+            m_spatial_tree.Remove(it->second);
+            m_spatial_proxies.erase(it);
+        }
+
         // Keep a reference to it's parent (in case it has one)
         auto parent = entity->GetTransform()->GetParent();
 
@@ -377,6 +777,228 @@ namespace Spartan
         }
     }
 
+	void World::RayCast(const Ray& ray, vector<RayHit>& hits, const float max_distance /*= INFINITY*/) const
+	{
+		hits.clear();
+
+		m_spatial_tree.QueryRay(ray, max_distance, [this, &ray, &hits](const int32_t proxy, const float distance_max)
+		{
+			Entity* entity = static_cast<Entity*>(m_spatial_tree.GetUserData(proxy));
+			if (const BoundingBox* aabb = get_bounds(entity))
+			{
+				const float distance = ray.HitDistance(*aabb);
+				if (distance != INFINITY && distance <= distance_max)
+				{
+					hits.emplace_back(
+						entity->GetPtrShared(),                                 // Entity
+						ray.GetStart() + distance * ray.GetDirection(),         // Position
+						distance,                                               // Distance
+						distance == 0.0f                                        // Inside
+					);
+				}
+			}
+
+			return distance_max;
+		});
+
+		// Sort by distance (ascending)
+		sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) { return a.m_distance < b.m_distance; });
+	}
+
+	Entity* World::RayCastClosest(const Ray& ray, const float max_distance /*= INFINITY*/, float* distance /*= nullptr*/) const
+	{
+		Entity* closest			= nullptr;
+		float distance_closest	= max_distance;
+
+		// Shrink the query as closer hits are found
+		m_spatial_tree.QueryRay(ray, max_distance, [this, &ray, &closest, &distance_closest](const int32_t proxy, const float distance_max)
+		{
+			Entity* entity = static_cast<Entity*>(m_spatial_tree.GetUserData(proxy));
+			if (const BoundingBox* aabb = get_bounds(entity))
+			{
+				const float distance_hit = ray.HitDistance(*aabb);
+				if (distance_hit != INFINITY && distance_hit <= distance_max)
+				{
+					closest				= entity;
+					distance_closest	= distance_hit;
+					return distance_hit;
+				}
+			}
+
+			return distance_max;
+		});
+
+		if (closest && distance)
+		{
+			*distance = distance_closest;
+		}
+
+		return closest;
+	}
+
+	void World::QueryFrustum(const Frustum& frustum, vector<Entity*>& entities) const
+	{
+		entities.clear();
+
+		m_spatial_tree.QueryFrustum(frustum, [this, &frustum, &entities](const int32_t proxy)
+		{
+			Entity* entity = static_cast<Entity*>(m_spatial_tree.GetUserData(proxy));
+			const BoundingBox* aabb = get_bounds(entity);
+			if (aabb && frustum.IsInside(*aabb) != Outside)
+			{
+				entities.emplace_back(entity);
+			}
+
+			return true;
+		});
+	}
+
+	void World::QuerySphere(const Vector3& center, const float radius, vector<Entity*>& entities) const
+	{
+		entities.clear();
+
+		m_spatial_tree.QuerySphere(center, radius, [this, &center, radius, &entities](const int32_t proxy)
+		{
+			Entity* entity = static_cast<Entity*>(m_spatial_tree.GetUserData(proxy));
+			const BoundingBox* aabb = get_bounds(entity);
+			if (aabb && Vector3::DistanceSquared(center, aabb->GetClosestPoint(center)) <= radius * radius)
+			{
+				entities.emplace_back(entity);
+			}
+
+			return true;
+		});
+	}
+
+	void World::QueryBox(const BoundingBox& box, vector<Entity*>& entities) const
+	{
+		entities.clear();
+
+		m_spatial_tree.QueryBox(box, [this, &box, &entities](const int32_t proxy)
+		{
+			Entity* entity = static_cast<Entity*>(m_spatial_tree.GetUserData(proxy));
+			const BoundingBox* aabb = get_bounds(entity);
+			if (aabb && box.IsInside(*aabb) != Outside)
+			{
+				entities.emplace_back(entity);
+			}
+
+			return true;
+		});
+	}
+
+	void World::SpatialMarkDirty(Entity* entity)
+	{
+		// Transforms can be updated from worker threads (e.g. while a model is loading or physics writes back),
+		// so this is lock free. The flag lets repeated updates of the same entity within a tick queue it once.
+		Transform* transform = entity->GetTransform();
+		if (transform->m_spatial_link.queued.exchange(true, memory_order_acquire))
+			return;
+
+		transform->m_spatial_link.next = m_spatial_dirty_head.load(memory_order_relaxed);
+		while (!m_spatial_dirty_head.compare_exchange_weak(transform->m_spatial_link.next, transform, memory_order_release, memory_order_relaxed)) {}
+	}
+
+	// Moves the queued entities to m_spatial_dirty, the queue is taken as a whole so it never races with a push
+	void World::SpatialCollectDirty()
+	{
+		Transform* transform = m_spatial_dirty_head.exchange(nullptr, memory_order_acquire);
+		while (transform)
+		{
+			// Read the link before clearing the flag, after that the transform can be queued again
+			Transform* next = transform->m_spatial_link.next;
+			m_spatial_dirty.emplace_back(transform->GetEntity());
+			transform->m_spatial_link.queued.store(false, memory_order_release);
+			transform = next;
+		}
+	}
+
+	// Inserts renderables which are new, refits the known ones and removes those which are gone
+	void World::SpatialResolve()
+	{
+		unordered_map<Entity*, int32_t> proxies;
+		proxies.reserve(m_entities.size());
+
+		for (const auto& entity_ptr : m_entities)
+		{
+			Entity* entity = entity_ptr.get();
+			const BoundingBox* aabb = get_bounds(entity);
+			if (!aabb)
+				continue;
+
+			const auto it = m_spatial_proxies.find(entity);
+			if (it != m_spatial_proxies.end())
+			{
+				m_spatial_tree.Update(it->second, *aabb);
+				proxies[entity] = it->second;
+				m_spatial_proxies.erase(it);
+			}
+			else
+			{
+				proxies[entity] = m_spatial_tree.Insert(*aabb, entity);
+			}
+		}
+
+		// Whatever is left is either gone or no longer renderable (never dereferenced)
+		for (const auto& [entity, proxy] : m_spatial_proxies)
+		{
+			m_spatial_tree.Remove(proxy);
+		}
+
+		m_spatial_proxies = move(proxies);
+	}
+
+	// Refits the bounds of entities whose transform has changed
+	void World::SpatialUpdate()
+	{
+		SpatialCollectDirty();
+
+		for (Entity* entity : m_spatial_dirty)
+		{
+			// Unknown entities are picked up by the next resolve, so they are never dereferenced
+			const auto it = m_spatial_proxies.find(entity);
+			if (it == m_spatial_proxies.end())
+				continue;
+
+			if (const BoundingBox* aabb = get_bounds(entity))
+			{
+				m_spatial_tree.Update(it->second, *aabb);
+			}
+			else
+			{
+				m_spatial_tree.Remove(it->second);
+				m_spatial_proxies.erase(it);
+			}
+		}
+
+		m_spatial_dirty.clear();
+	}
+
+	void World::AnimatorsResolve()
+	{
+		m_animators.clear();
+
+		for (const auto& entity : m_entities)
+		{
+			if (!entity->IsActive())
+				continue;
+
+			if (Animator* animator = entity->GetComponent<Animator>())
+			{
+				m_animators.emplace_back(animator);
+			}
+		}
+	}
+
+	// Only the playback advances here, poses are evaluated by whoever reads them
+	void World::AnimatorsTick(const float delta_time)
+	{
+		for (Animator* animator : m_animators)
+		{
+			animator->Advance(delta_time);
+		}
+	}
+
 	shared_ptr<Entity>& World::CreateEnvironment()
 	{
 		auto& environment = EntityCreate();
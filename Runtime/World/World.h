@@ -25,8 +25,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <memory>
 #include <string>
+#include <atomic>
+#include <unordered_map>
 #include "../Core/EngineDefs.h"
 #include "../Core/ISubsystem.h"
+#include "../Math/DynamicAabbTree.h"
 //=============================
 
 namespace Spartan
@@ -35,6 +38,17 @@ namespace Spartan
 	class Light;
 	class Input;
 	class Profiler;
+	class Scripting;
+	class FileStream;
+	class Animator;
+	class Transform;
+
+	namespace Math
+	{
+		class Ray;
+		class RayHit;
+		class Frustum;
+	}
 
 	enum Scene_State
 	{
@@ -73,8 +87,27 @@ namespace Spartan
 		auto EntityGetCount() const         { return static_cast<uint32_t>(m_entities.size()); }
 		//======================================================================================
 
+		//= SPATIAL QUERIES ====================================================================================================
+		// Returns all renderable entities hit by the ray, sorted by distance (ascending)
+		void RayCast(const Math::Ray& ray, std::vector<Math::RayHit>& hits, float max_distance = INFINITY) const;
+		// Returns the closest renderable entity hit by the ray, or null
+		Entity* RayCastClosest(const Math::Ray& ray, float max_distance = INFINITY, float* distance = nullptr) const;
+		void QueryFrustum(const Math::Frustum& frustum, std::vector<Entity*>& entities) const;
+		void QuerySphere(const Math::Vector3& center, float radius, std::vector<Entity*>& entities) const;
+		void QueryBox(const Math::BoundingBox& box, std::vector<Entity*>& entities) const;
+		// Flags the bounds of an entity as changed, they are refitted during the next tick
+		void SpatialMarkDirty(Entity* entity);
+		const auto& GetSpatialTree() const { return m_spatial_tree; }
+		//======================================================================================================================
+
 	private:
         void _EntityRemove(const std::shared_ptr<Entity>& entity);
+        bool LoadChunked(FileStream* file, const std::string& file_path);
+        void SpatialResolve();
+        void SpatialCollectDirty();
+        void SpatialUpdate();
+        void AnimatorsResolve();
+        void AnimatorsTick(float delta_time);
 
 		//= COMMON ENTITY CREATION ========================
 		std::shared_ptr<Entity>& CreateEnvironment();
@@ -88,7 +121,17 @@ namespace Spartan
         Scene_State m_state         = Ticking;	
         Input* m_input              = nullptr;
         Profiler* m_profiler        = nullptr;
+        Scripting* m_scripting      = nullptr;
 
         std::vector<std::shared_ptr<Entity>> m_entities;
+
+        // Spatial queries
+        Math::DynamicAabbTree m_spatial_tree;
+        std::unordered_map<Entity*, int32_t> m_spatial_proxies;
+        std::atomic<Transform*> m_spatial_dirty_head = nullptr; // pushed to from any thread
+        std::vector<Entity*> m_spatial_dirty;                   // collected from the above, game thread only
+
+        // Animation
+        std::vector<Animator*> m_animators;
 	};
 }
@@ -19,10 +19,12 @@
 
 SOLUTION_NAME		= "Spartan"
 EDITOR_NAME			= "Editor"
+BENCHMARK_NAME		= "Benchmark"
 RUNTIME_NAME		= "Runtime"
 TARGET_NAME			= "Spartan" -- Name of executable
 DEBUG_FORMAT		= "c7"
 EDITOR_DIR			= "../" .. EDITOR_NAME
+BENCHMARK_DIR		= "../" .. BENCHMARK_NAME
 RUNTIME_DIR			= "../" .. RUNTIME_NAME
 IGNORE_FILES		= {}
 LIBRARY_DIR			= "../ThirdParty/libraries"
@@ -30,6 +32,7 @@ INTERMEDIATE_DIR	= "../Binaries/Intermediate"
 TARGET_DIR_RELEASE  = "../Binaries/Release"
 TARGET_DIR_DEBUG    = "../Binaries/Debug"
 API_GRAPHICS		= _ARGS[1]
+API_AUDIO			= _ARGS[2]
 
 -- Compute graphics api specific variables
 if API_GRAPHICS == "d3d11" then
@@ -37,16 +40,41 @@ if API_GRAPHICS == "d3d11" then
 	TARGET_NAME		= "Spartan_d3d11"
 	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D12/**"
 	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/Vulkan/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Null/**"
 elseif API_GRAPHICS == "d3d12" then
 	API_GRAPHICS	= "API_GRAPHICS_D3D12"
 	TARGET_NAME		= "Spartan_d3d12"
 	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D11/**"
 	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/Vulkan/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Null/**"
 elseif API_GRAPHICS == "vulkan" then
 	API_GRAPHICS	= "API_GRAPHICS_VULKAN"
 	TARGET_NAME		= "Spartan_vk"
 	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D11/**"
 	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/D3D12/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Null/**"
+elseif API_GRAPHICS == "null" then
+	API_GRAPHICS	= "API_GRAPHICS_NULL"
+	TARGET_NAME		= "Spartan_null"
+	IGNORE_FILES[0]	= RUNTIME_DIR .. "/RHI/D3D11/**"
+	IGNORE_FILES[1]	= RUNTIME_DIR .. "/RHI/D3D12/**"
+	IGNORE_FILES[2]	= RUNTIME_DIR .. "/RHI/Vulkan/**"
+end
+
+-- Options
+newoption
+{
+	trigger		= "no_soft_bodies",
+	description	= "Drop soft body support, so that Bullet's multithreaded world can solve rigid body islands in parallel"
+}
+
+-- Compute audio api specific variables (the software mixer needs no third-party libraries, for headless and server builds)
+if API_AUDIO == "software" then
+	API_AUDIO		= "API_AUDIO_SOFTWARE"
+	IGNORE_FILES[3]	= RUNTIME_DIR .. "/Audio/FMOD/**"
+else
+	API_AUDIO		= "API_AUDIO_FMOD"
+	IGNORE_FILES[3]	= RUNTIME_DIR .. "/Audio/Software/**"
 end
 
 -- Solution
@@ -88,7 +116,12 @@ project (RUNTIME_NAME)
 	objdir (INTERMEDIATE_DIR)
 	kind "StaticLib"
 	staticruntime "On"
-	defines{ "SPARTAN_RUNTIME", API_GRAPHICS }
+	defines{ "SPARTAN_RUNTIME", API_GRAPHICS, API_AUDIO }
+	defines{ "BT_THREADSAFE=1" } -- the Bullet libraries have to be built with it too, the engine checks on startup and stays single threaded if they weren't
+	
+	if not _OPTIONS["no_soft_bodies"] then
+		defines{ "SPARTAN_PHYSICS_SOFT_BODIES" }
+	end
 	
 	-- Source
 	files 
@@ -100,7 +133,7 @@ project (RUNTIME_NAME)
 	}
 	
 	-- Source to ignore
-	removefiles { IGNORE_FILES[0], IGNORE_FILES[1] }
+	removefiles { IGNORE_FILES[0], IGNORE_FILES[1], IGNORE_FILES[2], IGNORE_FILES[3] }
 
 	-- Includes
 	includedirs { "../ThirdParty/DirectXShaderCompiler" }
@@ -125,7 +158,9 @@ project (RUNTIME_NAME)
 		links { "dxcompiler", "spirv-cross-core_debug", "spirv-cross-hlsl_debug", "spirv-cross-glsl_debug" }
 		links { "angelscript_debug" }
 		links { "assimp_debug" }
-		links { "fmodL64_vc" }
+		if API_AUDIO == "API_AUDIO_FMOD" then
+			links { "fmodL64_vc" }
+		end
 		links { "FreeImageLib_debug" }
 		links { "freetype_debug" }
 		links { "BulletCollision_debug", "BulletDynamics_debug", "BulletSoftBody_debug", "LinearMath_debug" }
@@ -139,7 +174,9 @@ project (RUNTIME_NAME)
 		links { "dxcompiler", "spirv-cross-core", "spirv-cross-hlsl", "spirv-cross-glsl" }
 		links { "angelscript" }
 		links { "assimp" }
-		links { "fmod64_vc" }
+		if API_AUDIO == "API_AUDIO_FMOD" then
+			links { "fmod64_vc" }
+		end
 		links { "FreeImageLib" }
 		links { "freetype" }
 		links { "BulletCollision", "BulletDynamics", "BulletSoftBody", "LinearMath" }
@@ -155,7 +192,7 @@ project (EDITOR_NAME)
 	objdir (INTERMEDIATE_DIR)
 	kind "WindowedApp"
 	staticruntime "On"
-	defines{ "SPARTAN_EDITOR", API_GRAPHICS }
+	defines{ "SPARTAN_EDITOR", API_GRAPHICS, API_AUDIO }
 	
 	-- Files
 	files 
@@ -182,4 +219,42 @@ project (EDITOR_NAME)
 	-- "Release"
 	filter "configurations:Release"
 		targetdir (TARGET_DIR_RELEASE)
-		debugdir (TARGET_DIR_RELEASE)
\ No newline at end of file
+		debugdir (TARGET_DIR_RELEASE)
+
+-- Benchmark -----------------------------------------------------------------------------------------------
+-- Headless, it reads the null backend's command stream, so it only exists in null solutions
+if API_GRAPHICS == "API_GRAPHICS_NULL" then
+project (BENCHMARK_NAME)
+	location (BENCHMARK_DIR)
+	links { RUNTIME_NAME }
+	dependson { RUNTIME_NAME }
+	targetname ( BENCHMARK_NAME .. "_null" )
+	objdir (INTERMEDIATE_DIR)
+	kind "ConsoleApp"
+	staticruntime "On"
+	defines{ API_GRAPHICS, API_AUDIO }
+	
+	-- Files
+	files 
+	{ 
+		BENCHMARK_DIR .. "/**.h",
+		BENCHMARK_DIR .. "/**.cpp"
+	}
+	
+	-- Includes
+	includedirs { "../" .. RUNTIME_NAME }
+	
+	-- Libraries
+	libdirs (LIBRARY_DIR)
+
+	-- "Debug"
+	filter "configurations:Debug"
+		targetdir (TARGET_DIR_DEBUG)	
+		debugdir (TARGET_DIR_DEBUG)
+		debugformat (DEBUG_FORMAT)		
+				
+	-- "Release"
+	filter "configurations:Release"
+		targetdir (TARGET_DIR_RELEASE)
+		debugdir (TARGET_DIR_RELEASE)
+end